@@ -33,7 +33,7 @@
 #define VERIFY_ORIGINAL_IMPL_RET_UNSUPPORTED VERIFY_ORIGINAL_IMPL(synUnsupported)
 #define VERIFY_ORIGINAL_IMPL_RET_NULL        VERIFY_ORIGINAL_IMPL(nullptr)
 
-#define SYNAPSE_SINGLETON_INTERFACE_VERSION "1.14.0.2"
+#define SYNAPSE_SINGLETON_INTERFACE_VERSION "1.14.0.3"
 
 class synSingletonInterface
 {
@@ -1348,6 +1348,15 @@ public:
         VERIFY_ORIGINAL_IMPL_RET_UNSUPPORTED
         return m_originalImpl->getModuleId(idOut);
     }
+
+    virtual synStatus enqueueBatch(const synStreamHandle     streamHandle,
+                                   const synLaunchBatchInfo* launchBatchInfo,
+                                   const uint32_t            numberOfLaunches,
+                                   uint32_t&                 rNumberOfLaunched)
+    {
+        VERIFY_ORIGINAL_IMPL_RET_UNSUPPORTED
+        return m_originalImpl->enqueueBatch(streamHandle, launchBatchInfo, numberOfLaunches, rNumberOfLaunched);
+    }
 };
 
 #endif /*_SYN_SYN_SINGLETON_INTERFACE_H_*/
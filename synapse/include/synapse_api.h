@@ -546,6 +546,12 @@ synStatus SYN_API_CALL synRecipeSectionHostBuffersClear( synRecipeHandle     rec
  * @param   flags                     [in]  A bit map indicates one or more of the following values:
  *                                          SYN_FLAGS_TENSOR_NAME: identify the tensors by their names,
  *                                          instead of their ids.
+ *                                          SYN_FLAGS_LAUNCH_CAPTURE: capture the launch-tensors of this launch,
+ *                                          for the following replay launches of the recipe on the stream.
+ *                                          SYN_FLAGS_LAUNCH_REPLAY: replay the captured launch, re-resolving only
+ *                                          the tensors whose address had changed. The tensors must be given
+ *                                          in the captured order, otherwise (or if the recipe was not captured
+ *                                          on the stream) the recipe is launched regularly.
  *
  * @return                            Status of the operation
  ***************************************************************************************************
@@ -579,6 +585,12 @@ synStatus SYN_API_CALL synLaunch( const synStreamHandle             streamHandle
  * @param   flags                        [in]  A bit map indicates one or more of the following values:
  *                                             SYN_FLAGS_TENSOR_NAME: identify the tensors by their names,
  *                                             instead of their ids.
+ *                                             SYN_FLAGS_LAUNCH_CAPTURE: capture the launch-tensors of this launch,
+ *                                             for the following replay launches of the recipe on the stream.
+ *                                             SYN_FLAGS_LAUNCH_REPLAY: replay the captured launch, re-resolving only
+ *                                             the tensors whose address had changed. The tensors must be given
+ *                                             in the captured order, otherwise (or if the recipe was not captured
+ *                                             on the stream) the recipe is launched regularly.
  *
  * @return                               Status of the operation
  ***************************************************************************************************
@@ -619,6 +631,12 @@ synStatus SYN_API_CALL synLaunchExt(const synStreamHandle             streamHand
  * @param   flags                     [in]  A bit map indicates one or more of the following values:
  *                                          SYN_FLAGS_TENSOR_NAME: identify the tensors by their names,
  *                                          instead of their ids.
+ *                                          SYN_FLAGS_LAUNCH_CAPTURE: capture the launch-tensors of this launch,
+ *                                          for the following replay launches of the recipe on the stream.
+ *                                          SYN_FLAGS_LAUNCH_REPLAY: replay the captured launch, re-resolving only
+ *                                          the tensors whose address had changed. The tensors must be given
+ *                                          in the captured order, otherwise (or if the recipe was not captured
+ *                                          on the stream) the recipe is launched regularly.
  *
  * @return                            Status of the operation
  ***************************************************************************************************
@@ -660,6 +678,12 @@ synStatus SYN_API_CALL synLaunchWithExternalEvents(const synStreamHandle
  * @param   flags                     [in]  A bit map indicates one or more of the following values:
  *                                          SYN_FLAGS_TENSOR_NAME: identify the tensors by their names,
  *                                          instead of their ids.
+ *                                          SYN_FLAGS_LAUNCH_CAPTURE: capture the launch-tensors of this launch,
+ *                                          for the following replay launches of the recipe on the stream.
+ *                                          SYN_FLAGS_LAUNCH_REPLAY: replay the captured launch, re-resolving only
+ *                                          the tensors whose address had changed. The tensors must be given
+ *                                          in the captured order, otherwise (or if the recipe was not captured
+ *                                          on the stream) the recipe is launched regularly.
  *
  * @return                            Status of the operation
  ***************************************************************************************************
@@ -673,6 +697,34 @@ synStatus SYN_API_CALL synLaunchWithExternalEventsExt(const synStreamHandle
                                                       const uint32_t                 numberOfEvents,
                                                       uint32_t                       flags);
 
+//!
+/*!
+ ***************************************************************************************************
+ * @brief Launches a batch of recipes on the specified device stream.
+ *
+ * Equivalent to calling synLaunchExt for each of the batch entries, in order, but
+ * the stream is locked, checked for completions and submitted to the device once
+ * per batch instead of once per launch.
+ * Each entry holds the launch parameters of a single recipe, as given to synLaunchExt.
+ * The launches are enqueued in order, and the first failure stops the batch - the
+ * launches that precede it remain enqueued on the stream.
+ *
+ * @param   streamHandle              [in]  Stream to enqueue operation to
+ * @param   launchBatchInfo           [in]  A pointer to a list of structs holding the launches
+ *                                          information
+ * @param   numberOfLaunches          [in]  The number of launches in launchBatchInfo
+ * @param   pNumberOfLaunched         [out] The number of launches that were enqueued - all of them
+ *                                          on success, the ones preceding the failing launch
+ *                                          otherwise. Can be null
+ *
+ * @return                            Status of the operation
+ ***************************************************************************************************
+ */
+synStatus SYN_API_CALL synLaunchBatch(const synStreamHandle          streamHandle,
+                                      const synLaunchBatchInfo*      launchBatchInfo,
+                                      const uint32_t                 numberOfLaunches,
+                                      uint32_t*                      pNumberOfLaunched);
+
 //!
 /*!
  ***************************************************************************************************
@@ -1406,6 +1458,10 @@ synStatus SYN_API_CALL synNodeGetRoundingMode(  const synGraphHandle    graphHan
  ***************************************************************************************************
  * @brief   Compile the graph specified
  *
+ *          Different graphs may be compiled concurrently by different threads, the produced recipes are the same
+ *          as when the graphs are compiled one after the other. A graph must not be modified or compiled by another
+ *          thread while it is compiled, and the global configuration must not be changed while compiling.
+ *
  * @param   pRecipeHandle       [out] Handle to a HabanaRecipe
  * @param   graphHandle         [in] The Synapse graph to compile
  * @param   pRecipeName         [in] The name of the recipe that will be generated
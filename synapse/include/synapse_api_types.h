@@ -101,6 +101,15 @@ typedef struct
     uint64_t        tensorId;
 } synLaunchTensorInfoExt;
 
+typedef struct
+{
+    const synLaunchTensorInfoExt* launchTensorsInfoExt;
+    uint32_t                      numberOfTensors;
+    uint64_t                      pWorkspace;
+    synRecipeHandle               pRecipeHandle;
+    uint32_t                      flags;
+} synLaunchBatchInfo;
+
 typedef struct
 {
     char            tensorName[ENQUEUE_TENSOR_NAME_MAX_SIZE];
@@ -45,7 +45,9 @@ static const uint32_t INVALID_TENSOR_INDEX       = 0xFFFFFFFF;
 static const uint32_t INVALID_SECTION_ID         = 0xFFFFFFFF;
 static const uint64_t INVALID_CONST_SECTION_DATA = 0xFFFFFFFFFFFFFFFF;
 
-#define SYN_FLAGS_TENSOR_NAME 0x1
+#define SYN_FLAGS_TENSOR_NAME    0x1
+#define SYN_FLAGS_LAUNCH_CAPTURE 0x2
+#define SYN_FLAGS_LAUNCH_REPLAY  0x4
 
 #define TENSOR_INVALID_ID  (0xFFFFFFFFFFFFFFFF)
 
@@ -6,6 +6,7 @@
 #include "desc_gen/node2desc.h"
 #include "node_info/eager_node.h"
 #include "node_info/node_displacement.h"
+#include "recipe_gen/eager_recipe_cache.h"
 #include "recipe_gen/recipe_templates.h"
 #include "utils/general_defs.h"
 #include "utils/numeric_utils.h"
@@ -30,6 +31,7 @@
 #include <bitset>
 #include <memory>
 #include <optional>
+#include <string>
 
 namespace eager_mode
 {
@@ -45,6 +47,9 @@ EagerGraph::EagerGraph(synDeviceType deviceType)
   m_isDebugInfoEnabled(GCFG_ENABLE_PROFILER.value())
 {
     m_graphTraits = std::make_shared<GraphTraits>(deviceType, CompilationMode::Eager);
+    // SW-171881 will get rid of this setting. It is kept in the graph traits rather than in
+    // GCFG_ENABLE_TRANSPOSE_VIA_GEMM, since graphs may be compiled concurrently by other threads.
+    setTransposeViaGemmAllowed(false);
     GlobalConfManager::instance().setDeviceType(deviceType);
     getGraphAnnotation().memoryStrategyParams.dramInfo.enableDramAlloc = true;
 }
@@ -101,13 +106,6 @@ bool EagerGraph::performMaxShapeInference()
 
 bool EagerGraph::compileGraph()
 {
-    if (unlikely(!transitionGraphState(GraphState::COMPILATION_STARTED))) return false;
-    if (calcTypeForCompilation() != getCompilationMode())
-    {
-        EAGER_REPORT_ERROR("{}: Eager doesn't support compilation", HLLOG_FUNC);
-        return false;
-    }
-
     // Must come before nodes addition as it handles aux tensor allocation
     const auto& hal = *m_graphTraits->getHalReader();
     uint64_t    dramSizeInBytes = hal.getDRAMSizeInBytes();
@@ -175,23 +173,39 @@ bool EagerGraph::compile()
     // Must come before nodes addition
     CompilationHalReaderSetter compHalReaderSetter(this);
 
-    // SW-171881 will get rid of this temporary configuration change
-    class TmpGcfgChange
+    if (unlikely(!transitionGraphState(GraphState::COMPILATION_STARTED))) return false;
+    if (calcTypeForCompilation() != getCompilationMode())
     {
-    public:
-        TmpGcfgChange()
-        {
-            GCFG_ENABLE_TRANSPOSE_VIA_GEMM.setValue(false);
-        }
-        ~TmpGcfgChange()
+        EAGER_REPORT_ERROR("{}: Eager doesn't support compilation", HLLOG_FUNC);
+        return false;
+    }
+
+    // A graph of the same signature as a previously compiled one gets a copy of its recipe
+    EagerRecipeCache& recipeCache = EagerRecipeCache::getInstance();
+    std::string       signature;
+    if (recipeCache.isEnabled() && likely(!m_isDebugInfoEnabled) && likely(!GCFG_GRAPH_VISUALIZATION.value()))
+    {
+        if (!m_nodesContainer.lockOriginalNodes()) return false;
+        signature = recipeCache.calcSignature(m_chipType, m_nodesContainer.getOriginalNodes());
+        if (!signature.empty() && m_recipeGenerator.generateFromCache(recipeCache,
+                                                                      signature,
+                                                                      m_recipeName,
+                                                                      m_nodesContainer.getOriginalTensors()))
         {
-            GCFG_ENABLE_TRANSPOSE_VIA_GEMM.setValue(m_origGcfg);
+            return true;
         }
-        bool m_origGcfg = GCFG_ENABLE_TRANSPOSE_VIA_GEMM.value();
-    } tmpGcfgChange;
+    }
 
-    if (compileGraph() == false) return false;
+    if (compileGraph() == false || generateRecipe() == false) return false;
+    if (!signature.empty())
+    {
+        m_recipeGenerator.addToCache(recipeCache, signature);
+    }
+    return true;
+}
 
+bool EagerGraph::generateRecipe()
+{
     // Note that we pass in the original tensors since persistent tensors have to be preserved in the recipe for query
     if (m_nodesContainer.getNodes().getPhysicalNodesNr() > 0)
     {
@@ -126,6 +126,7 @@ public:
 
 private:
     bool compileGraph();
+    bool generateRecipe();
     bool allocateTensors();
     bool loadNOPKernelToProgramDataBlobManager(const KernelInfo& NOPKernelInfo);
     bool transitionGraphState(GraphState newState);
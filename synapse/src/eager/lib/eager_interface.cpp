@@ -2,6 +2,7 @@
 
 // eager includes (relative to src/eager/lib/)
 #include "eager_graph.h"
+#include "recipe_gen/eager_recipe_cache.h"
 #include "recipe_gen/recipe_templates.h"
 
 namespace eager_mode
@@ -30,4 +31,16 @@ const EagerMmeBrainBase& getEagerMmeBrain(const HabanaGraph& eagerGraph)
     return static_cast<const eager_mode::EagerGraph&>(eagerGraph).getEagerMmeBrain();
 }
 
+EagerRecipeCacheStats getEagerRecipeCacheStats()
+{
+    const EagerRecipeCache::Stats stats = EagerRecipeCache::getInstance().getStats();
+    return {stats.hits, stats.misses, stats.evictions, stats.lookupTimeNs, stats.entriesNr, stats.sizeInBytes};
+}
+
+// Drop the cached eager recipes. Called when the configuration changes and on synDestroy.
+void clearEagerRecipeCache()
+{
+    EagerRecipeCache::getInstance().clear();
+}
+
 }  // namespace eager_mode
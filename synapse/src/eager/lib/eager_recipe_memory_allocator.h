@@ -4,6 +4,7 @@
 #include "internal/recipe_allocator.h"
 
 // std includes
+#include <cstdint>
 #include <memory>
 
 namespace eager_mode
@@ -11,9 +12,23 @@ namespace eager_mode
 class EagerRecipeMemoryAllocator : public RecipeAllocator
 {
 public:
-    void addKernelOwnership(const std::shared_ptr<char>& ptr) { m_programPtr = ptr; }
+    void                         addKernelOwnership(const std::shared_ptr<char>& ptr) { m_programPtr = ptr; }
+    const std::shared_ptr<char>& getKernelOwnership() const { return m_programPtr; }
+
+    // Eager recipes are placed in a single buffer, which is tracked in order to copy the recipe (see EagerRecipeCache)
+    char* allocateRecipeBuffer(uint64_t sizeInBytes)
+    {
+        m_recipeBuffer     = allocate(sizeInBytes, /*shouldBeMappedToDevice*/ false);
+        m_recipeBufferSize = sizeInBytes;
+        return m_recipeBuffer;
+    }
+    const char* getRecipeBuffer() const { return m_recipeBuffer; }
+    uint64_t    getRecipeBufferSize() const { return m_recipeBufferSize; }
 
 private:
+    char*    m_recipeBuffer     = nullptr;
+    uint64_t m_recipeBufferSize = 0;
+
     // A shared pointer to kernel or Elf binary requiring ownership.
     // This is an optimization for recipes with a single program data blob.
     // program_data_blobs_buffer should be a continuous memory and hold all
@@ -10,6 +10,9 @@
 // synapse api (relative to include/)
 #include "synapse_common_types.h"
 
+// std includes
+#include <cstdint>
+
 class HabanaGraph;
 
 namespace eager_mode
@@ -28,4 +31,19 @@ HabanaGraph* createEagerGraph(synDeviceType deviceType);
 
 const EagerMmeBrainBase& getEagerMmeBrain(const HabanaGraph& eagerGraph);
 
+// Eager recipe cache statistics, accumulated since the process start
+struct EagerRecipeCacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t lookupTimeNs;  // Total time of the signatures calculation and the lookups, including the copies
+    uint64_t entriesNr;
+    uint64_t sizeInBytes;   // Memory footprint of the cached recipes
+};
+EagerRecipeCacheStats getEagerRecipeCacheStats();
+
+// Drop the cached eager recipes. Called when the configuration changes and on synDestroy.
+void clearEagerRecipeCache();
+
 }  // namespace eager_mode
\ No newline at end of file
@@ -26,8 +26,10 @@ public:
     bool             areOriginalNodesSupported() const { return m_areOrgNodesSupported; }
     bool             areOriginalTensorsSupported() const { return m_orgNodes.getTensors().areAllTensorsSupported(); }
     bool             prepareForGraphDuplication() { return lockAndSortUserNodes(); }
+    bool             lockOriginalNodes() { return !m_orgNodes.isAddingNewNodesEnabled() || lockAndSortUserNodes(); }
 
     NodesNrType            getOriginalNodesNr() const { return m_orgNodes.size(); }
+    const EagerNodes&      getOriginalNodes() const { return m_orgNodes; }
     const EagerTensorsSet& getOriginalTensors() const { return m_orgNodes.getTensors(); }
     bool isEagerCompilationSupported() const { return areOriginalNodesSupported() && areOriginalTensorsSupported(); }
     bool              addNewNode(const EagerNode& node);
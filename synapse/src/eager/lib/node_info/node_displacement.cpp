@@ -1343,24 +1343,18 @@ bool NodeDisplacement::handleMmeConcurrency(const EagerNode& node)
         }  // clang-format on
     }();
 
-    // TODO[SW-170003]: Avoid GCFG temp changes
-
-    // Save some graph mode related env var to restore them later
-    const unsigned defaultPipelineDepth       = GCFG_DEFAULT_PIPELINE_DEPTH.value();
-    const bool     sbReuse                    = GCFG_SB_REUSE.value();
-    const bool     enableMmeEnableMmeAlignOpt = GCFG_ENABLE_MME_ALIGN_OPT.value();
-    // Overwrite current vals to match Eager's config
-    GCFG_DEFAULT_PIPELINE_DEPTH.setValue(1);
-    GCFG_SB_REUSE.setValue(sbReuseStrat);
-    GCFG_ENABLE_MME_ALIGN_OPT.setValue(false);
+    // Graph mode related settings are overridden to match Eager's config for this node only, rather than by
+    // temporarily changing the global knobs, as graphs may be compiled concurrently
+    MmeBrainIfc::StrategyOverrides overrides;
+    overrides.pipelineDepth = 1;
+    overrides.sbReuse       = sbReuseStrat;
+    overrides.alignOpt      = false;
+    brainIfc.setStrategyOverrides(overrides);
 
     // Choose the concurrency
     brainIfc.setRecommendedConcurrency();
 
-    // Restore env vars
-    GCFG_DEFAULT_PIPELINE_DEPTH.setValue(defaultPipelineDepth);
-    GCFG_SB_REUSE.setValue(sbReuse);
-    GCFG_ENABLE_MME_ALIGN_OPT.setValue(enableMmeEnableMmeAlignOpt);
+    brainIfc.setStrategyOverrides({});
 
     if (node->getNodeAnnotation().mmeMetaData.mmeStrategy.cdConcurrencyEn == MmeCommon::TurnedOn)
     {
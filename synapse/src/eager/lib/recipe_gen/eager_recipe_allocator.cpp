@@ -525,8 +525,7 @@ recipe_t* EagerRecipeAllocator::allocateAndInit(size_t namesStrLen)
     planAlloc<char>(totalAlloc, namesStrLen + dataAccum.debugInfoStringsLen);
 
     // Note that allocator's using "new" which has a sufficiently large alignment
-    auto* allocBase =
-        reinterpret_cast<std::byte*>(m_recipeAllocator.allocate(totalAlloc, /*shouldBeMappedToDevice*/ false));
+    auto* allocBase = reinterpret_cast<std::byte*>(m_recipeAllocator.allocateRecipeBuffer(totalAlloc));
 
     auto*     mappedPtr = allocBase;
     auto*     heapPtr   = mappedPtr + alignUpTo(dataAccum.totalMappedSz, 64);
@@ -577,8 +576,7 @@ recipe_t* EagerRecipeAllocator::clone(const DescGeneratorBase& descGenBase, size
     planAlloc<char>(totalAlloc, namesStrLen + debugInfoStringsLen);
 
     // Actual allocation and pointers initialization
-    auto* allocBase =
-        reinterpret_cast<std::byte*>(m_recipeAllocator.allocate(totalAlloc, /*shouldBeMappedToDevice*/ false));
+    auto* allocBase = reinterpret_cast<std::byte*>(m_recipeAllocator.allocateRecipeBuffer(totalAlloc));
     // Recipe and data buffer
     auto* actualRecipe = doPlacement<recipe_t>(allocBase, 1);
     auto* dataBuf      = doPlacement<std::byte>(allocBase, dataBufSize);
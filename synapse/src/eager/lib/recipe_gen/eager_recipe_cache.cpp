@@ -0,0 +1,504 @@
+#include "eager_recipe_cache.h"
+
+// eager includes (relative to src/eager/lib/)
+#include "node_info/eager_node.h"
+#include "node_info/tensor_info.h"
+#include "recipe_gen/recipe_instantiation.h"
+#include "utils/memory_utils.h"
+
+// synapse-internal includes (relative to src/)
+#include "graph_compiler/habana_global_conf.h"
+#include "graph_compiler/habana_nodes/node.h"
+#include "graph_compiler/utils.h"
+
+// synapse api (relative to include/)
+#include "internal/recipe.h"
+
+// std includes
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace eager_mode
+{
+namespace
+{
+constexpr uint64_t BYTES_IN_MB = 1024 * 1024;
+
+// Accumulates the graph description into a flat buffer, which is compared as is on lookup
+class SignatureBuilder
+{
+public:
+    explicit SignatureBuilder(std::string& buffer) : m_buffer(buffer) {}
+
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be added as raw bytes");
+        m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void add(std::string_view str) { addBytes(str.data(), str.size()); }
+    void add(const std::string& str) { add(std::string_view(str)); }
+
+    void addBytes(const void* data, uint64_t size)
+    {
+        add(size);
+        if (size != 0)
+        {
+            m_buffer.append(reinterpret_cast<const char*>(data), size);
+        }
+    }
+
+private:
+    std::string& m_buffer;
+};
+
+class ScopedLookupTimer
+{
+public:
+    explicit ScopedLookupTimer(std::atomic<uint64_t>& rTotalNs)
+    : m_rTotalNs(rTotalNs), m_start(std::chrono::steady_clock::now())
+    {
+    }
+    ~ScopedLookupTimer()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_rTotalNs += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+private:
+    std::atomic<uint64_t>&                      m_rTotalNs;
+    const std::chrono::steady_clock::time_point m_start;
+};
+
+// The eager knobs may be changed between compilations (e.g. by tests). The cache is cleared when the rest of the
+// configuration is set through synConfigurationSet, other changes are not tracked (see EAGER_RECIPE_CACHE_MAX_ENTRIES)
+void addEagerConfigs(SignatureBuilder& sig)
+{
+    sig.add(GCFG_ENABLE_COMPLEX_GUID_LIB_IN_EAGER.value());
+    sig.add(GCFG_ENABLE_EAGER_ARCH_OPTIMIZATIONS.value());
+    sig.add(GCFG_ENABLE_EAGER_NOP_IN_RECIPE.value());
+    sig.add(GCFG_ENABLE_EAGER_SB_REUSE_G2.value());
+    sig.add(GCFG_ENABLE_EAGER_SB_REUSE_G3.value());
+    sig.add(GCFG_ENABLE_EAGER_BATCH_CONCURRENCY.value());
+    sig.add(GCFG_ENABLE_EAGER_MME_CONCURRENCY.value());
+    sig.add(GCFG_ENABLE_CONV_PACKING_EAGER.value());
+    sig.add(GCFG_ENABLE_SUGGESTED_MANIPULATION_IN_EAGER.value());
+    sig.add(std::string_view(GCFG_ENABLE_EAGER_PARALLEL_EXECUTION.value()));
+    sig.add(GCFG_ENABLE_CONSTANT_OPTIMIZATION_IN_EAGER.value());
+    sig.add(GCFG_ENABLE_CAST_OPTIMIZATION_IN_EAGER.value());
+    sig.add(GCFG_ENABLE_EAGER_NODE_DISPLACEMENT_OPTIMIZATIONS.value());
+    sig.add(GCFG_ENABLE_BATCH_NORM_SPLIT_IN_EAGER.value());
+    sig.add(GCFG_ENABLE_TRANSPOSE_FUSION_IN_EAGER.value());
+}
+
+std::optional<uint32_t> findTensorIdx(const VecTensors<TensorPtr>& tensors, const Tensor* tensor)
+{
+    for (uint32_t i = 0; i < tensors.size(); ++i)
+    {
+        if (tensors[i].get() == tensor) return i;
+    }
+    return std::nullopt;
+}
+
+// Everything but the name, which is bound on a hit
+bool addTensor(SignatureBuilder& sig, const VecTensors<TensorPtr>& tensors, const Tensor& tensor)
+{
+    if (tensor.isDynamicShape()) return false;
+
+    sig.add(tensor.getElementType());
+    sig.add(tensor.getTensorType());
+    sig.add(tensor.getDim());
+    sig.addBytes(tensor.getAllNSizesInElements().data(), sizeof(TSize) * tensor.getDim());
+    sig.addBytes(tensor.getNStridesInBytes(), sizeof(TStride) * (tensor.getDim() + 1));
+    sig.add(tensor.isPersistent());
+    sig.add(tensor.getMemorySectionID());
+    sig.add(tensor.getMemorySectionOffset());
+
+    const std::optional<gc::Permutation>& permutation = tensor.getPermutation();
+    sig.add(permutation.has_value());
+    if (permutation.has_value())
+    {
+        const auto& values = permutation->getValues();
+        sig.addBytes(values.data(), values.size() * sizeof(values[0]));
+    }
+
+    if (is8BitFloat(tensor.getElementType()))
+    {
+        sig.add(tensor.getScale());
+        sig.add(tensor.getExpBias());
+    }
+
+    sig.add(tensor.isAliasedTensor());
+    if (tensor.isAliasedTensor())
+    {
+        const std::optional<uint32_t> aliasIdx = findTensorIdx(tensors, tensor.getAliasTensor().get());
+        if (!aliasIdx.has_value()) return false;
+        sig.add(*aliasIdx);
+        sig.add(tensor.getAliasedByteOffset());
+    }
+
+    // Const tensors data is embedded in the recipe
+    sig.add(tensor.isStaticParam());
+    if (tensor.isStaticParam() && tensor.getData() != nullptr)
+    {
+        sig.addBytes(tensor.getData(), tensor.getBufferSizeInBytes());
+    }
+    return true;
+}
+
+bool addOperands(SignatureBuilder& sig, const VecTensors<TensorPtr>& tensors, const TensorVector& operands)
+{
+    static constexpr uint32_t NULL_OPERAND = std::numeric_limits<uint32_t>::max();
+
+    sig.add(operands.size());
+    for (const TensorPtr& operand : operands)
+    {
+        if (operand == nullptr)
+        {
+            sig.add(NULL_OPERAND);
+            continue;
+        }
+        const std::optional<uint32_t> idx = findTensorIdx(tensors, operand.get());
+        if (!idx.has_value()) return false;
+        sig.add(*idx);
+    }
+    return true;
+}
+
+template<typename PtrFunc>
+void forEachTensorsPointer(persist_tensor_info_t*& rTensors, uint64_t tensorsNr, const PtrFunc& func)
+{
+    func(rTensors);
+    for (uint64_t i = 0; i < tensorsNr; ++i)
+    {
+        func(rTensors[i].name);
+        func(rTensors[i].layout);
+        func(rTensors[i].multi_views_indices);
+    }
+}
+
+// The sizes of the recipe structures forEachRecipePointer walks, and of those its arrays point to. A changed size means
+// a member was added or removed: update forEachRecipePointer to visit any new pointer, and then the size here.
+static_assert(sizeof(recipe_t) == 448, "recipe_t changed, update forEachRecipePointer");
+static_assert(sizeof(blob_t) == 16, "blob_t changed, update forEachRecipePointer");
+static_assert(sizeof(program_t) == 16, "program_t changed, update forEachRecipePointer");
+static_assert(sizeof(job_t) == 8, "job_t changed, update forEachRecipePointer");
+static_assert(sizeof(arc_job_t) == 40, "arc_job_t changed, update forEachRecipePointer");
+static_assert(sizeof(ecb_t) == 16, "ecb_t changed, update forEachRecipePointer");
+static_assert(sizeof(persist_tensor_info_t) == 312, "persist_tensor_info_t changed, update forEachRecipePointer");
+static_assert(sizeof(const_section_t) == 24, "const_section_t changed, update forEachRecipePointer");
+static_assert(sizeof(program_data_blob_t) == 32, "program_data_blob_t changed, update forEachRecipePointer");
+static_assert(sizeof(patch_point_t) == 32, "patch_point_t changed, update forEachRecipePointer");
+static_assert(sizeof(section_group_t) == 16, "section_group_t changed, update forEachRecipePointer");
+static_assert(sizeof(section_blobs_t) == 16, "section_blobs_t changed, update forEachRecipePointer");
+static_assert(sizeof(node_program_t) == 16, "node_program_t changed, update forEachRecipePointer");
+static_assert(sizeof(debug_info_t) == 48, "debug_info_t changed, update forEachRecipePointer");
+static_assert(sizeof(node_symbol_info_t) == 64, "node_symbol_info_t changed, update forEachRecipePointer");
+static_assert(sizeof(debug_sync_scheme_t) == 24, "debug_sync_scheme_t changed, update forEachRecipePointer");
+static_assert(sizeof(node_sync_info_arc_t) == 12, "node_sync_info_arc_t changed, update forEachRecipePointer");
+static_assert(sizeof(gc_conf_t) == 16, "gc_conf_t changed, update forEachRecipePointer");
+
+// Calls func on every pointer member of the recipe, an array pointer is visited before its elements
+template<typename PtrFunc>
+void forEachRecipePointer(recipe_t& recipe, const PtrFunc& func)
+{
+    func(recipe.name);
+    func(recipe.execution_blobs_buffer);
+    func(recipe.patching_blobs_buffer);
+    func(recipe.dynamic_blobs_buffer);
+
+    func(recipe.blobs);
+    for (uint64_t i = 0; i < recipe.blobs_nr; ++i)
+    {
+        func(recipe.blobs[i].data);
+    }
+
+    func(recipe.programs);
+    for (uint32_t i = 0; i < recipe.programs_nr; ++i)
+    {
+        func(recipe.programs[i].blob_indices);
+    }
+    func(recipe.activate_jobs);
+    func(recipe.execute_jobs);
+
+    func(recipe.arc_jobs);
+    for (uint32_t i = 0; i < recipe.arc_jobs_nr; ++i)
+    {
+        func(recipe.arc_jobs[i].static_ecb.cmds);
+        func(recipe.arc_jobs[i].dynamic_ecb.cmds);
+    }
+
+    forEachTensorsPointer(recipe.tensors, recipe.persist_tensors_nr, func);
+    forEachTensorsPointer(recipe.permute_tensors_views, recipe.permute_tensors_views_nr, func);
+
+    func(recipe.const_sections);
+    for (uint32_t i = 0; i < recipe.const_sections_nr; ++i)
+    {
+        func(recipe.const_sections[i].data);
+    }
+
+    func(recipe.program_data_blobs_buffer);
+    func(recipe.program_data_blobs);
+    for (uint32_t i = 0; i < recipe.program_data_blobs_nr; ++i)
+    {
+        func(recipe.program_data_blobs[i].data);
+    }
+
+    func(recipe.patch_points);
+
+    func(recipe.section_groups_patch_points);
+    for (uint32_t i = 0; i < recipe.section_groups_nr; ++i)
+    {
+        func(recipe.section_groups_patch_points[i].patch_points_index_list);
+    }
+    func(recipe.sobj_section_group_patch_points.patch_points_index_list);
+
+    func(recipe.section_blobs_indices);
+    for (uint32_t i = 0; i < recipe.section_ids_nr; ++i)
+    {
+        func(recipe.section_blobs_indices[i].blob_indices);
+    }
+
+    func(recipe.node_exe_list);
+    for (uint32_t i = 0; i < recipe.node_nr; ++i)
+    {
+        func(recipe.node_exe_list[i].program_blobs_nr);
+    }
+
+    func(recipe.workspace_sizes);
+
+    debug_info_t& profilerInfo = recipe.debug_profiler_info;
+    func(profilerInfo.nodes);
+    for (uint32_t i = 0; i < profilerInfo.num_nodes; ++i)
+    {
+        func(profilerInfo.nodes[i].node_name);
+        func(profilerInfo.nodes[i].operation);
+        func(profilerInfo.nodes[i].data_type);
+        func(profilerInfo.nodes[i].num_working_engines);
+    }
+    func(profilerInfo.printf_addr);
+    func(recipe.debug_sync_scheme_info.node_sync_info_arc);
+
+    func(recipe.recipe_conf_params);
+}
+
+// Moves the pointers of a copied recipe that point into the source buffer, to the same offsets in the destination.
+// Pointers to data outside of the recipe buffer (e.g. the TPC kernels, see EagerRecipeMemoryAllocator) are kept.
+class PointersRelocator
+{
+public:
+    PointersRelocator(const std::byte* srcBase, uint64_t size, std::byte* dstBase)
+    : m_srcBase(srcBase), m_srcEnd(srcBase + size), m_dstBase(dstBase)
+    {
+    }
+
+    template<typename T>
+    void operator()(T*& rPtr) const
+    {
+        if (isInSource(rPtr))
+        {
+            rPtr = reinterpret_cast<T*>(m_dstBase + (reinterpret_cast<const std::byte*>(rPtr) - m_srcBase));
+        }
+    }
+
+    void relocateRecipe(recipe_t& recipe) const { forEachRecipePointer(recipe, *this); }
+
+private:
+    template<typename T>
+    bool isInSource(const T* ptr) const
+    {
+        const auto* bytePtr = reinterpret_cast<const std::byte*>(ptr);
+        return bytePtr >= m_srcBase && bytePtr < m_srcEnd;
+    }
+
+    const std::byte* m_srcBase;
+    const std::byte* m_srcEnd;
+    std::byte*       m_dstBase;
+};
+
+}  // anonymous namespace
+
+EagerRecipeCache& EagerRecipeCache::getInstance()
+{
+    static EagerRecipeCache cache;
+    return cache;
+}
+
+bool EagerRecipeCache::isEnabled() const
+{
+    return GCFG_EAGER_RECIPE_CACHE_MAX_ENTRIES.value() != 0;
+}
+
+std::string EagerRecipeCache::calcSignature(ChipType chipType, const EagerNodes& orgNodes)
+{
+    ScopedLookupTimer timer(m_lookupTimeNs);
+
+    std::string      signature;
+    SignatureBuilder sig(signature);
+
+    sig.add(chipType);
+    addEagerConfigs(sig);
+
+    const EagerTensorsSet&       tensorsSet = orgNodes.getTensors();
+    const VecTensors<TensorPtr>& tensors    = tensorsSet.getTensors();
+    sig.add(tensors.size());
+    for (uint32_t i = 0; i < tensors.size(); ++i)
+    {
+        if (!addTensor(sig, tensors, *tensors[i])) return {};
+        sig.add(tensorsSet.isGraphInput(i));
+    }
+
+    sig.add(orgNodes.size());
+    for (const EagerNode& node : orgNodes)
+    {
+        // Control dependencies aren't part of the signature
+        if (!node->getControlInputs().empty() || !node->getControlOutputs().empty()) return {};
+
+        sig.add(std::string_view(node->getGUID()));
+        sig.addBytes(node->getParamsRawData().data(), node->getParamsRawData().size());
+        sig.add(node->getRoundingMode());
+        sig.add(node->getDeterministic());
+        sig.add(node->getNodePrecision());
+        sig.add(node->getInputLayouts().empty() ? std::string() : gc::Layout::toString(node->getInputLayouts()));
+        sig.add(node->getOutputLayouts().empty() ? std::string() : gc::Layout::toString(node->getOutputLayouts()));
+        if (!addOperands(sig, tensors, node->getInputs()) || !addOperands(sig, tensors, node->getOutputs()))
+        {
+            return {};
+        }
+    }
+    return signature;
+}
+
+recipe_t* EagerRecipeCache::lookup(const std::string&           signature,
+                                   std::string_view             recipeName,
+                                   const EagerTensorsSet&       tensorsSet,
+                                   EagerRecipeMemoryAllocator*& rpRecipeAllocator)
+{
+    ScopedLookupTimer timer(m_lookupTimeNs);
+
+    EntrySptr entry;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_signatureToEntry.find(signature);
+        if (it != m_signatureToEntry.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            entry = *it->second;
+        }
+    }
+    if (entry == nullptr)
+    {
+        m_misses++;
+        return nullptr;
+    }
+
+    // The names of the recipe and of its persistent tensors are placed after the copied buffer, the names of the
+    // cached recipe are left unused
+    const size_t namesStrLen = (recipeName.size() + 1) + tensorsSet.getNamesSizeOfPersistentTensors();
+
+    auto* pRecipeAllocator = new EagerRecipeMemoryAllocator;
+    auto* buf = reinterpret_cast<std::byte*>(pRecipeAllocator->allocateRecipeBuffer(entry->bufferSize + namesStrLen));
+    std::memcpy(buf, entry->buffer.get(), entry->bufferSize);
+    if (entry->kernelOwnership != nullptr)
+    {
+        pRecipeAllocator->addKernelOwnership(entry->kernelOwnership);
+    }
+
+    auto* recipe = reinterpret_cast<recipe_t*>(buf + (reinterpret_cast<const std::byte*>(entry->recipe) -
+                                                      entry->buffer.get()));
+    PointersRelocator(entry->buffer.get(), entry->bufferSize, buf).relocateRecipe(*recipe);
+
+    StringBufAllocator sba {DataBuf(buf + entry->bufferSize, namesStrLen)};
+    recipe->nameSize = recipeName.size() + 1;
+    recipe->name     = sba.cloneAllocStr(recipeName);
+    RecipeInstantiation::createPersistentTensorsInfo(*recipe, tensorsSet, sba);
+    EAGER_ASSERT(sba.isAllocationCompleted(), "Invalid string buffer allocation");
+
+    rpRecipeAllocator = pRecipeAllocator;
+    m_hits++;
+    return recipe;
+}
+
+void EagerRecipeCache::insert(const std::string&                signature,
+                              const recipe_t&                   recipe,
+                              const EagerRecipeMemoryAllocator& recipeAllocator)
+{
+    const auto*    srcBuf     = reinterpret_cast<const std::byte*>(recipeAllocator.getRecipeBuffer());
+    const uint64_t bufferSize = recipeAllocator.getRecipeBufferSize();
+    EAGER_ASSERT(srcBuf != nullptr, "Eager recipe buffer is not tracked");
+
+    const uint64_t maxEntries     = GCFG_EAGER_RECIPE_CACHE_MAX_ENTRIES.value();
+    const uint64_t maxSizeInBytes = GCFG_EAGER_RECIPE_CACHE_MAX_SIZE.value() * BYTES_IN_MB;
+    if (bufferSize + signature.size() > maxSizeInBytes) return;
+
+    // The copy is done outside of the lock, another thread may insert the same signature in the meantime
+    auto entry        = std::make_shared<Entry>();
+    entry->signature  = signature;
+    entry->buffer     = std::make_unique<std::byte[]>(bufferSize);
+    entry->bufferSize = bufferSize;
+    entry->recipe     = reinterpret_cast<const recipe_t*>(entry->buffer.get() +
+                                                      (reinterpret_cast<const std::byte*>(&recipe) - srcBuf));
+    entry->kernelOwnership = recipeAllocator.getKernelOwnership();
+    std::memcpy(entry->buffer.get(), srcBuf, bufferSize);
+    PointersRelocator(srcBuf, bufferSize, entry->buffer.get()).relocateRecipe(*const_cast<recipe_t*>(entry->recipe));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_signatureToEntry.count(entry->signature) != 0) return;
+
+    m_entries.push_front(entry);
+    m_signatureToEntry.emplace(entry->signature, m_entries.begin());
+    m_sizeInBytes += entry->bufferSize + entry->signature.size();
+    evict(maxEntries, maxSizeInBytes);
+}
+
+void EagerRecipeCache::evict(uint64_t maxEntries, uint64_t maxSizeInBytes)
+{
+    while (m_entries.size() > maxEntries || m_sizeInBytes > maxSizeInBytes)
+    {
+        const EntrySptr& lruEntry = m_entries.back();
+        m_sizeInBytes -= lruEntry->bufferSize + lruEntry->signature.size();
+        m_signatureToEntry.erase(lruEntry->signature);
+        m_entries.pop_back();
+        m_evictions++;
+    }
+}
+
+void EagerRecipeCache::clear()
+{
+    logStats();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_signatureToEntry.clear();
+    m_entries.clear();
+    m_sizeInBytes = 0;
+}
+
+EagerRecipeCache::Stats EagerRecipeCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return {m_hits, m_misses, m_evictions, m_lookupTimeNs, m_entries.size(), m_sizeInBytes};
+}
+
+void EagerRecipeCache::logStats() const
+{
+    const Stats    stats   = getStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+    if (lookups == 0) return;
+
+    LOG_INFO(EAGER,
+             "Eager recipe cache: {} lookups, hit rate {:.1f}%, average lookup time {} ns, {} evictions, "
+             "{} recipes of {} bytes",
+             lookups,
+             100.0 * stats.hits / lookups,
+             stats.lookupTimeNs / lookups,
+             stats.evictions,
+             stats.entriesNr,
+             stats.sizeInBytes);
+}
+
+}  // namespace eager_mode
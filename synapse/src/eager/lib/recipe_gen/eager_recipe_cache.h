@@ -0,0 +1,91 @@
+#pragma once
+
+// eager includes (relative to src/eager/lib/)
+#include "eager_recipe_memory_allocator.h"
+#include "utils/general_defs.h"
+
+// std includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct recipe_t;
+
+namespace eager_mode
+{
+class EagerNodes;
+class EagerTensorsSet;
+
+// A process-wide LRU cache of generated eager recipes.
+// Eager graphs are mostly single ops which are compiled again and again with the same tensors geometry. Such graphs
+// get the same recipe, up to the names of the recipe and of its persistent tensors (the tensors addresses are resolved
+// by their sections at launch). The key is the canonical signature of the user graph (the ops, their params and the
+// geometry, sections and offsets of the tensors), and a hit copies the cached recipe rather than compiling the graph.
+// The configuration is assumed to be fixed while the recipes are cached, apart from the eager knobs which are part of
+// the key. The cache is cleared on synConfigurationSet and on synDestroy.
+class EagerRecipeCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        uint64_t lookupTimeNs;  // Total time of the signatures calculation and the lookups, including the copies
+        uint64_t entriesNr;
+        uint64_t sizeInBytes;
+    };
+
+    static EagerRecipeCache& getInstance();
+
+    bool isEnabled() const;
+
+    // Returns an empty signature for graphs that can't be cached
+    std::string calcSignature(ChipType chipType, const EagerNodes& orgNodes);
+
+    // On a hit, a copy of the cached recipe is placed in a new allocator, bound to the given names and tensors
+    recipe_t* lookup(const std::string&           signature,
+                     std::string_view             recipeName,
+                     const EagerTensorsSet&       tensorsSet,
+                     EagerRecipeMemoryAllocator*& rpRecipeAllocator);
+
+    void insert(const std::string& signature, const recipe_t& recipe, const EagerRecipeMemoryAllocator& recipeAllocator);
+
+    void  clear();
+    Stats getStats() const;
+
+private:
+    EagerRecipeCache() = default;
+
+    struct Entry
+    {
+        std::string                  signature;
+        std::unique_ptr<std::byte[]> buffer;
+        uint64_t                     bufferSize;
+        const recipe_t*              recipe;           // Placed in the buffer
+        std::shared_ptr<char>        kernelOwnership;  // See EagerRecipeMemoryAllocator
+    };
+    using EntrySptr   = std::shared_ptr<const Entry>;
+    using EntriesList = std::list<EntrySptr>;
+
+    void evict(uint64_t maxEntries, uint64_t maxSizeInBytes);
+    void logStats() const;
+
+    mutable std::mutex                                          m_mutex;
+    EntriesList                                                 m_entries;  // Most recently used first
+    std::unordered_map<std::string_view, EntriesList::iterator> m_signatureToEntry;
+    uint64_t                                                    m_sizeInBytes = 0;
+
+    std::atomic<uint64_t> m_hits {0};
+    std::atomic<uint64_t> m_misses {0};
+    std::atomic<uint64_t> m_evictions {0};
+    std::atomic<uint64_t> m_lookupTimeNs {0};
+};
+
+}  // namespace eager_mode
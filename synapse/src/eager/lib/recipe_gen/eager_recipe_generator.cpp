@@ -5,6 +5,7 @@
 #include "desc_gen/node2desc.h"
 #include "eager_recipe_memory_allocator.h"
 #include "recipe_gen/eager_recipe_allocator.h"
+#include "recipe_gen/eager_recipe_cache.h"
 #include "recipe_gen/recipe_instantiation.h"
 #include "utils/general_defs.h"
 #include "utils/memory_utils.h"
@@ -97,8 +98,7 @@ bool EagerRecipeGenerator::generateEmptyRecipe(std::string_view       recipeName
     planAlloc<char>(totalAlloc, namesStrLen);
 
     // Note that allocator's using "new" which has a sufficiently large alignment
-    std::byte* buf =
-        reinterpret_cast<std::byte*>(m_recipeAllocator->allocate(totalAlloc, /*shouldBeMappedToDevice*/ false));
+    std::byte* buf = reinterpret_cast<std::byte*>(m_recipeAllocator->allocateRecipeBuffer(totalAlloc));
     EAGER_ASSERT(size_t(buf) % alignof(recipe_t) == 0, "expected default alignment of new to be sufficiently large");
 
     m_recipe  = doPlacement<recipe_t>(buf, 1);
@@ -139,4 +139,20 @@ bool EagerRecipeGenerator::generateEmptyRecipe(std::string_view       recipeName
     return true;
 }
 
+bool EagerRecipeGenerator::generateFromCache(EagerRecipeCache&      cache,
+                                             const std::string&     signature,
+                                             std::string_view       recipeName,
+                                             const EagerTensorsSet& tensorsSet)
+{
+    EAGER_ASSERT(m_recipeAllocator == nullptr, "Trying to allocate recipe allocator twice");
+    m_recipe = cache.lookup(signature, recipeName, tensorsSet, m_recipeAllocator);
+    return m_recipe != nullptr;
+}
+
+void EagerRecipeGenerator::addToCache(EagerRecipeCache& cache, const std::string& signature) const
+{
+    EAGER_ASSERT(m_recipe != nullptr && m_recipeAllocator != nullptr, "Recipe wasn't generated");
+    cache.insert(signature, *m_recipe, *m_recipeAllocator);
+}
+
 }  // namespace eager_mode
@@ -7,6 +7,7 @@
 #include "recipe_gen/recipe_defs.h"
 
 // std includes
+#include <string>
 #include <string_view>
 #include <utility>
 
@@ -15,6 +16,7 @@ class RecipeAllocator;
 
 namespace eager_mode
 {
+class EagerRecipeCache;
 class Node2DescContainer;
 
 class EagerRecipeGenerator
@@ -32,6 +34,13 @@ public:
 
     bool generateEmptyRecipe(std::string_view recipeName, synDeviceType deviceType, const EagerTensorsSet& tensorsSet);
 
+    // Takes a copy of a cached recipe of the same signature, returns false on a miss
+    bool generateFromCache(EagerRecipeCache&      cache,
+                           const std::string&     signature,
+                           std::string_view       recipeName,
+                           const EagerTensorsSet& tensorsSet);
+    void addToCache(EagerRecipeCache& cache, const std::string& signature) const;
+
     RecipeAllocator* consumeRecipeAllocator() { return std::exchange(m_recipeAllocator, nullptr); }
     const recipe_t*  getRecipe() const { return m_recipe; }
 
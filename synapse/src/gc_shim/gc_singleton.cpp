@@ -15,6 +15,7 @@
 #include <cmath>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -474,6 +475,39 @@ synStatus GraphCompilerSingleton::enqueueWithExternalEventsExt(const synStreamHa
     });
 }
 
+synStatus GraphCompilerSingleton::enqueueBatch(const synStreamHandle     streamHandle,
+                                               const synLaunchBatchInfo* launchBatchInfo,
+                                               const uint32_t            numberOfLaunches,
+                                               uint32_t&                 rNumberOfLaunched)
+{
+    // The tensors are recorded per launch, so the batch is split into its launches
+    for (rNumberOfLaunched = 0; rNumberOfLaunched < numberOfLaunches; rNumberOfLaunched++)
+    {
+        const synLaunchBatchInfo& rLaunch = launchBatchInfo[rNumberOfLaunched];
+
+        auto launchCallback = [&]() {
+            return m_originalImpl->enqueue(streamHandle,
+                                           rLaunch.launchTensorsInfoExt,
+                                           rLaunch.numberOfTensors,
+                                           rLaunch.pWorkspace,
+                                           rLaunch.pRecipeHandle,
+                                           rLaunch.flags);
+        };
+
+        synStatus status = enqueueAndCapture(streamHandle,
+                                             rLaunch.launchTensorsInfoExt,
+                                             rLaunch.numberOfTensors,
+                                             rLaunch.pRecipeHandle,
+                                             launchCallback);
+        if (status != synSuccess)
+        {
+            return status;
+        }
+    }
+
+    return synSuccess;
+}
+
 static bool skipRecording(const std::string recipeName, uint64_t rankId)
 {
     if (!sConfig.ranks.empty() && std::find(sConfig.ranks.begin(), sConfig.ranks.end(), rankId) == sConfig.ranks.end())
@@ -1148,7 +1182,10 @@ synStatus GraphCompilerSingleton::compileGraph(synRecipeHandle*     pRecipeHandl
                                                const char*          recipeName,
                                                const char*          buildLog)
 {
-    GCFG_ENABLE_PROFILER.setValue(true);  // enable debug info for recipe ID, doesn't actually enable profiling.
+    // Enable debug info for recipe ID, doesn't actually enable profiling.
+    // Set once only, as other graphs may be compiled concurrently.
+    static std::once_flag enableDebugInfoOnce;
+    std::call_once(enableDebugInfoOnce, []() { GCFG_ENABLE_PROFILER.setValue(true); });
     const std::string notEmptyRecipeName = recipeName != nullptr && *recipeName != '\0'
                                                ? recipeName
                                                : fmt::format("synrec-auto-gen-{}", (void*)graphHandle);
@@ -98,6 +98,11 @@ public:
                                            uint32_t                      numberOfEvents,
                                            uint32_t                      flags) override;
 
+    synStatus enqueueBatch(const synStreamHandle     streamHandle,
+                           const synLaunchBatchInfo* launchBatchInfo,
+                           const uint32_t            numberOfLaunches,
+                           uint32_t&                 rNumberOfLaunched) override;
+
     virtual synStatus
     createGraph(synGraphHandle* pGraphHandle, synDeviceType deviceType, CompilationMode compilationMode) override;
 
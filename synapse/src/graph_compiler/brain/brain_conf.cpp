@@ -65,6 +65,12 @@ GlobalConfUint64
                                                        DfltUint64(3),
                                                        MakePrivate);
 
+GlobalConfUint64 GCFG_LAYERED_BRAIN_NUM_THREADS("LAYERED_BRAIN_NUM_THREADS",
+                                                "Number of threads used by the iterative layered brain to solve "
+                                                "bundles concurrently. 0/1 to solve bundles one after another",
+                                                DfltUint64(1),
+                                                MakePrivate);
+
 GlobalConfBool GCFG_ENABLE_LAYERED_BRAIN_FULL_LOGGING("ENABLE_LAYERED_BRAIN_FULL_LOGGING",
                                                       "Enable logging when running layered brain generic passes,"
                                                       "WARNING: enabling thie cfg may bloat the log files",
@@ -22,6 +22,7 @@ extern GlobalConfBool   GCFG_LAYERED_BRAIN_SCHEDULER_PREFETCH_NEXT_THREAD;
 extern GlobalConfUint64 GCFG_LAYERED_BRAIN_SCHEDULER_MIN_PIPELINE_DEPTH;
 extern GlobalConfUint64 GCFG_LAYERED_BRAIN_SCHEDULER_MAX_PIPELINE_DEPTH;
 extern GlobalConfUint64 GCFG_LAYERED_BRAIN_FLOW_MODE;
+extern GlobalConfUint64 GCFG_LAYERED_BRAIN_NUM_THREADS;
 extern GlobalConfBool   GCFG_ENABLE_LB_DUPLICATE_SHARED_BUNDLE_INPUTS;
 extern GlobalConfBool   GCFG_ENABLE_ADD_CACHE_WARMUP;
 extern GlobalConfBool   GCFG_ENABLE_CACHE_WARMUP_ON_SINGLE_DCORE;
@@ -8,6 +8,11 @@
 #include "scheduler/scheduler.h"
 #include "slicer/slicer.h"
 #include "memory_management/bundle_cache_manager.h"
+#include "infra/threads/work_stealing_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
 
 namespace gc::layered_brain
 {
@@ -30,14 +35,27 @@ public:
     ScopedLogSuppression& operator=(ScopedLogSuppression&& other) = delete;
 
 private:
-    std::map<synapse::LogManager::LogType, int /*prev log level*/> m_origLoggingLevels;
+    // Log levels are global, so the suppression scopes of bundles solved concurrently are shared - the original levels
+    // are restored when the last scope ends.
+    static std::mutex                                                     s_mutex;
+    static unsigned                                                       s_nofActiveScopes;
+    static std::map<synapse::LogManager::LogType, int /*prev log level*/> s_origLoggingLevels;
+
+    bool m_active = false;
 
     static constexpr int SUPPRESSED_LOG_LEVEL = 4 /*error*/;
 };
 
+std::mutex                                                     ScopedLogSuppression::s_mutex;
+unsigned                                                       ScopedLogSuppression::s_nofActiveScopes = 0;
+std::map<synapse::LogManager::LogType, int /*prev log level*/> ScopedLogSuppression::s_origLoggingLevels;
+
 ScopedLogSuppression::ScopedLogSuppression()
 {
     if (GCFG_ENABLE_LAYERED_BRAIN_FULL_LOGGING.value()) return;
+    std::lock_guard<std::mutex> lock(s_mutex);
+    m_active = true;
+    if (s_nofActiveScopes++ > 0) return;
     auto& logMngr = synapse::LogManager::instance();
     for (uint32_t loggerIdx = 0; loggerIdx < hl_logger::getNbLoggers<synapse::LogManager::LogType>(); ++loggerIdx)
     {
@@ -45,7 +63,7 @@ ScopedLogSuppression::ScopedLogSuppression()
         const auto                         level  = logMngr.get_log_level(logger);
         if (level < SUPPRESSED_LOG_LEVEL)
         {
-            m_origLoggingLevels[logger] = level;
+            s_origLoggingLevels[logger] = level;
             logMngr.set_log_level(logger, SUPPRESSED_LOG_LEVEL);
         }
     }
@@ -53,12 +71,16 @@ ScopedLogSuppression::ScopedLogSuppression()
 
 ScopedLogSuppression::~ScopedLogSuppression()
 {
+    if (!m_active) return;
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (--s_nofActiveScopes > 0) return;
     auto& logMngr = synapse::LogManager::instance();
-    for (const auto& [loggerIdx, prevLevel] : m_origLoggingLevels)
+    for (const auto& [loggerIdx, prevLevel] : s_origLoggingLevels)
     {
         const synapse::LogManager::LogType logger = static_cast<synapse::LogManager::LogType>(loggerIdx);
         logMngr.set_log_level(logger, prevLevel);
     }
+    s_origLoggingLevels.clear();
 }
 
 namespace lb_timing
@@ -192,26 +214,136 @@ void Runner::runIterative()
 
     bundler->logGraphBundlingStatus();
 
-    auto expansionStartTime = lb_timing::now();
-    for (auto& bundle : expandedBundles)
+    auto           expansionStartTime = lb_timing::now();
+    const unsigned nofThreads         = std::max<uint64_t>(GCFG_LAYERED_BRAIN_NUM_THREADS.value(), 1);
+    if (nofThreads == 1)
     {
-        LOG_DEBUG(LAYERED_BRAIN, "Finalizing bundle index {}", bundle->index());
-        const auto unslicedNodes = bundle->getNodesCopy<BundleNodes>();
-        Slicer     slicer(m_graph, bundle->index(), unslicedNodes);
-        const auto chosenStrategy = solveBundle(slicer, bundle);
-        HB_ASSERT_PTR(chosenStrategy);
-        auto slicedGraph = slicer.sliceBundleByStrategy(chosenStrategy);
-        HB_ASSERT(slicedGraph->isConnectedGraph(), "Expecting sliced graph {} to be connected", bundle->index());
-        BundleNodes slicedNodes(slicedGraph->getNodes().begin(), slicedGraph->getNodes().end());
-
-        bptContaminationCanaryCheck(slicedGraph);
-
-        const bool swapSlicedSuccess = finalizeBundleSlicing(*slicedGraph, slicedNodes, unslicedNodes);
-        HB_ASSERT(swapSlicedSuccess, "Failed to insert sliced bundle into the graph");
+        for (auto& bundle : expandedBundles)
+        {
+            const auto unslicedNodes = bundle->getNodesCopy<BundleNodes>();
+            Slicer     slicer(m_graph, bundle->index(), unslicedNodes);
+            sliceAndFinalizeBundle(bundle, slicer, solveBundle(slicer, bundle));
+        }
+    }
+    else
+    {
+        // A pool of a single thread has no workers, so the pool gets all the threads
+        synapse::WorkStealingPool pool(nofThreads);
+        for (auto waveBegin = expandedBundles.cbegin(); waveBegin != expandedBundles.cend();)
+        {
+            auto waveEnd = getIndependentBundlesEnd(waveBegin, expandedBundles.cend());
+            const std::vector<BundlePtr>         wave(waveBegin, waveEnd);
+            std::vector<std::unique_ptr<Slicer>> slicers(wave.size());
+            std::vector<StrategyPtr>             chosenStrategies(wave.size());
+            solveBundles(pool, wave, slicers, chosenStrategies);
+
+            // Merge in bundle order, so the result doesn't depend on the number of threads or their scheduling
+            for (unsigned i = 0; i < wave.size(); i++)
+            {
+                sliceAndFinalizeBundle(wave[i], *slicers[i], chosenStrategies[i]);
+            }
+            waveBegin = waveEnd;
+        }
     }
     LOG_DEBUG(LAYERED_BRAIN, "<LB_TIMING> Bundle solving duration: {}[ms]", lb_timing::elapsedMili(expansionStartTime));
 }
 
+std::vector<BundlePtr>::const_iterator
+Runner::getIndependentBundlesEnd(std::vector<BundlePtr>::const_iterator begin,
+                                 std::vector<BundlePtr>::const_iterator end) const
+{
+    // Bundles connected by a path or sharing a tensor are dependent - the solution of the later one may depend on the
+    // slicing of the earlier one
+    std::vector<BundleNodes> waveNodes;
+    TensorSet                waveTensors;
+    auto                     it = begin;
+    for (; it != end; ++it)
+    {
+        const auto nodes = (*it)->getNodesCopy<BundleNodes>();
+        TensorSet  tensors;
+        for (const NodePtr& n : nodes)
+        {
+            for (const TensorPtr& t : n->getOperands())
+            {
+                if (t != nullptr) tensors.insert(t);
+            }
+        }
+        const bool isDependent =
+            std::any_of(tensors.begin(), tensors.end(), [&](const TensorPtr& t) { return waveTensors.count(t) > 0; }) ||
+            std::any_of(waveNodes.begin(), waveNodes.end(), [&](const BundleNodes& prevNodes) {
+                return m_graph.isAncestor(prevNodes, nodes) || m_graph.isAncestor(nodes, prevNodes);
+            });
+        if (isDependent) break;
+
+        waveNodes.push_back(nodes);
+        waveTensors.insert(tensors.begin(), tensors.end());
+    }
+    LOG_DEBUG(LAYERED_BRAIN,
+              "{} independent bundles starting at bundle index {}",
+              std::distance(begin, it),
+              (*begin)->index());
+    return it;
+}
+
+void Runner::solveBundles(synapse::WorkStealingPool&            pool,
+                          const std::vector<BundlePtr>&         bundles,
+                          std::vector<std::unique_ptr<Slicer>>& rSlicers,
+                          std::vector<StrategyPtr>&             rChosenStrategies) const
+{
+    const unsigned nofBundles = bundles.size();
+    LOG_DEBUG(LAYERED_BRAIN, "Solving {} bundles using {} threads", nofBundles, pool.getNumOfThreads());
+
+    // Solving a bundle only reads the full graph (evaluation steps run on insulated sliced graphs), build the graph
+    // lazy caches before the workers start.
+    m_graph.getNodes();
+    m_graph.getTensors();
+    m_graph.getTopoSortedNodes();
+    m_graph.getExeSortedNodes();
+
+    std::vector<std::exception_ptr> exceptions(nofBundles);
+    synapse::TaskGroup              group(pool);
+    for (unsigned i = 0; i < nofBundles; i++)
+    {
+        group.run([&, i]() {
+            try
+            {
+                const auto unslicedNodes = bundles[i]->getNodesCopy<BundleNodes>();
+                rSlicers[i]              = std::make_unique<Slicer>(m_graph, bundles[i]->index(), unslicedNodes);
+                rChosenStrategies[i]     = solveBundle(*rSlicers[i], bundles[i]);
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        });
+    }
+    group.wait();
+
+    // Report the failure of the first bundle, as the serial flow would
+    for (const std::exception_ptr& exception : exceptions)
+    {
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+void Runner::sliceAndFinalizeBundle(const BundlePtr& bundle, const Slicer& slicer, const StrategyPtr& chosenStrategy)
+{
+    LOG_DEBUG(LAYERED_BRAIN, "Finalizing bundle index {}", bundle->index());
+    HB_ASSERT_PTR(chosenStrategy);
+    const auto unslicedNodes = bundle->getNodesCopy<BundleNodes>();
+    auto       slicedGraph   = slicer.sliceBundleByStrategy(chosenStrategy);
+    HB_ASSERT(slicedGraph->isConnectedGraph(), "Expecting sliced graph {} to be connected", bundle->index());
+    BundleNodes slicedNodes(slicedGraph->getNodes().begin(), slicedGraph->getNodes().end());
+
+    bptContaminationCanaryCheck(slicedGraph);
+
+    const bool swapSlicedSuccess = finalizeBundleSlicing(*slicedGraph, slicedNodes, unslicedNodes);
+    HB_ASSERT(swapSlicedSuccess, "Failed to insert sliced bundle into the graph");
+}
+
 std::vector<bundler::BundleAndExpanders> Runner::getInitialBundles(const BundlerPtr& bundler)
 {
     std::vector<bundler::BundleAndExpanders> initialBundles {};
@@ -9,6 +9,11 @@
 #include "strategy.h"
 #include "slicer/slicer.h"
 
+namespace synapse
+{
+class WorkStealingPool;
+}
+
 namespace gc::layered_brain
 {
 // The layered brain runner performs the outermost flow of the brain - setting it up and calling each layer
@@ -31,6 +36,17 @@ private:
 
     bool finalizeBundleSlicing(HabanaGraph& slicedGraph, BundleNodes& sliceNodes, const BundleNodes& bigNodes);
     void runIterative();
+    // Returns the end of the longest run of bundles starting at begin which are independent of each other
+    std::vector<BundlePtr>::const_iterator getIndependentBundlesEnd(std::vector<BundlePtr>::const_iterator begin,
+                                                                    std::vector<BundlePtr>::const_iterator end) const;
+    // Solves independent bundles concurrently against the current graph. With LAYERED_BRAIN_NUM_THREADS > 1 the bundles
+    // are solved in such waves, each of which is merged into the graph in bundle order before the next one is solved,
+    // so the result is the same as solving, slicing and merging the bundles one by one.
+    void solveBundles(synapse::WorkStealingPool&            pool,
+                      const std::vector<BundlePtr>&         bundles,
+                      std::vector<std::unique_ptr<Slicer>>& rSlicers,
+                      std::vector<StrategyPtr>&             rChosenStrategies) const;
+    void sliceAndFinalizeBundle(const BundlePtr& bundle, const Slicer& slicer, const StrategyPtr& chosenStrategy);
     std::vector<bundler::BundleAndExpanders> getInitialBundles(const BundlerPtr& bundler);
     std::vector<BundlePtr>                   getExpandedBundles(const BundlerPtr& bundler);
     std::vector<BundlePtr>                   expandInitialBundles(const BundlerPtr&                               bundler,
@@ -0,0 +1,21 @@
+#include "compilation_config_snapshot.h"
+
+#include <hl_gcfg/hlgcfg.hpp>
+
+CompilationConfigSnapshot::CompilationConfigSnapshot()
+{
+    hl_gcfg::forEachRegisteredGcfgItem([&](auto& name, auto& item) { m_values.emplace(name, item.getValueStr()); });
+}
+
+std::vector<std::string> CompilationConfigSnapshot::getChangedKnobs() const
+{
+    std::vector<std::string> changed;
+    hl_gcfg::forEachRegisteredGcfgItem([&](auto& name, auto& item) {
+        auto it = m_values.find(name);
+        if (it == m_values.end() || it->second != item.getValueStr())
+        {
+            changed.push_back(name);
+        }
+    });
+    return changed;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Values of all the registered global configuration knobs, as they were when a compilation started
+ *
+ * Independent graphs may be compiled concurrently by different threads, and all of them read the process wide knobs.
+ * Compilation code must not change knobs, settings which differ per graph belong to the graph (e.g. GraphTraits).
+ * A knob changed by another thread while a graph is compiled is seen by part of its passes only, so the snapshot is
+ * used to detect such changes (GCFG_VERIFY_COMPILATION_CONFIG).
+ */
+class CompilationConfigSnapshot
+{
+public:
+    CompilationConfigSnapshot();
+
+    const std::map<std::string, std::string>& getValues() const { return m_values; }
+
+    // Names of the knobs whose current value differs from their snapshot value
+    std::vector<std::string> getChangedKnobs() const;
+
+private:
+    std::map<std::string, std::string> m_values;  // knob name to value string
+};
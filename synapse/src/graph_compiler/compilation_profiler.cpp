@@ -0,0 +1,285 @@
+#include "compilation_profiler.h"
+
+#include "habana_global_conf.h"
+#include "habana_graph.h"
+#include "json_utils.h"
+#include "log_manager.h"
+
+#include <malloc.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+
+static uint64_t cpuTimeUs(bool threadCpu)
+{
+    timespec ts {};
+    clock_gettime(threadCpu ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int64_t maxRssKb()
+{
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static int64_t heapInUseBytes()
+{
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+// Number of ids in sorted 'from' which are missing in sorted 'in'
+static uint32_t countMissing(const std::vector<uint64_t>& from, const std::vector<uint64_t>& in)
+{
+    uint32_t count = 0;
+    auto     inIt  = in.begin();
+    for (uint64_t id : from)
+    {
+        inIt = std::lower_bound(inIt, in.end(), id);
+        if (inIt == in.end() || *inIt != id)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+static void sampleGraphContent(const HabanaGraph& graph, std::vector<uint64_t>& nodeIds, std::vector<uint64_t>& tensorIds)
+{
+    nodeIds.clear();
+    tensorIds.clear();
+    for (const NodePtr& node : graph.getNodes())
+    {
+        if (node == nullptr) continue;
+        nodeIds.push_back(node->getId());
+    }
+    for (const TensorPtr& tensor : graph.getTensors())
+    {
+        if (tensor == nullptr) continue;
+        tensorIds.push_back(tensor->getId());
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+    std::sort(tensorIds.begin(), tensorIds.end());
+}
+
+CompilationProfiler::CompilationProfiler(std::string recipeName)
+: m_recipeName(std::move(recipeName)), m_startTime(std::chrono::steady_clock::now()), m_nofRuns(PASS_ID_MAX_ID, 0)
+{
+}
+
+bool CompilationProfiler::isEnabled()
+{
+    return GCFG_ENABLE_COMPILATION_PROFILE.value() || !GCFG_COMPILATION_PROFILE_FILE.value().empty();
+}
+
+uint64_t CompilationProfiler::elapsedUs(std::chrono::steady_clock::time_point time) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - m_startTime).count();
+}
+
+unsigned CompilationProfiler::nextRunIdx(PassId id)
+{
+    return id < m_nofRuns.size() ? m_nofRuns[id]++ : 0;
+}
+
+CompilationProfiler::Sample
+CompilationProfiler::startPass(const HabanaGraph& graph, const pPass& pass, bool concurrent) const
+{
+    Sample sample;
+    if (!pass->isGraphReadOnly())
+    {
+        sampleGraphContent(graph, sample.nodeIds, sample.tensorIds);
+    }
+    sample.maxRssKb  = maxRssKb();
+    sample.heapBytes = heapInUseBytes();
+    // The process CPU time of a concurrently executed pass would include the other passes of its batch
+    sample.cpuUs    = cpuTimeUs(concurrent);
+    sample.wallTime = std::chrono::steady_clock::now();
+    return sample;
+}
+
+void CompilationProfiler::endPass(const HabanaGraph& graph, const pPass& pass, const Sample& start, bool concurrent)
+{
+    const auto     endTime = std::chrono::steady_clock::now();
+    const uint64_t endCpu  = cpuTimeUs(concurrent);
+
+    PassExecution execution;
+    execution.name           = pass->getName();
+    execution.id             = pass->getId();
+    execution.concurrent     = concurrent;
+    execution.threadId       = static_cast<uint32_t>(syscall(SYS_gettid));
+    execution.startUs        = elapsedUs(start.wallTime);
+    execution.wallUs         = std::chrono::duration_cast<std::chrono::microseconds>(endTime - start.wallTime).count();
+    execution.cpuUs          = endCpu - start.cpuUs;
+    execution.peakRssDeltaKb = maxRssKb() - start.maxRssKb;
+    execution.heapDeltaBytes = heapInUseBytes() - start.heapBytes;
+
+    if (!pass->isGraphReadOnly())
+    {
+        std::vector<uint64_t> nodeIds;
+        std::vector<uint64_t> tensorIds;
+        sampleGraphContent(graph, nodeIds, tensorIds);
+        execution.nodesAdded     = countMissing(nodeIds, start.nodeIds);
+        execution.nodesRemoved   = countMissing(start.nodeIds, nodeIds);
+        execution.tensorsAdded   = countMissing(tensorIds, start.tensorIds);
+        execution.tensorsRemoved = countMissing(start.tensorIds, tensorIds);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    execution.runIdx = nextRunIdx(execution.id);
+    m_executions.push_back(std::move(execution));
+}
+
+std::vector<CompilationProfiler::PassExecution> CompilationProfiler::getExecutions() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_executions;
+}
+
+static nlohmann_hcl::json executionToJson(const CompilationProfiler::PassExecution& execution)
+{
+    nlohmann_hcl::json json;
+    json["pass"]           = execution.name;
+    json["runIdx"]         = execution.runIdx;
+    json["concurrent"]     = execution.concurrent;
+    json["startUs"]        = execution.startUs;
+    json["wallUs"]         = execution.wallUs;
+    json["cpuUs"]          = execution.cpuUs;
+    json["peakRssDeltaKb"] = execution.peakRssDeltaKb;
+    json["heapDeltaBytes"] = execution.heapDeltaBytes;
+    json["nodesAdded"]     = execution.nodesAdded;
+    json["nodesRemoved"]   = execution.nodesRemoved;
+    json["tensorsAdded"]   = execution.tensorsAdded;
+    json["tensorsRemoved"] = execution.tensorsRemoved;
+    return json;
+}
+
+nlohmann_hcl::json CompilationProfiler::toChromeTrace() const
+{
+    const auto pid = getpid();
+
+    nlohmann_hcl::json events = nlohmann_hcl::json::array();
+    for (const PassExecution& execution : getExecutions())
+    {
+        nlohmann_hcl::json event;
+        event["name"] = execution.name;
+        event["cat"]  = "pass";
+        event["pid"]  = pid;
+        event["tid"]  = execution.threadId;
+        event["ts"]   = execution.startUs;
+        event["ph"]   = "X";
+        event["dur"]  = execution.wallUs;
+        event["args"] = executionToJson(execution);
+        events.push_back(std::move(event));
+    }
+
+    nlohmann_hcl::json trace;
+    trace["traceEvents"]         = std::move(events);
+    trace["displayTimeUnit"]     = "ms";
+    trace["otherData"]["recipe"] = m_recipeName;
+    return trace;
+}
+
+nlohmann_hcl::json CompilationProfiler::toSummary() const
+{
+    struct PassTotals
+    {
+        std::string name;
+        unsigned    runs           = 0;
+        uint64_t    wallUs         = 0;
+        uint64_t    maxWallUs      = 0;
+        uint64_t    cpuUs          = 0;
+        int64_t     peakRssDeltaKb = 0;
+        int64_t     heapDeltaBytes = 0;
+        uint64_t    nodesAdded     = 0;
+        uint64_t    nodesRemoved   = 0;
+        uint64_t    tensorsAdded   = 0;
+        uint64_t    tensorsRemoved = 0;
+    };
+
+    const std::vector<PassExecution> executions = getExecutions();
+
+    std::map<PassId, PassTotals> perPass;
+    PassTotals                   total;
+    for (const PassExecution& execution : executions)
+    {
+        for (PassTotals* totals : {&perPass[execution.id], &total})
+        {
+            totals->runs++;
+            totals->wallUs += execution.wallUs;
+            totals->maxWallUs = std::max(totals->maxWallUs, execution.wallUs);
+            totals->cpuUs += execution.cpuUs;
+            totals->peakRssDeltaKb += execution.peakRssDeltaKb;
+            totals->heapDeltaBytes += execution.heapDeltaBytes;
+            totals->nodesAdded += execution.nodesAdded;
+            totals->nodesRemoved += execution.nodesRemoved;
+            totals->tensorsAdded += execution.tensorsAdded;
+            totals->tensorsRemoved += execution.tensorsRemoved;
+        }
+        perPass[execution.id].name = execution.name;
+    }
+
+    std::vector<const PassTotals*> sortedPasses;
+    for (const auto& idAndTotals : perPass)
+    {
+        sortedPasses.push_back(&idAndTotals.second);
+    }
+    // Most expensive passes first
+    std::stable_sort(sortedPasses.begin(), sortedPasses.end(), [](const PassTotals* a, const PassTotals* b) {
+        return a->wallUs > b->wallUs;
+    });
+
+    auto totalsToJson = [](const PassTotals& totals) {
+        nlohmann_hcl::json json;
+        json["runs"]           = totals.runs;
+        json["wallUs"]         = totals.wallUs;
+        json["maxWallUs"]      = totals.maxWallUs;
+        json["cpuUs"]          = totals.cpuUs;
+        json["peakRssDeltaKb"] = totals.peakRssDeltaKb;
+        json["heapDeltaBytes"] = totals.heapDeltaBytes;
+        json["nodesAdded"]     = totals.nodesAdded;
+        json["nodesRemoved"]   = totals.nodesRemoved;
+        json["tensorsAdded"]   = totals.tensorsAdded;
+        json["tensorsRemoved"] = totals.tensorsRemoved;
+        return json;
+    };
+
+    nlohmann_hcl::json summary;
+    summary["recipe"] = m_recipeName;
+    summary["total"]  = totalsToJson(total);
+    summary["passes"] = nlohmann_hcl::json::array();
+    for (const PassTotals* totals : sortedPasses)
+    {
+        nlohmann_hcl::json passJson = totalsToJson(*totals);
+        passJson["pass"]            = totals->name;
+        summary["passes"].push_back(std::move(passJson));
+    }
+    summary["executions"] = nlohmann_hcl::json::array();
+    for (const PassExecution& execution : executions)
+    {
+        summary["executions"].push_back(executionToJson(execution));
+    }
+    return summary;
+}
+
+void CompilationProfiler::dump() const
+{
+    if (GCFG_COMPILATION_PROFILE_FILE.value().empty()) return;
+
+    std::string recipeName = m_recipeName.empty() ? std::string("graph") : m_recipeName;
+    std::replace(recipeName.begin(), recipeName.end(), '/', '_');
+    const std::string prefix = GCFG_COMPILATION_PROFILE_FILE.value() + "." + recipeName;
+
+    LOG_INFO(PASS_MANAGER, "Writing compilation profile of {} to {}.trace.json, {}.summary.json", m_recipeName, prefix, prefix);
+    json_utils::jsonToFile(toChromeTrace(), prefix + ".trace.json");
+    json_utils::jsonToFile(toSummary(), prefix + ".summary.json", 4);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "habana_pass.h"
+#include "json.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class HabanaGraph;
+
+/**
+ * Structured profile of a graph compilation
+ *
+ * Every pass execution, including re-runs triggered by predicates, is recorded with its wall time, CPU time, growth of
+ * the process peak RSS, change of the heap in use, and the nodes and tensors it added to or removed from the graph.
+ * The profile can be fetched from the compiled graph (HabanaGraph::getCompilationProfile) and dumped as a chrome
+ * trace (chrome://tracing, perfetto) and as a per pass summary.
+ */
+class CompilationProfiler
+{
+public:
+    struct PassExecution
+    {
+        std::string name;
+        PassId      id;
+        unsigned    runIdx         = 0;  // 0 for the first execution of the pass, re-runs are numbered from 1
+        bool        concurrent     = false;
+        uint32_t    threadId       = 0;
+        uint64_t    startUs        = 0;  // relative to the start of the compilation
+        uint64_t    wallUs         = 0;
+        uint64_t    cpuUs          = 0;  // process CPU time, or the thread's CPU time for concurrently executed passes
+        int64_t     peakRssDeltaKb = 0;
+        int64_t     heapDeltaBytes = 0;
+        uint32_t    nodesAdded     = 0;
+        uint32_t    nodesRemoved   = 0;
+        uint32_t    tensorsAdded   = 0;
+        uint32_t    tensorsRemoved = 0;
+    };
+
+    // Resource usage and graph content at the start of a pass execution
+    struct Sample
+    {
+        std::chrono::steady_clock::time_point wallTime;
+        uint64_t                              cpuUs     = 0;
+        int64_t                               maxRssKb  = 0;
+        int64_t                               heapBytes = 0;
+        std::vector<uint64_t>                 nodeIds;    // sorted
+        std::vector<uint64_t>                 tensorIds;  // sorted
+    };
+
+    explicit CompilationProfiler(std::string recipeName);
+
+    static bool isEnabled();
+
+    // The graph content is sampled only for passes which may change the graph. Thread safe.
+    Sample startPass(const HabanaGraph& graph, const pPass& pass, bool concurrent) const;
+    void   endPass(const HabanaGraph& graph, const pPass& pass, const Sample& start, bool concurrent);
+
+    std::vector<PassExecution> getExecutions() const;
+
+    nlohmann_hcl::json toChromeTrace() const;
+    nlohmann_hcl::json toSummary() const;
+
+    // Writes <prefix>.<recipe>.trace.json and <prefix>.<recipe>.summary.json, prefix is GCFG_COMPILATION_PROFILE_FILE
+    void dump() const;
+
+private:
+    unsigned nextRunIdx(PassId id);
+    uint64_t elapsedUs(std::chrono::steady_clock::time_point time) const;
+
+    const std::string                           m_recipeName;
+    const std::chrono::steady_clock::time_point m_startTime;
+    mutable std::mutex                          m_mutex;
+    std::vector<PassExecution>                  m_executions;
+    std::vector<unsigned>                       m_nofRuns;  // per pass id
+};
@@ -0,0 +1,252 @@
+#include "flat_graph.h"
+
+#include "graph.h"
+#include "habana_global_conf.h"
+#include "log_manager.h"
+
+#include <algorithm>
+
+FlatGraph::FlatGraph(const Graph& graph)
+{
+    m_nodes = graph.getTopoSortedNodes();
+    if (m_nodes.size() != graph.getNumNodes())
+    {
+        // Cyclic graph, no topological order
+        m_topologicallySorted = false;
+        m_nodes.clear();
+        for (const NodePtr& node : graph.getNodes())
+        {
+            m_nodes.push_back(node);
+        }
+    }
+
+    const unsigned nofNodes = m_nodes.size();
+    m_nodeIndexById.reserve(nofNodes);
+    for (Index nodeIdx = 0; nodeIdx < nofNodes; ++nodeIdx)
+    {
+        m_nodeIndexById.emplace(m_nodes[nodeIdx]->getId(), nodeIdx);
+    }
+
+    // Node tensors
+    m_nodeTensorOffsets.reserve(nofNodes * NUM_SECTIONS + 1);
+    for (const NodePtr& node : m_nodes)
+    {
+        for (const TensorVector* tensors :
+             {&node->getInputs(), &node->getControlInputs(), &node->getOutputs(), &node->getControlOutputs()})
+        {
+            m_nodeTensorOffsets.push_back(m_nodeTensors.size());
+            for (const TensorPtr& tensor : *tensors)
+            {
+                if (tensor == nullptr) continue;
+                m_nodeTensors.push_back(addTensor(tensor));
+            }
+        }
+    }
+    m_nodeTensorOffsets.push_back(m_nodeTensors.size());
+
+    // Tensor producers and consumers. Nodes are visited by index order, so a repeated consumer of a tensor is always
+    // the last one added.
+    const unsigned nofTensors = m_tensors.size();
+    m_tensorProducer.assign(nofTensors, INVALID_IDX);
+    std::vector<Index> lastConsumer(nofTensors, INVALID_IDX);
+    std::vector<Index> nofConsumers(nofTensors, 0);
+    for (Index nodeIdx = 0; nodeIdx < nofNodes; ++nodeIdx)
+    {
+        for (NodeTensorSection section : {DATA_INPUTS, CONTROL_INPUTS})
+        {
+            for (Index tensorIdx : nodeTensors(nodeIdx, section))
+            {
+                if (lastConsumer[tensorIdx] == nodeIdx) continue;
+                lastConsumer[tensorIdx] = nodeIdx;
+                nofConsumers[tensorIdx]++;
+            }
+        }
+        for (NodeTensorSection section : {DATA_OUTPUTS, CONTROL_OUTPUTS})
+        {
+            for (Index tensorIdx : nodeTensors(nodeIdx, section))
+            {
+                m_tensorProducer[tensorIdx] = nodeIdx;
+            }
+        }
+    }
+
+    m_tensorConsumerOffsets.resize(nofTensors + 1, 0);
+    for (Index tensorIdx = 0; tensorIdx < nofTensors; ++tensorIdx)
+    {
+        m_tensorConsumerOffsets[tensorIdx + 1] = m_tensorConsumerOffsets[tensorIdx] + nofConsumers[tensorIdx];
+    }
+    m_tensorConsumers.resize(m_tensorConsumerOffsets.back());
+    std::fill(lastConsumer.begin(), lastConsumer.end(), INVALID_IDX);
+    std::vector<Index> consumerPos(m_tensorConsumerOffsets.begin(), m_tensorConsumerOffsets.end() - 1);
+    for (Index nodeIdx = 0; nodeIdx < nofNodes; ++nodeIdx)
+    {
+        for (NodeTensorSection section : {DATA_INPUTS, CONTROL_INPUTS})
+        {
+            for (Index tensorIdx : nodeTensors(nodeIdx, section))
+            {
+                if (lastConsumer[tensorIdx] == nodeIdx) continue;
+                lastConsumer[tensorIdx]                     = nodeIdx;
+                m_tensorConsumers[consumerPos[tensorIdx]++] = nodeIdx;
+            }
+        }
+    }
+
+    // Node adjacency
+    std::vector<Index> adjacent;
+    m_producerOffsets.reserve(nofNodes + 1);
+    m_consumerOffsets.reserve(nofNodes + 1);
+    m_producerOffsets.push_back(0);
+    m_consumerOffsets.push_back(0);
+    for (Index nodeIdx = 0; nodeIdx < nofNodes; ++nodeIdx)
+    {
+        adjacent.clear();
+        for (NodeTensorSection section : {DATA_INPUTS, CONTROL_INPUTS})
+        {
+            for (Index tensorIdx : nodeTensors(nodeIdx, section))
+            {
+                if (m_tensorProducer[tensorIdx] != INVALID_IDX)
+                {
+                    adjacent.push_back(m_tensorProducer[tensorIdx]);
+                }
+            }
+        }
+        std::sort(adjacent.begin(), adjacent.end());
+        adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+        m_producers.insert(m_producers.end(), adjacent.begin(), adjacent.end());
+        m_producerOffsets.push_back(m_producers.size());
+
+        adjacent.clear();
+        for (NodeTensorSection section : {DATA_OUTPUTS, CONTROL_OUTPUTS})
+        {
+            for (Index tensorIdx : nodeTensors(nodeIdx, section))
+            {
+                const IndexRange tensorConsumers = this->tensorConsumers(tensorIdx);
+                adjacent.insert(adjacent.end(), tensorConsumers.begin(), tensorConsumers.end());
+            }
+        }
+        std::sort(adjacent.begin(), adjacent.end());
+        adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+        m_consumers.insert(m_consumers.end(), adjacent.begin(), adjacent.end());
+        m_consumerOffsets.push_back(m_consumers.size());
+    }
+
+    LOG_TRACE(GC, "Flat graph snapshot built, nodes: {}, tensors: {}", nofNodes, nofTensors);
+}
+
+FlatGraph::Index FlatGraph::addTensor(const TensorPtr& tensor)
+{
+    auto [it, inserted] = m_tensorIndexById.emplace(tensor->getId(), m_tensors.size());
+    if (inserted)
+    {
+        m_tensors.push_back(tensor);
+    }
+    return it->second;
+}
+
+FlatGraph::Index FlatGraph::nodeIndex(const NodePtr& node) const
+{
+    if (node == nullptr) return INVALID_IDX;
+    auto it = m_nodeIndexById.find(node->getId());
+    return (it != m_nodeIndexById.end() && m_nodes[it->second] == node) ? it->second : INVALID_IDX;
+}
+
+FlatGraph::Index FlatGraph::tensorIndex(const TensorPtr& tensor) const
+{
+    if (tensor == nullptr) return INVALID_IDX;
+    auto it = m_tensorIndexById.find(tensor->getId());
+    return (it != m_tensorIndexById.end() && m_tensors[it->second] == tensor) ? it->second : INVALID_IDX;
+}
+
+FlatGraph::IndexRange FlatGraph::nodeTensors(Index nodeIdx, NodeTensorSection section) const
+{
+    const Index* offsets = &m_nodeTensorOffsets[nodeIdx * NUM_SECTIONS + section];
+    return IndexRange(m_nodeTensors.data() + offsets[0], m_nodeTensors.data() + offsets[1]);
+}
+
+FlatGraph::IndexRange FlatGraph::dataInputs(Index nodeIdx) const
+{
+    return nodeTensors(nodeIdx, DATA_INPUTS);
+}
+
+FlatGraph::IndexRange FlatGraph::controlInputs(Index nodeIdx) const
+{
+    return nodeTensors(nodeIdx, CONTROL_INPUTS);
+}
+
+FlatGraph::IndexRange FlatGraph::dataOutputs(Index nodeIdx) const
+{
+    return nodeTensors(nodeIdx, DATA_OUTPUTS);
+}
+
+FlatGraph::IndexRange FlatGraph::controlOutputs(Index nodeIdx) const
+{
+    return nodeTensors(nodeIdx, CONTROL_OUTPUTS);
+}
+
+FlatGraph::IndexRange FlatGraph::tensorConsumers(Index tensorIdx) const
+{
+    return IndexRange(m_tensorConsumers.data() + m_tensorConsumerOffsets[tensorIdx],
+                      m_tensorConsumers.data() + m_tensorConsumerOffsets[tensorIdx + 1]);
+}
+
+FlatGraph::IndexRange FlatGraph::producers(Index nodeIdx) const
+{
+    return IndexRange(m_producers.data() + m_producerOffsets[nodeIdx],
+                      m_producers.data() + m_producerOffsets[nodeIdx + 1]);
+}
+
+FlatGraph::IndexRange FlatGraph::consumers(Index nodeIdx) const
+{
+    return IndexRange(m_consumers.data() + m_consumerOffsets[nodeIdx],
+                      m_consumers.data() + m_consumerOffsets[nodeIdx + 1]);
+}
+
+void FlatGraph::buildReachability() const
+{
+    if (!m_topologicallySorted || numNodes() > GCFG_FLAT_GRAPH_REACHABILITY_MAX_NODES.value()) return;
+
+    // Producers precede their consumers, so a node's ancestors are final once all its producers were visited
+    m_ancestors = std::make_unique<BitArray2D>(numNodes());
+    m_ancestors->setDiagonal();
+    for (Index nodeIdx = 0; nodeIdx < numNodes(); ++nodeIdx)
+    {
+        for (Index producerIdx : producers(nodeIdx))
+        {
+            m_ancestors->bitwiseOr(producerIdx, nodeIdx, nodeIdx);
+        }
+    }
+}
+
+bool FlatGraph::searchAncestor(Index sourceIdx, Index targetIdx) const
+{
+    // Walk backwards from the target. In topological order, nodes preceding the source can't be reached from it.
+    std::vector<bool>  visited(numNodes(), false);
+    std::vector<Index> stack = {targetIdx};
+    visited[targetIdx]       = true;
+    while (!stack.empty())
+    {
+        const Index nodeIdx = stack.back();
+        stack.pop_back();
+        for (Index producerIdx : producers(nodeIdx))
+        {
+            if (producerIdx == sourceIdx) return true;
+            if (visited[producerIdx] || (m_topologicallySorted && producerIdx < sourceIdx)) continue;
+            visited[producerIdx] = true;
+            stack.push_back(producerIdx);
+        }
+    }
+    return false;
+}
+
+bool FlatGraph::isAncestor(Index sourceIdx, Index targetIdx) const
+{
+    if (sourceIdx == targetIdx) return true;
+    if (m_topologicallySorted && sourceIdx > targetIdx) return false;
+
+    std::call_once(m_reachabilityOnce, [this]() { buildReachability(); });
+    if (m_ancestors != nullptr)
+    {
+        return m_ancestors->getBit(targetIdx, sourceIdx);
+    }
+    return searchAncestor(sourceIdx, targetIdx);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "types.h"
+#include "utils/bit_array_2d.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Graph;
+
+/**
+ * Read-only snapshot of a graph in compressed sparse row form
+ *
+ * Nodes and tensors are assigned dense indices, nodes by topological order, and all the adjacency lists are contiguous
+ * index arrays, so queries don't chase pointers or hash shared pointers.
+ * Node adjacency (producers / consumers) includes data and control edges, like Graph::isAncestor.
+ *
+ * The snapshot is owned by the graph (Graph::getFlatGraph), built on first use and dropped on any topology change.
+ * It is intended for passes that don't modify the graph, or that query it many times between edits.
+ * All the queries are thread safe.
+ */
+class FlatGraph
+{
+public:
+    using Index                        = uint32_t;
+    static constexpr Index INVALID_IDX = std::numeric_limits<Index>::max();
+
+    class IndexRange
+    {
+    public:
+        IndexRange(const Index* begin, const Index* end) : m_begin(begin), m_end(end) {}
+        const Index* begin() const { return m_begin; }
+        const Index* end() const { return m_end; }
+        unsigned     size() const { return m_end - m_begin; }
+        bool         empty() const { return m_begin == m_end; }
+        Index        operator[](unsigned i) const { return m_begin[i]; }
+
+    private:
+        const Index* m_begin;
+        const Index* m_end;
+    };
+
+    explicit FlatGraph(const Graph& graph);
+
+    unsigned numNodes() const { return m_nodes.size(); }
+    unsigned numTensors() const { return m_tensors.size(); }
+
+    // Nodes are topologically sorted, unless the graph has a cycle
+    bool isTopologicallySorted() const { return m_topologicallySorted; }
+
+    const NodePtr&   node(Index nodeIdx) const { return m_nodes[nodeIdx]; }
+    const TensorPtr& tensor(Index tensorIdx) const { return m_tensors[tensorIdx]; }
+
+    // INVALID_IDX if not part of the graph
+    Index nodeIndex(const NodePtr& node) const;
+    Index tensorIndex(const TensorPtr& tensor) const;
+
+    IndexRange dataInputs(Index nodeIdx) const;  // tensor indices
+    IndexRange controlInputs(Index nodeIdx) const;
+    IndexRange dataOutputs(Index nodeIdx) const;
+    IndexRange controlOutputs(Index nodeIdx) const;
+
+    Index      tensorProducer(Index tensorIdx) const { return m_tensorProducer[tensorIdx]; }
+    IndexRange tensorConsumers(Index tensorIdx) const;  // node indices, by order of topological index
+
+    IndexRange producers(Index nodeIdx) const;  // unique node indices
+    IndexRange consumers(Index nodeIdx) const;
+
+    // Ancestor bitsets are built on first use for graphs up to GCFG_FLAT_GRAPH_REACHABILITY_MAX_NODES nodes, larger
+    // graphs are searched on demand. A node is its own ancestor, as in Graph::isAncestor.
+    bool isAncestor(Index sourceIdx, Index targetIdx) const;
+
+private:
+    // Per node offsets into the node's tensor array: [data inputs, control inputs, data outputs, control outputs]
+    enum NodeTensorSection
+    {
+        DATA_INPUTS,
+        CONTROL_INPUTS,
+        DATA_OUTPUTS,
+        CONTROL_OUTPUTS,
+        NUM_SECTIONS
+    };
+
+    IndexRange nodeTensors(Index nodeIdx, NodeTensorSection section) const;
+    Index      addTensor(const TensorPtr& tensor);
+    void       buildReachability() const;
+    bool       searchAncestor(Index sourceIdx, Index targetIdx) const;
+
+    NodeVector                          m_nodes;
+    TensorVector                        m_tensors;
+    std::unordered_map<uint64_t, Index> m_nodeIndexById;
+    std::unordered_map<uint64_t, Index> m_tensorIndexById;
+    bool                                m_topologicallySorted = true;
+
+    std::vector<Index> m_nodeTensorOffsets;  // NUM_SECTIONS per node, plus a terminating offset
+    std::vector<Index> m_nodeTensors;
+    std::vector<Index> m_tensorProducer;
+    std::vector<Index> m_tensorConsumerOffsets;
+    std::vector<Index> m_tensorConsumers;
+    std::vector<Index> m_producerOffsets;
+    std::vector<Index> m_producers;
+    std::vector<Index> m_consumerOffsets;
+    std::vector<Index> m_consumers;
+
+    mutable std::once_flag              m_reachabilityOnce;
+    mutable std::unique_ptr<BitArray2D> m_ancestors;  // row per node, bit per ancestor
+};
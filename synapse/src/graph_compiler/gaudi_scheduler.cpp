@@ -7,6 +7,7 @@
 #include "strided_insert_node.h"
 #include "handle_memory_reuse.h"
 #include "gaudi_max_path_scheduler.h"
+#include "memory_aware_scheduler.h"
 #include "types.h"
 #include <stack>
 #include "brain_conf.h"
@@ -461,7 +462,14 @@ NodeList GaudiScheduler::scheduleNodes()
     {
         GaudiMaxPathScheduler::ConnectivityFunc getBlocking = [&](const NodePtr& n) { return getBlockingNodes(n); };
         GaudiMaxPathScheduler::ConnectivityFunc getBlocked  = [&](const NodePtr& n) { return getBlockedNodes(n); };
-        schedule = GaudiMaxPathScheduler(m_graph, getBlocking, getBlocked).scheduleNodes();
+        if (GCFG_ENABLE_MEMORY_AWARE_SCHEDULE.value())
+        {
+            schedule = MemoryAwareScheduler(m_graph, getBlocking, getBlocked).scheduleNodes();
+        }
+        else
+        {
+            schedule = GaudiMaxPathScheduler(m_graph, getBlocking, getBlocked).scheduleNodes();
+        }
     }
     else
     {
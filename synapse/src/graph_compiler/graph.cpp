@@ -1,5 +1,6 @@
 #include "graph.h"
 
+#include "flat_graph.h"
 #include "graph_compiler/print_cycles.h"
 #include "habana_pass.h"
 #include "infra/defs.h"
@@ -12,7 +13,11 @@
 #include <lemon/connectivity.h>
 #include <lemon/core.h>
 #include <lemon/list_graph.h>
+
+#include <algorithm>
 #include <limits>
+#include <unordered_map>
+#include <vector>
 
 #define GTOKEN(object)  (object)->m_graphToken->tokens[m_id]
 
@@ -21,10 +26,208 @@ typedef Digraph::NodeMap<NodePtr>   NodeMap;
 // map from (tensor, consumer) to list of arcs
 typedef std::map<std::pair<TensorPtr, Digraph::Node>, Digraph::Arc> ArcMap;
 
-class Graph::Reachability : public lemon::Dfs<Digraph>
+/*
+ * Reachability index maintained under graph edits.
+ *
+ * A topological order of the nodes is kept up to date on every arc insertion (Pearce-Kelly: only the nodes between the
+ * arc endpoints in the current order are visited and relabeled), and isn't affected by arc or node removal.
+ * A node can only reach nodes that come after it in the order, so most negative queries are answered by comparing the
+ * order labels, and the rest by a DFS which doesn't leave the order range between the source and the target.
+ * Query results are cached per (source, target) and stay valid until an edit which may change them - arc insertion for
+ * unreachable pairs, arc or node removal for reachable ones.
+ * While the graph has a cycle there is no order, queries fall back to a plain DFS until a removal breaks the cycle.
+ */
+class Graph::ReachabilityIndex
 {
 public:
-    Reachability(lemon::ListDigraph& g) : lemon::Dfs<Digraph>(g) {}
+    explicit ReachabilityIndex(const Digraph& g) : m_g(g), m_ord(g), m_visitStamp(g, 0) { rebuildOrder(); }
+
+    void onNodeAdded(Digraph::Node node) { m_ord[node] = m_nextOrd++; }
+
+    void onNodeRemoved() { m_removeEpoch++; }
+
+    void onArcRemoved() { m_removeEpoch++; }
+
+    void onArcAdded(Digraph::Node from, Digraph::Node to)
+    {
+        m_insertEpoch++;
+        if (m_orderValid && m_ord[from] >= m_ord[to])
+        {
+            reorder(from, to);
+        }
+    }
+
+    bool isAncestor(Digraph::Node source, Digraph::Node target)
+    {
+        if (!m_orderValid && m_failedRebuildEpoch != m_removeEpoch)
+        {
+            rebuildOrder();
+        }
+        if (m_orderValid && m_ord[source] > m_ord[target]) return false;
+
+        const uint64_t key     = (uint64_t(Digraph::id(source)) << 32) | uint32_t(Digraph::id(target));
+        auto           cacheIt = m_cache.find(key);
+        if (cacheIt != m_cache.end() &&
+            cacheIt->second.epoch == (cacheIt->second.reachable ? m_removeEpoch : m_insertEpoch))
+        {
+            return cacheIt->second.reachable;
+        }
+
+        const bool reachable = search(source, target);
+        if (m_cache.size() >= MAX_CACHED_QUERIES)
+        {
+            m_cache.clear();
+        }
+        m_cache[key] = {reachable, reachable ? m_removeEpoch : m_insertEpoch};
+        return reachable;
+    }
+
+private:
+    static constexpr size_t MAX_CACHED_QUERIES = 1 << 20;
+
+    struct CachedQuery
+    {
+        bool     reachable;
+        uint64_t epoch;  // remove epoch for reachable pairs, insert epoch for unreachable ones
+    };
+
+    void rebuildOrder()
+    {
+        Digraph::NodeMap<int> order(m_g);
+        m_orderValid = lemon::checkedTopologicalSort(m_g, order);
+        if (!m_orderValid)
+        {
+            m_failedRebuildEpoch = m_removeEpoch;
+            return;
+        }
+        m_nextOrd = 0;
+        for (Digraph::NodeIt n(m_g); n != lemon::INVALID; ++n)
+        {
+            m_ord[n] = order[n];
+            m_nextOrd++;
+        }
+    }
+
+    void newVisit()
+    {
+        if (++m_currentStamp == 0)
+        {
+            for (Digraph::NodeIt n(m_g); n != lemon::INVALID; ++n)
+            {
+                m_visitStamp[n] = 0;
+            }
+            m_currentStamp = 1;
+        }
+    }
+
+    bool visit(Digraph::Node node)
+    {
+        if (m_visitStamp[node] == m_currentStamp) return false;
+        m_visitStamp[node] = m_currentStamp;
+        return true;
+    }
+
+    // New arc from -> to, with 'to' preceding 'from' in the current order
+    void reorder(Digraph::Node from, Digraph::Node to)
+    {
+        const uint64_t lowerBound = m_ord[to];
+        const uint64_t upperBound = m_ord[from];
+
+        // Nodes reachable from 'to' which don't come after 'from'
+        std::vector<Digraph::Node> forward;
+        newVisit();
+        m_stack = {to};
+        visit(to);
+        while (!m_stack.empty())
+        {
+            Digraph::Node node = m_stack.back();
+            m_stack.pop_back();
+            forward.push_back(node);
+            for (Digraph::OutArcIt arc(m_g, node); arc != lemon::INVALID; ++arc)
+            {
+                Digraph::Node next = m_g.target(arc);
+                if (next == from)
+                {
+                    m_orderValid         = false;  // the new arc closed a cycle
+                    m_failedRebuildEpoch = m_removeEpoch;
+                    return;
+                }
+                if (m_ord[next] < upperBound && visit(next)) m_stack.push_back(next);
+            }
+        }
+
+        // Nodes reaching 'from' which don't come before 'to'
+        std::vector<Digraph::Node> backward;
+        m_stack = {from};
+        visit(from);
+        while (!m_stack.empty())
+        {
+            Digraph::Node node = m_stack.back();
+            m_stack.pop_back();
+            backward.push_back(node);
+            for (Digraph::InArcIt arc(m_g, node); arc != lemon::INVALID; ++arc)
+            {
+                Digraph::Node prev = m_g.source(arc);
+                if (m_ord[prev] > lowerBound && visit(prev)) m_stack.push_back(prev);
+            }
+        }
+
+        // Reuse the labels of both sets, 'from' and its ancestors first, keeping the relative order inside each set
+        auto byOrd = [this](Digraph::Node a, Digraph::Node b) { return m_ord[a] < m_ord[b]; };
+        std::sort(forward.begin(), forward.end(), byOrd);
+        std::sort(backward.begin(), backward.end(), byOrd);
+        std::vector<uint64_t> labels;
+        labels.reserve(forward.size() + backward.size());
+        for (const auto* nodes : {&backward, &forward})
+        {
+            for (Digraph::Node node : *nodes)
+            {
+                labels.push_back(m_ord[node]);
+            }
+        }
+        std::sort(labels.begin(), labels.end());
+        auto labelIt = labels.begin();
+        for (const auto* nodes : {&backward, &forward})
+        {
+            for (Digraph::Node node : *nodes)
+            {
+                m_ord[node] = *labelIt++;
+            }
+        }
+    }
+
+    bool search(Digraph::Node source, Digraph::Node target)
+    {
+        const uint64_t targetOrd = m_ord[target];
+        newVisit();
+        m_stack = {source};
+        visit(source);
+        while (!m_stack.empty())
+        {
+            Digraph::Node node = m_stack.back();
+            m_stack.pop_back();
+            for (Digraph::OutArcIt arc(m_g, node); arc != lemon::INVALID; ++arc)
+            {
+                Digraph::Node next = m_g.target(arc);
+                if (next == target) return true;
+                if (m_orderValid && m_ord[next] >= targetOrd) continue;
+                if (visit(next)) m_stack.push_back(next);
+            }
+        }
+        return false;
+    }
+
+    const Digraph&                            m_g;
+    Digraph::NodeMap<uint64_t>                m_ord;
+    Digraph::NodeMap<uint32_t>                m_visitStamp;
+    uint32_t                                  m_currentStamp       = 0;
+    uint64_t                                  m_nextOrd            = 0;
+    bool                                      m_orderValid         = false;
+    uint64_t                                  m_insertEpoch        = 0;
+    uint64_t                                  m_removeEpoch        = 0;
+    uint64_t                                  m_failedRebuildEpoch = 0;
+    std::vector<Digraph::Node>                m_stack;
+    std::unordered_map<uint64_t, CachedQuery> m_cache;
 };
 
 // The declaration of GraphContainer should remain in graph.cpp
@@ -121,6 +324,7 @@ Graph::Graph(const Graph& other)
 
 Graph::~Graph()
 {
+    m_reachabilityIndex.reset();  // holds maps of the lemon graph
     delete m_graph;
 }
 
@@ -172,6 +376,8 @@ void Graph::clear()
     m_graph->g().clear();
     m_cacheAllNodes.clear();
     m_cacheAllTensors.clear();
+    m_flatGraph.reset();
+    m_reachabilityIndex.reset();
 }
 
 template <typename CacheT, typename ObjT>
@@ -428,6 +634,10 @@ bool Graph::addNode(NodePtr node)
         node->m_graphToken = std::shared_ptr<NodeGraphToken>(new NodeGraphToken);
     }
     GTOKEN(node).lmNode = lmNode;
+    if (m_reachabilityIndex != nullptr)
+    {
+        m_reachabilityIndex->onNodeAdded(lmNode);
+    }
 
     runOnTensorsForType<Node::USAGE_INPUT>(node, Node::TENSOR_TYPE_ALL, [&](const TensorPtr& t) {
         if (t != nullptr)
@@ -444,6 +654,7 @@ bool Graph::addNode(NodePtr node)
 
     updateCache(m_cacheAllNodes, node, true);
     m_nodesByID[node->getId()] = node;
+    m_flatGraph.reset();
     LOG_TRACE(GC,
               "{}: Node {} with guid {} and ID {} was added to the graph",
               HLLOG_FUNC,
@@ -507,9 +718,13 @@ void Graph::removeNode(NodePtr node, NodePtr newProducer /*=nullptr*/)
         }
     }
 
-    m_nodeReachability.erase(node->getId());
+    m_flatGraph.reset();
     // Remove node from graph
     m_graph->g().erase(GTOKEN(node).lmNode);
+    if (m_reachabilityIndex != nullptr)
+    {
+        m_reachabilityIndex->onNodeRemoved();
+    }
     GTOKEN(node).lmNode = lemon::INVALID;
     node->m_graphToken  = nullptr;
 
@@ -606,6 +821,10 @@ void Graph::addRelationship(const TensorPtr& t, const NodePtr& n, Node::eParamUs
             {
                 Digraph::Arc a          = g.addArc(GTOKEN(n).lmNode, lmConsumer);
                 arcMap[{t, lmConsumer}] = a;
+                if (m_reachabilityIndex != nullptr)
+                {
+                    m_reachabilityIndex->onArcAdded(GTOKEN(n).lmNode, lmConsumer);
+                }
             }
         }
     }
@@ -625,6 +844,10 @@ void Graph::addRelationship(const TensorPtr& t, const NodePtr& n, Node::eParamUs
         {
             Digraph::Arc a = g.addArc(lmProducer, lmConsumer);
             arcMap[{t, lmConsumer}] = a;
+            if (m_reachabilityIndex != nullptr)
+            {
+                m_reachabilityIndex->onArcAdded(lmProducer, lmConsumer);
+            }
         }
     }
     else
@@ -663,6 +886,10 @@ void Graph::removeRelationship(const TensorPtr& t, const NodePtr& n, Node::ePara
             {
                 g.erase(arcIt->second);
                 arcMap.erase(arcIt);
+                if (m_reachabilityIndex != nullptr)
+                {
+                    m_reachabilityIndex->onArcRemoved();
+                }
             }
         }
     }
@@ -678,6 +905,10 @@ void Graph::removeRelationship(const TensorPtr& t, const NodePtr& n, Node::ePara
             {
                 g.erase(arcIt->second);
                 arcMap.erase(arcIt);
+                if (m_reachabilityIndex != nullptr)
+                {
+                    m_reachabilityIndex->onArcRemoved();
+                }
             }
         }
     }
@@ -741,65 +972,56 @@ NodeSet Graph::getIntersectingNodes(const NodeVector& nodes) const
 {
     NodeSet ret;
 
-    // container dedicated to hold potential intersection nodes.
-    // if a node exists in the container - there is a path from one of the input nodes to it.
-    // if the value is "true" - there is also a path from that node to one of the input nodes.
-    std::unordered_map<NodePtr, bool> intersectingNodes;
+    const FlatGraph& flatGraph = getFlatGraph();
+    HB_ASSERT(flatGraph.isTopologicallySorted(), "found cycle in graph!");
+
+    // per node state: reached from one of the input nodes, and also reaching one of the input nodes.
+    enum : uint8_t
+    {
+        NOT_REACHED     = 0,
+        REACHED_FROM    = 1,
+        REACHED_FROM_TO = 3
+    };
+    std::vector<uint8_t> state(flatGraph.numNodes(), NOT_REACHED);
 
     // mark all inputs nodes as having a path from input nodes and having a path to input nodes.
+    // find the smallest section in topological order containing all input nodes (for performance optimization)
+    // nodes that are out of this range cannot be intersecting the input nodes.
+    FlatGraph::Index startIdx = FlatGraph::INVALID_IDX;
+    FlatGraph::Index endIdx   = 0;
     for (const NodePtr& n : nodes)
     {
-        intersectingNodes[n] = true;
+        const FlatGraph::Index idx = flatGraph.nodeIndex(n);
+        HB_ASSERT(idx != FlatGraph::INVALID_IDX, "intersection nodes not found!");
+        state[idx] = REACHED_FROM_TO;
+        startIdx   = std::min(startIdx, idx);
+        endIdx     = std::max(endIdx, idx);
     }
-
-    // find the smallest section in topological sort containing all input nodes (for performance optimization)
-    // nodes that are out of this range cannot be intersecting the input nodes.
-    const NodeVector& topoSort = getTopoSortedNodes();
-    auto              startIt  = std::find_if(topoSort.begin(), topoSort.end(), [&](const NodePtr& n) {
-        return intersectingNodes.find(n) != intersectingNodes.end();
-    });
-    auto              endIt    = std::find_if(topoSort.rbegin(), topoSort.rend(), [&](const NodePtr& n) {
-        return intersectingNodes.find(n) != intersectingNodes.end();
-    });
-
-    int startIdx = startIt - topoSort.begin();
-    int endIdx   = topoSort.size() - (endIt - topoSort.rbegin()) - 1;
-    HB_ASSERT((startIdx >= 0) && (endIdx < topoSort.size()) && (startIdx <= endIdx), "intersection nodes not found!");
+    HB_ASSERT(startIdx <= endIdx, "intersection nodes not found!");
 
     // find all nodes that have a path -from- one of the input nodes
-    for (int i = startIdx; i <= endIdx; i++)
+    for (FlatGraph::Index i = startIdx; i <= endIdx; i++)
     {
-        const NodePtr& node = topoSort[i];
-        auto           it   = intersectingNodes.find(node);
-        if (it != intersectingNodes.end())  // means there is a path from one of the input nodes to "node"
+        if (state[i] == NOT_REACHED) continue;
+        // all its consumers also have a path to them.
+        for (FlatGraph::Index consumer : flatGraph.consumers(i))
         {
-            // all its consumers also have a path to them.
-            for (const NodePtr& consumer : getNodeConsumers(node, Node::eTensorType::TENSOR_TYPE_ALL))
-            {
-                // if the consumer does exist in map it will keep it's original value. otherwise, it will be inserted.
-                intersectingNodes.emplace(consumer, false);
-            }
+            state[consumer] |= REACHED_FROM;
         }
     }
 
     // find all nodes that also have path -to- them from one of the input nodes
-    for (int i = endIdx; i >= startIdx; i--)
+    for (FlatGraph::Index i = endIdx + 1; i-- > startIdx;)
     {
-        const NodePtr& node = topoSort[i];
-        auto           it   = intersectingNodes.find(node);
-        if ((it != intersectingNodes.end()) &&
-            it->second)  // means there is a path from and to one of the input nodes from "node"
+        if (state[i] != REACHED_FROM_TO) continue;
+        ret.insert(flatGraph.node(i));  // node is intersecting
+        for (FlatGraph::Index producer : flatGraph.producers(i))
         {
-            ret.insert(node);  // node is intersecting
-            for (const NodePtr& producer : getNodeProducers(node, Node::eTensorType::TENSOR_TYPE_ALL))
+            // its producers also have a path to one of the input nodes.
+            // mark them only if they have a path -to- them as well
+            if (state[producer] != NOT_REACHED)
             {
-                // its producers also have a path to one of the input nodes.
-                // mark them only if they exist in container (have a path -to- them as well)
-                auto producerIt = intersectingNodes.find(producer);
-                if (producerIt != intersectingNodes.end())
-                {
-                    producerIt->second = true;
-                }
+                state[producer] = REACHED_FROM_TO;
             }
         }
     }
@@ -827,29 +1049,15 @@ bool Graph::isAncestor(const NodePtr& source, const NodePtr& target) const
         return false; // Not a graph node(s)
     }
 
-    /*
-     * From lemon docs:
-     * "Warning:
-     *     The source nodes are inditated as unreachable." [sic]
-     * So adding the edge case below.
-     */
     if (source == target) return true;
 
-    auto nodeReachabilityIter = m_nodeReachability.find(source->getId());
-    //Find dfs search algorithm for source node in cache
-    if (nodeReachabilityIter == m_nodeReachability.end())
+    // The index is built on first query and then follows the graph edits, it isn't dropped by invalidateCachedData
+    std::lock_guard<std::mutex> lock(m_queryCachesMutex);
+    if (m_reachabilityIndex == nullptr)
     {
-        nodeReachabilityIter =
-            m_nodeReachability.emplace(source->getId(), std::make_shared<Reachability>(m_graph->g())).first;
-        nodeReachabilityIter->second->init();
-        nodeReachabilityIter->second->addSource(GTOKEN(source).lmNode);
+        m_reachabilityIndex = std::make_unique<ReachabilityIndex>(m_graph->g());
     }
-
-    //If target node not found in dfs yet, continue search until it's done or the node is found
-    Reachability& reachability = *nodeReachabilityIter->second;
-    reachability.start(GTOKEN(target).lmNode);
-
-    return reachability.reached(GTOKEN(target).lmNode);
+    return m_reachabilityIndex->isAncestor(GTOKEN(source).lmNode, GTOKEN(target).lmNode);
 }
 
 NodeList Graph::getRootNodes() const
@@ -1085,6 +1293,15 @@ void Graph::generateTopoSortedNodes() const
     }
 }
 
+const FlatGraph& Graph::getFlatGraph() const
+{
+    if (m_flatGraph == nullptr)
+    {
+        m_flatGraph = std::make_unique<FlatGraph>(*this);
+    }
+    return *m_flatGraph;
+}
+
 const NodeSet& Graph::getNodes() const
 {
     if (m_cacheAllNodes.empty())
@@ -1285,10 +1502,10 @@ bool Graph::isDebugMode() const
 
 void Graph::invalidateCachedData()
 {
-    m_nodeReachability.clear();
     m_numOfGraphPaths.clear();
     m_cacheTopoSortedNodes.clear();
     m_connectivityMap.reset();
+    m_flatGraph.reset();
     setGraphChangedInLastPass();
 }
 
@@ -1341,7 +1558,8 @@ uint64_t Graph::getNumberOfPaths(const NodePtr& source, const NodePtr& target, N
 {
     HB_ASSERT(containsNode(source), "source node {} doesn't exist in graph!", source->getNodeName());
     HB_ASSERT(containsNode(target), "target node {} doesn't exist in graph!", target->getNodeName());
-    auto key = GraphPathsKey(source->getId(), target->getId(), tensorType);
+    auto                        key = GraphPathsKey(source->getId(), target->getId(), tensorType);
+    std::lock_guard<std::mutex> lock(m_queryCachesMutex);
     if(m_numOfGraphPaths.find(key) == m_numOfGraphPaths.end())
     {
         countAndCache(source, target, tensorType);
@@ -1353,21 +1571,22 @@ bool Graph::areConnected(const NodePtr& source, const NodePtr& target, Node::eTe
 {
     HB_ASSERT(containsNode(source), "source node {} doesn't exist in graph!", source->getNodeName());
     HB_ASSERT(containsNode(target), "target node {} doesn't exist in graph!", target->getNodeName());
-    if (m_connectivityMap && m_connectivityMap->tensorType == tensorType)
     {
-        unsigned sourceIdx = m_connectivityMap->sortedIndices[GTOKEN(source).lmNode];
-        unsigned targetIdx = m_connectivityMap->sortedIndices[GTOKEN(target).lmNode];
-        return m_connectivityMap->bitArray.getBit(targetIdx, sourceIdx);
-    }
-    else
-    {
-        return getNumberOfPaths(source, target, tensorType) > 0;
+        std::lock_guard<std::mutex> lock(m_queryCachesMutex);
+        if (m_connectivityMap && m_connectivityMap->tensorType == tensorType)
+        {
+            unsigned sourceIdx = m_connectivityMap->sortedIndices[GTOKEN(source).lmNode];
+            unsigned targetIdx = m_connectivityMap->sortedIndices[GTOKEN(target).lmNode];
+            return m_connectivityMap->bitArray.getBit(targetIdx, sourceIdx);
+        }
     }
+    return getNumberOfPaths(source, target, tensorType) > 0;
 }
 
 void Graph::buildConnectivityMap(Node::eTensorType tensorType) const
 {
     // already built
+    std::lock_guard<std::mutex> lock(m_queryCachesMutex);
     if (m_connectivityMap && m_connectivityMap->tensorType == tensorType) return;
 
     const Digraph& g        = m_graph->g();
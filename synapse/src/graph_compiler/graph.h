@@ -11,10 +11,12 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
+class FlatGraph;
 struct recipe_t;
 struct shape_plane_graph_t;
 class RecipeAllocator;
@@ -119,6 +121,8 @@ public:
     void                         printTensorProducerConsumers(const pTensor& t) const;
     virtual NodePtr              getNodeByID(synNodeId nodeID) const;
     const NodeVector&            getTopoSortedNodes() const;
+    // Contiguous snapshot of the graph for read-heavy queries, dropped on any topology change
+    const FlatGraph&             getFlatGraph() const;
 
     template<typename Predicate>
     const NodeVector getTopoSortedNodesCond(Predicate predicate) const;
@@ -230,12 +234,15 @@ private:
     NodeVector           m_storedTopoSortedNodes;
     const uint64_t       m_id;
 
-    // Fwd declaration of class to hold whether there is a path to any node from a specific node (root).
-    class Reachability;
+    // Fwd declaration of the index answering whether there is a path between two nodes, updated on graph edits
+    class ReachabilityIndex;
     struct ConnectivityMap;
-    mutable std::unordered_map<unsigned, std::shared_ptr<Reachability>> m_nodeReachability;
+    mutable std::unique_ptr<ReachabilityIndex>                          m_reachabilityIndex;
     mutable std::map<GraphPathsKey, uint64_t>                           m_numOfGraphPaths;
     mutable std::unique_ptr<ConnectivityMap>                            m_connectivityMap;
+    mutable std::unique_ptr<FlatGraph>                                  m_flatGraph;
+    // Guards the caches above which are filled per query, since read-only passes may query the graph concurrently
+    mutable std::mutex                                                  m_queryCachesMutex;
     bool                                                                m_graphChangedInLastPass;
     bool                                                                m_scheduleFlashAttention = false;
 
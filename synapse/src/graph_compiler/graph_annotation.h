@@ -14,6 +14,7 @@ using TensorAndData    = std::pair<TensorPtr, std::shared_ptr<char>>;
 using AuxiliaryTensors = std::map<AuxiliaryTensorsKey, TensorAndData>;
 
 struct SyncOrMonitor;
+class WorkspacePlanner;
 
 struct ErrorStatus
 {
@@ -155,4 +156,7 @@ struct GraphAnnotation
     FlashAttentionDb flashAttentionDb;
 
     bool                 partialGraph = false;
+
+    // The plan the workspace tensors were allocated by, when the workspace planner was chosen (see allocateTensors)
+    std::shared_ptr<WorkspacePlanner> workspacePlan;
 };
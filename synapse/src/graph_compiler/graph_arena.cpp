@@ -0,0 +1,51 @@
+#include "graph_arena.h"
+
+#include "habana_global_conf.h"
+#include "log_manager.h"
+
+static thread_local GraphArena* s_currentArena = nullptr;
+
+// Large enough for the biggest node classes and their control block, bigger requests go to the upstream resource
+static constexpr size_t MAX_POOLED_BLOCK_SIZE = 16 * 1024;
+
+GraphArena::GraphArena() : m_pool(std::pmr::pool_options {0 /*default*/, MAX_POOLED_BLOCK_SIZE}) {}
+
+GraphArena::~GraphArena()
+{
+    LOG_DEBUG(GC, "Releasing graph arena, {} allocations were made from it", getNumAllocations());
+}
+
+std::shared_ptr<GraphArena> GraphArena::create()
+{
+    if (!GCFG_ENABLE_GRAPH_ARENA.value()) return nullptr;
+    // The constructor is private, so make_shared can't be used
+    return std::shared_ptr<GraphArena>(new GraphArena());
+}
+
+GraphArena* GraphArena::current()
+{
+    return s_currentArena;
+}
+
+void* GraphArena::allocate(size_t bytes, size_t alignment)
+{
+    m_numAllocations.fetch_add(1, std::memory_order_relaxed);
+    m_bytesInUse.fetch_add(bytes, std::memory_order_relaxed);
+    return m_pool.allocate(bytes, alignment);
+}
+
+void GraphArena::deallocate(void* p, size_t bytes, size_t alignment)
+{
+    m_bytesInUse.fetch_sub(bytes, std::memory_order_relaxed);
+    m_pool.deallocate(p, bytes, alignment);
+}
+
+ScopedGraphArena::ScopedGraphArena(GraphArena* arena) : m_prevArena(s_currentArena)
+{
+    s_currentArena = arena;
+}
+
+ScopedGraphArena::~ScopedGraphArena()
+{
+    s_currentArena = m_prevArena;
+}
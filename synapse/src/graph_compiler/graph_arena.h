@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+/**
+ * Pooled memory backing the nodes and tensors created while a graph is compiled
+ *
+ * Slicing and fusion create and drop huge numbers of short lived nodes and tensors, each a separate heap allocation
+ * of the object and its shared_ptr control block. Objects created by makeGraphObject while a graph arena is active on
+ * the thread (ScopedGraphArena) are allocated, together with their control block, from the graph's pool, so the churn
+ * recycles pool blocks instead of going to malloc, and concurrently compiled graphs don't contend on the same heap.
+ * The node and tensor annotations are members of their objects, so they come from the pool as well.
+ *
+ * Every object holds a reference on its arena, so objects which outlive the graph (e.g. tensors kept by the recipe) stay
+ * valid, and the pool memory is released once the graph and all the objects allocated from it are gone.
+ */
+class GraphArena : public std::enable_shared_from_this<GraphArena>
+{
+public:
+    template<class T>
+    class Allocator
+    {
+    public:
+        using value_type = T;
+
+        explicit Allocator(std::shared_ptr<GraphArena> arena) : m_arena(std::move(arena)) {}
+        template<class U>
+        Allocator(const Allocator<U>& other) : m_arena(other.m_arena)
+        {
+        }
+
+        T* allocate(size_t n) { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T* p, size_t n) { m_arena->deallocate(p, n * sizeof(T), alignof(T)); }
+
+        template<class U>
+        bool operator==(const Allocator<U>& other) const
+        {
+            return m_arena == other.m_arena;
+        }
+        template<class U>
+        bool operator!=(const Allocator<U>& other) const
+        {
+            return m_arena != other.m_arena;
+        }
+
+    private:
+        template<class U>
+        friend class Allocator;
+
+        std::shared_ptr<GraphArena> m_arena;
+    };
+
+    // nullptr unless GCFG_ENABLE_GRAPH_ARENA is set
+    static std::shared_ptr<GraphArena> create();
+
+    // The arena of the graph compiled by the calling thread, if any
+    static GraphArena* current();
+
+    ~GraphArena();
+
+    uint64_t getNumAllocations() const { return m_numAllocations.load(std::memory_order_relaxed); }
+    int64_t  getBytesInUse() const { return m_bytesInUse.load(std::memory_order_relaxed); }
+
+private:
+    friend class ScopedGraphArena;
+
+    GraphArena();
+
+    void* allocate(size_t bytes, size_t alignment);
+    void  deallocate(void* p, size_t bytes, size_t alignment);
+
+    std::pmr::synchronized_pool_resource m_pool;
+    std::atomic<uint64_t>                m_numAllocations {0};
+    std::atomic<int64_t>                 m_bytesInUse {0};
+};
+
+// Makes 'arena' the current arena of the calling thread for the scope lifetime. Scopes may be nested.
+class ScopedGraphArena
+{
+public:
+    explicit ScopedGraphArena(GraphArena* arena);
+    ~ScopedGraphArena();
+
+    ScopedGraphArena(const ScopedGraphArena&) = delete;
+    ScopedGraphArena& operator=(const ScopedGraphArena&) = delete;
+
+private:
+    GraphArena* m_prevArena;
+};
+
+// std::make_shared, from the current graph arena if there is one
+template<class T, class... Args>
+std::shared_ptr<T> makeGraphObject(Args&&... args)
+{
+    GraphArena* arena = GraphArena::current();
+    if (arena == nullptr)
+    {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+    return std::allocate_shared<T>(GraphArena::Allocator<T>(arena->shared_from_this()), std::forward<Args>(args)...);
+}
@@ -1,5 +1,6 @@
 #include "graph_traits.h"
 
+#include "habana_global_conf.h"
 #include "hal_reader/hal_reader.h"
 #include "infra/defs.h"
 #include "platform/gaudi/graph_compiler/engine_selector.h"
@@ -14,6 +15,8 @@ GraphTraits::GraphTraits(synDeviceType device, CompilationMode mode)
 : m_isTraining(false),
   m_isQuantizationEnabled(false),
   m_backoffFactor(1.0),
+  m_isDataTypeSelectionAllowed(true),
+  m_isTransposeViaGemmAllowed(true),
   m_compilationMode(mode),
   m_deviceId(deviceTypeToDeviceID(device))
 {
@@ -52,4 +55,27 @@ void GraphTraits::setBackoffFactor(double boFactor)
 {
     LOG_TRACE(GC, "Setting GraphTraits backoff factor to {}", boFactor);
     m_backoffFactor = boFactor;
-}
\ No newline at end of file
+}
+
+void GraphTraits::setDataTypeSelectionAllowed(bool allowed)
+{
+    LOG_TRACE(GC, "Setting GraphTraits data type selection allowed to {}", allowed ? "true" : "false");
+    m_isDataTypeSelectionAllowed = allowed;
+}
+
+unsigned GraphTraits::defaultPipelineDepth() const
+{
+    return m_defaultPipelineDepth.value_or(GCFG_DEFAULT_PIPELINE_DEPTH.value());
+}
+
+void GraphTraits::setDefaultPipelineDepth(unsigned depth)
+{
+    LOG_TRACE(GC, "Setting GraphTraits default pipeline depth to {}", depth);
+    m_defaultPipelineDepth = depth;
+}
+
+void GraphTraits::setTransposeViaGemmAllowed(bool allowed)
+{
+    LOG_TRACE(GC, "Setting GraphTraits transpose via gemm allowed to {}", allowed ? "true" : "false");
+    m_isTransposeViaGemmAllowed = allowed;
+}
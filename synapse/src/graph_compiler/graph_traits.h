@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <cstring>
 #include "synapse_common_types.h"
 #include "compiler_types.h"
@@ -25,6 +26,14 @@ public:
 
     double backoffFactor() const { return m_backoffFactor; }
 
+    // Per graph settings, set instead of their process wide knobs as other graphs may be compiled concurrently
+    bool isDataTypeSelectionAllowed() const { return m_isDataTypeSelectionAllowed; }
+
+    // GCFG_DEFAULT_PIPELINE_DEPTH, unless set for this graph by setDefaultPipelineDepth
+    unsigned defaultPipelineDepth() const;
+
+    bool isTransposeViaGemmAllowed() const { return m_isTransposeViaGemmAllowed; }
+
     const std::shared_ptr<HalReader>& getHalReader() const { return m_halReader; }
 
     CompilationMode getCompilationMode() const { return m_compilationMode; }
@@ -37,12 +46,21 @@ public:
 
     void setBackoffFactor(double boFactor);
 
+    void setDataTypeSelectionAllowed(bool allowed);
+
+    void setDefaultPipelineDepth(unsigned depth);
+
+    void setTransposeViaGemmAllowed(bool allowed);
+
 private:
     std::shared_ptr<HalReader> m_halReader;
 
     bool              m_isTraining;
     bool              m_isQuantizationEnabled;
-    double            m_backoffFactor;
+    double                  m_backoffFactor;
+    bool                    m_isDataTypeSelectionAllowed;
+    std::optional<unsigned> m_defaultPipelineDepth;
+    bool                    m_isTransposeViaGemmAllowed;
     CompilationMode   m_compilationMode;
     tpc_lib_api::DeviceId m_deviceId;
 };
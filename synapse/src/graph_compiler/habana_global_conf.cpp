@@ -140,7 +140,28 @@ GlobalConfUint64 GCFG_MAX_NUM_DMA_CHUNKS(
 
 GlobalConfUint64 GCFG_NUM_OF_THREADS_CONF(
     "NUM_OF_THREADS_CONF",
-    "Number of threads to be open when using thread pool. 0/1 to disable",
+    "Number of threads to be open when using thread pool, physical ROIs are split on the shared pool when above 1. "
+    "0/1 to disable",
+    1,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_SHARED_THREAD_POOL_NUM_THREADS(
+    "SHARED_THREAD_POOL_NUM_THREADS",
+    "Number of threads of the process-wide work-stealing thread pool. 0 for the number of cores of the process "
+    "affinity mask",
+    0,
+    MakePrivate);
+
+GlobalConfBool GCFG_THREAD_POOL_PIN_THREADS(
+    "THREAD_POOL_PIN_THREADS",
+    "Pin the thread pool workers to the cores of the process affinity mask (worker i to the i-th allowed core modulo "
+    "their number)",
+    false,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_PARALLEL_PASSES_NUM_THREADS(
+    "PARALLEL_PASSES_NUM_THREADS",
+    "Number of threads used by the pass manager to run adjacent read-only passes concurrently. 0/1 to disable",
     1,
     MakePrivate);
 
@@ -162,6 +183,40 @@ GlobalConfBool GCFG_ENABLE_MAX_PATH_SCHEDULE(
     DfltBool(true),
     MakePrivate);
 
+GlobalConfBool GCFG_ENABLE_MEMORY_AWARE_SCHEDULE(
+    "ENABLE_MEMORY_AWARE_SCHEDULE",
+    "Choose the max-path schedule among candidates trading the critical path for the peak live workspace bytes. "
+    "It replaces the max-path schedule only, so like ENABLE_MAX_PATH_SCHEDULE it applies to TPC-only graphs: graphs "
+    "with MME nodes, bundled nodes or multibuffered tensors keep the default schedule",
+    DfltBool(false),
+    MakePrivate);
+
+GlobalConfSize GCFG_MEMORY_AWARE_SCHEDULE_BUDGET(
+    "MEMORY_AWARE_SCHEDULE_BUDGET",
+    "Peak live workspace bytes budget of the memory-aware schedule, the fastest candidate within it is chosen (0 - no "
+    "budget)",
+    hl_gcfg::SizeParam("0"),
+    MakePrivate);
+
+GlobalConfFloat GCFG_MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT(
+    "MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT",
+    "Weight of the peak live workspace bytes vs. the critical path when choosing the memory-aware schedule without a "
+    "budget (0 - critical path only, 1 - memory only)",
+    0.5f,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_MEMORY_AWARE_SCHEDULE_CANDIDATES(
+    "MEMORY_AWARE_SCHEDULE_CANDIDATES",
+    "Number of memory-aware schedule candidates, with memory weights spread evenly from 0 (max-path) to 1",
+    5,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_MEMORY_AWARE_SCHEDULE_MAX_SCANNED_NODES(
+    "MEMORY_AWARE_SCHEDULE_MAX_SCANNED_NODES",
+    "Max number of free nodes, in max-path order, the memory-aware schedule scores to pick the next node",
+    256,
+    MakePrivate);
+
 GlobalConfBool GCFG_ENABLE_PARENT_ID_SCHEDULE(
     "ENABLE_PARENT_ID_SCHEDULE",
     "use parent-id as the tie-breaker when scheduling graphs",
@@ -1722,6 +1777,49 @@ GlobalConfUint64 GCFG_SCAL_RECIPE_LAUNCHER_DEBUG_MODE(
     0,      // Bitwise value
     MakePrivate);
 
+GlobalConfBool GCFG_ENABLE_DELTA_PATCHING(
+    "ENABLE_DELTA_PATCHING",
+    "When the recipe's patchable data-chunks are reused, patch only the sections whose address had changed",
+    true,
+    MakePrivate);
+
+GlobalConfBool GCFG_ENABLE_SIMD_PATCHING(
+    "ENABLE_SIMD_PATCHING",
+    "Use the vectorized (AVX2) patch-points loops when the host supports them",
+    true,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_DSD_SIF_CACHE_SIZE(
+    "DSD_SIF_CACHE_SIZE",
+    "Max number of launch-shapes sets per dynamic recipe and stream, whose SIF and SMF results are cached (0 disables)",
+    8,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS(
+    "PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS",
+    "Recipes with at least this number of patch-points (or SMF patch-points) are patched by a few threads of the "
+    "shared thread pool. 0 disables",
+    0,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_PARALLEL_LAUNCH_PREP_NUM_THREADS(
+    "PARALLEL_LAUNCH_PREP_NUM_THREADS",
+    "Max number of threads (including the launching thread) patching a recipe, see PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS",
+    4,
+    MakePrivate);
+
+GlobalConfBool GCFG_ENABLE_LAUNCH_LATENCY_STATS(
+    "ENABLE_LAUNCH_LATENCY_STATS",
+    "Collect per stream latency histograms of the host launch stages",
+    false,
+    MakePrivate);
+
+GlobalConfString GCFG_LAUNCH_LATENCY_STATS_FILE(
+    "LAUNCH_LATENCY_STATS_FILE",
+    "File the launch latency histograms are written to (as JSON) on synDestroy, see ENABLE_LAUNCH_LATENCY_STATS",
+    std::string(),
+    MakePrivate);
+
 GlobalConfBool GCFG_PRESERVE_TESTS_RECIPE(
     "PRESERVE_TESTS_RECIPE",
     "Preserves the test's recipe file in a file with a similar name",
@@ -2025,6 +2123,12 @@ GlobalConfBool GCFG_ENABLE_PARALLEL_COMPILATION(
         true,
         MakePrivate);
 
+GlobalConfBool GCFG_VERIFY_COMPILATION_CONFIG(
+        "VERIFY_COMPILATION_CONFIG",
+        "Snapshot the global configuration when a graph compilation starts, and report knobs changed before it ended",
+        false,
+        MakePrivate);
+
 GlobalConfBool GCFG_LOG_LAUNCH_INFO_UPON_FAILURE(
         "LOG_LAUNCH_INFO_UPON_FAILURE",
         "Log launch' tensors-info and serialize recipe upon launch-failure",
@@ -2119,6 +2223,21 @@ GlobalConfBool GCFG_EAGER_GENERATE_TEMPLATES(
         true,
         MakePrivate);
 
+GlobalConfUint64 GCFG_EAGER_RECIPE_CACHE_MAX_ENTRIES(
+        "EAGER_RECIPE_CACHE_MAX_ENTRIES",
+        "Maximal number of recipes in the eager recipe cache, which reuses the recipe of a previously compiled graph "
+        "of the same ops, tensors geometry and sections. Least recently used recipes are evicted beyond it. 0 - disabled. "
+        "Only the eager knobs are part of the cache key and the cache is cleared on synConfigurationSet, so other "
+        "configuration changes made while it is enabled (e.g. directly through hl_gcfg) may reuse stale recipes",
+        0,
+        MakePrivate);
+
+GlobalConfUint64 GCFG_EAGER_RECIPE_CACHE_MAX_SIZE(
+        "EAGER_RECIPE_CACHE_MAX_SIZE",
+        "Maximal size in MB of the recipes in the eager recipe cache. Least recently used recipes are evicted beyond it",
+        256,
+        MakePrivate);
+
 GlobalConfInt64 GCFG_ENABLE_COMPLEX_GUID_LIB_IN_EAGER(
         "ENABLE_COMPLEX_GUID_LIB_IN_EAGER",
         "Use complex GUID library to apply node extraction: 0 - Disable, 1 - Enable, 2 - Enable for specific GUIDs only",
@@ -2283,6 +2402,25 @@ GlobalConfSize GCFG_WORKSPACE_MIN_SIZE_LIMIT(
     MakePrivate
 );
 
+GlobalConfBool GCFG_ENABLE_WORKSPACE_PLANNER(
+    "ENABLE_WORKSPACE_PLANNER",
+    "Place the workspace tensors by an offline plan of all their lifetimes when it is smaller than the "
+    "incremental DRAM allocators",
+    DfltBool(false),
+    MakePrivate);
+
+GlobalConfUint64 GCFG_WORKSPACE_PLANNER_ITERATIONS(
+    "WORKSPACE_PLANNER_ITERATIONS",
+    "Number of improvement iterations of the workspace planner after its greedy placement",
+    8,
+    MakePrivate);
+
+GlobalConfUint64 GCFG_WORKSPACE_PLANNER_MAX_CONFLICTS(
+    "WORKSPACE_PLANNER_MAX_CONFLICTS",
+    "The workspace planner is not used for graphs with more pairs of workspace allocations live together",
+    10000000,
+    MakePrivate);
+
 GlobalConfBool GCFG_ENABLE_PERSISTENT_OUTPUT_REUSE(
     "ENABLE_PERSISTENT_OUTPUT_REUSE",
     "Enable persistent output reuse for intermediate tensors",
@@ -2382,6 +2520,12 @@ GlobalConfBool GCFG_DISABLE_SYNAPSE_HUGE_PAGES(
     DfltBool(true),
     MakePrivate);
 
+GlobalConfBool GCFG_ENABLE_NUMA_AWARE_HOST_PLACEMENT(
+    "ENABLE_NUMA_AWARE_HOST_PLACEMENT",
+    "Place the Runtime host buffers (and its completion thread) on the NUMA node of the acquired device",
+    DfltBool(true),
+    MakePrivate);
+
 GlobalConfBool GCFG_ENABLE_LOWER_DEDX(
     "ENABLE_LOWER_DEDX",
     "Enable lower dedx pass - replaces dedx nodes by transpose + transposedDedx",
@@ -2548,4 +2692,17 @@ GlobalConfBool GCFG_ENABLE_DSD_WITH_LB(
      DfltBool(true),
      MakePrivate);
 
+GlobalConfString GCFG_RECIPE_DISK_CACHE_PATH(
+    "RECIPE_DISK_CACHE_PATH",
+    "Folder of the persistent compiled-recipe cache. Graphs are keyed by their pre-compilation content and a cached "
+    "recipe is deserialized instead of compiling the graph. The folder may be shared between processes. Empty - disabled",
+    std::string(),
+    MakePublic);
+
+GlobalConfUint64 GCFG_RECIPE_DISK_CACHE_MAX_SIZE(
+    "RECIPE_DISK_CACHE_MAX_SIZE",
+    "Maximal size in MB of the persistent compiled-recipe cache folder. Least recently used recipes are evicted beyond it",
+    4 * 1024,
+    MakePublic);
+
 // clang-format on
@@ -29,6 +29,17 @@ extern GlobalConfUint64    GCFG_DEFAULT_PIPELINE_DEPTH;
 extern GlobalConfUint64    GCFG_MAX_DYNAMIC_PIPELINE_DEPTH;
 extern GlobalConfUint64    GCFG_MAX_NUM_DMA_CHUNKS;
 extern GlobalConfUint64    GCFG_NUM_OF_THREADS_CONF;
+extern GlobalConfUint64    GCFG_TPC_INSTANTIATION_CACHE_MAX_ENTRIES;
+extern GlobalConfUint64    GCFG_TPC_INSTANTIATION_CACHE_MAX_MEMORY_SIZE;
+extern GlobalConfString    GCFG_TPC_INSTANTIATION_CACHE_PATH;
+extern GlobalConfUint64    GCFG_TPC_INSTANTIATION_CACHE_MAX_SIZE;
+extern GlobalConfUint64    GCFG_FLAT_GRAPH_REACHABILITY_MAX_NODES;
+extern GlobalConfBool      GCFG_ENABLE_COMPILATION_PROFILE;
+extern GlobalConfString    GCFG_COMPILATION_PROFILE_FILE;
+extern GlobalConfBool      GCFG_ENABLE_GRAPH_ARENA;
+extern GlobalConfUint64    GCFG_SHARED_THREAD_POOL_NUM_THREADS;
+extern GlobalConfBool      GCFG_THREAD_POOL_PIN_THREADS;
+extern GlobalConfUint64    GCFG_PARALLEL_PASSES_NUM_THREADS;
 extern GlobalConfBool      GCFG_ENABLE_GVD;
 extern GlobalConfBool      GCFG_ENABLE_PARTIAL_GVD;
 extern GlobalConfInt64     GCFG_VISUALIZATION_MODE;
@@ -120,6 +131,7 @@ extern GlobalConfBool      GCFG_RECOVER_INCOMPATIBLE_DATA_TYPE;
 extern GlobalConfBool      GCFG_FUSE_CAST_TO_MME;
 extern GlobalConfBool      GCFG_FUSE_CONVERT_TO_MME;
 extern GlobalConfBool      GCFG_ENABLE_PARALLEL_COMPILATION;
+extern GlobalConfBool      GCFG_VERIFY_COMPILATION_CONFIG;
 extern GlobalConfBool      GCFG_ALLOW_PERMUTATION_ON_USER_TRANSPOSE;
 extern GlobalConfBool      GCFG_ENABLE_DYNAMIC_SHAPE_IN_HIGH_DIMENSION;
 extern GlobalConfUint64    GCFG_DETERMINISTIC_MODE;
@@ -137,6 +149,9 @@ extern GlobalConfBool      GCFG_ENABLE_STATIC_TRANSPOSE_STRATEGY;
 extern GlobalConfUint64    GCFG_SYNAPSE_MLIR_MODE;
 extern GlobalConfFloat     GCFG_WORKSPACE_EPOCH_SIZE_PERCISION;
 extern GlobalConfSize      GCFG_WORKSPACE_MIN_SIZE_LIMIT;
+extern GlobalConfBool      GCFG_ENABLE_WORKSPACE_PLANNER;
+extern GlobalConfUint64    GCFG_WORKSPACE_PLANNER_ITERATIONS;
+extern GlobalConfUint64    GCFG_WORKSPACE_PLANNER_MAX_CONFLICTS;
 extern GlobalConfBool      GCFG_ENABLE_PERSISTENT_OUTPUT_REUSE;
 extern GlobalConfBool      GCFG_ENABLE_BIG_TENSOR_PP_PRUNE;
 extern GlobalConfUint64    GCFG_MAX_CONST_TENSOR_SIZE_BYTES;
@@ -291,6 +306,11 @@ extern GlobalConfBool      GCFG_CHECK_SECTION_OVERLAP;
 extern GlobalConfUint64    GCFG_ENABLED_COMPRESSION_MODES;
 // TODO[SW-167365]: Remove all Greco specific GCFGs
 extern GlobalConfBool      GCFG_ENABLE_MAX_PATH_SCHEDULE;
+extern GlobalConfBool      GCFG_ENABLE_MEMORY_AWARE_SCHEDULE;
+extern GlobalConfSize      GCFG_MEMORY_AWARE_SCHEDULE_BUDGET;
+extern GlobalConfFloat     GCFG_MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT;
+extern GlobalConfUint64    GCFG_MEMORY_AWARE_SCHEDULE_CANDIDATES;
+extern GlobalConfUint64    GCFG_MEMORY_AWARE_SCHEDULE_MAX_SCANNED_NODES;
 extern GlobalConfBool      GCFG_ENABLE_PARENT_ID_SCHEDULE;
 extern GlobalConfUint64    GCFG_ROTATOR_SYNC_TRACE_EN_MASK;
 extern GlobalConfUint64    GCFG_INT16_LIMITED_BITS;
@@ -346,6 +366,8 @@ extern GlobalConfBool      GCFG_ENABLE_DSD_WITH_LB;
 // Eager - Functional features
 extern GlobalConfInt64     GCFG_FORCE_EAGER;
 extern GlobalConfBool      GCFG_EAGER_GENERATE_TEMPLATES;
+extern GlobalConfUint64    GCFG_EAGER_RECIPE_CACHE_MAX_ENTRIES;
+extern GlobalConfUint64    GCFG_EAGER_RECIPE_CACHE_MAX_SIZE;
 extern GlobalConfInt64     GCFG_MAX_NODES_IN_EAGER_GRAPH;
 extern GlobalConfInt64     GCFG_ENABLE_COMPLEX_GUID_LIB_IN_EAGER;
 // Eager - Runtime and compilation optimizations of arch features
@@ -6,6 +6,7 @@
 #include "graph_compiler/print_cycles.h"
 #include "graph_compiler/tpc_json_serializer.h"
 #include "graph_serializers/serializer.h"
+#include "graph_arena.h"
 #include "graph_traits.h"
 #include "graph_visualization.h"
 #include "habana_global_conf.h"
@@ -446,8 +447,9 @@ void HabanaGraph::invalidateExecutionSchedule() const
 bool HabanaGraph::validateGCOp(const NodePtr& node) const
 {
     if (!GCFG_ENABLE_GC_NODES_VALIDATION_BY_OPS_DB.value()) return true;
-    const auto sts =
-        gc::ops::OpValidator::validateOp(node->getGUID(), nodePtrToOpValidationContext(node), getDeviceType());
+    auto ovc = nodePtrToOpValidationContext(node);
+    ovc.setDataTypeSelectionEnabled(isDataTypeSelectionEnabled());
+    const auto sts = gc::ops::OpValidator::validateOp(node->getGUID(), ovc, getDeviceType());
     switch (sts)
     {
         case gc::ops::ValidationResult::GUID_NOT_FOUND:
@@ -913,6 +915,20 @@ std::unique_ptr<PassManager> HabanaGraph::clonePassManager() const
     return m_passManager->clone();
 }
 
+const CompilationProfiler* HabanaGraph::getCompilationProfile() const
+{
+    return m_passManager != nullptr ? m_passManager->getCompilationProfile() : nullptr;
+}
+
+GraphArena* HabanaGraph::getArena()
+{
+    if (m_arena == nullptr)
+    {
+        m_arena = GraphArena::create();
+    }
+    return m_arena.get();
+}
+
 unsigned HabanaGraph::getNumTpcEng() const
 {
     unsigned maxNumOfTPCs = 8;
@@ -1198,7 +1214,7 @@ const std::shared_ptr<HalReader>& HabanaGraph::getHALReader() const
 
 unsigned HabanaGraph::getDefaultPipelineDepth() const
 {
-    return GCFG_DEFAULT_PIPELINE_DEPTH.value();
+    return m_graphTraits->defaultPipelineDepth();
 }
 
 unsigned HabanaGraph::getPipelineDepth(const pNode& node) const
@@ -1229,7 +1245,7 @@ unsigned HabanaGraph::getPipelineDepth(const Node& node) const
 
 void HabanaGraph::setDefaultPipelineDepth(unsigned depth)
 {
-    GCFG_DEFAULT_PIPELINE_DEPTH.setValue(depth);
+    m_graphTraits->setDefaultPipelineDepth(depth);
 }
 
 bool HabanaGraph::rerunPass(PassId id)
@@ -1729,21 +1745,26 @@ bool HabanaGraph::isTensorDataTypeValid(const TensorPtr& tensor) const
 {
     synDataType type = tensor->getElementType();
     return (m_graphTraits->getHalReader()->isSupportedDataType(type) || isSupported64BitDataType(type)) ||
-           (type == syn_type_na && m_preDataTypeSelection) || tensor->isControlEdge();
+           (type == syn_type_na && m_preDataTypeSelection && isDataTypeSelectionEnabled()) ||
+           tensor->isControlEdge();
 }
 
 void HabanaGraph::setInferenceMode(bool mode)
 {
     if (!mode)
     {
-        LOG_DEBUG(GC, "Set GCFG_SYNAPSE_DATA_TYPE_SELECTION=false, data type selction can be enabled only in "
-                      "inference mode");
-        GCFG_SYNAPSE_DATA_TYPE_SELECTION.setValue(false);
+        LOG_DEBUG(GC, "Disable data type selection of graph, data type selction can be enabled only in inference mode");
+        m_graphTraits->setDataTypeSelectionAllowed(false);
     }
 
     return m_graphTraits->setTrainingGraph(!mode);
 }
 
+bool HabanaGraph::isDataTypeSelectionEnabled() const
+{
+    return GCFG_SYNAPSE_DATA_TYPE_SELECTION.value() && m_graphTraits->isDataTypeSelectionAllowed();
+}
+
 void HabanaGraph::setBackoffFactor(double boFactor)
 {
     return m_graphTraits->setBackoffFactor(boFactor);
@@ -59,6 +59,8 @@ class Recipe;
 // (to maintain this chart use http://asciiflow.com, you can import the chart there, edit
 // and then paste it back here.)
 
+class CompilationProfiler;
+class GraphArena;
 class Pass;
 class PassManager;
 class HabanaGraph;
@@ -311,10 +313,16 @@ public:
 
     bool getInferenceMode() const { return m_graphTraits->inferenceGraph(); }
 
+    // GCFG_SYNAPSE_DATA_TYPE_SELECTION, unless disabled for this graph by setInferenceMode(false)
+    bool isDataTypeSelectionEnabled() const;
+
     void setQuantizationEnabled(bool enabled) { m_graphTraits->setQuantizationEnabled(enabled); }
 
     bool getQuantizationEnabled() const { return m_graphTraits->isQuantizationEnabled(); }
 
+    // Disables transpose via gemm for this graph only, whichever thread compiles its nodes
+    void setTransposeViaGemmAllowed(bool allowed) { m_graphTraits->setTransposeViaGemmAllowed(allowed); }
+
     void setBackoffFactor(double boFactor);
 
     double getBackoffFactor() const { return m_graphTraits->backoffFactor(); }
@@ -371,6 +379,12 @@ public:
     void                         setPassManager(std::unique_ptr<PassManager>& pm);
     std::unique_ptr<PassManager> clonePassManager() const;
 
+    // Per pass time, memory and graph changes of the last compilation, null unless the compilation profile is enabled
+    const CompilationProfiler* getCompilationProfile() const;
+
+    // Pool of the nodes and tensors created while passes run on the graph, null unless GCFG_ENABLE_GRAPH_ARENA is set
+    GraphArena* getArena();
+
     std::optional<std::pair<NodeCostModel::EngineType, double>> getNodeExpectedDuration(const NodePtr& node) const;
 
     bool wasCreatedUsingDuplicateAPI() const { return m_duplicatedTarget; }
@@ -478,6 +492,7 @@ protected:
     mutable GraphAnnotation                    m_annotation;
     uint32_t                                   m_numOfDmaIntermediates = 0;
     std::unique_ptr<PassManager>               m_passManager;
+    std::shared_ptr<GraphArena>                m_arena;
     bool                                       m_ctrlDepWasConfigured = false;
     bool                                       m_duplicatedTarget = false; // created through a call to synGraphDuplicate
     size_t                                     m_dynamicNodeCount = 0;
@@ -1,6 +1,7 @@
 #include "conv_base_node.h"
 
 #include "convolution_node.h"
+#include "graph_arena.h"
 #include "habana_graph.h"
 #include "hal_reader/hal_reader.h"
 #include "infra/cpu_calculator.h"
@@ -62,7 +63,7 @@ bool ConvolutionNode::is3DConvolutionGuid() const
 
 NodePtr ConvolutionNode::clone() const
 {
-    return NodePtr(new ConvolutionNode(*this));
+    return makeGraphObject<ConvolutionNode>(*this);
 }
 
 TensorSemanticType ConvolutionNode::getParamSemanticType(const TensorPtr& param) const
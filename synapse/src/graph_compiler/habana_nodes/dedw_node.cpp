@@ -1,6 +1,7 @@
 #include "dedw_node.h"
 
 #include "graph_traits.h"
+#include "graph_arena.h"
 #include "habana_graph.h"
 #include "node_factory.h"
 #include "synapse_types_operators.h"
@@ -32,7 +33,7 @@ NodePtr DeToDwNode::createNode(const TensorVector& inputs,
 
 NodePtr DeToDwNode::clone() const
 {
-    return NodePtr(new DeToDwNode(*this));
+    return makeGraphObject<DeToDwNode>(*this);
 }
 
 TensorSemanticType DeToDwNode::getParamSemanticType(const TensorPtr& param) const
@@ -1,6 +1,7 @@
 #include "dedx_node.h"
 
 #include "graph_traits.h"
+#include "graph_arena.h"
 #include "habana_graph.h"
 #include "node_factory.h"
 #include "synapse_types_operators.h"
@@ -35,7 +36,7 @@ bool DeToDxNode::is3DConvolutionGuid() const
 
 NodePtr DeToDxNode::clone() const
 {
-    return NodePtr(new DeToDxNode(*this));
+    return makeGraphObject<DeToDxNode>(*this);
 }
 
 TensorSemanticType DeToDxNode::getParamSemanticType(const TensorPtr& param) const
@@ -201,7 +202,7 @@ NodePtr TransposedDedxNode::createNode(const TensorVector& inputs,
 
 NodePtr TransposedDedxNode::clone() const
 {
-    return NodePtr(new TransposedDedxNode(*this));
+    return makeGraphObject<TransposedDedxNode>(*this);
 }
 
 bool TransposedDedxNode::isOperandTransposed(const TensorPtr& t) const
@@ -6,6 +6,7 @@
 #include "compilation_hal_reader.h"
 #include "data_type_utils.h"
 #include "defs.h"
+#include "graph_arena.h"
 #include "graph_traits.h"
 #include "habana_graph.h"
 #include "hal_reader/hal_reader.h"
@@ -513,17 +514,17 @@ void GEMMDeToDxNode::setParams(UserParams userParams, unsigned int userParamsSiz
 
 NodePtr GEMMNode::clone() const
 {
-    return NodePtr(new GEMMNode(*this));
+    return makeGraphObject<GEMMNode>(*this);
 }
 
 NodePtr GEMMDeToDxNode::clone() const
 {
-    return NodePtr(new GEMMDeToDxNode(*this));
+    return makeGraphObject<GEMMDeToDxNode>(*this);
 }
 
 NodePtr GEMMDeToDwNode::clone() const
 {
-    return NodePtr(new GEMMDeToDwNode(*this));
+    return makeGraphObject<GEMMDeToDwNode>(*this);
 }
 
 Settable<NodeROI> GEMMNode::getInputROI(const NodeROI& roi, uint32_t tensorIdx) const
@@ -755,7 +756,7 @@ NodePtr BatchGemmNode::createNode(const TensorVector& inputs,
 
 NodePtr BatchGemmNode::clone() const
 {
-    return NodePtr(new BatchGemmNode(*this));
+    return makeGraphObject<BatchGemmNode>(*this);
 }
 
 bool BatchGemmNode::validateNodeLayout() const
@@ -977,7 +978,7 @@ void BatchGemmDeToDwNode::setParams(UserParams userParams, unsigned int userPara
 
 NodePtr BatchGemmDeToDwNode::clone() const
 {
-    return NodePtr(new BatchGemmDeToDwNode(*this));
+    return makeGraphObject<BatchGemmDeToDwNode>(*this);
 }
 
 bool BatchGemmDeToDwNode::validateNodeForGraph(const HabanaGraph& g) const
@@ -1034,7 +1035,7 @@ void BatchGemmDeToDxNode::setParams(UserParams userParams, unsigned int userPara
 
 NodePtr BatchGemmDeToDxNode::clone() const
 {
-    return NodePtr(new BatchGemmDeToDxNode(*this));
+    return makeGraphObject<BatchGemmDeToDxNode>(*this);
 }
 
 bool BatchGemmDeToDxNode::validateNodeForGraph(const HabanaGraph& g) const
@@ -1072,7 +1073,7 @@ NodePtr MaskedBatchGemmNode::createNode(const TensorVector& inputs,
 
 NodePtr MaskedBatchGemmNode::clone() const
 {
-    return NodePtr(new MaskedBatchGemmNode(*this));
+    return makeGraphObject<MaskedBatchGemmNode>(*this);
 }
 
 bool MaskedBatchGemmNode::validateNode() const
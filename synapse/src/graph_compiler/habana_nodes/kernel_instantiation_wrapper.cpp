@@ -5,6 +5,7 @@
 #include "habana_global_conf.h"
 #include "kernel_db.h"
 #include "log_manager.h"
+#include "tpc_instantiation_cache.h"
 #include "tpc_node.h"
 
 #include <cstring>
@@ -511,8 +512,90 @@ void KernelInstantiationWrapper::resetKernelInstantiationParams()
     }
 }
 
+std::shared_ptr<const CachedTpcInstantiation> KernelInstantiationWrapper::captureInstantiation() const
+{
+    auto cached      = std::make_shared<CachedTpcInstantiation>();
+    cached->instance = m_instance;
+
+    cached->instance.inputTensorAccessPattern  = nullptr;
+    cached->instance.outputTensorAccessPattern = nullptr;
+    cached->instance.auxiliaryTensors          = nullptr;
+    cached->instance.kernel.kernelElf          = nullptr;
+
+    cached->inputAccessPatterns.assign(m_instance.inputTensorAccessPattern,
+                                       m_instance.inputTensorAccessPattern + m_glueParams.inputTensorNr);
+    cached->outputAccessPatterns.assign(m_instance.outputTensorAccessPattern,
+                                        m_instance.outputTensorAccessPattern + m_glueParams.outputTensorNr);
+
+    cached->auxTensors.assign(m_instance.auxiliaryTensors, m_instance.auxiliaryTensors + m_instance.auxiliaryTensorNr);
+    cached->auxData.resize(m_instance.auxiliaryTensorNr);
+    for (unsigned i = 0; i < m_instance.auxiliaryTensorNr; i++)
+    {
+        const char* data = static_cast<const char*>(m_instance.auxiliaryTensors[i].pData);
+        cached->auxData[i].assign(data, data + m_instance.auxiliaryTensors[i].bufferSize);
+        cached->auxTensors[i].pData = nullptr;
+    }
+
+    const char* elf = static_cast<const char*>(m_instance.kernel.kernelElf);
+    cached->elf.assign(elf, elf + m_instance.kernel.elfSize);
+    return cached;
+}
+
+void KernelInstantiationWrapper::restoreInstantiation(const CachedTpcInstantiation& cached)
+{
+    HB_ASSERT(cached.inputAccessPatterns.size() == m_glueParams.inputTensorNr &&
+                  cached.outputAccessPatterns.size() == m_glueParams.outputTensorNr,
+              "cached TPC instantiation doesn't match the node operands");
+
+    tpc_lib_api::TensorAccessPattern* inputTensorAccessPattern  = m_instance.inputTensorAccessPattern;
+    tpc_lib_api::TensorAccessPattern* outputTensorAccessPattern = m_instance.outputTensorAccessPattern;
+
+    m_instance                           = cached.instance;
+    m_instance.inputTensorAccessPattern  = inputTensorAccessPattern;
+    m_instance.outputTensorAccessPattern = outputTensorAccessPattern;
+    m_instance.auxiliaryTensors          = m_auxTensors.data();
+    std::copy(cached.inputAccessPatterns.begin(), cached.inputAccessPatterns.end(), inputTensorAccessPattern);
+    std::copy(cached.outputAccessPatterns.begin(), cached.outputAccessPatterns.end(), outputTensorAccessPattern);
+
+    // Each node owns its copy of the buffers, as they are released or replaced independently of the cache
+    m_auxBuffers.resize(m_instance.auxiliaryTensorNr);
+    for (unsigned i = 0; i < MAX_TENSOR_NR; i++)
+    {
+        if (i >= m_instance.auxiliaryTensorNr)
+        {
+            m_auxTensors[i] = {};
+            continue;
+        }
+        const std::vector<char>& data = cached.auxData[i];
+        m_auxTensors[i]               = cached.auxTensors[i];
+        m_auxBuffers[i].buffer.reset(new char[data.size()], ArrayDeletor<char>());
+        m_auxBuffers[i].size = data.size();
+        memcpy(m_auxBuffers[i].buffer.get(), data.data(), data.size());
+        m_auxTensors[i].pData = m_auxBuffers[i].buffer.get();
+    }
+
+    prepareElfBuffer(cached.elf.size());
+    memcpy(m_kernelElf.get(), cached.elf.data(), cached.elf.size());
+    m_validTpcHeader = false;
+}
+
 tpc_lib_api::GlueCodeReturn KernelInstantiationWrapper::instantiate(const StringWithHash& guidAndHash)
 {
+    TpcInstantiationCache& cache = TpcInstantiationCache::instance();
+    std::string            cacheKey;
+    if (cache.isEnabled())
+    {
+        cacheKey = TpcInstantiationCache::calcKey(m_glueParams);
+        if (!cacheKey.empty())
+        {
+            if (CachedTpcInstantiationSptr cached = cache.lookup(cacheKey))
+            {
+                restoreInstantiation(*cached);
+                return tpc_lib_api::GLUE_SUCCESS;
+            }
+        }
+    }
+
     // Since the glue code can fail for various reasons, we gonna call it several times - while handling previous error.
     // Currently there are only 3 errors that we can recover from - on all others we fail the kernel instantiation
     tpc_lib_api::GlueCodeReturn ret      = tpc_lib_api::GLUE_FAILED;
@@ -573,6 +656,11 @@ tpc_lib_api::GlueCodeReturn KernelInstantiationWrapper::instantiate(const String
 
     validateAuxTensorsSize();
 
+    if (ret == tpc_lib_api::GLUE_SUCCESS && !cacheKey.empty())
+    {
+        cache.insert(cacheKey, captureInstantiation());
+    }
+
     return ret;
 
 }
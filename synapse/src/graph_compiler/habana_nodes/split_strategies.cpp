@@ -443,8 +443,10 @@ uint32_t SplitTransposeToLowDescriptorCount::optimizeNumOfChunksNum(const Node&
 
     if (firstPrefferedDimSizeInElements / logicalEngineCount % srcLineSize == 0) return logicalEngineCount;
 
-    for (int numOfChunks = logicalEngineCount - 1; numOfChunks >= GCFG_DEFAULT_PIPELINE_DEPTH.value();
-         numOfChunks--)
+    const auto& graphTraits = node.getGraphTraits();
+    const int   minNumOfChunks =
+        graphTraits != nullptr ? graphTraits->defaultPipelineDepth() : GCFG_DEFAULT_PIPELINE_DEPTH.value();
+    for (int numOfChunks = logicalEngineCount - 1; numOfChunks >= minNumOfChunks; numOfChunks--)
     {
         if (numOfChunks != 0 && firstPrefferedDimSizeInElements / numOfChunks % srcLineSize == 0)
         {
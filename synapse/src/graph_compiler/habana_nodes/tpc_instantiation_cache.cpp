@@ -0,0 +1,506 @@
+#include "tpc_instantiation_cache.h"
+
+#include "fasthash.h"
+#include "file_lock.h"
+#include "filesystem.h"
+#include "habana_global_conf.h"
+#include "kernel_db.h"
+#include "log_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr const char* LOCK_FILE_NAME  = "tpc_instantiation_cache.lock";
+constexpr const char* ENTRY_EXTENSION = ".tpcinst";
+constexpr const char* TEMP_EXTENSION  = ".tmp";
+constexpr auto        STALE_TEMP_AGE  = std::chrono::hours(1);
+constexpr uint64_t    BYTES_IN_MB     = 1024 * 1024;
+
+// The folder is evicted down to this part of its maximal size, so it is scanned again only after that much is stored
+constexpr double DISK_EVICTION_WATERMARK = 0.9;
+
+// Bumped on any change of the entries layout. The sizes of the glue code structures are part of the header as well.
+constexpr uint32_t ENTRY_MAGIC          = 0x49435054;  // "TPCI"
+constexpr uint32_t ENTRY_FORMAT_VERSION = 1;
+
+// Accumulates raw bytes into a flat buffer, used for both the keys and the disk entries
+class ByteWriter
+{
+public:
+    explicit ByteWriter(std::string& buffer) : m_buffer(buffer) {}
+
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be added as raw bytes");
+        m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void addBytes(const void* data, uint64_t size)
+    {
+        add(size);
+        if (size != 0)
+        {
+            m_buffer.append(reinterpret_cast<const char*>(data), size);
+        }
+    }
+
+    template<typename T>
+    void addVector(const std::vector<T>& values)
+    {
+        addBytes(values.data(), values.size() * sizeof(T));
+    }
+
+private:
+    std::string& m_buffer;
+};
+
+class ByteReader
+{
+public:
+    explicit ByteReader(std::string_view buffer) : m_buffer(buffer) {}
+
+    template<typename T>
+    bool get(T& rValue)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be read as raw bytes");
+        if (m_buffer.size() < sizeof(T)) return false;
+        std::memcpy(&rValue, m_buffer.data(), sizeof(T));
+        m_buffer.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool getBytes(std::string_view& rBytes)
+    {
+        uint64_t size = 0;
+        if (!get(size) || m_buffer.size() < size) return false;
+        rBytes = m_buffer.substr(0, size);
+        m_buffer.remove_prefix(size);
+        return true;
+    }
+
+    template<typename T>
+    bool getVector(std::vector<T>& rValues)
+    {
+        std::string_view bytes;
+        if (!getBytes(bytes) || bytes.size() % sizeof(T) != 0) return false;
+        rValues.resize(bytes.size() / sizeof(T));
+        std::memcpy(rValues.data(), bytes.data(), bytes.size());
+        return true;
+    }
+
+    bool isEmpty() const { return m_buffer.empty(); }
+
+private:
+    std::string_view m_buffer;
+};
+
+// Returns false for tensors that can't be cached
+bool addTensors(ByteWriter& key, const tpc_lib_api::Tensor* tensors, uint32_t tensorsNr)
+{
+    key.add(tensorsNr);
+    for (uint32_t i = 0; i < tensorsNr; ++i)
+    {
+        const tpc_lib_api::Tensor& tensor = tensors[i];
+        // The glue code may depend on the static data, which isn't worth hashing
+        if (tensor.pData != nullptr) return false;
+
+        key.add(tensor.geometry.dims);
+        key.add(tensor.geometry.maxSizes);
+        key.add(tensor.geometry.minSizes);
+        key.add(tensor.geometry.dataType);
+        key.add(tensor.quantizationParam.zeroPoint);
+        key.add(tensor.quantizationParam.scale);
+        key.add(tensor.layout);
+        key.add(tensor.flags);
+        key.add(tensor.permutation);
+        key.add(tensor.reserved);
+    }
+    return true;
+}
+
+void serializeEntry(std::string& buffer, const std::string& key, const CachedTpcInstantiation& instantiation)
+{
+    ByteWriter writer(buffer);
+    writer.add(ENTRY_MAGIC);
+    writer.add(ENTRY_FORMAT_VERSION);
+    writer.add(sizeof(tpc_lib_api::HabanaKernelInstantiation));
+    writer.add(sizeof(tpc_lib_api::TensorAccessPattern));
+    writer.add(sizeof(tpc_lib_api::AuxTensor));
+    writer.addBytes(key.data(), key.size());
+
+    writer.add(instantiation.instance);
+    writer.addVector(instantiation.inputAccessPatterns);
+    writer.addVector(instantiation.outputAccessPatterns);
+    writer.addVector(instantiation.auxTensors);
+    for (const std::vector<char>& data : instantiation.auxData)
+    {
+        writer.addVector(data);
+    }
+    writer.addVector(instantiation.elf);
+}
+
+bool deserializeEntry(std::string_view buffer, const std::string& key, CachedTpcInstantiation& rInstantiation)
+{
+    ByteReader       reader(buffer);
+    uint32_t         magic          = 0;
+    uint32_t         formatVersion  = 0;
+    size_t           instanceSize   = 0;
+    size_t           accessPattSize = 0;
+    size_t           auxTensorSize  = 0;
+    std::string_view entryKey;
+    if (!reader.get(magic) || !reader.get(formatVersion) || !reader.get(instanceSize) ||
+        !reader.get(accessPattSize) || !reader.get(auxTensorSize) || !reader.getBytes(entryKey))
+    {
+        return false;
+    }
+    if (magic != ENTRY_MAGIC || formatVersion != ENTRY_FORMAT_VERSION ||
+        instanceSize != sizeof(tpc_lib_api::HabanaKernelInstantiation) ||
+        accessPattSize != sizeof(tpc_lib_api::TensorAccessPattern) ||
+        auxTensorSize != sizeof(tpc_lib_api::AuxTensor) || entryKey != key)
+    {
+        return false;
+    }
+
+    if (!reader.get(rInstantiation.instance) || !reader.getVector(rInstantiation.inputAccessPatterns) ||
+        !reader.getVector(rInstantiation.outputAccessPatterns) || !reader.getVector(rInstantiation.auxTensors))
+    {
+        return false;
+    }
+    // The instance is copied to the node as is, so its counts must match the read buffers
+    if (rInstantiation.instance.auxiliaryTensorNr != rInstantiation.auxTensors.size() ||
+        rInstantiation.instance.auxiliaryTensorNr > MAX_TENSOR_NR)
+    {
+        return false;
+    }
+    rInstantiation.auxData.resize(rInstantiation.auxTensors.size());
+    for (std::vector<char>& data : rInstantiation.auxData)
+    {
+        if (!reader.getVector(data)) return false;
+    }
+    return reader.getVector(rInstantiation.elf) && rInstantiation.instance.kernel.elfSize == rInstantiation.elf.size() &&
+           reader.isEmpty();
+}
+
+bool prepareFolder(const std::string& folder)
+{
+    std::error_code ec;
+    fs::create_directories(folder, ec);
+    if (ec)
+    {
+        LOG_WARN(KERNEL_DB, "{}: failed to create TPC instantiation cache folder {}: {}", HLLOG_FUNC, folder, ec.message());
+        return false;
+    }
+
+    // FileLock expects an existing file
+    std::ofstream lockFile(fmt::format("{}/{}", folder, LOCK_FILE_NAME), std::ios_base::app);
+    return lockFile.good();
+}
+}  // anonymous namespace
+
+uint64_t CachedTpcInstantiation::getSizeInBytes() const
+{
+    uint64_t size = sizeof(*this) + elf.size() + sizeof(tpc_lib_api::TensorAccessPattern) *
+                                                     (inputAccessPatterns.size() + outputAccessPatterns.size());
+    for (const std::vector<char>& data : auxData)
+    {
+        size += sizeof(tpc_lib_api::AuxTensor) + data.size();
+    }
+    return size;
+}
+
+TpcInstantiationCache& TpcInstantiationCache::instance()
+{
+    static TpcInstantiationCache cache;
+    return cache;
+}
+
+bool TpcInstantiationCache::isEnabled() const
+{
+    return GCFG_TPC_INSTANTIATION_CACHE_MAX_ENTRIES.value() != 0;
+}
+
+std::string TpcInstantiationCache::calcKey(const tpc_lib_api::HabanaKernelParams& params)
+{
+    const std::string_view guid(params.guid.name, strnlen(params.guid.name, tpc_lib_api::MAX_NODE_NAME));
+    if (KernelDB::isFusedGUID(guid)) return {};
+
+    // Kernels which aren't loaded from a perf library are not cached
+    const uint64_t libVersion = KernelDB::instance().getKernelLibraryVersion(StringWithHash(std::string(guid)),
+                                                                             params.deviceId);
+    if (libVersion == 0) return {};
+
+    std::string key;
+    ByteWriter  writer(key);
+    writer.add(libVersion);
+    writer.add(params.apiVersion);
+    writer.add(params.deviceId);
+    writer.addBytes(guid.data(), guid.size());
+    writer.add(params.guid.kernelProperties);
+    writer.addBytes(params.nodeParams.nodeParams, params.nodeParams.nodeParams ? params.nodeParams.nodeParamsSize : 0);
+    if (!addTensors(writer, params.inputTensors, params.inputTensorNr) ||
+        !addTensors(writer, params.outputTensors, params.outputTensorNr))
+    {
+        return {};
+    }
+    writer.add(params.maxAvailableTpc);
+    writer.add(params.useDeterministic);
+    writer.add(params.debugFlags);
+    writer.add(params.validInputTensors);
+    writer.add(params.validOutputTensors);
+    writer.add(params.reserved);
+    return key;
+}
+
+CachedTpcInstantiationSptr TpcInstantiationCache::lookup(const std::string& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_keyToEntry.find(key);
+        if (it != m_keyToEntry.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            m_hits++;
+            return it->second->instantiation;
+        }
+    }
+
+    if (!GCFG_TPC_INSTANTIATION_CACHE_PATH.value().empty())
+    {
+        if (CachedTpcInstantiationSptr instantiation = loadFromDisk(key))
+        {
+            insertToMemory(key, instantiation);
+            m_hits++;
+            m_diskHits++;
+            return instantiation;
+        }
+    }
+
+    m_misses++;
+    return nullptr;
+}
+
+void TpcInstantiationCache::insert(const std::string& key, CachedTpcInstantiationSptr instantiation)
+{
+    insertToMemory(key, instantiation);
+    if (!GCFG_TPC_INSTANTIATION_CACHE_PATH.value().empty())
+    {
+        storeToDisk(key, *instantiation);
+    }
+}
+
+void TpcInstantiationCache::insertToMemory(const std::string& key, CachedTpcInstantiationSptr instantiation)
+{
+    const uint64_t maxEntries  = GCFG_TPC_INSTANTIATION_CACHE_MAX_ENTRIES.value();
+    const uint64_t maxSize     = GCFG_TPC_INSTANTIATION_CACHE_MAX_MEMORY_SIZE.value() * BYTES_IN_MB;
+    const uint64_t sizeInBytes = key.size() + instantiation->getSizeInBytes();
+    // It would evict all the others
+    if (sizeInBytes > maxSize) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Another thread may have instantiated the same kernel in the meantime
+    if (m_keyToEntry.count(key) != 0) return;
+
+    m_entries.push_front({key, std::move(instantiation), sizeInBytes});
+    m_keyToEntry.emplace(m_entries.front().key, m_entries.begin());
+    m_sizeInBytes += sizeInBytes;
+    while (m_entries.size() > maxEntries || m_sizeInBytes > maxSize)
+    {
+        m_sizeInBytes -= m_entries.back().sizeInBytes;
+        m_keyToEntry.erase(m_entries.back().key);
+        m_entries.pop_back();
+        m_evictions++;
+    }
+}
+
+std::string TpcInstantiationCache::getEntryPath(const std::string& key) const
+{
+    return fmt::format("{}/{:016x}{}", GCFG_TPC_INSTANTIATION_CACHE_PATH.value(), fasthash(key), ENTRY_EXTENSION);
+}
+
+CachedTpcInstantiationSptr TpcInstantiationCache::loadFromDisk(const std::string& key)
+{
+    const std::string entryPath = getEntryPath(key);
+
+    std::ifstream file(entryPath, std::ios::binary);
+    if (!file.good()) return nullptr;
+    const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto instantiation = std::make_shared<CachedTpcInstantiation>();
+    if (!deserializeEntry(buffer, key, *instantiation))
+    {
+        // A hash collision, an entry of another version, or a corrupted one. It is replaced on the next store.
+        LOG_DEBUG(KERNEL_DB, "{}: TPC instantiation cache entry {} doesn't match", HLLOG_FUNC, entryPath);
+        return nullptr;
+    }
+
+    // Mark the entry as recently used
+    std::error_code ec;
+    fs::last_write_time(entryPath, fs::file_time_type::clock::now(), ec);
+    return instantiation;
+}
+
+void TpcInstantiationCache::storeToDisk(const std::string& key, const CachedTpcInstantiation& instantiation)
+{
+    const std::string folder = GCFG_TPC_INSTANTIATION_CACHE_PATH.value();
+    if (!prepareFolder(folder)) return;
+
+    const std::string entryPath = getEntryPath(key);
+    const std::string tempPath =
+        fmt::format("{}.{}.{}{}", entryPath, getpid(), (pid_t)syscall(SYS_gettid), TEMP_EXTENSION);
+
+    std::string buffer;
+    serializeEntry(buffer, key, instantiation);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(buffer.data(), buffer.size());
+        if (!file.good())
+        {
+            LOG_WARN(KERNEL_DB, "{}: failed to write TPC instantiation to {}", HLLOG_FUNC, tempPath);
+            file.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return;
+        }
+    }
+
+    try
+    {
+        auto fileLock = FileLock::lock(fmt::format("{}/{}", folder, LOCK_FILE_NAME));
+
+        std::error_code ec;
+        fs::rename(tempPath, entryPath, ec);
+        if (ec)
+        {
+            LOG_WARN(KERNEL_DB, "{}: failed to publish TPC instantiation {}: {}", HLLOG_FUNC, entryPath, ec.message());
+            fs::remove(tempPath, ec);
+            return;
+        }
+        trackDiskStore(folder, buffer.size());
+    }
+    catch (const SynapseException& e)
+    {
+        LOG_WARN(KERNEL_DB, "{}: TPC instantiation cache is not updated: {}", HLLOG_FUNC, e.what());
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+    }
+}
+
+// Must be called while holding the folder lock
+void TpcInstantiationCache::trackDiskStore(const std::string& folder, uint64_t entrySize)
+{
+    const uint64_t maxSize = GCFG_TPC_INSTANTIATION_CACHE_MAX_SIZE.value() * BYTES_IN_MB;
+
+    // The folder is only scanned when the size it may have reached crosses the limit. The size counts the entries
+    // stored by this process since the last scan, the ones of the other processes are found by their own scans.
+    std::lock_guard<std::mutex> lock(m_diskMutex);
+    if (folder != m_diskFolder)
+    {
+        m_diskFolder = folder;
+        m_diskSizeInBytes.reset();
+    }
+    if (m_diskSizeInBytes.has_value())
+    {
+        *m_diskSizeInBytes += entrySize;
+        if (*m_diskSizeInBytes <= maxSize) return;
+    }
+    m_diskSizeInBytes = evictFromDisk(folder, maxSize);
+}
+
+// Must be called while holding the folder lock, returns the size of the entries left
+uint64_t TpcInstantiationCache::evictFromDisk(const std::string& folder, uint64_t maxSize)
+{
+    struct DiskEntry
+    {
+        fs::file_time_type lastUse;
+        uint64_t           size;
+        fs::path           path;
+    };
+
+    std::vector<DiskEntry> entries;
+    uint64_t               totalSize = 0;
+    const auto             now       = fs::file_time_type::clock::now();
+
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(folder, ec))
+    {
+        std::error_code    fileEc;
+        const fs::path&    path    = file.path();
+        fs::file_time_type lastUse = fs::last_write_time(path, fileEc);
+        if (fileEc) continue;
+
+        if (path.extension() == TEMP_EXTENSION)
+        {
+            // Leftovers of a process that died while storing
+            if (now - lastUse > STALE_TEMP_AGE)
+            {
+                fs::remove(path, fileEc);
+            }
+            continue;
+        }
+        if (path.extension() != ENTRY_EXTENSION) continue;
+
+        uint64_t size = fs::file_size(path, fileEc);
+        if (fileEc) continue;
+
+        entries.push_back({lastUse, size, path});
+        totalSize += size;
+    }
+
+    if (totalSize <= maxSize) return totalSize;
+
+    const uint64_t targetSize = maxSize * DISK_EVICTION_WATERMARK;
+    std::sort(entries.begin(), entries.end(), [](const DiskEntry& a, const DiskEntry& b) {
+        return a.lastUse < b.lastUse;
+    });
+    for (const DiskEntry& entry : entries)
+    {
+        if (totalSize <= targetSize) break;
+        if (fs::remove(entry.path, ec))
+        {
+            totalSize -= entry.size;
+        }
+    }
+    return totalSize;
+}
+
+void TpcInstantiationCache::clear()
+{
+    const Stats    stats   = getStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+    if (lookups != 0)
+    {
+        LOG_INFO(KERNEL_DB,
+                 "TPC instantiation cache: {} lookups, hit rate {:.1f}% ({} from disk), {} evictions",
+                 lookups,
+                 100.0 * stats.hits / lookups,
+                 stats.diskHits,
+                 stats.evictions);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_keyToEntry.clear();
+        m_entries.clear();
+        m_sizeInBytes = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_diskMutex);
+    m_diskFolder.clear();
+    m_diskSizeInBytes.reset();
+}
+
+TpcInstantiationCache::Stats TpcInstantiationCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return {m_hits.load(), m_diskHits.load(), m_misses.load(), m_evictions.load(), m_sizeInBytes};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "tpc_kernel_lib_interface.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// The glue code outputs of a TPC kernel instantiation, detached from the buffers of the instantiating node
+struct CachedTpcInstantiation
+{
+    tpc_lib_api::HabanaKernelInstantiation        instance;  // The pointers are not valid
+    std::vector<tpc_lib_api::TensorAccessPattern> inputAccessPatterns;
+    std::vector<tpc_lib_api::TensorAccessPattern> outputAccessPatterns;
+    std::vector<tpc_lib_api::AuxTensor>           auxTensors;  // The pData pointers are not valid
+    std::vector<std::vector<char>>                auxData;
+    std::vector<char>                             elf;
+
+    uint64_t getSizeInBytes() const;
+};
+using CachedTpcInstantiationSptr = std::shared_ptr<const CachedTpcInstantiation>;
+
+/**
+ * Process-wide LRU cache of TPC kernel instantiations, optionally backed by a folder shared between processes
+ *
+ * TPC nodes of both graph and eager compilations are instantiated by KernelInstantiationWrapper, which calls the glue
+ * code (negotiating the ELF and aux buffers sizes on the way) and is the main cost of a TPC node init. The results
+ * only depend on the glue code params, so they are keyed by the GUID, the tensors geometry, data types, layouts and
+ * permutations, the node params, the device and the TPC library version. Tensors with static data given to the glue
+ * code and fused kernels (whose GUIDs are local to the process) are not cached.
+ * The in-memory entries are bounded by both their number and their total size (see
+ * CachedTpcInstantiation::getSizeInBytes).
+ * Disk entries hold the full key, so a hash collision is a miss. The folder is scanned for eviction only when the
+ * entries stored since the last scan may have crossed its size limit, and is then evicted below the limit.
+ */
+class TpcInstantiationCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t diskHits;  // Included in the hits
+        uint64_t misses;
+        uint64_t evictions;
+        uint64_t sizeInBytes;  // Of the in-memory entries
+    };
+
+    static TpcInstantiationCache& instance();
+
+    bool isEnabled() const;
+
+    // Returns an empty key for params that can't be cached
+    static std::string calcKey(const tpc_lib_api::HabanaKernelParams& params);
+
+    CachedTpcInstantiationSptr lookup(const std::string& key);
+    void                       insert(const std::string& key, CachedTpcInstantiationSptr instantiation);
+
+    void  clear();
+    Stats getStats() const;
+
+private:
+    TpcInstantiationCache() = default;
+
+    void insertToMemory(const std::string& key, CachedTpcInstantiationSptr instantiation);
+
+    std::string                getEntryPath(const std::string& key) const;
+    CachedTpcInstantiationSptr loadFromDisk(const std::string& key);
+    void                       storeToDisk(const std::string& key, const CachedTpcInstantiation& instantiation);
+    void                       trackDiskStore(const std::string& folder, uint64_t entrySize);
+    uint64_t                   evictFromDisk(const std::string& folder, uint64_t maxSize);
+
+    struct Entry
+    {
+        std::string                key;
+        CachedTpcInstantiationSptr instantiation;
+        uint64_t                   sizeInBytes;  // Including the key
+    };
+    using EntriesList = std::list<Entry>;
+
+    mutable std::mutex                                          m_mutex;
+    EntriesList                                                 m_entries;  // Most recently used first
+    std::unordered_map<std::string_view, EntriesList::iterator> m_keyToEntry;
+    uint64_t                                                    m_sizeInBytes = 0;  // Of m_entries
+
+    std::mutex              m_diskMutex;
+    std::string             m_diskFolder;
+    std::optional<uint64_t> m_diskSizeInBytes;  // Of the folder entries, unknown until it is scanned
+
+    std::atomic<uint64_t> m_hits {0};
+    std::atomic<uint64_t> m_diskHits {0};
+    std::atomic<uint64_t> m_misses {0};
+    std::atomic<uint64_t> m_evictions {0};
+};
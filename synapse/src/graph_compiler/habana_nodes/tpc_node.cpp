@@ -2,6 +2,7 @@
 
 // synapse graph_compiler
 #include "access_pattern.h"
+#include "graph_arena.h"
 #include "graph_traits.h"
 #include "habana_global_conf.h"         // for GCFG_TPC_PRINTF_TENSOR_SIZE
 #include "habana_graph.h"
@@ -502,7 +503,7 @@ NodePtr TPCNode::clone() const
 
 NodePtr TPCNode::getSlice() const
 {
-    auto slice = std::make_shared<TPCSlice>(this);
+    auto slice = makeGraphObject<TPCSlice>(this);
     return slice;
 }
 
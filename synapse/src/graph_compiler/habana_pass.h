@@ -343,6 +343,10 @@ public:
     // Subclasses that allow predicates need to override this.
     virtual inline bool   canRunMultipleTimes() { return false; }
 
+    // Passes which only inspect the graph (no modification of the graph, its nodes, tensors or annotations) may be
+    // executed by the pass manager concurrently with adjacent read-only passes. Subclasses need to override this.
+    virtual inline bool   isGraphReadOnly() const { return false; }
+
 protected:
     std::string    m_name;
     PassId         m_id;
@@ -364,6 +368,9 @@ public:
 
     // Passes that allow predicates should define specialization to override the default.
     inline bool canRunMultipleTimes() override { return Pass::canRunMultipleTimes(); }
+
+    // Read-only passes should define specialization to override the default.
+    inline bool isGraphReadOnly() const override { return Pass::isGraphReadOnly(); }
 };
 
 class PassGroup : public Pass
@@ -387,6 +394,9 @@ protected:
 #define SET_HABANA_PASS_CAN_RUN_MULTIPLE_TIMES(pass_) \
     template<> inline bool HabanaPass<pass_>::canRunMultipleTimes() { return true; }
 
+#define SET_HABANA_PASS_GRAPH_READ_ONLY(pass_) \
+    template<> inline bool HabanaPass<pass_>::isGraphReadOnly() const { return true; }
+
 #define REGISTER_GROUP(name_, id_, groupMembers_, depSet_)                                                             \
     addPass(pPass(new PassGroup(#name_, (id_), groupMembers_, depSet_)))
 
@@ -397,6 +407,7 @@ SET_HABANA_PASS_CAN_RUN_MULTIPLE_TIMES(fuseBroadcast);
 bool generateROIs(HabanaGraph& g);
 bool splitToDcoreROIs(HabanaGraph& g);
 bool validateNodesLayout(HabanaGraph& g);
+SET_HABANA_PASS_GRAPH_READ_ONLY(validateNodesLayout);
 bool assignAddressesToTensorROIs(HabanaGraph& g);
 bool projectNodeROIs(HabanaGraph& g);
 bool splitTPCDims(HabanaGraph& g);
@@ -441,9 +452,12 @@ bool checkInputPersistence(HabanaGraph& g);
 bool allocateTensors(HabanaGraph& g);
 bool validateExecutionScheduleBundles(HabanaGraph& g);
 bool validateMMENodes(HabanaGraph& g);
+SET_HABANA_PASS_GRAPH_READ_ONLY(validateMMENodes);
 bool InitMmeBrainIfc(HabanaGraph& g);                   SET_HABANA_PASS_CAN_RUN_MULTIPLE_TIMES(InitMmeBrainIfc)
 bool validateAtomicNodes(HabanaGraph& g);
+SET_HABANA_PASS_GRAPH_READ_ONLY(validateAtomicNodes);
 bool validateMemoryAllocation(HabanaGraph& g);
+SET_HABANA_PASS_GRAPH_READ_ONLY(validateMemoryAllocation);
 bool updateNodesWithAliasTensors(HabanaGraph& g);
 bool handleTpcRmwKernels(HabanaGraph& g);
 bool relaxCtrlDeps(HabanaGraph& g);
@@ -502,6 +516,7 @@ bool synapseMLIROptimizer(HabanaGraph& g);
 bool fuseSpillFillDirectives(HabanaGraph& g);
 bool lowerDedx(HabanaGraph& g);
 bool gcPerfChecks(HabanaGraph& g);
+SET_HABANA_PASS_GRAPH_READ_ONLY(gcPerfChecks);
 bool removeOppositeConcatSplitSequence(HabanaGraph& g);
 bool staticTensorsFloatConversion(HabanaGraph&);
 bool staticTensorsCastInsert(HabanaGraph& g);
@@ -547,6 +562,7 @@ bool eliminateNodesWithStaticInputs(HabanaGraph &g);
 SET_HABANA_PASS_CAN_RUN_MULTIPLE_TIMES(eliminateNodesWithStaticInputs)
 
 bool validateDmaNodes(HabanaGraph& g);
+SET_HABANA_PASS_GRAPH_READ_ONLY(validateDmaNodes);
 SET_HABANA_PASS_CAN_RUN_MULTIPLE_TIMES(validateDmaNodes);
 
 bool markReductionInputs(HabanaGraph& g);
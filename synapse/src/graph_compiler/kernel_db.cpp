@@ -1,6 +1,7 @@
 #include "kernel_db.h"
 
 #include "complex_guid_extractor.h"
+#include "habana_nodes/tpc_instantiation_cache.h"
 #include "infra/defs.h"
 #include "types_exception.h"
 #include "utils.h"
@@ -151,6 +152,8 @@ void KernelDB::clear()
         cguidDSMap.clear();
     });
     m_initializedIds.clear();
+    // the cached instantiations are only valid for the unloaded libraries
+    TpcInstantiationCache::instance().clear();
     // clearing Complex GUID extractor shared object
     ComplexGuidExtractorSharedObject::instance().destroy();
     TPCFuserSharedObject::instance().destroy();
@@ -728,6 +731,12 @@ uint64_t KernelDB::GetLibraryVersion(tpc_lib_api::DeviceId deviceId, const std::
     return libVersion;
 }
 
+uint64_t KernelDB::getKernelLibraryVersion(const StringWithHash& guidAndHash, tpc_lib_api::DeviceId deviceId) const
+{
+    auto kernelIter = m_kernelDB[deviceId].find(guidAndHash);
+    return kernelIter != m_kernelDB[deviceId].end() ? kernelIter->second.libraryVersion : 0;
+}
+
 bool KernelDB::GetKernelShapeInferenceFunctionID(tpc_lib_api::DeviceId                  deviceId,
                                                  const std::string&                     kernelName,
                                                  tpc_lib_api::UniqueShapeInferenceHash* sifId) const
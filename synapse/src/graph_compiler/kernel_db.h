@@ -97,6 +97,9 @@ public:
 
     uint64_t GetLibraryVersion(tpc_lib_api::DeviceId deviceId, const std::string& kernelName) const;
 
+    // The version of the library of a loaded (non-complex, non-fused) kernel, 0 if there is no such kernel
+    uint64_t getKernelLibraryVersion(const StringWithHash& guidAndHash, tpc_lib_api::DeviceId deviceId) const;
+
     bool GetKernelShapeInferenceFunctionID(tpc_lib_api::DeviceId                  deviceId,
                                            const std::string&                     kernelName,
                                            tpc_lib_api::UniqueShapeInferenceHash* sifId) const;
@@ -0,0 +1,327 @@
+#include "memory_aware_scheduler.h"
+
+#include "allocators_utils.h"
+#include "habana_global_conf.h"
+#include "habana_graph.h"
+#include "log_manager.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <unordered_set>
+
+namespace
+{
+// Picks the free node with the best mix of max path and net workspace bytes, and tracks the live workspace tensors as
+// the nodes are scheduled
+class MemoryAwareFreeNodesContainer : public GaudiMaxPathFreeNodesContainer
+{
+public:
+    using NodeTensors = MemoryAwareScheduler::NodeWorkspaceTensors;
+
+    MemoryAwareFreeNodesContainer(const MaxPathNodeComparator& cmp,
+                                  const MaxPathMap&            maxPath,
+                                  const NodeTensors&           nodeTensors,
+                                  double                       memoryWeight)
+    : GaudiMaxPathFreeNodesContainer(cmp),
+      m_maxPath(maxPath),
+      m_nodeTensors(nodeTensors),
+      m_memoryWeight(memoryWeight),
+      m_maxScannedNodes(std::max<uint64_t>(GCFG_MEMORY_AWARE_SCHEDULE_MAX_SCANNED_NODES.value(), 1))
+    {
+        uint64_t maxTensorSize = 1;
+        uint64_t maxNodeBytes  = 0;
+        for (const auto& [node, tensors] : m_nodeTensors)
+        {
+            uint64_t nodeBytes = 0;
+            for (const auto& [tensor, size] : tensors)
+            {
+                m_remainingUses[tensor]++;
+                maxTensorSize = std::max(maxTensorSize, size);
+                nodeBytes += size;
+            }
+            maxNodeBytes = std::max(maxNodeBytes, nodeBytes);
+        }
+        unsigned maxPathLength = 1;
+        for (const auto& [node, length] : m_maxPath)
+        {
+            maxPathLength = std::max(maxPathLength, length);
+        }
+        m_maxPathScale = 1.0 / maxPathLength;
+        m_bytesScale   = 1.0 / maxTensorSize;
+        // No node releases more than the bytes of all its tensors
+        m_maxReleaseScore = m_memoryWeight * maxNodeBytes * m_bytesScale;
+    }
+
+    NodePtr getNext() override
+    {
+        NodePtr  best;
+        double   bestScore = 0;
+        uint64_t scanned   = 0;
+        // The free nodes are ordered by the max-path comparator: logical nodes first, then by descending max path
+        for (const NodePtr& n : m_freeNodes)
+        {
+            // Logical nodes don't execute, so they go first as in the max-path order
+            if (n->isLogicalOperation() && !n->isDebug()) return n;
+
+            const double maxPathScore = (1 - m_memoryWeight) * m_maxPath.at(n) * m_maxPathScale;
+            // Neither this node nor the next ones (of a shorter or equal max path) can beat the best one
+            if (best != nullptr && maxPathScore + m_maxReleaseScore <= bestScore) break;
+            // The frontier may be wide, the nodes of the longest max paths are preferred anyway
+            if (scanned++ == m_maxScannedNodes) break;
+
+            const double score = maxPathScore - m_memoryWeight * getNetBytes(n) * m_bytesScale;
+            // The max-path order breaks the ties
+            if (best == nullptr || score > bestScore)
+            {
+                best      = n;
+                bestScore = score;
+            }
+        }
+        return best;
+    }
+
+    void erase(const NodePtr& n) override
+    {
+        const auto it = m_nodeTensors.find(n);
+        if (it != m_nodeTensors.end())
+        {
+            for (const auto& [tensor, size] : it->second)
+            {
+                m_started.insert(tensor);
+                if (--m_remainingUses.at(tensor) == 0) m_started.erase(tensor);
+            }
+        }
+        GaudiMaxPathFreeNodesContainer::erase(n);
+    }
+
+private:
+    // The workspace bytes which stay live after the node, minus the ones it releases
+    int64_t getNetBytes(const NodePtr& n) const
+    {
+        const auto it = m_nodeTensors.find(n);
+        if (it == m_nodeTensors.end()) return 0;
+
+        int64_t netBytes = 0;
+        for (const auto& [tensor, size] : it->second)
+        {
+            const bool started  = m_started.count(tensor) != 0;
+            const bool lastUser = m_remainingUses.at(tensor) == 1;
+            if (!started && !lastUser) netBytes += size;
+            if (started && lastUser) netBytes -= size;
+        }
+        return netBytes;
+    }
+
+    const MaxPathMap&                       m_maxPath;
+    const NodeTensors&                      m_nodeTensors;
+    const double                            m_memoryWeight;
+    const uint64_t                          m_maxScannedNodes;
+    double                                  m_maxPathScale;
+    double                                  m_bytesScale;
+    double                                  m_maxReleaseScore;
+    std::unordered_map<TensorPtr, unsigned> m_remainingUses;
+    std::unordered_set<TensorPtr>           m_started;
+};
+}  // anonymous namespace
+
+MemoryAwareScheduler::MemoryAwareScheduler(const Graph*            graph,
+                                           const ConnectivityFunc& getBlockingNodes,
+                                           const ConnectivityFunc& getBlockedNodes)
+: GaudiMaxPathScheduler(graph, getBlockingNodes, getBlockedNodes),
+  m_habanaGraph(dynamic_cast<const HabanaGraph*>(graph))
+{
+    collectWorkspaceTensors();
+    collectNodeDurations();
+}
+
+void MemoryAwareScheduler::collectWorkspaceTensors()
+{
+    m_nodeWorkspaceTensors.clear();
+    for (const NodePtr& n : m_graph->getNodes())
+    {
+        if (!n) continue;
+        std::unordered_set<TensorPtr> seen;
+        for (const auto* tensorVec : {&n->getInputs(), &n->getOutputs()})
+        {
+            for (TensorPtr t : *tensorVec)
+            {
+                GET_REAL_TENSOR_IF_NULL_CONTINUE(t);
+                if (!isAllocInDramForced(t) || !seen.insert(t).second) continue;
+                m_nodeWorkspaceTensors[n].emplace_back(t, getWriteSpaceForTensor(t));
+            }
+        }
+    }
+}
+
+void MemoryAwareScheduler::collectNodeDurations()
+{
+    m_nodeDurations.clear();
+    for (const NodePtr& n : m_graph->getNodes())
+    {
+        if (!n) continue;
+        std::optional<NodeDuration> duration;
+        if (m_habanaGraph != nullptr)
+        {
+            duration = m_habanaGraph->getNodeExpectedDuration(n);
+        }
+        if (!duration.has_value())
+        {
+            // Without a cost model estimation every executing node takes a unit of time on its engine
+            if (n->isLogicalOperation())
+            {
+                duration = NodeDuration(NodeCostModel::EngineType::INVALID, 0);
+            }
+            else if (HabanaGraph::runsOnMME(n))
+            {
+                duration = NodeDuration(NodeCostModel::EngineType::MME, 1);
+            }
+            else if (HabanaGraph::runsOnTPC(n))
+            {
+                duration = NodeDuration(NodeCostModel::EngineType::TPC, 1);
+            }
+            else
+            {
+                duration = NodeDuration(n->isDma() ? NodeCostModel::EngineType::DMA
+                                                   : NodeCostModel::EngineType::INVALID,
+                                        1);
+            }
+        }
+        m_nodeDurations.emplace(n, duration.value());
+    }
+}
+
+MemoryAwareScheduler::CandidateMetrics MemoryAwareScheduler::evaluate(const NodeList& schedule) const
+{
+    CandidateMetrics metrics;
+
+    // Each engine runs its nodes in the schedule order, once their producers are done
+    std::array<double, static_cast<size_t>(NodeCostModel::EngineType::ENGINES_NR) + 1> engineEnd {};
+    std::unordered_map<NodePtr, double>                                                nodeEnd;
+    // The same lifetimes as the liveness analysis: from the first to the last node using the tensor, inclusive
+    std::unordered_map<TensorPtr, std::pair<unsigned, unsigned>> lifetimes;
+    std::unordered_map<TensorPtr, uint64_t>                      sizes;
+
+    unsigned idx = 0;
+    for (const NodePtr& n : schedule)
+    {
+        const auto durationIt = m_nodeDurations.find(n);
+        const auto [engine, duration]  = durationIt != m_nodeDurations.end()
+                                             ? durationIt->second
+                                             : NodeDuration(NodeCostModel::EngineType::INVALID, 0);
+        double start = engineEnd[static_cast<size_t>(engine)];
+        for (const NodePtr& blocking : getBlockingNodes(n))
+        {
+            const auto it = nodeEnd.find(blocking);
+            if (it != nodeEnd.end()) start = std::max(start, it->second);
+        }
+        const double end = start + duration;
+        nodeEnd[n]       = end;
+        if (duration > 0) engineEnd[static_cast<size_t>(engine)] = end;
+        metrics.criticalPath = std::max(metrics.criticalPath, end);
+
+        const auto tensorsIt = m_nodeWorkspaceTensors.find(n);
+        if (tensorsIt != m_nodeWorkspaceTensors.end())
+        {
+            for (const auto& [tensor, size] : tensorsIt->second)
+            {
+                auto [it, inserted] = lifetimes.emplace(tensor, std::make_pair(idx, idx));
+                if (!inserted) it->second.second = idx;
+                sizes[tensor] = size;
+            }
+        }
+        idx++;
+    }
+
+    std::vector<int64_t> usedMemDelta(schedule.size() + 1, 0);
+    for (const auto& [tensor, lifetime] : lifetimes)
+    {
+        usedMemDelta[lifetime.first] += sizes.at(tensor);
+        usedMemDelta[lifetime.second + 1] -= sizes.at(tensor);
+    }
+    int64_t usedMem = 0;
+    for (int64_t delta : usedMemDelta)
+    {
+        usedMem += delta;
+        metrics.peakLiveBytes = std::max<uint64_t>(metrics.peakLiveBytes, usedMem);
+    }
+    return metrics;
+}
+
+NodeList MemoryAwareScheduler::scheduleWithMemoryWeight(const MaxPathMap& maxPath, double memoryWeight) const
+{
+    MaxPathNodeComparator         maxPathCompare(maxPath, FreeNodesContainer::defaultCompare);
+    MemoryAwareFreeNodesContainer freeNodes(maxPathCompare, maxPath, m_nodeWorkspaceTensors, memoryWeight);
+    return MaxPathScheduler::getTopoSortedNodes(freeNodes);
+}
+
+NodeList MemoryAwareScheduler::scheduleNodes()
+{
+    const uint64_t   budget          = GCFG_MEMORY_AWARE_SCHEDULE_BUDGET.value();
+    const double     memoryWeight    = GCFG_MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT.value();
+    const unsigned   numOfCandidates = std::max<uint64_t>(GCFG_MEMORY_AWARE_SCHEDULE_CANDIDATES.value(), 2);
+    const MaxPathMap maxPath         = createMaxPathMap();
+
+    std::vector<NodeList>         candidates;
+    std::vector<CandidateMetrics> metrics;
+    std::vector<double>           weights;
+    for (unsigned i = 0; i < numOfCandidates; i++)
+    {
+        const double weight = static_cast<double>(i) / (numOfCandidates - 1);
+        candidates.push_back(weight == 0 ? GaudiMaxPathScheduler::scheduleNodes()
+                                         : scheduleWithMemoryWeight(maxPath, weight));
+        metrics.push_back(evaluate(candidates.back()));
+        weights.push_back(weight);
+        LOG_INFO(SCHEDULER,
+                 "Memory-aware schedule candidate {} (memory weight {:.2f}): critical path {:.2f}, peak live bytes {}",
+                 i,
+                 weight,
+                 metrics.back().criticalPath,
+                 metrics.back().peakLiveBytes);
+    }
+
+    double   minCriticalPath = std::numeric_limits<double>::max();
+    uint64_t minPeak         = std::numeric_limits<uint64_t>::max();
+    for (const CandidateMetrics& m : metrics)
+    {
+        minCriticalPath = std::min(minCriticalPath, m.criticalPath);
+        minPeak         = std::min(minPeak, m.peakLiveBytes);
+    }
+    auto cost = [&](const CandidateMetrics& m) {
+        return (1 - memoryWeight) * m.criticalPath / std::max(minCriticalPath, 1e-9) +
+               memoryWeight * static_cast<double>(m.peakLiveBytes) / std::max<uint64_t>(minPeak, 1);
+    };
+    auto isBetter = [&](const CandidateMetrics& a, const CandidateMetrics& b) {
+        if (budget == 0) return cost(a) < cost(b);
+        const bool aFits = a.peakLiveBytes <= budget;
+        const bool bFits = b.peakLiveBytes <= budget;
+        if (aFits != bFits) return aFits;
+        if (!aFits) return a.peakLiveBytes < b.peakLiveBytes;
+        if (a.criticalPath != b.criticalPath) return a.criticalPath < b.criticalPath;
+        return a.peakLiveBytes < b.peakLiveBytes;
+    };
+
+    size_t chosen = 0;
+    for (size_t i = 1; i < candidates.size(); i++)
+    {
+        if (isBetter(metrics[i], metrics[chosen])) chosen = i;
+    }
+    if (budget != 0 && metrics[chosen].peakLiveBytes > budget)
+    {
+        LOG_WARN(SCHEDULER,
+                 "No schedule fits the memory budget {}, the smallest peak live bytes is {}",
+                 budget,
+                 metrics[chosen].peakLiveBytes);
+    }
+    LOG_INFO(SCHEDULER,
+             "Memory-aware schedule chose candidate {} (memory weight {:.2f}): critical path {:.2f} (max-path {:.2f}), "
+             "peak live bytes {} (max-path {})",
+             chosen,
+             weights[chosen],
+             metrics[chosen].criticalPath,
+             metrics.front().criticalPath,
+             metrics[chosen].peakLiveBytes,
+             metrics.front().peakLiveBytes);
+    return std::move(candidates[chosen]);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "gaudi_max_path_scheduler.h"
+#include "node_cost_model.h"
+
+#include <unordered_map>
+#include <vector>
+
+class HabanaGraph;
+
+/**
+ * Max-path scheduler which co-optimizes the device critical path and the peak of the live workspace bytes
+ *
+ * Every candidate is a list schedule of the Gaudi max-path scheduler, where each free node is scored by its max path
+ * to the graph exit and by the net workspace bytes its execution adds (its first-used tensors) or releases (the tensors
+ * it is the last user of), mixed by the candidate memory weight. The candidate of weight 0 is the max-path schedule.
+ * Each candidate is measured by its device critical path - an in-order run of the engine queues with the node cost
+ * model durations - and by its peak live workspace bytes, as ForceDramAllocLivenessAnalysis::getUsedMem counts them.
+ * Within MEMORY_AWARE_SCHEDULE_BUDGET the fastest candidate is chosen; without a budget, the one with the lowest cost
+ * weighted by MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT; when no candidate fits the budget, the smallest.
+ * GaudiScheduler uses it in place of the max-path scheduler, so only for the graphs that one takes (no MME nodes,
+ * bundles or multibuffered tensors, see GaudiScheduler::isValidGraphForMaxPath).
+ */
+class MemoryAwareScheduler : public GaudiMaxPathScheduler
+{
+public:
+    struct CandidateMetrics
+    {
+        double   criticalPath  = 0;  // In the node cost model units (usec), or in nodes when it is not available
+        uint64_t peakLiveBytes = 0;
+    };
+    // The distinct real workspace tensors of every node, with their write space
+    using NodeWorkspaceTensors = std::unordered_map<NodePtr, std::vector<std::pair<TensorPtr, uint64_t>>>;
+
+    MemoryAwareScheduler(const Graph*            graph,
+                         const ConnectivityFunc& getBlockingNodes,
+                         const ConnectivityFunc& getBlockedNodes);
+
+    NodeList scheduleNodes() override;
+
+    CandidateMetrics evaluate(const NodeList& schedule) const;
+
+private:
+    using NodeDuration = std::pair<NodeCostModel::EngineType, double>;
+
+    NodeList scheduleWithMemoryWeight(const MaxPathMap& maxPath, double memoryWeight) const;
+    void     collectWorkspaceTensors();
+    void     collectNodeDurations();
+
+    const HabanaGraph*                        m_habanaGraph;
+    NodeWorkspaceTensors                      m_nodeWorkspaceTensors;
+    std::unordered_map<NodePtr, NodeDuration> m_nodeDurations;
+};
@@ -7,6 +7,7 @@
 
 #include "utils.h"
 #include "timer.h"
+#include "workspace_planner.h"
 
 #define LOG_PRINT_STATUS LOG_DEBUG
 // #define LOG_PRINT_STATUS        LOG_ERR
@@ -38,6 +39,10 @@ HeapAllocatorBase<RangeT>::HeapAllocatorBase(const HeapAllocatorBase<RangeT>& ot
   m_stat(other.m_stat),
   m_threadSafe(other.m_threadSafe)
 {
+    for (auto iter = m_freeRanges.begin(); iter != m_freeRanges.end(); ++iter)
+    {
+        m_freeRangesByBase.emplace_hint(m_freeRangesByBase.end(), iter->base, iter);
+    }
 }
 
 template<class RangeT>
@@ -51,8 +56,8 @@ void HeapAllocatorBase<RangeT>::Init(uint64_t memorySize, deviceAddrOffset base)
     allRanges.size = m_memorySize;
     allRanges.base = m_base;
 
-    m_freeRanges.push_back(allRanges);
-    insertRange(m_freeRanges.begin());
+    insertFreeRange(m_freeRanges.end(), allRanges);
+    LOG_TRACE(HEAP_ALLOC, "trace {} init {} 0x{:x}", m_name, m_memorySize, m_base);
 }
 
 template<class RangeT>
@@ -62,25 +67,74 @@ void HeapAllocatorBase<RangeT>::collectStatistics(StatPoints point, uint64_t sum
 }
 
 template<class RangeT>
-bool HeapAllocatorBase<RangeT>::allocateReqRange(const Range& reqRange, unsigned pad)
+typename HeapAllocatorBase<RangeT>::freeListIterT HeapAllocatorBase<RangeT>::insertFreeRange(freeListIterT pos,
+                                                                                             const RangeT& range)
 {
-    HEAP_ALLOCATOR_LOCK();
+    auto iter = m_freeRanges.insert(pos, range);
+    m_freeRangesByBase.emplace(iter->base, iter);
+    insertRange(iter);
+    return iter;
+}
+
+template<class RangeT>
+void HeapAllocatorBase<RangeT>::eraseFreeRange(freeListIterT iter)
+{
+    removeRange(iter);
+    m_freeRangesByBase.erase(iter->base);
+    m_freeRanges.erase(iter);
+}
+
+template<class RangeT>
+void HeapAllocatorBase<RangeT>::resizeFreeRange(freeListIterT iter, uint64_t base, uint64_t size)
+{
+    removeRange(iter);
+    if (iter->base != base)
+    {
+        // A free range never grows or shrinks over its neighbours, so the new base is not taken
+        auto node  = m_freeRangesByBase.extract(iter->base);
+        node.key() = base;
+        m_freeRangesByBase.insert(std::move(node));
+    }
+    iter->base = base;
+    iter->size = size;
+    insertRange(iter);
+}
 
-    for (auto rangesIter = m_freeRanges.begin(); rangesIter != m_freeRanges.end(); ++rangesIter)
+template<class RangeT>
+typename HeapAllocatorBase<RangeT>::freeRangesIndexT::const_iterator
+HeapAllocatorBase<RangeT>::findFreeRangeByAddress(deviceAddrOffset address) const
+{
+    auto next = m_freeRangesByBase.upper_bound(address);
+    if (next != m_freeRangesByBase.begin())
     {
-        Range& range = *rangesIter;
-        if (rangeContainedIn(reqRange, range))
+        auto prev = std::prev(next);
+        if (prev->second->base + prev->second->size >= address)
         {
-            setCandidateOneAfter(rangesIter);
-            allocateRangeI(reqRange, rangesIter);
-            m_occupiedRanges[reqRange.base + pad] = reqRange;
-            m_currentlyUsed += reqRange.size;
-            _PrintStatus();
-            // Reset the current free ranges iterator if needed
-            wrapCandidateIfEnd();
-            return true;
+            return prev;
         }
     }
+    return next;
+}
+
+template<class RangeT>
+bool HeapAllocatorBase<RangeT>::allocateReqRange(const Range& reqRange, unsigned pad)
+{
+    HEAP_ALLOCATOR_LOCK();
+    LOG_TRACE(HEAP_ALLOC, "trace {} reqrange 0x{:x} {} {}", m_name, reqRange.base, reqRange.size, pad);
+
+    auto indexIter = findFreeRangeByAddress(reqRange.base);
+    if (indexIter != m_freeRangesByBase.end() && rangeContainedIn(reqRange, *indexIter->second))
+    {
+        freeListIterT rangesIter = indexIter->second;
+        setCandidateOneAfter(rangesIter);
+        allocateRangeI(reqRange, rangesIter);
+        m_occupiedRanges[reqRange.base + pad] = reqRange;
+        m_currentlyUsed += reqRange.size;
+        _PrintStatus();
+        // Reset the current free ranges iterator if needed
+        wrapCandidateIfEnd();
+        return true;
+    }
 
     LOG_ERR(HEAP_ALLOC,
             "{}: requested range (base = 0x{:x} size = {}) was not found in current free ranges",
@@ -108,40 +162,146 @@ void HeapAllocatorBase<RangeT>::allocateRangeI(const Range&
         if (fromRange.size == reqRange.size)
         {
             // 1) Allocated range same as free range
-            removeRange(rangesIter);
-            m_freeRanges.erase(rangesIter);
+            eraseFreeRange(rangesIter);
         }
         else
         {
             if (fromRange.base == reqRange.base)
             {
                 // 2) Allocated range start at the same address as the free but is smaller -> leftover at the end
-                fromRange.base += reqRange.size;
-                fromRange.size -= reqRange.size;
-                resizeRange(rangesIter);
+                resizeFreeRange(rangesIter, fromRange.base + reqRange.size, fromRange.size - reqRange.size);
             }
             else if ((fromRange.base + fromRange.size) == (reqRange.base + reqRange.size))
             {
                 // 3) Allocated range ends  at the same address as the free but is smaller
-                fromRange.size -= reqRange.size;
-                resizeRange(rangesIter);
+                resizeFreeRange(rangesIter, fromRange.base, fromRange.size - reqRange.size);
             }
             else
             {
                 // 4) Allocated range in the middile of the free range
-                Range newRange;
-                newRange.base  = reqRange.base + reqRange.size;
-                newRange.size  = fromRange.base + fromRange.size - newRange.base;
-                fromRange.size = reqRange.base - fromRange.base;
-                auto newIter   = m_freeRanges.insert(std::next(rangesIter), newRange);
-
-                resizeRange(rangesIter);
-                insertRange(newIter);
+                RangeT newRange;
+                newRange.base = reqRange.base + reqRange.size;
+                newRange.size = fromRange.base + fromRange.size - newRange.base;
+
+                resizeFreeRange(rangesIter, fromRange.base, reqRange.base - fromRange.base);
+                insertFreeRange(std::next(rangesIter), newRange);
             }
         }
     }
 }
 
+template<class RangeT>
+std::pair<Settable<deviceAddrOffset>, uint64_t> HeapAllocatorBase<RangeT>::allocateRequestedRange(
+    uint64_t         size,
+    uint64_t         alignment,
+    uint64_t         offset,
+    deviceAddrOffset requestedAddress)
+{
+    const uint64_t allocationSize = size + offset;
+
+    // Validate padding - no padding allowed on a requested-address
+    const uint64_t pad = _CalculatePadding(requestedAddress, alignment);
+    // Not sure that there is sense for allowing offset either
+    if (pad != 0)
+    {
+        LOG_WARN(HEAP_ALLOC, "Requested address must be aligned, but requires padding {}", pad);
+        return {Settable<deviceAddrOffset>(), 0};
+    }
+
+    // The candidate is the last free range that starts at or before the requested address
+    auto nextByBase = m_freeRangesByBase.upper_bound(requestedAddress);
+    if (nextByBase == m_freeRangesByBase.begin())
+    {
+        LOG_DEBUG(HEAP_ALLOC,
+                  "Failed to allocate requested adress. Minimum free address is 0x{:x}",
+                  m_freeRanges.front().base);
+        return {Settable<deviceAddrOffset>(), 0};
+    }
+    typename std::list<RangeT>::iterator candidateFreeRangeIter = std::prev(nextByBase)->second;
+    typename std::list<RangeT>::iterator nextFreeRangeIter      = std::next(candidateFreeRangeIter);
+
+    uint64_t candidateRageStartAddress = candidateFreeRangeIter->base;
+    uint64_t candidateRageEndAddress   = candidateRageStartAddress + candidateFreeRangeIter->size;
+    uint64_t requestedRangeBaseAddress = requestedAddress - offset;
+    uint64_t requestedRangeEndAddress  = requestedRangeBaseAddress + allocationSize;
+
+    if (candidateRageEndAddress < requestedRangeEndAddress)
+    {
+        LOG_DEBUG(HEAP_ALLOC,
+                  "Failed to allocate requested adress due to out-of-range (required 0x{:x} available 0x{:x})",
+                  requestedRangeEndAddress,
+                  candidateRageEndAddress);
+        return {Settable<deviceAddrOffset>(), 0};
+    }
+
+    // For simplicity (in general, when dealing with requested addresses, we probably just don't care about the
+    //  other mechanism... at the moment)
+    incCandidateIfSame(candidateFreeRangeIter);
+
+    // create new range (leftovers from candidate range) - post requested range
+    if (requestedRangeEndAddress < candidateRageEndAddress)
+    {
+        RangeT postReuqestedRangeLeftover;
+
+        postReuqestedRangeLeftover.base = requestedRangeEndAddress;
+        postReuqestedRangeLeftover.size = candidateRageEndAddress - postReuqestedRangeLeftover.base;
+
+        insertFreeRange(nextFreeRangeIter, postReuqestedRangeLeftover);
+    }
+
+    // the candidate range is left with the leftover before the requested range, if any
+    if (candidateRageStartAddress < requestedRangeBaseAddress)
+    {
+        resizeFreeRange(candidateFreeRangeIter,
+                        candidateRageStartAddress,
+                        requestedRangeBaseAddress - candidateRageStartAddress);
+    }
+    else
+    {
+        eraseFreeRange(candidateFreeRangeIter);
+    }
+
+    RangeT requestedRange;
+    requestedRange.base = requestedRangeBaseAddress;
+    requestedRange.size = allocationSize;
+
+    Settable<deviceAddrOffset> addr;
+    addr = requestedRangeBaseAddress + offset;
+
+    LOG_DEBUG(HEAP_ALLOC, "Allocate HEAP at addr 0x{:x}, size 0x{:x}", addr.value(), allocationSize);
+    HB_ASSERT(requestedRangeBaseAddress + allocationSize <= m_base + m_memorySize,
+              "Allocation outside of memory range");
+
+    m_occupiedRanges[addr.value()] = requestedRange;
+    m_currentlyUsed += requestedRange.size;
+    _PrintStatus();
+
+    return {addr, requestedRange.size};
+}
+
+template<class RangeT>
+Settable<deviceAddrOffset> HeapAllocatorBase<RangeT>::AllocateAt(uint64_t         size,
+                                                                 uint64_t         alignment,
+                                                                 uint64_t         offset,
+                                                                 deviceAddrOffset address,
+                                                                 bool             allowFailure /* = false*/)
+{
+    {
+        HEAP_ALLOCATOR_LOCK();
+        if (m_memorySize != m_currentlyUsed)
+        {
+            setNextCandidate();
+            Settable<deviceAddrOffset> addr = allocateRequestedRange(size, alignment, offset, address).first;
+            if (addr.is_set())
+            {
+                LOG_TRACE(HEAP_ALLOC, "trace {} alloc_at {} {} {} 0x{:x}", m_name, size, alignment, offset, address);
+                return addr;
+            }
+        }
+    }
+    return Allocate(size, alignment, offset, allowFailure);
+}
+
 template<class RangeT>
 Settable<deviceAddrOffset> HeapAllocatorBase<RangeT>::Allocate(uint64_t size,
                                                                uint64_t alignment /* = 128*/,
@@ -150,6 +310,16 @@ Settable<deviceAddrOffset> HeapAllocatorBase<RangeT>::Allocate(uint64_t size,
                                                                uint64_t requestedAddress /* = 0 */)
 {
     auto x = AllocateReturnInfo(size, alignment, offset, allowFailure, requestedAddress);
+    // Allocation traces can be replayed by heap_allocator_benchmark
+    LOG_TRACE(HEAP_ALLOC,
+              "trace {} alloc {} {} {} {} 0x{:x} {}",
+              m_name,
+              size,
+              alignment,
+              offset,
+              allowFailure,
+              requestedAddress,
+              x.first.is_set() ? fmt::format("0x{:x}", x.first.value()) : "-");
     return x.first;
 }
 
@@ -179,140 +349,13 @@ HeapAllocatorBase<RangeT>::AllocateReturnInfo(uint64_t size,
     uint64_t allocationSize = size + offset;
     uint64_t pad            = 0;
 
-    typename std::list<RangeT>::iterator freeRangeIter;
-
     setNextCandidate();
 
-    do
+    if (requestedAddress != 0)
     {
-        if (requestedAddress == 0)
-        {
-            break;
-        }
-
-        // Validate padding - no padding allowed on a requested-address
-        pad = _CalculatePadding(requestedAddress, alignment);
-        // Not sure that there is sense for allowing offset either
-        if (pad != 0)
-        {
-            LOG_WARN(HEAP_ALLOC, "Requested address must be aligned, but requires padding {}", pad);
-            break;
-        }
-
-        freeRangeIter = m_freeRanges.begin();
-
-        while (freeRangeIter != m_freeRanges.end())
-        {
-            if (freeRangeIter->base > requestedAddress)
-            {
-                break;
-            }
-            ++freeRangeIter;
-        }
-
-        typename std::list<RangeT>::iterator candidateFreeRangeIter = freeRangeIter;
-        typename std::list<RangeT>::iterator nextFreeRangeIter      = m_freeRanges.end();
-
-        if (freeRangeIter == m_freeRanges.begin())
-        {
-            if (freeRangeIter->base > requestedAddress)
-            {
-                LOG_DEBUG(HEAP_ALLOC,
-                          "Failed to allocate requested adress. Minimum free address is 0x{:x}",
-                          freeRangeIter->base);
-                break;
-            }
-
-            if (freeRangeIter != m_freeRanges.end())
-            {
-                nextFreeRangeIter = ++freeRangeIter;
-            }
-        }
-        else
-        {
-            nextFreeRangeIter      = freeRangeIter;
-            candidateFreeRangeIter = std::prev(freeRangeIter);
-        }
-
-        uint64_t candidateRageStartAddress = candidateFreeRangeIter->base;
-        uint64_t candidateRageEndAddress   = candidateRageStartAddress + candidateFreeRangeIter->size;
-        uint64_t requestedRangeBaseAddress = requestedAddress - offset;
-        uint64_t requestedRangeEndAddress  = requestedRangeBaseAddress + allocationSize;
-
-        if (candidateRageEndAddress < requestedRangeEndAddress)
-        {
-            LOG_DEBUG(HEAP_ALLOC,
-                      "Failed to allocate requested adress due to out-of-range (required 0x{:x} available 0x{:x})",
-                      requestedRangeEndAddress,
-                      candidateRageEndAddress);
-            break;
-        }
-
-        // For simplicity (in general, when dealing with requested addresses, we probably just don't care about the
-        //  other mechanism... at the moment)
-        incCandidateIfSame(candidateFreeRangeIter);
-
-        // create new range (leftovers from candidate range) - post requested range
-        if (requestedRangeEndAddress < candidateRageEndAddress)
-        {
-            RangeT postReuqestedRangeLeftover;
-
-            postReuqestedRangeLeftover.base = requestedRangeEndAddress;
-            postReuqestedRangeLeftover.size = candidateRageEndAddress - postReuqestedRangeLeftover.base;
-
-            if (nextFreeRangeIter != m_freeRanges.end())
-            {
-                nextFreeRangeIter = m_freeRanges.insert(nextFreeRangeIter, postReuqestedRangeLeftover);
-                insertRange(nextFreeRangeIter);
-            }
-            else
-            {
-                m_freeRanges.push_back(postReuqestedRangeLeftover);
-                nextFreeRangeIter = std::prev(m_freeRanges.end());
-                insertRange(nextFreeRangeIter);
-            }
-        }
-
-        // create new range (leftovers from candidate range) - pre requested range
-        if (candidateRageStartAddress < requestedRangeBaseAddress)
-        {
-            RangeT preReuqestedRangeLeftover;
-
-            preReuqestedRangeLeftover.base = candidateRageStartAddress;
-            preReuqestedRangeLeftover.size = requestedRangeBaseAddress - preReuqestedRangeLeftover.base;
-
-            if (nextFreeRangeIter != m_freeRanges.end())
-            {
-                auto iter = m_freeRanges.insert(nextFreeRangeIter, preReuqestedRangeLeftover);
-                insertRange(iter);
-            }
-            else
-            {
-                m_freeRanges.push_back(preReuqestedRangeLeftover);
-                auto iter = std::prev(m_freeRanges.end());
-                insertRange(iter);
-            }
-        }
-
-        RangeT requestedRange;
-        requestedRange.base = requestedRangeBaseAddress;
-        requestedRange.size = allocationSize;
-
-        Settable<deviceAddrOffset> addr;
-        addr = requestedRangeBaseAddress + offset;
-        removeRange(candidateFreeRangeIter);
-        m_freeRanges.erase(candidateFreeRangeIter);
-
-        LOG_DEBUG(HEAP_ALLOC, "Allocate HEAP at addr 0x{:x}, size 0x{:x}", addr.value(), allocationSize);
-        HB_ASSERT(requestedRangeBaseAddress + allocationSize <= m_base + m_memorySize,
-                  "Allocation outside of memory range");
-
-        m_occupiedRanges[addr.value()] = requestedRange;
-        m_currentlyUsed += requestedRange.size;
-        _PrintStatus();
-
-        return {addr, requestedRange.size};
-    } while (0);
+        auto requested = allocateRequestedRange(size, alignment, offset, requestedAddress);
+        if (requested.first.is_set()) return requested;
+    }
 
     // use aligned size allocations to be consistent with outside code tensor size calculations.
     // should almost not increase memory consumption, but ease interaction with outside code.
@@ -348,6 +391,7 @@ HeapAllocatorBase<RangeT>::AllocateReturnInfo(uint64_t size,
 template<class RangeT>
 void HeapAllocatorBase<RangeT>::Free(deviceAddrOffset ptr)
 {
+    LOG_TRACE(HEAP_ALLOC, "trace {} free 0x{:x}", m_name, ptr);
     FreeReturnInfo(ptr);
 }
 
@@ -380,29 +424,19 @@ uint64_t HeapAllocatorBase<RangeT>::FreeReturnInfo(deviceAddrOffset ptr)
     // Attempt to coalesce the freed allocation
     // Find the two adjacent allocations
     deviceAddrOffset allocationEnd = allocation.base + allocation.size;
-    auto             next          = m_freeRanges.begin();
-    while (next != m_freeRanges.end())
-    {
-        if (next->base >= allocationEnd)
-        {
-            break;
-        }
-        ++next;
-    }
+    auto             nextByBase    = m_freeRangesByBase.lower_bound(allocationEnd);
+    auto             next          = nextByBase != m_freeRangesByBase.end() ? nextByBase->second : m_freeRanges.end();
     // Corner case: no previous allocation
     if (next == m_freeRanges.begin())
     {
         if (next != m_freeRanges.end() && allocationEnd == next->base)
         {
             // can coalesce, increase the first range by <allocation size>
-            next->base -= allocation.size;
-            next->size += allocation.size;
-            resizeRange(next);
+            resizeFreeRange(next, next->base - allocation.size, next->size + allocation.size);
         }
         else
         {
-            m_freeRanges.push_front(allocation);
-            insertRange(m_freeRanges.begin());
+            insertFreeRange(m_freeRanges.begin(), allocation);
         }
         _PrintStatus();
         collectStatistics(StatPoints::free, TimeTools::timeFromNs(freeStart));
@@ -413,32 +447,26 @@ uint64_t HeapAllocatorBase<RangeT>::FreeReturnInfo(deviceAddrOffset ptr)
     // attempt to fuse with prev
     if (prev->base + prev->size == allocation.base)
     {
-        prev->size += allocation.size;
-        resizeRange(prev);
+        uint64_t fusedSize = prev->size + allocation.size;
         // Potentially add next
         if ((next != m_freeRanges.end()) && (allocationEnd == next->base))
         {
             // Double fuse
-            // m_freeCont.rezise(range);
-            prev->size += next->size;
-            resizeRange(prev);
+            fusedSize += next->size;
             incCandidateIfSame(next);
-            removeRange(next);
-            m_freeRanges.erase(next);
+            eraseFreeRange(next);
         }
+        resizeFreeRange(prev, prev->base, fusedSize);
     }
     // attempt to fuse with next
     else if ((next != m_freeRanges.end()) && (allocationEnd == next->base))
     {
-        next->base -= allocation.size;
-        next->size += allocation.size;
-        resizeRange(next);
+        resizeFreeRange(next, next->base - allocation.size, next->size + allocation.size);
     }
     // No possible coalescing
     else
     {
-        auto itr = m_freeRanges.insert(next, allocation);
-        insertRange(itr);
+        insertFreeRange(next, allocation);
     }
     collectStatistics(StatPoints::free, TimeTools::timeFromNs(freeStart));
     _PrintStatus();
@@ -479,6 +507,23 @@ Range HeapAllocatorBase<RangeT>::getMaxFreeRange() const
     return maxRange;
 }
 
+HeapAllocator::HeapAllocator(const HeapAllocator& other)
+: HeapAllocatorBase(other),
+  m_freeRangesIterator(m_freeRanges.end()),
+  m_cyclicAllocation(other.m_cyclicAllocation),
+  m_bestFitAllocation(other.m_bestFitAllocation)
+{
+    for (auto iter = m_freeRanges.begin(); iter != m_freeRanges.end(); ++iter)
+    {
+        insertRange(iter);
+    }
+    // Point at the same range as the copied allocator, in the copied list
+    if (other.m_freeRangesIterator != other.m_freeRanges.end())
+    {
+        m_freeRangesIterator = m_freeRangesByBase.at(other.m_freeRangesIterator->base);
+    }
+}
+
 std::unique_ptr<MemoryAllocator> HeapAllocator::Clone()
 {
     HEAP_ALLOCATOR_LOCK();
@@ -646,30 +691,15 @@ HeapAllocatorBase<RangeT>::GetStartOfFreeRangeContaningOffset(const deviceAddrOf
     tmpRange.base = offset;
     tmpRange.size = 0;
 
-    for (auto rangesIter = m_freeRanges.begin(); rangesIter != m_freeRanges.end(); ++rangesIter)
+    auto indexIter = findFreeRangeByAddress(offset);
+    if (indexIter != m_freeRangesByBase.end() && rangeContainedIn(tmpRange, *indexIter->second))
     {
-        Range range = *rangesIter;
-
-        if (rangeContainedIn(tmpRange, range))
-        {
-            result.set(range.base);
-            break;
-        }
+        result.set(indexIter->second->base);
     }
 
     return result;
 }
 
-void HeapAllocator::_AdvanceFreeRangeIterator()
-{
-    ++m_freeRangesIterator;
-    // Reset the current free ranges iterator if needed
-    if (m_freeRangesIterator == m_freeRanges.end())
-    {
-        m_freeRangesIterator = m_freeRanges.begin();
-    }
-}
-
 template<class RangeT>
 void HeapAllocatorBase<RangeT>::_AllocateRange(typename std::list<RangeT>::iterator itr,
                                                uint64_t                    allocationSize,  // size + pad + offset
@@ -690,16 +720,12 @@ void HeapAllocatorBase<RangeT>::_AllocateRange(typename std::list<RangeT>::itera
     if (itr->size == newAllocation.size)
     {
         // Update free ranges iterator before deleting in order to preserve valid iterator
-        auto toBeErasedIterator = itr;
         incCandidateIfSame(itr);
-        removeRange(toBeErasedIterator);
-        m_freeRanges.erase(toBeErasedIterator);
+        eraseFreeRange(itr);
     }
     else
     {
-        itr->base += newAllocation.size;
-        itr->size -= newAllocation.size;
-        resizeRange(itr);
+        resizeFreeRange(itr, itr->base + newAllocation.size, itr->size - newAllocation.size);
     }
     m_currentlyUsed += newAllocation.size;
     _PrintStatus();
@@ -734,38 +760,134 @@ void HeapAllocator::incCandidateIfSame(typename std::list<Range>::iterator itr)
     if (itr == m_freeRangesIterator) m_freeRangesIterator++;
 }
 
+void HeapAllocator::removeRange(freeListIterT iter)
+{
+    m_freeRangesBySizeClass[getSizeClass(iter->size)].erase(iter->base);
+}
+
+void HeapAllocator::insertRange(freeListIterT iter)
+{
+    m_freeRangesBySizeClass[getSizeClass(iter->size)].emplace(iter->base, iter);
+}
+
 std::list<Range>::iterator HeapAllocator::findRange(uint64_t allocationSize, uint64_t alignment)
 {
-    auto                                 lastUsedRangeIterator = m_freeRangesIterator;
-    uint64_t                             paddedAllocationSize  = 0;
-    int                                  cnt                   = 0;
-    Settable<std::list<Range>::iterator> bestFitRange;
-    do
+    return m_bestFitAllocation ? findBestFit(allocationSize, alignment) : findFirstFit(allocationSize, alignment);
+}
+
+// The first range that fits, in address order starting from the candidate and wrapping around. The cyclic distance of
+// a range from the candidate is (base - candidateBase) in unsigned arithmetic.
+std::list<Range>::iterator HeapAllocator::findFirstFit(uint64_t allocationSize, uint64_t alignment)
+{
+    const deviceAddrOffset               candidateBase = m_freeRangesIterator->base;
+    Settable<std::list<Range>::iterator> firstFitRange;
+    uint64_t                             firstFitDistance = 0;
+    int                                  cnt              = 0;
+
+    // Smaller classes only hold ranges smaller than the allocation
+    for (unsigned sizeClass = getSizeClass(allocationSize); sizeClass < NUM_SIZE_CLASSES; sizeClass++)
     {
-        cnt++;
-        Range& range = *m_freeRangesIterator;
+        const freeRangesIndexT& ranges = m_freeRangesBySizeClass[sizeClass];
+        auto                    iter   = ranges.lower_bound(candidateBase);
+        for (size_t i = 0; i < ranges.size(); i++, iter++)
+        {
+            if (iter == ranges.end()) iter = ranges.begin();
 
-        // calculate size including alignment
-        uint64_t pad         = _CalculatePadding(range.base, alignment);
-        paddedAllocationSize = allocationSize + pad;
+            const uint64_t distance = iter->first - candidateBase;
+            if (firstFitRange.is_set() && distance >= firstFitDistance) break;
+
+            cnt++;
+            const Range& range = *iter->second;
+            if (range.size >= allocationSize + _CalculatePadding(range.base, alignment))
+            {
+                firstFitRange    = iter->second;
+                firstFitDistance = distance;
+                break;
+            }
+        }
+    }
+
+    if (!firstFitRange.is_set()) return m_freeRanges.end();
 
-        if (range.size >= paddedAllocationSize)
+    collectStatistics(StatPoints::triesToFind, cnt);
+    m_freeRangesIterator = firstFitRange.value();
+    return m_freeRangesIterator;
+}
+
+// The smallest range that fits, the first one from the candidate among equal ones. A range that fits exactly (with the
+// alignment padding) is taken first, even when a smaller range that needs less padding fits as well.
+// Each class is ordered by address, so a visited class is scanned in full. The visited classes are those that may hold
+// an exact fit, then the larger ones up to the first one holding a fit.
+std::list<Range>::iterator HeapAllocator::findBestFit(uint64_t allocationSize, uint64_t alignment)
+{
+    const deviceAddrOffset               candidateBase     = m_freeRangesIterator->base;
+    const unsigned                       lastExactFitClass = getSizeClass(allocationSize + alignment - 1);
+    Settable<std::list<Range>::iterator> exactFitRange;
+    Settable<std::list<Range>::iterator> bestFitRange;
+    uint64_t                             exactFitDistance = 0;
+    uint64_t                             bestFitDistance  = 0;
+    int                                  cnt              = 0;
+
+    for (unsigned sizeClass = getSizeClass(allocationSize); sizeClass < NUM_SIZE_CLASSES; sizeClass++)
+    {
+        // Larger classes hold neither exact fits nor ranges smaller than the one found
+        if (sizeClass > lastExactFitClass && (exactFitRange.is_set() || bestFitRange.is_set())) break;
+
+        for (const auto& [base, iter] : m_freeRangesBySizeClass[sizeClass])
         {
-            collectStatistics(StatPoints::triesToFind, cnt);
-            if (!m_bestFitAllocation || (range.size == paddedAllocationSize))
+            cnt++;
+            const uint64_t paddedAllocationSize = allocationSize + _CalculatePadding(base, alignment);
+            if (iter->size < paddedAllocationSize) continue;
+
+            const uint64_t distance = base - candidateBase;
+            if (iter->size == paddedAllocationSize)
             {
-                return m_freeRangesIterator;
+                if (!exactFitRange.is_set() || distance < exactFitDistance)
+                {
+                    exactFitRange    = iter;
+                    exactFitDistance = distance;
+                }
             }
-            if (!bestFitRange.is_set() || (range.size < bestFitRange.value()->size))
+            else if (!bestFitRange.is_set() || iter->size < bestFitRange.value()->size ||
+                     (iter->size == bestFitRange.value()->size && distance < bestFitDistance))
             {
-                bestFitRange = m_freeRangesIterator;
+                bestFitRange    = iter;
+                bestFitDistance = distance;
             }
         }
-        _AdvanceFreeRangeIterator();
+    }
 
-    } while (m_freeRangesIterator != lastUsedRangeIterator);
+    if (exactFitRange.is_set())
+    {
+        collectStatistics(StatPoints::triesToFind, cnt);
+        m_freeRangesIterator = exactFitRange.value();
+        return m_freeRangesIterator;
+    }
+    if (bestFitRange.is_set())
+    {
+        collectStatistics(StatPoints::triesToFind, cnt);
+        return bestFitRange.value();
+    }
+    return m_freeRanges.end();
+}
 
-    return (!m_bestFitAllocation || !bestFitRange.is_set()) ? m_freeRanges.end() : bestFitRange.value();
+Range HeapAllocator::getMaxFreeRange() const
+{
+    HEAP_ALLOCATOR_LOCK();
+    // The largest range is in the highest non-empty class, the first one by address among equal ones
+    for (unsigned sizeClass = NUM_SIZE_CLASSES; sizeClass-- > 0;)
+    {
+        Range maxRange {0, 0};
+        for (const auto& [base, iter] : m_freeRangesBySizeClass[sizeClass])
+        {
+            if (iter->size > maxRange.size)
+            {
+                maxRange = *iter;
+            }
+        }
+        if (maxRange.size != 0) return maxRange;
+    }
+    return Range {0, 0};
 }
 
 void HeapAllocator::wrapCandidateIfEnd()
@@ -786,14 +908,6 @@ void HeapAllocatorBestFit::removeRange(freeListIterT iter)
     m_setBySize.erase(setIter);
 }
 
-void HeapAllocatorBestFit::resizeRange(freeListIterT iter)
-{
-    auto setIter = iter->setIter;
-    m_setBySize.erase(setIter);
-    setIter       = m_setBySize.insert(iter);
-    iter->setIter = setIter;
-}
-
 void HeapAllocatorBestFit::insertRange(freeListIterT iter)
 {
     auto setIter  = m_setBySize.insert(iter);
@@ -829,6 +943,14 @@ std::list<RangeE>::iterator HeapAllocatorBestFit::findRange(uint64_t allocationS
     return m_freeRanges.end();
 }
 
+HeapAllocatorBestFit::HeapAllocatorBestFit(const HeapAllocatorBestFit& other) : HeapAllocatorBase(other)
+{
+    for (auto iter = m_freeRanges.begin(); iter != m_freeRanges.end(); ++iter)
+    {
+        insertRange(iter);
+    }
+}
+
 std::unique_ptr<MemoryAllocator> HeapAllocatorBestFit::Clone()
 {
     HEAP_ALLOCATOR_LOCK();
@@ -890,7 +1012,8 @@ HeapAllocatorWrapper::HeapAllocatorWrapper(const HeapAllocatorWrapper& other)
   m_threadSafe(other.m_threadSafe),
   m_logStats(other.m_logStats),
   m_sectionIdxToAllocatorLivenessMap(other.m_sectionIdxToAllocatorLivenessMap),
-  m_sortedAllocatorLivenessMap(other.m_sortedAllocatorLivenessMap)
+  m_sortedAllocatorLivenessMap(other.m_sortedAllocatorLivenessMap),
+  m_workspacePlanner(other.m_workspacePlanner)
 {
     std::shared_ptr<MemoryAllocator> workspaceAllocatorClone = other.m_WSAllocator->Clone();
     m_WSAllocator = std::static_pointer_cast<HeapAllocator>(workspaceAllocatorClone);
@@ -925,7 +1048,20 @@ Settable<deviceAddrOffset> HeapAllocatorWrapper::Allocate(uint64_t size,
         }
     }
     LOG_DEBUG(HEAP_ALLOC, "allocate tensor in WS allocator tensors size 0x{:x}", size);
-    return m_WSAllocator->Allocate(size, alignment, offset, allowFailure, requestedAddress);
+    std::optional<deviceAddrOffset> plannedAddress;
+    if (m_workspacePlanner && m_workspacePlanner->getMode() == WorkspacePlanner::Mode::replay && requestedAddress == 0)
+    {
+        plannedAddress = m_workspacePlanner->getPlannedAddress(size, alignment, offset);
+    }
+    Settable<deviceAddrOffset> addr =
+        plannedAddress.has_value()
+            ? m_WSAllocator->AllocateAt(size, alignment, offset, *plannedAddress, allowFailure)
+            : m_WSAllocator->Allocate(size, alignment, offset, allowFailure, requestedAddress);
+    if (m_workspacePlanner && m_workspacePlanner->getMode() == WorkspacePlanner::Mode::record && addr.is_set())
+    {
+        m_workspacePlanner->recordAllocation(size, alignment, offset, addr.value());
+    }
+    return addr;
 }
 
 void HeapAllocatorWrapper::Free(deviceAddrOffset ptr)
@@ -934,6 +1070,10 @@ void HeapAllocatorWrapper::Free(deviceAddrOffset ptr)
     if (sectionidx == MEMORY_ID_RESERVED_FOR_WORKSPACE)
     {
         m_WSAllocator->Free(ptr);
+        if (m_workspacePlanner && m_workspacePlanner->getMode() == WorkspacePlanner::Mode::record)
+        {
+            m_workspacePlanner->recordFree(ptr);
+        }
     }
     else
     {
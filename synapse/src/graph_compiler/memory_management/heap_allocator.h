@@ -1,6 +1,8 @@
 #pragma once
+#include <array>
 #include <list>
 #include <map>
+#include <set>
 #include "memory_allocator.h"
 #include "range.h"
 #include <mutex>
@@ -8,6 +10,8 @@
 #include <optional>
 #include "liveness_analysis.h"
 
+class WorkspacePlanner;
+
 template<class RangeT>
 class HeapAllocatorBase : public MemoryAllocatorBase
 {
@@ -25,8 +29,9 @@ protected:
                                                                     {StatPoints::triesToFind, "Tries to find free"}});
 
 public:
-    using freeListT     = typename std::list<RangeT>;
-    using freeListIterT = typename freeListT::iterator;
+    using freeListT        = typename std::list<RangeT>;
+    using freeListIterT    = typename freeListT::iterator;
+    using freeRangesIndexT = std::map<deviceAddrOffset, freeListIterT>;
 
     explicit HeapAllocatorBase(const std::string& name,
                                uint32_t           statFreq,
@@ -42,6 +47,13 @@ public:
                                                 uint64_t offset           = 0,
                                                 bool     allowFailure     = false,
                                                 uint64_t requestedAddress = 0) override;
+    // Allocates at the given address, which unlike a requested address of Allocate may be 0, or as Allocate does when
+    // the address isn't free
+    Settable<deviceAddrOffset>         AllocateAt(uint64_t         size,
+                                                  uint64_t         alignment,
+                                                  uint64_t         offset,
+                                                  deviceAddrOffset address,
+                                                  bool             allowFailure = false);
     virtual void                       Free(deviceAddrOffset ptr) override;
     virtual uint64_t                   GetCurrentlyUsed() const override;
     virtual uint64_t                   getMaxFreeContiguous() const override;
@@ -68,10 +80,20 @@ protected:
 
 private:
     void allocateRangeI(const Range& reqRange, const freeListIterT& rangesIter);
+    // The lock must be held, returns an unset address when the requested range isn't free
+    std::pair<Settable<deviceAddrOffset>, uint64_t>
+    allocateRequestedRange(uint64_t size, uint64_t alignment, uint64_t offset, deviceAddrOffset requestedAddress);
+
+    // All the changes of the free ranges go through these, to keep the indices in sync with the list
+    freeListIterT insertFreeRange(freeListIterT pos, const RangeT& range);
+    void          eraseFreeRange(freeListIterT iter);
+    void          resizeFreeRange(freeListIterT iter, uint64_t base, uint64_t size);
+
+    // The first free range which ends at or after the given address (the range containing it, if any)
+    typename freeRangesIndexT::const_iterator findFreeRangeByAddress(deviceAddrOffset address) const;
 
-    // overridden by best-fit
+    // overridden by the allocators which index the free ranges by size
     virtual void removeRange(freeListIterT iter) {}
-    virtual void resizeRange(freeListIterT iter) {}
     virtual void insertRange(freeListIterT iter) {}
 
     // overridden by first-fit
@@ -94,6 +116,8 @@ protected:
 
     // A Sorted (by start address) list of free ranges
     freeListT m_freeRanges;
+    // The free ranges by their start address, for finding the neighbours of an address without walking the list
+    freeRangesIndexT m_freeRangesByBase;
     // A container for existing allocations
     std::map<deviceAddrOffset, Range> m_occupiedRanges;
 
@@ -129,23 +153,39 @@ public:
       m_cyclicAllocation(cyclicAllocation)
     {
     }
+    HeapAllocator(const HeapAllocator& other);
     virtual std::unique_ptr<MemoryAllocator> Clone() override;
     virtual void setCyclicAllocation(bool cyclicAllocation = true) { m_cyclicAllocation = cyclicAllocation; }
     virtual void setBestFitAllocation(bool bestFitAllocation) { m_bestFitAllocation = bestFitAllocation; }
 
+    virtual Range getMaxFreeRange() const override;
+
 private:
+    virtual void          removeRange(freeListIterT iter) override;
+    virtual void          insertRange(freeListIterT iter) override;
     virtual void          setNextCandidate() override;
     virtual void          incCandidateIfSame(freeListIterT itr) override;
     virtual freeListIterT findRange(uint64_t allocationSize, uint64_t alignment) override;
     virtual void          wrapCandidateIfEnd() override;
     virtual void          setCandidateOneAfter(freeListIterT itr) override { m_freeRangesIterator = std::next(itr); }
-    void                  _AdvanceFreeRangeIterator();
+
+    freeListIterT findFirstFit(uint64_t allocationSize, uint64_t alignment);
+    freeListIterT findBestFit(uint64_t allocationSize, uint64_t alignment);
+
+    static unsigned getSizeClass(uint64_t size) { return size == 0 ? 0 : 63 - __builtin_clzll(size); }
 
 private:
+    static constexpr unsigned NUM_SIZE_CLASSES = 64;
+
     // Iterator on the free ranges, to be able to consume all the memory-space before
     // reusing freed ranges.
     freeListIterT m_freeRangesIterator;
 
+    // The free ranges segregated by the log2 of their size, each class sorted by start address. The first (or best)
+    // fit is the earliest (or smallest) fitting range over the classes that may hold one, instead of a walk over all
+    // the free ranges.
+    std::array<freeRangesIndexT, NUM_SIZE_CLASSES> m_freeRangesBySizeClass;
+
     // Select between cyclic allocation (allocate sequential chunks until memory's end and only then start over),
     // to always pick the first available chunk of memory with enough space.
     bool m_cyclicAllocation = true;
@@ -159,13 +199,13 @@ class HeapAllocatorBestFit : public HeapAllocatorBase<RangeE>
 {
 public:
     HeapAllocatorBestFit(const std::string& name, uint32_t statFreq = 0) : HeapAllocatorBase(name, statFreq) {}
+    HeapAllocatorBestFit(const HeapAllocatorBestFit& other);
     virtual std::unique_ptr<MemoryAllocator> Clone() override;
 
     virtual Range getMaxFreeRange() const override;
 
 private:
     virtual void          removeRange(freeListIterT iter) override;
-    virtual void          resizeRange(freeListIterT iter) override;
     virtual void          insertRange(freeListIterT iter) override;
     virtual freeListIterT findRange(uint64_t allocationSize, uint64_t alignment) override;
 
@@ -217,6 +257,9 @@ public:
     Settable<deviceAddrOffset> GetStartOfFreeRangeContaningOffset(const deviceAddrOffset offset) const;
     virtual Range              getMaxFreeRange() const;
 
+    // The workspace allocations are recorded to, or placed at the addresses of, the planner according to its mode
+    void setWorkspacePlanner(const std::shared_ptr<WorkspacePlanner>& planner) { m_workspacePlanner = planner; }
+
 protected:
 private:
     uint32_t                                                         m_statFreq;
@@ -225,4 +268,5 @@ private:
     std::unordered_map<uint64_t, std::pair<HeapAllocator, Lifetime>> m_sectionIdxToAllocatorLivenessMap;
     std::vector<std::pair<uint64_t, uint64_t>>                       m_sortedAllocatorLivenessMap;
     std::shared_ptr<HeapAllocator>                                   m_WSAllocator;
+    std::shared_ptr<WorkspacePlanner>                                m_workspacePlanner;
 };
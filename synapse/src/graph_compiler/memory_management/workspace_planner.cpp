@@ -0,0 +1,234 @@
+#include "workspace_planner.h"
+
+#include "log_manager.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace
+{
+constexpr uint32_t         NOT_FREED  = std::numeric_limits<uint32_t>::max();
+constexpr deviceAddrOffset NOT_PLACED = std::numeric_limits<deviceAddrOffset>::max();
+
+// The lowest address from which an allocation of the interval can start at or after the given address
+deviceAddrOffset alignedAddress(const WorkspacePlanner::Interval& interval, deviceAddrOffset from)
+{
+    const uint64_t         alignment = std::max<uint64_t>(interval.alignment, 1);
+    const deviceAddrOffset addr      = from + interval.offset;
+    return (addr + alignment - 1) / alignment * alignment;
+}
+}  // anonymous namespace
+
+void WorkspacePlanner::startRecording()
+{
+    m_mode = Mode::record;
+    m_time = 0;
+    m_intervals.clear();
+    m_liveIntervals.clear();
+    m_addresses.clear();
+    m_pendingReplay.clear();
+    m_plannedPeak = 0;
+}
+
+void WorkspacePlanner::recordAllocation(uint64_t size, uint64_t alignment, uint64_t offset, deviceAddrOffset addr)
+{
+    m_liveIntervals[addr] = m_intervals.size();
+    m_intervals.push_back({size, alignment, offset, m_time++, NOT_FREED});
+}
+
+void WorkspacePlanner::recordFree(deviceAddrOffset addr)
+{
+    auto it = m_liveIntervals.find(addr);
+    if (it == m_liveIntervals.end()) return;
+    m_intervals[it->second].end = m_time++;
+    m_liveIntervals.erase(it);
+}
+
+uint64_t WorkspacePlanner::getLowerBound() const
+{
+    // Frees come before allocations of the same time, as the ends are exclusive
+    std::vector<std::pair<uint32_t, int64_t>> events;
+    events.reserve(2 * m_intervals.size());
+    for (const Interval& interval : m_intervals)
+    {
+        const int64_t size = interval.size + interval.offset;
+        events.emplace_back(interval.start, size);
+        events.emplace_back(interval.end, -size);
+    }
+    std::sort(events.begin(), events.end());
+
+    int64_t live = 0, maxLive = 0;
+    for (const auto& [time, delta] : events)
+    {
+        live += delta;
+        maxLive = std::max(maxLive, live);
+    }
+    return maxLive;
+}
+
+bool WorkspacePlanner::buildConflicts(Conflicts& conflicts, uint64_t maxConflicts) const
+{
+    // The recording times are unique and increasing, so the intervals are already sorted by their start
+    std::multimap<uint32_t, uint32_t> active;  // End to interval
+    uint64_t                          numConflicts = 0;
+    for (const Interval& interval : m_intervals)
+    {
+        active.erase(active.begin(), active.upper_bound(interval.start));
+        numConflicts += active.size();
+        if (numConflicts > maxConflicts) return false;
+        active.emplace(interval.end, 0);
+    }
+
+    conflicts.assign(m_intervals.size(), {});
+    active.clear();
+    for (uint32_t i = 0; i < m_intervals.size(); i++)
+    {
+        const Interval& interval = m_intervals[i];
+        active.erase(active.begin(), active.upper_bound(interval.start));
+        for (const auto& [end, other] : active)
+        {
+            conflicts[i].push_back(other);
+            conflicts[other].push_back(i);
+        }
+        active.emplace(interval.end, i);
+    }
+    return true;
+}
+
+uint64_t WorkspacePlanner::place(const Order&     order,
+                                 const Conflicts& conflicts,
+                                 deviceAddrOffset base,
+                                 Placement&       rPlacement) const
+{
+    rPlacement.assign(m_intervals.size(), NOT_PLACED);
+    deviceAddrOffset                                           peakEnd = base;
+    std::vector<std::pair<deviceAddrOffset, deviceAddrOffset>> placedConflicts;  // [start, end) of the ranges
+    for (uint32_t i : order)
+    {
+        const Interval& interval = m_intervals[i];
+        placedConflicts.clear();
+        for (uint32_t other : conflicts[i])
+        {
+            if (rPlacement[other] == NOT_PLACED) continue;
+            const Interval& otherInterval = m_intervals[other];
+            placedConflicts.emplace_back(rPlacement[other] - otherInterval.offset,
+                                         rPlacement[other] + otherInterval.size);
+        }
+        std::sort(placedConflicts.begin(), placedConflicts.end());
+
+        // The smallest gap between the conflicting ranges which fits the interval, or after all of them
+        deviceAddrOffset bestAddr = NOT_PLACED;
+        uint64_t         bestGap  = std::numeric_limits<uint64_t>::max();
+        deviceAddrOffset gapStart = base;
+        for (const auto& [start, end] : placedConflicts)
+        {
+            const deviceAddrOffset addr = alignedAddress(interval, gapStart);
+            if (start > gapStart && addr + interval.size <= start && start - gapStart < bestGap)
+            {
+                bestGap  = start - gapStart;
+                bestAddr = addr;
+            }
+            gapStart = std::max(gapStart, end);
+        }
+        if (bestAddr == NOT_PLACED)
+        {
+            bestAddr = alignedAddress(interval, gapStart);
+        }
+
+        rPlacement[i] = bestAddr;
+        peakEnd       = std::max(peakEnd, bestAddr + interval.size);
+    }
+    return peakEnd - base;
+}
+
+bool WorkspacePlanner::plan(deviceAddrOffset base, unsigned improvementIterations, uint64_t maxConflicts)
+{
+    m_mode = Mode::idle;
+    for (Interval& interval : m_intervals)
+    {
+        if (interval.end == NOT_FREED) interval.end = m_time;
+    }
+    m_liveIntervals.clear();
+
+    Conflicts conflicts;
+    if (!buildConflicts(conflicts, maxConflicts))
+    {
+        LOG_DEBUG(TENSORS_ALLOC,
+                  "Workspace planner: more than {} pairs of {} intervals are live together",
+                  maxConflicts,
+                  m_intervals.size());
+        return false;
+    }
+
+    Order bySize(m_intervals.size());
+    for (uint32_t i = 0; i < bySize.size(); i++)
+    {
+        bySize[i] = i;
+    }
+    auto duration = [&](uint32_t i) { return uint64_t(m_intervals[i].end - m_intervals[i].start); };
+    auto fullSize = [&](uint32_t i) { return m_intervals[i].size + m_intervals[i].offset; };
+    std::stable_sort(bySize.begin(), bySize.end(), [&](uint32_t a, uint32_t b) {
+        if (fullSize(a) != fullSize(b)) return fullSize(a) > fullSize(b);
+        return duration(a) > duration(b);
+    });
+
+    Order bestOrder = bySize;
+    m_plannedPeak   = place(bestOrder, conflicts, base, m_addresses);
+
+    // The improvement search - starts from the intervals with the largest size * lifetime, then perturbs the order
+    // of the best placement so far.
+    std::mt19937 gen(0);
+    Placement    placement;
+    for (unsigned iteration = 0; iteration < improvementIterations && m_intervals.size() > 1; iteration++)
+    {
+        Order order = bestOrder;
+        if (iteration == 0)
+        {
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return fullSize(a) * duration(a) > fullSize(b) * duration(b);
+            });
+        }
+        else
+        {
+            std::uniform_int_distribution<size_t> position(0, order.size() - 1);
+            const size_t                          swaps = std::max<size_t>(1, order.size() / 16);
+            for (size_t s = 0; s < swaps; s++)
+            {
+                const size_t i = position(gen);
+                const size_t j = std::min(order.size() - 1, i + 1 + position(gen) % 8);
+                std::swap(order[i], order[j]);
+            }
+        }
+
+        const uint64_t peak = place(order, conflicts, base, placement);
+        LOG_TRACE(TENSORS_ALLOC, "Workspace planner iteration {}: peak {} (best {})", iteration, peak, m_plannedPeak);
+        if (peak < m_plannedPeak)
+        {
+            m_plannedPeak = peak;
+            bestOrder     = std::move(order);
+            m_addresses.swap(placement);
+        }
+    }
+    return true;
+}
+
+void WorkspacePlanner::startReplay()
+{
+    m_mode = Mode::replay;
+    m_pendingReplay.clear();
+    for (uint32_t i = 0; i < m_intervals.size(); i++)
+    {
+        const Interval& interval = m_intervals[i];
+        m_pendingReplay[{interval.size, interval.alignment, interval.offset}].push_back(i);
+    }
+}
+
+std::optional<deviceAddrOffset> WorkspacePlanner::getPlannedAddress(uint64_t size, uint64_t alignment, uint64_t offset)
+{
+    auto it = m_pendingReplay.find({size, alignment, offset});
+    if (it == m_pendingReplay.end() || it->second.empty()) return std::nullopt;
+    const deviceAddrOffset addr = m_addresses[it->second.front()];
+    it->second.pop_front();
+    return addr;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "types.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Offline placement of the workspace allocations of a graph
+ *
+ * The planner records the workspace allocations and frees of a dry run of the tensors allocator as intervals of
+ * (size, alignment, [allocation, free)), where the time is the index of the allocator call. Once all the intervals are
+ * known, they are placed together: in descending size order, each one gets the best fitting gap between the already
+ * placed intervals it conflicts with (i.e. whose lifetime overlaps its own), or the end of them. An optional
+ * improvement search retries with other orders and keeps the placement with the lowest peak.
+ * Replaying the same allocations with the planned addresses as requested addresses reproduces the plan, and an
+ * allocation that doesn't match the recording falls back to the regular allocation of the heap.
+ */
+class WorkspacePlanner
+{
+public:
+    struct Interval
+    {
+        uint64_t size;
+        uint64_t alignment;
+        uint64_t offset;  // The allocated range starts offset bytes before the aligned address
+        uint32_t start;
+        uint32_t end;     // Exclusive
+    };
+
+    enum class Mode
+    {
+        idle,
+        record,
+        replay
+    };
+
+    // Recording
+    void startRecording();
+    void recordAllocation(uint64_t size, uint64_t alignment, uint64_t offset, deviceAddrOffset addr);
+    void recordFree(deviceAddrOffset addr);
+
+    // Places the recorded intervals from base. Fails when more than maxConflicts pairs of intervals are live together,
+    // as the placement time grows with them.
+    bool plan(deviceAddrOffset base, unsigned improvementIterations, uint64_t maxConflicts);
+
+    // Replay - returns the planned address of the next recorded allocation of these params, if there is one. The
+    // address may be the base, so it is allocated with HeapAllocator::AllocateAt rather than as a requested address.
+    void                            startReplay();
+    std::optional<deviceAddrOffset> getPlannedAddress(uint64_t size, uint64_t alignment, uint64_t offset);
+
+    Mode                         getMode() const { return m_mode; }
+    const std::vector<Interval>& getIntervals() const { return m_intervals; }
+    deviceAddrOffset             getIntervalAddress(size_t intervalIdx) const { return m_addresses[intervalIdx]; }
+    uint64_t                     getPlannedPeak() const { return m_plannedPeak; }  // Relative to the base
+    // The maximal total size of the intervals live together, which no placement can go below
+    uint64_t getLowerBound() const;
+
+private:
+    using Order     = std::vector<uint32_t>;
+    using Placement = std::vector<deviceAddrOffset>;
+    using Conflicts = std::vector<std::vector<uint32_t>>;  // The intervals whose lifetime overlaps each interval
+    using AllocKey  = std::tuple<uint64_t, uint64_t, uint64_t>;  // size, alignment, offset
+
+    bool     buildConflicts(Conflicts& conflicts, uint64_t maxConflicts) const;
+    uint64_t place(const Order& order, const Conflicts& conflicts, deviceAddrOffset base, Placement& rPlacement) const;
+
+    Mode                                           m_mode = Mode::idle;
+    uint32_t                                       m_time = 0;
+    std::vector<Interval>                          m_intervals;
+    std::unordered_map<deviceAddrOffset, uint32_t> m_liveIntervals;  // Allocated address to interval
+    Placement                                      m_addresses;
+    uint64_t                                       m_plannedPeak = 0;
+    std::map<AllocKey, std::deque<uint32_t>>       m_pendingReplay;  // Intervals not replayed yet, in order
+};
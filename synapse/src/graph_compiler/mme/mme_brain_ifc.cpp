@@ -8,6 +8,7 @@
 #include "mme_desc_gen_utils.h"
 #include "compilation_hal_reader.h"
 #include "brain_conf.h"
+#include "graph_traits.h"
 #include <memory>
 #include <optional>
 
@@ -81,16 +82,17 @@ void MmeBrainIfc::setStrategyFields(MmeCommon::MmeLayerParams& params, bool igno
     getTensorRolesCommon(m_mmeNode, params.opType, xTensor, wTensor, yTensor, oTensor);
 
     params.strategy.packingFactor      = m_mmeNode.getNodeAnnotation().mmeMetaData.packing[PACKING_X];
-    params.strategy.pipelineLevel = setPipeline ? GCFG_DEFAULT_PIPELINE_DEPTH.value() : 1;
+    params.strategy.pipelineLevel      = setPipeline ? getDefaultPipelineDepth() : 1;
     params.strategy.cdConcurrencyEn    = m_mmeNode.getNodeAnnotation().mmeMetaData.mmeStrategy.cdConcurrencyEn;
     params.strategy.batchConcurrencyEn = m_mmeNode.getNodeAnnotation().mmeMetaData.mmeStrategy.batchConcurrencyEn;
 
     params.strategy.flattenEn          = !m_mmeNode.isDynamicShape();
-    params.strategy.sbReuse            = GCFG_SB_REUSE.value();
+    params.strategy.sbReuse            = m_strategyOverrides.sbReuse.value_or(GCFG_SB_REUSE.value());
     params.strategy.partialsToMemoryEn = GCFG_MME_PARTIALS_TO_MEMORY.value();
     params.strategy.loweringEn         = GCFG_ENABLE_MME_CONV_LOWERING.value();
     params.strategy.alignedAddresses = getAlignedAddresses(&m_mmeNode, params.opType, ignoreTensorAliasing);
-    params.strategy.recurringMisalignmentOptEn = GCFG_ENABLE_MME_ALIGN_OPT.value() && params.strategy.alignedAddresses;
+    params.strategy.recurringMisalignmentOptEn =
+        m_strategyOverrides.alignOpt.value_or(GCFG_ENABLE_MME_ALIGN_OPT.value()) && params.strategy.alignedAddresses;
 
     params.strategy.mmeLimit  = m_mmeNode.getGraphTraits()->getHalReader()->getNumMmeEngines();
 
@@ -98,6 +100,13 @@ void MmeBrainIfc::setStrategyFields(MmeCommon::MmeLayerParams& params, bool igno
     params.strategy.pattern  = MmeCommon::e_mme_patterns_nr;
 }
 
+unsigned MmeBrainIfc::getDefaultPipelineDepth() const
+{
+    if (m_strategyOverrides.pipelineDepth.has_value()) return *m_strategyOverrides.pipelineDepth;
+    const auto& graphTraits = m_mmeNode.getGraphTraits();
+    return graphTraits != nullptr ? graphTraits->defaultPipelineDepth() : GCFG_DEFAULT_PIPELINE_DEPTH.value();
+}
+
 // This is the only function that access mme brain to choose the relevant strategy fields
 // The function should be removed when bug TODO [SW-117781] is fixed
 
@@ -132,7 +141,7 @@ MmeCommon::MmeLayerParams MmeBrainIfc::getRecommendedMmeLayerParams(bool isGeoPr
         params.strategy.pattern            = MmeCommon::e_mme_patterns_nr;
         params.strategy.flattenEn          = !m_mmeNode.isDynamicShape();
         bool setPipeline                   = m_mmeNode.getNodeAnnotation().splitToLogicalROIs;
-        params.strategy.pipelineLevel      = setPipeline ? GCFG_DEFAULT_PIPELINE_DEPTH.value() : 1;
+        params.strategy.pipelineLevel      = setPipeline ? getDefaultPipelineDepth() : 1;
         params.strategy.cdConcurrencyEn    = MmeCommon::TurnedOff;
         params.strategy.batchConcurrencyEn = MmeCommon::TurnedOff;
 
@@ -43,6 +43,16 @@ public:
                                                      bool                       isGeoPreferredShort);
     void setRecommendedConcurrency();
 
+    // Strategy settings which replace their global configuration for this node only, so a caller needing different
+    // settings doesn't have to modify the process wide knobs, which other graphs may be compiled with concurrently.
+    struct StrategyOverrides
+    {
+        std::optional<unsigned> pipelineDepth;
+        std::optional<bool>     sbReuse;
+        std::optional<bool>     alignOpt;
+    };
+    void setStrategyOverrides(const StrategyOverrides& overrides) { m_strategyOverrides = overrides; }
+
     // Layered-brain interfaces:
 
     // Generate strategies for the given node based on previous solutions for other MME nodes in the bundle.
@@ -95,6 +105,7 @@ public:
 private:
     MmeCommon::MmeLayerParams getMmeLayerBaseParams() const;
     void                      setStrategyFields(MmeCommon::MmeLayerParams& params, bool ignoreTensorAliasing = true);
+    unsigned                  getDefaultPipelineDepth() const;
     void getRecommendedStrategyFromMmeBrain(MmeCommon::MmeLayerParams& params, bool isGeoPreferredShort);
     MmeCommon::MmeLayerParams getRecommendedConcurrency();
     // These fields are initialized to nullptr because upon node creation the chip type is not known yet
@@ -103,4 +114,5 @@ private:
     const MmeNode&                     m_mmeNode;
     std::optional<MmeCommon::ChipType> m_chipType;
     std::optional<MmeCommon::MmeBrain> m_mmeBrain;
+    StrategyOverrides                  m_strategyOverrides;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "mme_services.h"
 #include "mme_brain_ifc.h"
 #include "compilation_hal_reader.h"
+#include "graph_traits.h"
 #include "node.h"
 #include "synapse_common_types.h"
 #include "tensor_shape.h"
@@ -174,9 +175,14 @@ bool MmeServices::checkTransposeViaGemmPattern(const MMENodePtr& mmeNode)
     bool tensorDimSupported = outputTensor->getDim() <= 4;
     bool fcdSizeLargeEnough =
         outputTensor->getSizeInBytes(0) > CompilationHalReader::getHalReader()->getCacheLineSizeInBytes();
-    return CompilationHalReader::getHalReader()->getDeviceType() == synDeviceGaudi3 && GCFG_ENABLE_TRANSPOSE_VIA_GEMM.value() && 
-           typeIsSupportedForTranspose && tensorDimSupported && fcdSizeLargeEnough;
+    // Read from the node's graph rather than a thread state, as the graph may be compiled by several threads
+    const auto& graphTraits = mmeNode->getGraphTraits();
+    bool        allowedForGraph = graphTraits == nullptr || graphTraits->isTransposeViaGemmAllowed();
+    return CompilationHalReader::getHalReader()->getDeviceType() == synDeviceGaudi3 &&
+           GCFG_ENABLE_TRANSPOSE_VIA_GEMM.value() && allowedForGraph && typeIsSupportedForTranspose &&
+           tensorDimSupported && fcdSizeLargeEnough;
 }
+
 void MmeAuxTensorHandler::addUnitMatrixToNode(MMENodePtr& mmeNode, synDataType dtype)
 {
     std::shared_ptr<MmeTransposeNode> xposeNode = std::static_pointer_cast<MmeTransposeNode>(mmeNode);
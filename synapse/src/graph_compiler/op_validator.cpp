@@ -87,10 +87,9 @@ ValidationResult OpValidator::runValidations() const
     return ValidationResult::SUCCESS;
 }
 
-bool OpValidator::isSupportedDatatype(synDataType testedType, unsigned supportedTypesMask)
+bool OpValidator::isSupportedDatatype(synDataType testedType, unsigned supportedTypesMask, bool dataTypeSelection)
 {
-    return ((supportedTypesMask & testedType) != 0) ||
-           (GCFG_SYNAPSE_DATA_TYPE_SELECTION.value() && testedType == syn_type_na);
+    return ((supportedTypesMask & testedType) != 0) || (dataTypeSelection && testedType == syn_type_na);
 }
 
 ValidationResult OpValidator::validateRank(const OpInfo& gcOpInfo, const OpValidationContext& opValCtx)
@@ -157,7 +156,7 @@ ValidationResult OpValidator::validateDatatypes(const OpInfo& gcOpInfo, const Op
                           supportedTypes,
                           ctx.getDatatype(),
                           getStringFromSynDataType(ctx.getDatatype()));
-                if (!isSupportedDatatype(ctx.getDatatype(), supportedTypes))
+                if (!isSupportedDatatype(ctx.getDatatype(), supportedTypes, opValCtx.isDataTypeSelectionEnabled()))
                 {
                     LOG_ERR(OP_VALIDATOR,
                             "Incompatible datatype {} for {} tensor idx {}",
@@ -203,7 +202,7 @@ ValidationResult OpValidator::validateDatatypes(const OpInfo& gcOpInfo, const Op
         {
             const auto& tensorCtx = operandsCtx.at(idx);
             if (tensorCtx.empty()) continue;
-            if (!isSupportedDatatype(tensorCtx.getDatatype(), supportedType))
+            if (!isSupportedDatatype(tensorCtx.getDatatype(), supportedType, opValCtx.isDataTypeSelectionEnabled()))
             {
                 LOG_ERR(OP_VALIDATOR,
                         "Incompatible datatype {} for {} tensor idx {}",
@@ -93,7 +93,7 @@ protected:
      * @brief Test whether tested type is included in input mask or not
      *
      */
-    static bool isSupportedDatatype(synDataType testedType, unsigned supportedTypesMask);
+    static bool isSupportedDatatype(synDataType testedType, unsigned supportedTypesMask, bool dataTypeSelection);
 
     /**
      * @brief Run all validations and return a retcode accordingly
@@ -138,6 +138,9 @@ public:
     // Whether context object is empty or not
     bool empty() const;
 
+    // Whether operands may have no data type, to be set by the data type selection of the validated op's graph
+    bool isDataTypeSelectionEnabled() const { return m_isDataTypeSelectionEnabled; }
+    void setDataTypeSelectionEnabled(bool enabled) { m_isDataTypeSelectionEnabled = enabled; }
 
 private:
     // Non-const operands context getter
@@ -145,6 +148,7 @@ private:
 
     std::vector<TensorValidationContext> m_input;
     std::vector<TensorValidationContext> m_output;
+    bool                                 m_isDataTypeSelectionEnabled = false;
 };
 
 /**
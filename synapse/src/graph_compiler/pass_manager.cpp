@@ -1,15 +1,22 @@
 #include "pass_manager.h"
 
+#include "compilation_config_snapshot.h"
+#include "compilation_profiler.h"
+#include "flat_graph.h"
 #include "graph_visualization.h"
 #include "habana_global_conf.h"
 #include "habana_graph.h"
+#include "graph_arena.h"
 #include "log_manager.h"
 #include "types_exception.h"
 #include "utils/quant_info_dumper.h"
+#include "infra/threads/work_stealing_pool.h"
 
 #include <lemon/connectivity.h>
 #include <lemon/list_graph.h>
 
+#include <algorithm>
+#include <exception>
 #include <queue>
 
 typedef lemon::ListDigraph                  DirectedGraph;
@@ -590,6 +597,117 @@ pPass PassManager::getNextPass(std::vector<pPass>::iterator& executionListIterat
     return nextExecPass;
 }
 
+// Executes a single read-only pass on a pool thread. Failures are reported back to the pass manager thread.
+static void applyConcurrentPass(const pPass&         pass,
+                                HabanaGraph&         graph,
+                                CompilationProfiler* profiler,
+                                GraphArena*          arena,
+                                char&                result,
+                                std::exception_ptr&  exception)
+{
+    // Objects created by the pass come from the graph arena, as if it ran on the compiling thread
+    ScopedGraphArena arenaScope(arena);
+    try
+    {
+        if (profiler == nullptr)
+        {
+            result = pass->Apply(graph);
+            return;
+        }
+        const auto profileSample = profiler->startPass(graph, pass, true /*concurrent*/);
+        result                   = pass->Apply(graph);
+        profiler->endPass(graph, pass, profileSample, true /*concurrent*/);
+    }
+    catch (...)
+    {
+        result    = false;
+        exception = std::current_exception();
+    }
+}
+
+bool PassManager::isConcurrentCandidate(const pPass& pass) const
+{
+    return GCFG_PARALLEL_PASSES_NUM_THREADS.value() > 1 && !pass->isPassGroup() && pass->isGraphReadOnly();
+}
+
+std::vector<pPass> PassManager::collectConcurrentPasses(const pPass&                  first,
+                                                        std::vector<pPass>::iterator& executionListIterator)
+{
+    std::vector<pPass> passes = {first};
+
+    // Re-run passes have to be interleaved by priority, keep the serial flow for them
+    if (!isConcurrentCandidate(first) || !m_reRunPriorityQueue.empty()) return passes;
+
+    while (executionListIterator != m_executionList.end() && isConcurrentCandidate(*executionListIterator))
+    {
+        const pPass& candidate   = *executionListIterator;
+        const auto&  depSet      = candidate->getDependencySet();
+        bool         isDependent = std::any_of(passes.begin(), passes.end(), [&](const pPass& p) {
+            return depSet.find(p->getId()) != depSet.end();
+        });
+        if (isDependent) break;
+
+        passes.push_back(candidate);
+        updateProgress();
+        executionListIterator++;
+    }
+    return passes;
+}
+
+bool PassManager::executeConcurrentPasses(HabanaGraph& graph, const std::vector<pPass>& passes)
+{
+    // Graph queries lazily build their caches, build them now so the passes only read them. The caches filled per
+    // query (reachability, number of paths, connectivity) are guarded by the graph itself.
+    graph.getNodes();
+    graph.getTensors();
+    graph.getTopoSortedNodes();
+    graph.getExeSortedNodes();
+    graph.getFlatGraph();
+
+    std::vector<char>               results(passes.size(), false);
+    std::vector<std::exception_ptr> exceptions(passes.size());
+
+    // A pool of a single thread has no workers, so the pool gets all the threads. The compiling thread only helps while
+    // it waits for the batch.
+    if (m_concurrentPassesPool == nullptr)
+    {
+        m_concurrentPassesPool = std::make_unique<synapse::WorkStealingPool>(GCFG_PARALLEL_PASSES_NUM_THREADS.value(),
+                                                                             GCFG_THREAD_POOL_PIN_THREADS.value());
+    }
+    GraphArena*        arena = GraphArena::current();
+    synapse::TaskGroup batch(*m_concurrentPassesPool);
+    for (unsigned i = 0; i < passes.size(); i++)
+    {
+        LOG_INFO(PASS_MANAGER, "Executing pass: {} (concurrently)", passes[i]->getName());
+        batch.run([&, i]() { applyConcurrentPass(passes[i], graph, m_profiler.get(), arena, results[i], exceptions[i]); });
+    }
+    batch.wait();
+
+    // Report in execution list order, as a serial execution would
+    for (unsigned i = 0; i < passes.size(); i++)
+    {
+        if (exceptions[i] != nullptr)
+        {
+            std::rethrow_exception(exceptions[i]);
+        }
+        if (!results[i])
+        {
+            LOG_ERR(PASS_MANAGER, "Graph optimization failed pass: {}", passes[i]->getName());
+            return false;
+        }
+    }
+
+    // Only structural changes are detected, e.g. tensors attributes set by a pass aren't
+    if (graph.isGraphChangedInLastPass())
+    {
+        LOG_ERR(PASS_MANAGER,
+                "Graph changed by one of the concurrent read-only passes starting at {}",
+                passes.front()->getName());
+        return false;
+    }
+    return true;
+}
+
 void PassManager::executeGVDPass(HabanaGraph& graph, const std::string& passName, int passIdx, bool isGraphChanged)
 {
     if (m_graphVisualDebug != nullptr)
@@ -670,6 +788,8 @@ bool PassManager::executePasses(HabanaGraph& graph, std::optional<PassId> stopBe
             m_graphVisualDebug = std::make_unique<GraphVisualization>("_GVD_", true);
         }
         advanceState(PassMgrState::RUNNING);  // READY-->RUNNING
+        m_profiler = CompilationProfiler::isEnabled() ? std::make_unique<CompilationProfiler>(graph.getRecipeName())
+                                                      : nullptr;
     }
     else
     {
@@ -698,6 +818,49 @@ bool PassManager::executePasses(HabanaGraph& graph, std::optional<PassId> stopBe
             }
         }
 
+        if constexpr (!IsPartial)
+        {
+            std::vector<pPass> concurrentPasses = collectConcurrentPasses(p, executionListIterator);
+            if (concurrentPasses.size() > 1)
+            {
+                try
+                {
+                    COND_TIMER(graph.m_timer.start(p->getName()));
+                    m_actualExecutionOrder.insert(m_actualExecutionOrder.end(),
+                                                  concurrentPasses.begin(),
+                                                  concurrentPasses.end());
+                    graph.clearGraphChangedInLastPass();
+                    if (!executeConcurrentPasses(graph, concurrentPasses))
+                    {
+                        return false;
+                    }
+                    COND_TIMER(graph.m_timer.stop(p->getName()));
+                    COND_TIMER(LOG_TRACE(PASS_MANAGER,
+                                         "Total time for {} concurrent passes starting at {}: {} seconds",
+                                         concurrentPasses.size(),
+                                         p->getName(),
+                                         graph.m_timer.getTotalSeconds(p->getName())));
+                }
+                catch (SynapseException& e)
+                {
+                    COND_TIMER(graph.m_timer.stop(p->getName()));
+                    LOG_ERR(PASS_MANAGER, "Graph optimization failed! Got SynapseException: {}", e.what());
+                    return false;
+                }
+
+                // Read-only passes neither change the graph nor turn on predicates
+                for (const pPass& concurrentPass : concurrentPasses)
+                {
+                    executeGVDPass(graph, concurrentPass->getName(), currPassIdx, false);
+                    graph.dumpGraphToJson(graph_serializer::GraphState::POST_PASS, concurrentPass->getName());
+                    printProgress(concurrentPass->getName());
+                    currPassIdx++;
+                    m_passRun[concurrentPass->getId()] = true;
+                }
+                continue;
+            }
+        }
+
         LOG_INFO(PASS_MANAGER, "Executing pass: {}", p->getName());
         try
         {
@@ -705,6 +868,12 @@ bool PassManager::executePasses(HabanaGraph& graph, std::optional<PassId> stopBe
             m_actualExecutionOrder.push_back(p);
             graph.clearGraphChangedInLastPass();
 
+            std::optional<CompilationProfiler::Sample> profileSample;
+            if (m_profiler)
+            {
+                profileSample = m_profiler->startPass(graph, p, false /*concurrent*/);
+            }
+
             if (!p->Apply(graph))
             {
                 if constexpr (!IsPartial)
@@ -715,6 +884,18 @@ bool PassManager::executePasses(HabanaGraph& graph, std::optional<PassId> stopBe
                 return false;
             }
 
+            if (profileSample)
+            {
+                m_profiler->endPass(graph, p, *profileSample, false /*concurrent*/);
+            }
+
+            // A pass marked read-only may run concurrently with others, it must not edit the graph
+            if (p->isGraphReadOnly() && graph.isGraphChangedInLastPass())
+            {
+                LOG_ERR(PASS_MANAGER, "Graph changed by read-only pass: {}", p->getName());
+                return false;
+            }
+
             if (!handleActivePredicates())
             {
                 LOG_ERR(PASS_MANAGER, "Predicates handling failed (following pass: {})", p->getName());
@@ -751,6 +932,10 @@ bool PassManager::executePasses(HabanaGraph& graph, std::optional<PassId> stopBe
         {
             dumpQuantInfoToJson(graph);
         }
+        if (m_profiler)
+        {
+            m_profiler->dump();
+        }
     }
     return true;
 }
@@ -882,11 +1067,30 @@ bool PassManager::run(HabanaGraph& graph)
         return false;
     }
     advanceState(PassMgrState::READY);  // INIT-->READY
+    std::optional<CompilationConfigSnapshot> configSnapshot;
+    if (GCFG_VERIFY_COMPILATION_CONFIG.value())
+    {
+        configSnapshot.emplace();
+    }
     //3. Execute passes
-    bool executionResult = executePasses<false /*IsPartial*/>(graph);
+    ScopedGraphArena arenaScope(graph.getArena());
+    bool             executionResult = executePasses<false /*IsPartial*/>(graph);
+    m_concurrentPassesPool.reset();  // joins the workers of the concurrent passes
     advanceState(PassMgrState::DONE);  // RUNNING-->DONE
     HB_ASSERT(state() == PassMgrState::DONE, "Expecting state DONE, actual {}", state());
 
+    if (configSnapshot.has_value())
+    {
+        const std::vector<std::string> changedKnobs = configSnapshot->getChangedKnobs();
+        if (!changedKnobs.empty())
+        {
+            LOG_WARN(PASS_MANAGER,
+                     "Global configuration changed while compiling {}, the graph may be compiled with mixed values of: {}",
+                     graph.getRecipeName(),
+                     fmt::join(changedKnobs, ", "));
+        }
+    }
+
     LOG_TRACE(PASS_MANAGER, "Printing pass execution order.");
 
     int i = 0;
@@ -917,7 +1121,8 @@ bool PassManager::runPartial(HabanaGraph& graph, PassId stopBefore)
         return false;
     }
 
-    const bool success = executePasses<true /*IsPartial*/>(graph, stopBefore);
+    ScopedGraphArena arenaScope(graph.getArena());
+    const bool       success = executePasses<true /*IsPartial*/>(graph, stopBefore);
     return success;
 }
 
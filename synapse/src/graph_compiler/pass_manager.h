@@ -8,9 +8,15 @@
 #include <queue>
 #include <optional>
 
+class CompilationProfiler;
 class DependencyGraphContainer;
 class GraphVisualization;
 
+namespace synapse
+{
+class WorkStealingPool;
+}
+
 // Enum cannot be used as a key of std::unordered_map. This is a defect fixed in c++ 14.
 // As a workaround an enum type may be used since the values of the enum constants
 // are values of an integral type.
@@ -77,6 +83,9 @@ public:
     // Each predicate may trigger passes multiple execution
     bool turnOnPredicate(PredicateId id);
 
+    // Profile of the last full execution, null unless the compilation profile is enabled
+    const CompilationProfiler* getCompilationProfile() const { return m_profiler.get(); }
+
 private:
     enum class PassMgrState
     {
@@ -115,6 +124,14 @@ private:
 
     pPass getNextPass(std::vector<pPass>::iterator& executionListIterator);
 
+    // Read-only passes following a read-only pass in the static execution list, which don't depend on each other,
+    // are collected into a batch that is executed concurrently
+    bool isConcurrentCandidate(const pPass& pass) const;
+
+    std::vector<pPass> collectConcurrentPasses(const pPass& first, std::vector<pPass>::iterator& executionListIterator);
+
+    bool executeConcurrentPasses(HabanaGraph& graph, const std::vector<pPass>& passes);
+
     void executeGVDPass(HabanaGraph& graph, const std::string& passName, int passIdx, bool isGraphChanged);
 
     void updateProgress();
@@ -158,6 +175,11 @@ private:
                                                                      // worst case - O(n)
     std::unique_ptr<GraphVisualization> m_graphVisualDebug;
 
+    std::unique_ptr<CompilationProfiler> m_profiler;
+
+    // Workers of the concurrent passes, created on the first concurrent batch and kept for the whole compilation
+    std::unique_ptr<synapse::WorkStealingPool> m_concurrentPassesPool;
+
     int m_currentProgress = {};
     PassMgrState m_state;
     bool         m_legacyMode;
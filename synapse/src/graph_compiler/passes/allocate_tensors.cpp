@@ -13,6 +13,7 @@
 #include "memory_management/range_epoch_allocator.h"
 #include <cstdint>
 #include "memory_management/heap_allocator.h"
+#include "memory_management/workspace_planner.h"
 #include "register_memory_coherence.h"
 
 static bool allocateTensor(const TensorPtr& t, MemoryAllocator& allocator)
@@ -82,6 +83,81 @@ static void clearAllocationStateBeforeRecalculation(HabanaGraph& g, const Tensor
     std::for_each(tensors.begin(), tensors.end(), [](auto& tensor) { tensor->unsetDramOffset(); });
 }
 
+// Records the workspace allocations of a dry run of the default DRAM allocator and plans them together, then replays
+// them at the planned addresses in another dry run, which gives the achieved workspace size.
+static bool planWorkspace(HabanaGraph&                             g,
+                          LivenessAnalysis&                        livenessAnalysis,
+                          const TensorVector&                      tensors,
+                          const std::shared_ptr<WorkspacePlanner>& planner,
+                          size_t&                                  workspaceSize,
+                          HeapAllocatorWrapper&                    heapAllocatorWrapper)
+{
+    const Range freeRange = heapAllocatorWrapper.getMaxFreeRange();
+
+    clearAllocationStateBeforeRecalculation(g, tensors);
+    planner->startRecording();
+    {
+        auto  workspaceAllocatorClone = heapAllocatorWrapper.Clone();
+        auto& workspaceAllocator      = *static_cast<HeapAllocatorWrapper*>(workspaceAllocatorClone.get());
+        workspaceAllocator.setWorkspacePlanner(planner);
+        DramTensorsAllocator allocator(&g, livenessAnalysis, workspaceAllocator);
+        if (!allocator.allocateTensorsMemorySpace()) return false;
+    }
+
+    if (!planner->plan(freeRange.base,
+                       GCFG_WORKSPACE_PLANNER_ITERATIONS.value(),
+                       GCFG_WORKSPACE_PLANNER_MAX_CONFLICTS.value()))
+    {
+        return false;
+    }
+    const uint64_t plannedPeak = planner->getPlannedPeak();
+    if (plannedPeak > freeRange.size)
+    {
+        LOG_DEBUG(TENSORS_ALLOC,
+                  "Workspace plan peak {} exceeds the max free workspace range {}",
+                  plannedPeak,
+                  freeRange.size);
+        return false;
+    }
+
+    clearAllocationStateBeforeRecalculation(g, tensors);
+    planner->startReplay();
+    {
+        auto  workspaceAllocatorClone = heapAllocatorWrapper.Clone();
+        auto& workspaceAllocator      = *static_cast<HeapAllocatorWrapper*>(workspaceAllocatorClone.get());
+        workspaceAllocator.setWorkspacePlanner(planner);
+        DramTensorsAllocator allocator(&g, livenessAnalysis, workspaceAllocator);
+        if (!allocator.allocateTensorsMemorySpace()) return false;
+        workspaceSize = allocator.getWorkspaceSize();
+    }
+
+    LOG_INFO(TENSORS_ALLOC,
+             "Workspace planner -- {} workspace allocations, planned peak: {}, lower bound: {}, achieved workspace "
+             "size: {}",
+             planner->getIntervals().size(),
+             plannedPeak,
+             planner->getLowerBound(),
+             workspaceSize);
+    return true;
+}
+
+static bool allocateTensorsUsingWorkspacePlan(HabanaGraph&                             g,
+                                              LivenessAnalysis&                        livenessAnalysis,
+                                              const std::shared_ptr<WorkspacePlanner>& planner,
+                                              HeapAllocatorWrapper&                    heapAllocatorWrapper)
+{
+    planner->startReplay();
+    heapAllocatorWrapper.setWorkspacePlanner(planner);
+    DramTensorsAllocator allocator(&g, livenessAnalysis, heapAllocatorWrapper);
+    bool                 allocationResult = allocator.allocateTensorsMemorySpace();
+    heapAllocatorWrapper.setWorkspacePlanner(nullptr);
+    if (allocationResult)
+    {
+        g.getGraphAnnotation().workspacePlan = planner;
+    }
+    return allocationResult;
+}
+
 static TensorVector gatherOutputTensors(HabanaGraph& g)
 {
     TensorVector outputTensors;
@@ -144,9 +220,38 @@ static bool allocateRemainingTensors(HabanaGraph& g, const TensorVector& tensors
     bool                 defaultAllocationSuccess =
         allocateTensorsUsingDefaultDRAMAllocator(g, livenessAnalysis, initialWorkspaceSize, true, heapAllocatorWrapper);
     double workspaceSizeFactor = static_cast<double>(initialWorkspaceSize) / adjustedMaxLiveCapacity;
+
+    g.getGraphAnnotation().workspacePlan.reset();
+    auto   workspacePlanner     = std::make_shared<WorkspacePlanner>();
+    size_t plannedWorkspaceSize = 0;
+    bool   planSuccess          = defaultAllocationSuccess && GCFG_ENABLE_WORKSPACE_PLANNER.value() &&
+                         planWorkspace(g,
+                                       livenessAnalysis,
+                                       tensors,
+                                       workspacePlanner,
+                                       plannedWorkspaceSize,
+                                       heapAllocatorWrapper);
+    // The plan replaces the allocator chosen below when it gives a smaller workspace
+    auto allocateUsingPlanIfSmaller = [&](uint64_t workspaceSize) {
+        if (!planSuccess || plannedWorkspaceSize >= workspaceSize) return false;
+        LOG_INFO(TENSORS_ALLOC,
+                 "DRAM allocation using workspace planner -- Tensors workspace size: {}, replaced workspace size: {}, "
+                 "max live capacity measured: {}, max live capacity with output reuse: {}",
+                 plannedWorkspaceSize,
+                 workspaceSize,
+                 maxLiveCapacity,
+                 adjustedMaxLiveCapacity);
+        return true;
+    };
+
     if (defaultAllocationSuccess && (initialWorkspaceSize <= GCFG_WORKSPACE_MIN_SIZE_LIMIT.value() ||
                                      workspaceSizeFactor <= 1 + GCFG_WORKSPACE_EPOCH_SIZE_PERCISION.value()))
     {
+        if (allocateUsingPlanIfSmaller(initialWorkspaceSize))
+        {
+            clearAllocationStateBeforeRecalculation(g, tensors);
+            return allocateTensorsUsingWorkspacePlan(g, livenessAnalysis, workspacePlanner, heapAllocatorWrapper);
+        }
         // actual allocation
         LOG_INFO(TENSORS_ALLOC,
                  "DRAM allocation using default allocator -- Tensors workspace size: {}, max live capacity measured: "
@@ -217,7 +322,12 @@ static bool allocateRemainingTensors(HabanaGraph& g, const TensorVector& tensors
     }
     // actual allocation
     clearAllocationStateBeforeRecalculation(g, tensors);
-    if (!defaultAllocationSuccess || bestWorkspaceSize < initialWorkspaceSize)
+    const bool useEpochAllocator = !defaultAllocationSuccess || bestWorkspaceSize < initialWorkspaceSize;
+    if (allocateUsingPlanIfSmaller(useEpochAllocator ? bestWorkspaceSize : initialWorkspaceSize))
+    {
+        return allocateTensorsUsingWorkspacePlan(g, livenessAnalysis, workspacePlanner, heapAllocatorWrapper);
+    }
+    if (useEpochAllocator)
     {
         LOG_INFO(TENSORS_ALLOC,
                  "DRAM allocation using epoch allocator -- Epoch size {} Tensors workspace size: {}, default allocator "
@@ -78,7 +78,7 @@ static void findEluMultNodes(HabanaGraph& g, std::vector<std::tuple<pNode, pNode
 pNode createSeluNode(HabanaGraph& g, pNode eluNode, pNode multNode, synDataType type, ns_SeluKernel::Params* params)
 {
     std::string_view guid;
-    if (GCFG_SYNAPSE_DATA_TYPE_SELECTION.value() && type == syn_type_na)
+    if (g.isDataTypeSelectionEnabled() && type == syn_type_na)
     {
         guid = "selu";
     }
@@ -24,7 +24,7 @@ bool enforceNodePrecision(HabanaGraph& g)
         return true;
     }
 
-    if (!GCFG_SYNAPSE_DATA_TYPE_SELECTION.value())
+    if (!g.isDataTypeSelectionEnabled())
     {
         LOG_DEBUG(QUANT, "Data type selection is disabled in synapse. Skip {} Pass", HLLOG_FUNC);
         return true;
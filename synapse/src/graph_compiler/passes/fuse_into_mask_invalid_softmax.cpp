@@ -54,7 +54,7 @@ bool fuseIntoMaskInvalidSoftmax(HabanaGraph& g)
                   "sequence mask node GUID prefix must be 'sequence_mask' ");
 
         if (tpcSequenceMaskNode->getNumInputs() != 2 ||
-            (!GCFG_SYNAPSE_DATA_TYPE_SELECTION.value() &&
+            (!g.isDataTypeSelectionEnabled() &&
              (tpcSequenceMaskNode->getGUID().find("_i16") == std::string::npos ||
               tpcSoftmaxNode->getGUID().find("_i16") == std::string::npos)) ||
             !GraphEditor::canEliminateTensor(g, tpcSequenceMaskNode->getOutput(0)) ||
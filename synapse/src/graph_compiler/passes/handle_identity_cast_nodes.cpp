@@ -16,7 +16,7 @@ bool handleIdentityCastNodes(HabanaGraph& g)
         return true;
     }
 
-    if (!GCFG_SYNAPSE_DATA_TYPE_SELECTION.value())
+    if (!g.isDataTypeSelectionEnabled())
     {
         LOG_DEBUG(GC, "Data type selection is disabled in synapse. Skip {} Pass", HLLOG_FUNC);
         return true;
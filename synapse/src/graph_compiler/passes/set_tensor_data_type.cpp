@@ -164,7 +164,7 @@ bool setGraphTensorsDataType(HabanaGraph& g)
         return true;
     }
 
-    if (!GCFG_SYNAPSE_DATA_TYPE_SELECTION.value())
+    if (!g.isDataTypeSelectionEnabled())
     {
         LOG_DEBUG(DATA_TYPES, "Data type selection is disabled in synapse. Skip {} Pass", HLLOG_FUNC);
         return true;
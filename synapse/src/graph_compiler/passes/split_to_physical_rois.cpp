@@ -1,6 +1,5 @@
 #include "code_generation/tensor_size_validator.h"
-#include "infra/threads/thread_pool.h"
-#include "infra/threads/thread_work_item.h"
+#include "infra/threads/work_stealing_pool.h"
 #include "habana_graph.h"
 #include "habana_nodes.h"
 #include "passes.h"
@@ -369,7 +368,7 @@ static std::list<NodeROI> splitRotateRoiToPhysicalRois(std::list<NodeROI>& roisT
     return physicalRois;
 }
 
-class PhysicalRoiSplitter : public synapse::ThreadWorkItem
+class PhysicalRoiSplitter
 {
 public:
     PhysicalRoiSplitter(const HabanaGraph&  graph,
@@ -403,7 +402,7 @@ public:
         }
     }
 
-    virtual void doWork() override
+    void doWork()
     {
         if (m_rois == nullptr)
         {
@@ -515,9 +514,9 @@ private:
 
 bool splitToPhysicalROIs(HabanaGraph& g)
 {
-    synapse::ThreadPool threadPool;
-
-    threadPool.start();
+    // The nodes are split on the process-wide pool, which avoids creating threads for every compilation
+    const bool         concurrent = GCFG_NUM_OF_THREADS_CONF.value() > 1;
+    synapse::TaskGroup group;
 
     const auto& sortedNodes = g.getExeSortedNodes();
 
@@ -533,9 +532,17 @@ bool splitToPhysicalROIs(HabanaGraph& g)
             n->setPhysicalRois(*logicalROIs);
             continue;
         }
-        threadPool.addJob(new PhysicalRoiSplitter(g, n, g.GetNodeROIs(n), g.getCodeGenerator()->getPhysicalRois(n)));
+        PhysicalRoiSplitter splitter(g, n, g.GetNodeROIs(n), g.getCodeGenerator()->getPhysicalRois(n));
+        if (concurrent)
+        {
+            group.run([splitter]() mutable { splitter.doWork(); });
+        }
+        else
+        {
+            splitter.doWork();
+        }
     }
-    threadPool.finish();
+    group.wait();
 
     return true;
 }
@@ -24,6 +24,7 @@
 #include <lemon/list_graph.h>
 #include <lemon/unionfind.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string.h>
@@ -2409,19 +2410,28 @@ bool findOriginalNodes(FuserNodePtrV4        fusedNode,
     return true;
 }
 
+// Nodes accumulated over the replacements of a subgraph, until its last node is replaced.
+// Kept by the caller rather than in statics, as graphs may be compiled concurrently.
+struct SubgraphReplacementState
+{
+    NodeList                    nodesToAdd;
+    std::unordered_set<NodePtr> totalOriginalNodesSet;
+};
+
 optimizedGraphStatus tryNodesReplacementInGraph(HabanaGraph&                              graph,
                                                 const std::pair<NodePtr, NodeList>&       fusedNodeOrigNodePair,
                                                 std::map<NodePtr, std::vector<unsigned>>& newNodesPerFusedNode,
                                                 std::map<unsigned, NodePtr>&              newNodeIdMap,
+                                                SubgraphReplacementState&                 subgraphState,
                                                 bool                                      isNeedToReplaceNodes = true,
                                                 bool                                      isPartOfSubgraph     = false)
 {
     // Replace received nodes from fuser with their original nodes in the graph
     // If the node belongs to subgraph send all subgraph nodes and then originals to the same call of replaceNodes
 
-    static NodeList nodesToAdd;
-    const NodePtr&  fusedNode     = fusedNodeOrigNodePair.first;
-    NodeList        originalNodes = fusedNodeOrigNodePair.second;
+    NodeList&      nodesToAdd    = subgraphState.nodesToAdd;
+    const NodePtr& fusedNode     = fusedNodeOrigNodePair.first;
+    NodeList       originalNodes = fusedNodeOrigNodePair.second;
 
     HB_ASSERT(!originalNodes.empty(), "No original nodes for node {}", fusedNode->getNodeName());
 
@@ -2461,7 +2471,7 @@ optimizedGraphStatus tryNodesReplacementInGraph(HabanaGraph&
     if (isPartOfSubgraph)
     {
         // The node is part of subgraph, add it all original nodes to the total original nodes in this subgraph
-        static std::unordered_set<NodePtr> totalOriginalNodesSet;
+        std::unordered_set<NodePtr>& totalOriginalNodesSet = subgraphState.totalOriginalNodesSet;
         totalOriginalNodesSet.insert(originalNodes.begin(), originalNodes.end());
 
         if (isNeedToReplaceNodes)
@@ -2496,11 +2506,11 @@ optimizedGraphStatus tryNodesReplacementInGraph(HabanaGraph&
 //     If false value returned to the caller - GC graph remains unmodified
 optimizedGraphStatus replaceOptimizedCluster(HabanaGraph& graph, const std::shared_ptr<GCTPCFuserWrapper>& fuser)
 {
-    static int fusedClustersCounter = -1;
-    int        fusedNodesCounter    = 0;
-    int        newNodesCounter      = 0;
-
-    fusedClustersCounter++;
+    // Graphs may be compiled concurrently, each cluster still gets a unique number for its fused node names
+    static std::atomic<int> nextFusedClusterIdx {0};
+    const int               fusedClustersCounter = nextFusedClusterIdx++;
+    int                     fusedNodesCounter    = 0;
+    int                     newNodesCounter      = 0;
 
     LOG_DEBUG(GC_TPC_FUSER, "tpcFuser: fusing nodes of subgraph (cluster) {}.", fusedClustersCounter);
 
@@ -2704,7 +2714,8 @@ optimizedGraphStatus replaceOptimizedCluster(HabanaGraph& graph, const std::shar
         return optimizedGraphSuccess;
     }
 
-    optimizedGraphStatus status = optimizedGraphSuccess;
+    optimizedGraphStatus     status = optimizedGraphSuccess;
+    SubgraphReplacementState subgraphState;
     // insert all fused nodes to the graph instead of their original nodes
     for (auto pair : fusedNodesMap)
     {
@@ -2756,6 +2767,7 @@ optimizedGraphStatus replaceOptimizedCluster(HabanaGraph& graph, const std::shar
                                                             fusedNodeOrigNodesPair,
                                                             newNodesPerFusedNode,
                                                             newNodeIdMap,
+                                                            subgraphState,
                                                             isLastNodeInSubgraph,
                                                             true);
                         if (status != optimizedGraphSuccess) return status;
@@ -2774,7 +2786,7 @@ optimizedGraphStatus replaceOptimizedCluster(HabanaGraph& graph, const std::shar
                           fusedNode->getId());
 
                 // this node is not part of subgraph
-                status = tryNodesReplacementInGraph(graph, pair, newNodesPerFusedNode, newNodeIdMap, true);
+                status = tryNodesReplacementInGraph(graph, pair, newNodesPerFusedNode, newNodeIdMap, subgraphState, true);
                 if (status != optimizedGraphSuccess) return status;
             }
         }
@@ -2788,7 +2800,7 @@ optimizedGraphStatus replaceOptimizedCluster(HabanaGraph& graph, const std::shar
                       fusedNode->getId());
 
             // this node is not part of subgraph
-            status = tryNodesReplacementInGraph(graph, pair, newNodesPerFusedNode, newNodeIdMap, true);
+            status = tryNodesReplacementInGraph(graph, pair, newNodesPerFusedNode, newNodeIdMap, subgraphState, true);
             if (status != optimizedGraphSuccess) return status;
         }
     }
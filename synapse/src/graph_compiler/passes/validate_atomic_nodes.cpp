@@ -1,18 +1,32 @@
+#include "flat_graph.h"
 #include "graph_annotation.h"
 #include "habana_graph.h"
 
 // Producer Node A and Consumer Node B will be called adjacent, if there is a path in the graph between Node A and Node
 // B that is either direct or passes only through logical nodes.
-bool areAdjacentNodes(HabanaGraph& g, const NodePtr& consumer, const NodePtr& targetProducer)
+bool areAdjacentNodes(const FlatGraph& flatGraph, const NodePtr& consumer, const NodePtr& targetProducer)
 {
-    const auto& directProducers = g.getNodeProducers(consumer);
-    NodeVector  candidateProducers;
-    std::copy(directProducers.begin(), directProducers.end(), std::back_inserter(candidateProducers));
+    std::vector<FlatGraph::Index> candidateProducers;
+    auto                          addDataProducers = [&](FlatGraph::Index nodeIdx) {
+        for (FlatGraph::Index tensorIdx : flatGraph.dataInputs(nodeIdx))
+        {
+            const FlatGraph::Index producerIdx = flatGraph.tensorProducer(tensorIdx);
+            if (producerIdx != FlatGraph::INVALID_IDX)
+            {
+                candidateProducers.push_back(producerIdx);
+            }
+        }
+    };
+
+    const FlatGraph::Index consumerIdx = flatGraph.nodeIndex(consumer);
+    if (consumerIdx == FlatGraph::INVALID_IDX) return false;
+    addDataProducers(consumerIdx);
 
     while (!candidateProducers.empty())
     {
-        const auto& currProducer = candidateProducers.back();
+        const FlatGraph::Index currIdx = candidateProducers.back();
         candidateProducers.pop_back();
+        const NodePtr& currProducer = flatGraph.node(currIdx);
         if (currProducer == targetProducer)
         {
             return true;
@@ -26,8 +40,7 @@ bool areAdjacentNodes(HabanaGraph& g, const NodePtr& consumer, const NodePtr& ta
 
         if (currProducer->isLogicalOperation())
         {
-            const auto& newCandidates = g.getNodeProducers(currProducer);
-            std::copy(newCandidates.begin(), newCandidates.end(), std::back_inserter(candidateProducers));
+            addDataProducers(currIdx);
         }
     }
     return false;
@@ -40,9 +53,12 @@ bool areAdjacentNodes(HabanaGraph& g, const NodePtr& consumer, const NodePtr& ta
 bool validateAtomicNodes(HabanaGraph& g)
 {
     const auto& atomicNodes = g.getGraphAnnotation().atomicNodes;
+    if (atomicNodes.empty()) return true;
+
+    const FlatGraph& flatGraph = g.getFlatGraph();
     for (const auto& [producer, consumer] : atomicNodes)
     {
-        if (!areAdjacentNodes(g, consumer, producer))
+        if (!areAdjacentNodes(flatGraph, consumer, producer))
         {
             LOG_CRITICAL(GC,
                          "Expected atomic nodes pair (producer node: {}, consumer node: {}) to be adjacent, but got "
@@ -1,5 +1,6 @@
 
 #include "small_fcd_perf_check.h"
+#include "flat_graph.h"
 #include "habana_graph.h"
 #include "include/mme_common/mme_brain.h"
 #include "types.h"
@@ -25,10 +26,14 @@ SmallFcdPerfCheck::SmallFcdPerfCheck(const HabanaGraph& g) : GcPerf::GcPerfCheck
 
 unsigned SmallFcdPerfCheck::getNumberOfReads(const TensorPtr& t) const
 {
-    unsigned ret = 0;
-    for (const auto& consumer : m_graph.getTensorConsumers(t))
+    unsigned         ret       = 0;
+    const FlatGraph& flatGraph = m_graph.getFlatGraph();
+    const auto       tensorIdx = flatGraph.tensorIndex(t);
+    if (tensorIdx == FlatGraph::INVALID_IDX) return ret;
+
+    for (FlatGraph::Index consumerIdx : flatGraph.tensorConsumers(tensorIdx))
     {
-        if (!consumer) continue;
+        const NodePtr& consumer = flatGraph.node(consumerIdx);
         ++ret;
         if (m_graph.runsOnMME(consumer))
         {
@@ -4,6 +4,7 @@
 #include "data_type_utils.h"
 #include "define_synapse_common.hpp"
 #include "defs.h"
+#include "graph_arena.h"
 #include "node.h"
 #include "quantization_data.h"
 #include "quantization_utils.h"
@@ -1678,7 +1679,7 @@ std::shared_ptr<Tensor> Tensor::clone(bool                  copyAddresses /*fals
                                       bool                  keepPersistent /*false*/,
                                       TensorNameClonePolicy namePolicy) const
 {
-    std::shared_ptr<Tensor> pClone = std::make_shared<Tensor>(*this, copyAddresses, copyData, namePolicy);
+    std::shared_ptr<Tensor> pClone = makeGraphObject<Tensor>(*this, copyAddresses, copyData, namePolicy);
 
     if (!keepPersistent)
     {
@@ -4,9 +4,9 @@
 #include <algorithm>
 #include <cstring>
 
-BitArray2D::BitArray2D(uint32_t numRows) : m_n(numRows), m_storage(getRowSize(numRows) * numRows, 0) {}
+inline BitArray2D::BitArray2D(uint32_t numRows) : m_n(numRows), m_storage(getRowSize(numRows) * numRows, 0) {}
 
-bool BitArray2D::getBit(uint32_t row, uint32_t col) const
+inline bool BitArray2D::getBit(uint32_t row, uint32_t col) const
 {
     uint32_t colIndex     = col / BITS_IN_UINT64;
     uint32_t elementIndex = row * getRowSize(m_n) + colIndex;
@@ -14,7 +14,7 @@ bool BitArray2D::getBit(uint32_t row, uint32_t col) const
     return (m_storage[elementIndex] >> bitOffset) & 1;
 }
 
-void BitArray2D::setBit(uint32_t row, uint32_t col, bool value)
+inline void BitArray2D::setBit(uint32_t row, uint32_t col, bool value)
 {
     uint32_t colIndex     = col / BITS_IN_UINT64;
     uint32_t elementIndex = row * getRowSize(m_n) + colIndex;
@@ -30,7 +30,7 @@ void BitArray2D::setBit(uint32_t row, uint32_t col, bool value)
     }
 }
 
-void BitArray2D::copyRow(uint32_t srcRow, uint32_t destRow)
+inline void BitArray2D::copyRow(uint32_t srcRow, uint32_t destRow)
 {
     size_t elementsPerRow = getRowSize(m_n);
     std::memcpy(&m_storage[destRow * elementsPerRow],
@@ -38,7 +38,7 @@ void BitArray2D::copyRow(uint32_t srcRow, uint32_t destRow)
                 elementsPerRow * sizeof(uint64_t));
 }
 
-void BitArray2D::bitwiseOr(uint32_t row1, uint32_t row2, uint32_t destRow)
+inline void BitArray2D::bitwiseOr(uint32_t row1, uint32_t row2, uint32_t destRow)
 {
     size_t elementsPerRow = getRowSize(m_n);
     for (uint32_t i = 0; i < elementsPerRow; ++i)
@@ -48,7 +48,7 @@ void BitArray2D::bitwiseOr(uint32_t row1, uint32_t row2, uint32_t destRow)
     }
 }
 
-void BitArray2D::bitwiseAnd(uint32_t row1, uint32_t row2, uint32_t destRow)
+inline void BitArray2D::bitwiseAnd(uint32_t row1, uint32_t row2, uint32_t destRow)
 {
     size_t elementsPerRow = getRowSize(m_n);
     for (uint32_t i = 0; i < elementsPerRow; ++i)
@@ -58,7 +58,7 @@ void BitArray2D::bitwiseAnd(uint32_t row1, uint32_t row2, uint32_t destRow)
     }
 }
 
-void BitArray2D::setDiagonal()
+inline void BitArray2D::setDiagonal()
 {
     size_t elementsPerRow = getRowSize(m_n);
     for (uint32_t i = 0; i < m_n; ++i)
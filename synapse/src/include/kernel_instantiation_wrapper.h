@@ -8,6 +8,7 @@
 #include <string>
 
 class TPCNode;
+struct CachedTpcInstantiation;
 
 template<typename T>
 class TensorOperandsVector
@@ -100,6 +101,10 @@ private:
     void prepareElfBuffer(uint64_t bufferSize);
     void resetKernelInstantiationParams();
 
+    // Copies the instantiation outputs to/from the process-wide TPC instantiation cache
+    std::shared_ptr<const CachedTpcInstantiation> captureInstantiation() const;
+    void                                          restoreInstantiation(const CachedTpcInstantiation& cached);
+
     struct TensorOperandCounts
     {
         uint8_t inputTensorCount  = 0;
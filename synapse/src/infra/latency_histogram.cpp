@@ -0,0 +1,119 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_RDTSC
+#endif
+
+namespace TscClock
+{
+uint64_t now()
+{
+#ifdef HAS_RDTSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+static double calibrate()
+{
+#ifdef HAS_RDTSC
+    // Long enough for a sub-percent error, once per process
+    const auto     steadyStart = std::chrono::steady_clock::now();
+    const uint64_t tscStart    = now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const uint64_t tscEnd    = now();
+    const auto     steadyEnd = std::chrono::steady_clock::now();
+
+    const double elapsedNs = std::chrono::duration<double, std::nano>(steadyEnd - steadyStart).count();
+    return (tscEnd > tscStart) ? elapsedNs / (tscEnd - tscStart) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+double nsPerTick()
+{
+    static const double s_nsPerTick = calibrate();
+    return s_nsPerTick;
+}
+}  // namespace TscClock
+
+unsigned LatencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) return value;
+
+    const unsigned msb   = 63 - __builtin_clzll(value);
+    const unsigned shift = msb - SUB_BUCKET_BITS;
+    return ((shift + 1) << SUB_BUCKET_BITS) + ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(unsigned bucketIdx)
+{
+    if (bucketIdx < SUB_BUCKET_COUNT) return bucketIdx;
+
+    const unsigned shift = (bucketIdx >> SUB_BUCKET_BITS) - 1;
+    const uint64_t lower = (uint64_t)(SUB_BUCKET_COUNT + (bucketIdx & (SUB_BUCKET_COUNT - 1))) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t currMin = m_min.load(std::memory_order_relaxed);
+    while (value < currMin && !m_min.compare_exchange_weak(currMin, value, std::memory_order_relaxed))
+    {
+    }
+    uint64_t currMax = m_max.load(std::memory_order_relaxed);
+    while (value > currMax && !m_max.compare_exchange_weak(currMax, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMin() const
+{
+    const uint64_t currMin = m_min.load(std::memory_order_relaxed);
+    return currMin == std::numeric_limits<uint64_t>::max() ? 0 : currMin;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const
+{
+    const uint64_t count = getCount();
+    if (count == 0) return 0;
+
+    // The rank of the value, 1 based
+    uint64_t rank = (uint64_t)(percentile / 100.0 * count + 0.5);
+    rank          = std::max<uint64_t>(std::min(rank, count), 1);
+
+    uint64_t accumulated = 0;
+    for (unsigned bucketIdx = 0; bucketIdx < NUM_BUCKETS; bucketIdx++)
+    {
+        accumulated += m_buckets[bucketIdx].load(std::memory_order_relaxed);
+        if (accumulated >= rank)
+        {
+            return std::min(bucketUpperBound(bucketIdx), getMax());
+        }
+    }
+    return getMax();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+// Cycle counter for latency measurements on hot paths, rdtsc on x86 (steady clock otherwise)
+namespace TscClock
+{
+uint64_t now();
+
+// Calibrated against the steady clock on first use
+double nsPerTick();
+
+inline uint64_t ticksToNs(uint64_t ticks)
+{
+    return (uint64_t)(ticks * nsPerTick());
+}
+}  // namespace TscClock
+
+/**
+ * Lock-free latency histogram with HDR-style buckets
+ *
+ * Values are bucketed log-linearly: every power of 2 range is split to 2^SUB_BUCKET_BITS linear buckets, so the
+ * relative error of a reported value is below 2^-SUB_BUCKET_BITS (~6%) over the whole uint64 range, in a fixed array.
+ * record() is a few relaxed atomic adds, so the histogram may be updated by any thread and read (e.g. dumped) while
+ * updated. A reader may see a count which is not yet reflected in the buckets, percentiles are approximate anyway.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS  = 4;
+    static constexpr unsigned SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr unsigned NUM_BUCKETS      = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram() { reset(); }
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t getSum() const { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t getMin() const;
+    uint64_t getMax() const { return m_max.load(std::memory_order_relaxed); }
+
+    // The upper bound of the bucket holding the value at the given percentile (0-100), 0 if empty
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    static unsigned bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(unsigned bucketIdx);
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> m_buckets;
+    std::atomic<uint64_t>                          m_count;
+    std::atomic<uint64_t>                          m_sum;
+    std::atomic<uint64_t>                          m_min;
+    std::atomic<uint64_t>                          m_max;
+};
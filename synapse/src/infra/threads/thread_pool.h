@@ -1,19 +1,20 @@
 #pragma once
 
-#include <condition_variable>
-#include <list>
-#include <mutex>
-#include <thread>
-#include <vector>
+#include <cstdint>
+#include <memory>
 
 namespace synapse
 {
 
 class ThreadWorkItem;
+class WorkStealingPool;
 
 /**
  * Utility to manage number of threads executing work items
  *
+ * The threads are owned by the ThreadPool instance, and the work items are distributed between them using a
+ * work-stealing pool. Users which don't need dedicated threads may use WorkStealingPool::instance() instead.
+ *
  * Note: ThreadPool itself is not thread safe
  *       it protect only its own created threads.
  *       start() and finish() MUST BE CALLED FROM THE SAME THREAD
@@ -44,17 +45,8 @@ public:
     bool addJob(ThreadWorkItem* workItem);
 
 private:
-    void threadWorkFunction();
-
-    const uint32_t m_numOfThreads;
-    std::list<ThreadWorkItem*> m_workItems;
-    std::vector<std::thread> m_threads;
-
-    std::mutex m_mutex;
-    std::condition_variable m_cv;
-
-    volatile bool m_working;
-    volatile bool m_stop;
+    const uint32_t                    m_numOfThreads;
+    std::unique_ptr<WorkStealingPool> m_pool;
 };
 
 }
@@ -0,0 +1,380 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include <cerrno>
+#include <chrono>
+
+#include "habana_global_conf.h"
+#include "log_manager.h"
+
+#include "work_stealing_pool.h"
+
+namespace synapse
+{
+
+static thread_local const WorkStealingPool* t_currentPool      = nullptr;
+static thread_local int32_t                 t_currentWorkerIdx = -1;
+
+WorkStealingDeque::WorkStealingDeque(uint64_t initialCapacity) : m_top(0), m_bottom(0)
+{
+    uint64_t capacity = 1;
+    while (capacity < initialCapacity)
+    {
+        capacity <<= 1;
+    }
+    m_buffers.push_back(std::make_unique<Buffer>(capacity));
+    m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::Buffer* WorkStealingDeque::grow(Buffer* buffer, int64_t top, int64_t bottom)
+{
+    m_buffers.push_back(std::make_unique<Buffer>(buffer->capacity * 2));
+    Buffer* newBuffer = m_buffers.back().get();
+    for (int64_t i = top; i < bottom; ++i)
+    {
+        newBuffer->put(i, buffer->get(i));
+    }
+    m_buffer.store(newBuffer, std::memory_order_release);
+    return newBuffer;
+}
+
+void WorkStealingDeque::push(ThreadWorkItem* workItem)
+{
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    const int64_t top    = m_top.load(std::memory_order_acquire);
+    Buffer*       buffer = m_buffer.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->capacity) - 1)
+    {
+        buffer = grow(buffer, top, bottom);
+    }
+    buffer->put(bottom, workItem);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+ThreadWorkItem* WorkStealingDeque::pop()
+{
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Buffer*       buffer = m_buffer.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // Empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    ThreadWorkItem* workItem = buffer->get(bottom);
+    if (top == bottom)
+    {
+        // Last item, race against the thieves
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            workItem = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return workItem;
+}
+
+ThreadWorkItem* WorkStealingDeque::steal()
+{
+    int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+
+    Buffer*         buffer   = m_buffer.load(std::memory_order_acquire);
+    ThreadWorkItem* workItem = buffer->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return workItem;
+}
+
+bool WorkStealingDeque::empty() const
+{
+    return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+}
+
+WorkStealingPool::WorkStealingPool(uint32_t numOfThreads, bool pinThreads) : m_pinThreads(pinThreads)
+{
+    // If only one thread - using the calling thread
+    if (numOfThreads <= 1) return;
+
+    if (m_pinThreads)
+    {
+        m_pinnedCpus = getAllowedCpus();
+    }
+    for (uint32_t i = 0; i < numOfThreads; ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    // Start the threads only once all the deques exist, since workers steal from each other
+    for (uint32_t i = 0; i < numOfThreads; ++i)
+    {
+        m_workers[i]->thread = std::thread(&WorkStealingPool::workerFunction, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_sleepCv.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::instance()
+{
+    static WorkStealingPool pool(GCFG_SHARED_THREAD_POOL_NUM_THREADS.value() != 0
+                                     ? GCFG_SHARED_THREAD_POOL_NUM_THREADS.value()
+                                     : getAllowedCpus().size(),
+                                 GCFG_THREAD_POOL_PIN_THREADS.value());
+    return pool;
+}
+
+std::vector<uint32_t> WorkStealingPool::getAllowedCpus()
+{
+    std::vector<uint32_t> cpus;
+    cpu_set_t             cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0)
+    {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    else
+    {
+        LOG_WARN(SYN_API, "Failed to get the process cpu affinity, errno {}", errno);
+        for (uint32_t cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+int32_t WorkStealingPool::currentWorkerIdx() const
+{
+    return t_currentPool == this ? t_currentWorkerIdx : -1;
+}
+
+void WorkStealingPool::submit(ThreadWorkItem* workItem)
+{
+    if (workItem == nullptr) return;
+
+    if (m_workers.empty())
+    {
+        workItem->call();
+        return;
+    }
+
+    m_nofInFlight++;
+    m_nofQueued++;
+
+    const int32_t workerIdx = currentWorkerIdx();
+    if (workerIdx >= 0)
+    {
+        m_workers[workerIdx]->deque.push(workItem);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_injectionMutex);
+        m_injectionQueue.push_back(workItem);
+        m_nofInjected++;
+    }
+
+    // A worker going to sleep registers itself before checking for queued work, so either it sees the new item or we
+    // see it and wake it up
+    if (m_nofSleepers > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_sleepCv.notify_one();
+    }
+}
+
+ThreadWorkItem* WorkStealingPool::popInjected()
+{
+    if (m_nofInjected == 0) return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_injectionMutex);
+    if (m_injectionQueue.empty()) return nullptr;
+
+    ThreadWorkItem* workItem = m_injectionQueue.front();
+    m_injectionQueue.pop_front();
+    m_nofInjected--;
+    return workItem;
+}
+
+ThreadWorkItem* WorkStealingPool::findWork(int32_t workerIdx)
+{
+    ThreadWorkItem* workItem = nullptr;
+    if (workerIdx >= 0)
+    {
+        workItem = m_workers[workerIdx]->deque.pop();
+    }
+    if (workItem == nullptr)
+    {
+        workItem = popInjected();
+    }
+
+    // Steal starting from the next worker, so thieves spread over the victims
+    const uint32_t nofWorkers = m_workers.size();
+    const uint32_t firstVictim = workerIdx >= 0 ? workerIdx + 1 : 0;
+    for (uint32_t i = 0; workItem == nullptr && i < nofWorkers; ++i)
+    {
+        const uint32_t victim = (firstVictim + i) % nofWorkers;
+        if (static_cast<int32_t>(victim) == workerIdx) continue;
+        workItem = m_workers[victim]->deque.steal();
+    }
+
+    if (workItem != nullptr)
+    {
+        m_nofQueued--;
+    }
+    return workItem;
+}
+
+void WorkStealingPool::run(ThreadWorkItem* workItem)
+{
+    workItem->call();
+
+    if (--m_nofInFlight == 0)
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_idleCv.notify_all();
+    }
+}
+
+bool WorkStealingPool::tryRunPendingItem()
+{
+    ThreadWorkItem* workItem = findWork(currentWorkerIdx());
+    if (workItem == nullptr) return false;
+
+    run(workItem);
+    return true;
+}
+
+void WorkStealingPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idleCv.wait(lock, [this] { return m_nofInFlight == 0; });
+}
+
+void WorkStealingPool::pinThread(uint32_t workerIdx)
+{
+    if (m_pinnedCpus.empty()) return;
+
+    const uint32_t cpu = m_pinnedCpus[workerIdx % m_pinnedCpus.size()];
+    cpu_set_t      cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    const int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (rc != 0)
+    {
+        LOG_WARN(SYN_API, "Failed to pin thread pool worker {} to cpu {}, error {}", workerIdx, cpu, rc);
+    }
+}
+
+void WorkStealingPool::workerFunction(uint32_t workerIdx)
+{
+    static const unsigned MAX_IDLE_SPINS = 64;
+
+    t_currentPool      = this;
+    t_currentWorkerIdx = workerIdx;
+    if (m_pinThreads)
+    {
+        pinThread(workerIdx);
+    }
+
+    unsigned idleSpins = 0;
+    while (true)
+    {
+        ThreadWorkItem* workItem = findWork(workerIdx);
+        if (workItem != nullptr)
+        {
+            run(workItem);
+            idleSpins = 0;
+            continue;
+        }
+
+        // Fine-grained loads submit work in bursts, yield for a while before going to sleep
+        if (idleSpins++ < MAX_IDLE_SPINS)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (m_stop && m_nofQueued == 0) return;
+
+        m_nofSleepers++;
+        m_sleepCv.wait(lock, [this] { return m_nofQueued > 0 || m_stop; });
+        m_nofSleepers--;
+        idleSpins = 0;
+    }
+}
+
+TaskGroup::~TaskGroup()
+{
+    join();
+}
+
+void TaskGroup::join()
+{
+    static const std::chrono::microseconds HELP_POLL_INTERVAL(100);
+
+    while (m_nofPending > 0)
+    {
+        // Help executing pending work instead of blocking a worker thread
+        if (m_pool.tryRunPendingItem()) continue;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCv.wait_for(lock, HELP_POLL_INTERVAL, [this] { return m_nofPending == 0; });
+    }
+
+    // The last task may still hold the lock after it decremented the counter
+    std::lock_guard<std::mutex> lock(m_mutex);
+}
+
+void TaskGroup::wait()
+{
+    join();
+
+    if (m_exception != nullptr)
+    {
+        std::exception_ptr exception = m_exception;
+        m_exception                  = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::onTaskDone(std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (exception != nullptr && m_exception == nullptr)
+    {
+        m_exception = exception;
+    }
+    if (--m_nofPending == 0)
+    {
+        m_doneCv.notify_all();
+    }
+}
+
+}  // namespace synapse
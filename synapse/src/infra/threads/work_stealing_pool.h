@@ -0,0 +1,214 @@
+#pragma once
+
+#include "thread_work_item.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace synapse
+{
+
+/**
+ * Lock-free work-stealing deque (Chase-Lev)
+ *
+ * The owner thread pushes and pops work items at the bottom, any other thread may steal from the top.
+ * Retired buffers are kept until destruction, so a thief never reads from a freed buffer.
+ */
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(uint64_t initialCapacity = 256);
+
+    // Owner thread only
+    void            push(ThreadWorkItem* workItem);
+    ThreadWorkItem* pop();
+
+    // Any thread, returns nullptr if the deque is empty or if the steal lost a race
+    ThreadWorkItem* steal();
+
+    bool empty() const;
+
+private:
+    struct Buffer
+    {
+        explicit Buffer(uint64_t cap) : capacity(cap), items(new std::atomic<ThreadWorkItem*>[cap]) {}
+
+        ThreadWorkItem* get(int64_t idx) const { return items[idx & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t idx, ThreadWorkItem* item) { items[idx & (capacity - 1)].store(item, std::memory_order_relaxed); }
+
+        const uint64_t                                    capacity;
+        std::unique_ptr<std::atomic<ThreadWorkItem*>[]> items;
+    };
+
+    Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom);
+
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    std::atomic<Buffer*>                 m_buffer;
+    std::vector<std::unique_ptr<Buffer>> m_buffers;  // current and retired buffers, owner thread only
+};
+
+/**
+ * Work-stealing thread pool
+ *
+ * Every worker owns a deque. Work submitted by a worker is pushed to its own deque, work submitted by any other thread
+ * goes to a shared injection queue. Idle workers steal from the other workers' deques.
+ * A process-wide pool is available through instance(), so the graph compiler and the runtime helpers don't need to
+ * create threads of their own.
+ *
+ * Note: submit() and async() are thread safe. A pool without workers executes the work on the submitting thread.
+ */
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(uint32_t numOfThreads, bool pinThreads = false);
+
+    // Executes all submitted work and joins the workers
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    static WorkStealingPool& instance();
+
+    // The CPUs of the process affinity mask, the pinned workers are spread over them only
+    static std::vector<uint32_t> getAllowedCpus();
+
+    uint32_t getNumOfThreads() const { return m_workers.size(); }
+
+    // The pool owns the work item once submitted (deleted according to ThreadWorkItem::shouldDeleteItem)
+    void submit(ThreadWorkItem* workItem);
+
+    // Fire and forget, func must not throw
+    template<class F>
+    void execute(F&& func);
+
+    template<class F>
+    std::future<std::invoke_result_t<F>> async(F&& func);
+
+    // Executes a single pending work item on the calling thread, returns false if none was found
+    bool tryRunPendingItem();
+
+    // Blocks until all submitted work was executed, must not be called from the pool's own work items
+    void waitIdle();
+
+private:
+    template<class F>
+    class FunctionWorkItem : public ThreadWorkItem
+    {
+    public:
+        explicit FunctionWorkItem(F&& func) : m_func(std::move(func)) {}
+        void doWork() override { m_func(); }
+
+    private:
+        F m_func;
+    };
+
+    struct Worker
+    {
+        WorkStealingDeque deque;
+        std::thread       thread;
+    };
+
+    void            workerFunction(uint32_t workerIdx);
+    ThreadWorkItem* findWork(int32_t workerIdx);
+    ThreadWorkItem* popInjected();
+    void            run(ThreadWorkItem* workItem);
+    void            pinThread(uint32_t workerIdx);
+    int32_t         currentWorkerIdx() const;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    const bool                           m_pinThreads;
+    std::vector<uint32_t>                m_pinnedCpus;  // worker i is pinned to m_pinnedCpus[i % size]
+
+    std::mutex                  m_injectionMutex;
+    std::deque<ThreadWorkItem*> m_injectionQueue;
+    std::atomic<uint64_t>       m_nofInjected {0};
+
+    std::atomic<uint64_t> m_nofQueued {0};    // submitted and not yet picked up by any thread
+    std::atomic<uint64_t> m_nofInFlight {0};  // submitted and not yet executed
+    std::atomic<uint32_t> m_nofSleepers {0};
+    std::mutex            m_sleepMutex;
+    std::condition_variable m_sleepCv;
+    std::condition_variable m_idleCv;
+    bool                    m_stop = false;
+};
+
+/**
+ * Group of tasks submitted to a work-stealing pool, which can be joined
+ *
+ * wait() executes pending work on the calling thread until all the tasks of the group are done, so groups may be
+ * nested within tasks of the same pool. The first exception thrown by a task is rethrown by wait().
+ */
+class TaskGroup
+{
+public:
+    explicit TaskGroup(WorkStealingPool& pool = WorkStealingPool::instance()) : m_pool(pool) {}
+
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template<class F>
+    void run(F&& func);
+
+    void wait();
+
+private:
+    void join();
+    void onTaskDone(std::exception_ptr exception);
+
+    WorkStealingPool&       m_pool;
+    std::atomic<uint64_t>   m_nofPending {0};
+    std::mutex              m_mutex;
+    std::condition_variable m_doneCv;
+    std::exception_ptr      m_exception;
+};
+
+template<class F>
+void WorkStealingPool::execute(F&& func)
+{
+    using Func = std::decay_t<F>;
+    submit(new FunctionWorkItem<Func>(Func(std::forward<F>(func))));
+}
+
+template<class F>
+std::future<std::invoke_result_t<F>> WorkStealingPool::async(F&& func)
+{
+    using Result = std::invoke_result_t<F>;
+    std::packaged_task<Result()> task(std::forward<F>(func));
+    auto                         future = task.get_future();
+    execute(std::move(task));
+    return future;
+}
+
+template<class F>
+void TaskGroup::run(F&& func)
+{
+    m_nofPending++;
+    m_pool.execute([this, f = std::forward<F>(func)]() mutable {
+        std::exception_ptr exception;
+        try
+        {
+            f();
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+        onTaskDone(exception);
+    });
+}
+
+}  // namespace synapse
@@ -62,7 +62,7 @@ Gaudi2Graph::Gaudi2Graph(uint64_t sramSize, uint64_t dramSize)
     LOG_DEBUG(GC, "Mark graph as DRAM allocated");
     getGraphAnnotation().memoryStrategyParams.allocatinMode = ALL_IN_DRAM;
     getGraphAnnotation().memoryStrategyParams.dramInfo.enableDramAlloc = true;
-    m_preDataTypeSelection = GCFG_SYNAPSE_DATA_TYPE_SELECTION.value();
+    m_preDataTypeSelection = true;
 
     m_nodeCostModel = std::make_shared<gaudi2::NodeCostModel>(*this);
 }
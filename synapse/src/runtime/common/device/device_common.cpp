@@ -691,6 +691,74 @@ synStatus DeviceCommon::launchWithExternalEvents(const synStreamHandle         s
                   flags);
 }
 
+synStatus DeviceCommon::launchBatch(const synStreamHandle     streamHandle,
+                                    const synLaunchBatchInfo* launchBatchInfo,
+                                    uint32_t                  numberOfLaunches,
+                                    uint32_t&                 rNumOfLaunched)
+{
+    rNumOfLaunched = 0;
+
+    for (uint32_t i = 0; i < numberOfLaunches; i++)
+    {
+        const synRecipeHandle pRecipeHandle = launchBatchInfo[i].pRecipeHandle;
+        if (m_devType != pRecipeHandle->deviceAgnosticRecipeHandle.m_deviceType)
+        {
+            LOG_ERR(SYN_API,
+                    "The device type {} does not match the recipe device type {} (launch index {})",
+                    m_devType,
+                    pRecipeHandle->deviceAgnosticRecipeHandle.m_deviceType,
+                    i);
+            return synInvalidArgument;
+        }
+    }
+
+    auto streamSptr = loadAndValidateStream(streamHandle, __FUNCTION__);
+    if (streamSptr == nullptr)
+    {
+        return synInvalidArgument;
+    }
+
+    if (numberOfLaunches == 0)
+    {
+        return synSuccess;
+    }
+
+    std::vector<synLaunchBatchInfo> alignedLaunchBatchInfo(launchBatchInfo, launchBatchInfo + numberOfLaunches);
+    for (synLaunchBatchInfo& rLaunch : alignedLaunchBatchInfo)
+    {
+        rLaunch.pWorkspace = QueueComputeUtils::getAlignedWorkspaceAddress(rLaunch.pWorkspace);
+    }
+
+    return launchBatch(streamSptr.get(), alignedLaunchBatchInfo.data(), numberOfLaunches, rNumOfLaunched);
+}
+
+synStatus DeviceCommon::launchBatch(Stream*                   pStream,
+                                    const synLaunchBatchInfo* launchBatchInfo,
+                                    uint32_t                  numberOfLaunches,
+                                    uint32_t&                 rNumOfLaunched)
+{
+    EventWithMappedTensorDB events;
+
+    for (rNumOfLaunched = 0; rNumOfLaunched < numberOfLaunches; rNumOfLaunched++)
+    {
+        const synLaunchBatchInfo& rLaunch = launchBatchInfo[rNumOfLaunched];
+
+        synStatus status = launch(pStream,
+                                  rLaunch.launchTensorsInfoExt,
+                                  rLaunch.numberOfTensors,
+                                  rLaunch.pWorkspace,
+                                  rLaunch.pRecipeHandle,
+                                  events,
+                                  rLaunch.flags);
+        if (status != synSuccess)
+        {
+            return status;
+        }
+    }
+
+    return synSuccess;
+}
+
 synStatus DeviceCommon::memcopy(const synStreamHandle  streamHandle,
                                 internalMemcopyParams& memcpyParams,
                                 const internalDmaDir   direction,
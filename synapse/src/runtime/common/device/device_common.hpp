@@ -122,6 +122,11 @@ public:
                                                uint32_t                      numberOfEvents,
                                                uint32_t                      flags) override;
 
+    virtual synStatus launchBatch(const synStreamHandle     streamHandle,
+                                  const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint32_t&                 rNumOfLaunched) override;
+
     virtual synStatus memcopy(const synStreamHandle  streamHandle,
                               internalMemcopyParams& memcpyParams,
                               const internalDmaDir   direction,
@@ -269,6 +274,12 @@ protected:
                              EventWithMappedTensorDB&      events,
                              uint32_t                      flags) = 0;
 
+    // The batch entries workspace addresses are already aligned. Launches the entries one by one, unless overridden
+    virtual synStatus launchBatch(Stream*                   pStream,
+                                  const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint32_t&                 rNumOfLaunched);
+
     synStatus addStreamAffinities(const AffinityCountersArray& rAffinityArr, bool isReduced);
 
     synStatus removeAllStreamAffinities();
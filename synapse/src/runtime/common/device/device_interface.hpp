@@ -119,6 +119,13 @@ public:
                                                uint32_t                      numberOfEvents,
                                                uint32_t                      flags) = 0;
 
+    // Launches the batch entries in order, stopping at the first failure.
+    // rNumOfLaunched is set to the number of the entries that were launched
+    virtual synStatus launchBatch(const synStreamHandle     streamHandle,
+                                  const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint32_t&                 rNumOfLaunched) = 0;
+
     virtual synStatus memcopy(const synStreamHandle  streamHandle,
                               internalMemcopyParams& memcpyParams,
                               const internalDmaDir   direction,
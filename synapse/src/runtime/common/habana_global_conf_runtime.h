@@ -28,6 +28,8 @@ extern GlobalConfUint64    GCFG_HOST_CYCLIC_BUFFER_SIZE;
 extern GlobalConfUint64    GCFG_HOST_CYCLIC_BUFFER_CHUNKS_AMOUNT;
 extern GlobalConfBool      GCFG_ENABLE_SAMPLING_HOST_CYCLIC_BUFFER_WATERMARK;
 extern GlobalConfBool      GCFG_DFA_SAVE_RECIPE;
+extern GlobalConfString    GCFG_RECIPE_DISK_CACHE_PATH;
+extern GlobalConfUint64    GCFG_RECIPE_DISK_CACHE_MAX_SIZE;
 
 // Gaudi:
 extern GlobalConfUint64    GCFG_RECIPE_CACHE_SIZE;
@@ -57,7 +59,15 @@ extern GlobalConfUint64    GCFG_NUM_OF_DCS_PER_CANARY_PROTECTION_HEADER;
 extern GlobalConfBool      GCFG_PARSE_EACH_COMPUTE_CS;
 extern GlobalConfBool      GCFG_ENABLE_WIDE_BUCKET;
 extern GlobalConfBool      GCFG_DISABLE_SYNAPSE_HUGE_PAGES;
+extern GlobalConfBool      GCFG_ENABLE_NUMA_AWARE_HOST_PLACEMENT;
 extern GlobalConfUint64    GCFG_NUM_OF_USER_STREAM_EVENTS;
+extern GlobalConfUint64    GCFG_DSD_SIF_CACHE_SIZE;
+extern GlobalConfUint64    GCFG_PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS;
+extern GlobalConfUint64    GCFG_PARALLEL_LAUNCH_PREP_NUM_THREADS;
+extern GlobalConfBool      GCFG_ENABLE_LAUNCH_LATENCY_STATS;
+extern GlobalConfString    GCFG_LAUNCH_LATENCY_STATS_FILE;
 
 // Gaudi 2:
 extern GlobalConfUint64    GCFG_SCAL_RECIPE_LAUNCHER_DEBUG_MODE;
+extern GlobalConfBool      GCFG_ENABLE_DELTA_PATCHING;
+extern GlobalConfBool      GCFG_ENABLE_SIMD_PATCHING;
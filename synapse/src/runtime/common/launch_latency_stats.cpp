@@ -0,0 +1,128 @@
+#include "launch_latency_stats.hpp"
+
+#include "habana_global_conf_runtime.h"
+#include "json_utils.h"
+#include "log_manager.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+static thread_local LaunchLatencyStats* s_currentStats = nullptr;
+
+static std::mutex                                       s_registryMutex;
+static std::vector<std::shared_ptr<LaunchLatencyStats>> s_registry;
+
+std::shared_ptr<LaunchLatencyStats> LaunchLatencyStats::create(const std::string& streamName)
+{
+    if (!GCFG_ENABLE_LAUNCH_LATENCY_STATS.value()) return nullptr;
+
+    // The constructor is private, so make_shared can't be used
+    std::shared_ptr<LaunchLatencyStats> stats(new LaunchLatencyStats(streamName));
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    s_registry.push_back(stats);
+    return stats;
+}
+
+LaunchLatencyStats* LaunchLatencyStats::current()
+{
+    return s_currentStats;
+}
+
+const char* LaunchLatencyStats::stageName(LaunchStage stage)
+{
+    switch (stage)
+    {
+        case LaunchStage::TOTAL:             return "total";
+        case LaunchStage::CHECK_COMPLETION:  return "check_completion";
+        case LaunchStage::MAPPED_MEM:        return "mapped_mem";
+        case LaunchStage::ANALYZE_TENSORS:   return "analyze_tensors";
+        case LaunchStage::SIF:               return "sif";
+        case LaunchStage::COPY_TO_MAPPED:    return "copy_to_mapped";
+        case LaunchStage::PATCHING:          return "patching";
+        case LaunchStage::DOWNLOAD:          return "download";
+        case LaunchStage::ENQUEUE:           return "enqueue";
+        case LaunchStage::CYCLIC_BUFFER_ADD: return "cyclic_buffer_add";
+        case LaunchStage::LAST:              break;
+    }
+    return "unknown";
+}
+
+nlohmann_hcl::json LaunchLatencyStats::toJson() const
+{
+    static constexpr std::pair<const char*, double> percentiles[] = {{"p50", 50},
+                                                                     {"p90", 90},
+                                                                     {"p99", 99},
+                                                                     {"p999", 99.9},
+                                                                     {"p9999", 99.99}};
+
+    nlohmann_hcl::json stages = nlohmann_hcl::json::object();
+    for (unsigned stageIdx = 0; stageIdx < (unsigned)LaunchStage::LAST; stageIdx++)
+    {
+        const LatencyHistogram& histogram = m_histograms[stageIdx];
+        const uint64_t          count     = histogram.getCount();
+        if (count == 0) continue;
+
+        nlohmann_hcl::json stage;
+        stage["count"]   = count;
+        stage["min_ns"]  = TscClock::ticksToNs(histogram.getMin());
+        stage["mean_ns"] = TscClock::ticksToNs(histogram.getSum() / count);
+        stage["max_ns"]  = TscClock::ticksToNs(histogram.getMax());
+        for (const auto& [name, percentile] : percentiles)
+        {
+            stage[std::string(name) + "_ns"] = TscClock::ticksToNs(histogram.getValueAtPercentile(percentile));
+        }
+        stages[stageName((LaunchStage)stageIdx)] = std::move(stage);
+    }
+
+    nlohmann_hcl::json json;
+    json["stream"] = m_streamName;
+    json["stages"] = std::move(stages);
+    return json;
+}
+
+void LaunchLatencyStats::reset()
+{
+    for (LatencyHistogram& histogram : m_histograms)
+    {
+        histogram.reset();
+    }
+}
+
+nlohmann_hcl::json LaunchLatencyStats::allToJson()
+{
+    nlohmann_hcl::json streams = nlohmann_hcl::json::array();
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    for (const auto& stats : s_registry)
+    {
+        streams.push_back(stats->toJson());
+    }
+    return streams;
+}
+
+void LaunchLatencyStats::dumpAll()
+{
+    if (!GCFG_LAUNCH_LATENCY_STATS_FILE.value().empty())
+    {
+        LOG_INFO(SYN_API, "Writing launch latency stats to {}", GCFG_LAUNCH_LATENCY_STATS_FILE.value());
+        json_utils::jsonToFile(allToJson(), GCFG_LAUNCH_LATENCY_STATS_FILE.value(), 4);
+    }
+
+    // Only the registry holds the stats of destroyed streams
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    s_registry.erase(
+        std::remove_if(s_registry.begin(), s_registry.end(), [](const auto& stats) { return stats.use_count() == 1; }),
+        s_registry.end());
+}
+
+ScopedLaunchLatencyStats::ScopedLaunchLatencyStats(LaunchLatencyStats* stats) : m_prevStats(s_currentStats)
+{
+    s_currentStats = stats;
+}
+
+ScopedLaunchLatencyStats::~ScopedLaunchLatencyStats()
+{
+    s_currentStats = m_prevStats;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "infra/latency_histogram.hpp"
+#include "json.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// The host side stages of a launch, see LaunchLatencyStats
+enum class LaunchStage
+{
+    TOTAL,              // the whole launch on the stream
+    CHECK_COMPLETION,   // releasing the resources of completed launches
+    MAPPED_MEM,         // mapped-memory acquisition (MappedMemMgr)
+    ANALYZE_TENSORS,
+    SIF,
+    COPY_TO_MAPPED,
+    PATCHING,
+    DOWNLOAD,           // PDMA commands of the recipe download
+    ENQUEUE,            // compute commands
+    CYCLIC_BUFFER_ADD,  // a single command added to the stream cyclic buffer
+    LAST
+};
+
+/**
+ * Per stream latency histograms of the launch stages
+ *
+ * Enabled by GCFG_ENABLE_LAUNCH_LATENCY_STATS. The stream makes its stats current on the launching thread for the
+ * launch duration (ScopedLaunchLatencyStats), and LAUNCH_LATENCY_SCOPE measures a stage into the current stats, so
+ * code shared between streams (memory managers, cyclic buffer) doesn't need to know the stream.
+ * Durations are measured in TSC ticks and reported in ns. Recording is lock-free, the stats can be queried while the
+ * stream is launching.
+ *
+ * All the stats created in the process are kept in a registry, until dumped (dumpAll), so the stats of destroyed
+ * streams are reported as well.
+ */
+class LaunchLatencyStats
+{
+public:
+    static std::shared_ptr<LaunchLatencyStats> create(const std::string& streamName);
+
+    void record(LaunchStage stage, uint64_t ticks) { m_histograms[(unsigned)stage].record(ticks); }
+
+    const LatencyHistogram& getHistogram(LaunchStage stage) const { return m_histograms[(unsigned)stage]; }
+    const std::string&      getStreamName() const { return m_streamName; }
+
+    // count, min, mean, max, p50, p90, p99, p99.9, p99.99 in ns, per stage
+    nlohmann_hcl::json toJson() const;
+
+    void reset();
+
+    // The stats of the stream launching on the calling thread, if any
+    static LaunchLatencyStats* current();
+
+    // All the stats of the process, by creation order
+    static nlohmann_hcl::json allToJson();
+
+    // Writes allToJson() to GCFG_LAUNCH_LATENCY_STATS_FILE (if set) and drops the stats of destroyed streams
+    static void dumpAll();
+
+    static const char* stageName(LaunchStage stage);
+
+private:
+    friend class ScopedLaunchLatencyStats;
+
+    explicit LaunchLatencyStats(const std::string& streamName) : m_streamName(streamName) {}
+
+    const std::string                                             m_streamName;
+    std::array<LatencyHistogram, (unsigned)LaunchStage::LAST> m_histograms;
+};
+
+// Makes 'stats' (may be null) current on the calling thread for the scope lifetime
+class ScopedLaunchLatencyStats
+{
+public:
+    explicit ScopedLaunchLatencyStats(LaunchLatencyStats* stats);
+    ~ScopedLaunchLatencyStats();
+
+    ScopedLaunchLatencyStats(const ScopedLaunchLatencyStats&) = delete;
+    ScopedLaunchLatencyStats& operator=(const ScopedLaunchLatencyStats&) = delete;
+
+private:
+    LaunchLatencyStats* m_prevStats;
+};
+
+// Measures its scope into the current stats, does nothing (not even reading the clock) if there are none
+class LaunchStageTimer
+{
+public:
+    explicit LaunchStageTimer(LaunchStage stage) : m_stats(LaunchLatencyStats::current()), m_stage(stage)
+    {
+        if (m_stats != nullptr) m_start = TscClock::now();
+    }
+
+    ~LaunchStageTimer()
+    {
+        if (m_stats != nullptr) m_stats->record(m_stage, TscClock::now() - m_start);
+    }
+
+    LaunchStageTimer(const LaunchStageTimer&) = delete;
+    LaunchStageTimer& operator=(const LaunchStageTimer&) = delete;
+
+private:
+    LaunchLatencyStats* const m_stats;
+    const LaunchStage         m_stage;
+    uint64_t                  m_start = 0;
+};
+
+#define LAUNCH_LATENCY_CONCAT_(a, b) a##b
+#define LAUNCH_LATENCY_CONCAT(a, b)  LAUNCH_LATENCY_CONCAT_(a, b)
+#define LAUNCH_LATENCY_SCOPE(stage)                                                                                    \
+    LaunchStageTimer LAUNCH_LATENCY_CONCAT(launchStageTimer, __LINE__)(LaunchStage::stage)
@@ -1,5 +1,7 @@
 #include "memory_allocator_utils.hpp"
 
+#include "runtime/common/osal/host_numa_placement.hpp"
+
 #include "syn_logging.h"
 #include "synapse_common_types.h"
 #include "synapse_types.h"
@@ -29,6 +31,11 @@ void* MemoryAllocatorUtils::alloc_memory_to_be_mapped_to_device(size_t length,
         LOG_TRACE(SYN_MEM_MAP, "mapping in protected {:x}/{:x}", TO64(hostAddr), length);
     }
 
+    if ((flags & MAP_ANONYMOUS) != 0)
+    {
+        HostNumaPlacement::bindMemory(hostAddr, length);
+    }
+
     int ret = madvise(hostAddr, length, MADV_DONTFORK);
     if (ret)
     {
@@ -6,6 +6,7 @@
 #include <sys/mman.h>
 
 #include "osal.hpp"
+#include "host_numa_placement.hpp"
 #include "infra/settable.h"
 #include "event_triggered_logger.hpp"
 
@@ -421,6 +422,12 @@ synStatus HostAllocator::_allocateMemory(const uint64_t& size, void** pHostAddre
         }
     }
 
+    // Placed before its pages are touched (and pinned by the mapping), the user buffers are left to the user threads
+    if (!isUserRequest)
+    {
+        HostNumaPlacement::bindMemory(*pHostAddress, allocatedSize);
+    }
+
     /* in order to prevent physical pages mapped to device from being swapped due to fork copyOnWrite
        mechanism, thus causing MMU mapping problems, need to add madvise flag to those pages.*/
     int ret = madvise((void*)*pHostAddress, allocatedSize, MADV_DONTFORK);
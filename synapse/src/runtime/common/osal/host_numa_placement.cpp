@@ -0,0 +1,213 @@
+#include "host_numa_placement.hpp"
+
+#include "habana_global_conf_runtime.h"
+#include "syn_logging.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <pthread.h>
+#include <sstream>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+std::atomic<int> HostNumaPlacement::s_node {HostNumaPlacement::INVALID_NODE};
+cpu_set_t        HostNumaPlacement::s_nodeCpus;
+
+namespace
+{
+// The memory policy syscalls are used directly, libnuma is not a dependency
+const int      MEMORY_POLICY_DEFAULT   = 0;
+const int      MEMORY_POLICY_PREFERRED = 1;
+const unsigned NODE_MASK_BITS          = sizeof(HostNumaPlacement::NodeMask) * 8;
+
+const std::string SYSFS_NODES_DIR = "/sys/devices/system/node/";
+
+bool readFirstLine(const std::string& path, std::string& rLine)
+{
+    std::ifstream file(path);
+    return file.good() && std::getline(file, rLine) && !rLine.empty();
+}
+
+// Parses a sysfs list, e.g. "0-3,8,10-11"
+bool parseList(const std::string& list, std::vector<unsigned>& rValues)
+{
+    std::stringstream stream(list);
+    std::string       range;
+    while (std::getline(stream, range, ','))
+    {
+        try
+        {
+            const size_t   dash  = range.find('-');
+            const unsigned first = std::stoul(range.substr(0, dash));
+            const unsigned last  = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+            for (unsigned value = first; value <= last; value++)
+            {
+                rValues.push_back(value);
+            }
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+    return !rValues.empty();
+}
+
+HostNumaPlacement::NodeMask getNodeMask(int node)
+{
+    HostNumaPlacement::NodeMask nodeMask {};
+    nodeMask[node / 64] = 1ULL << (node % 64);
+    return nodeMask;
+}
+
+// maxnode is the number of the mask bits + 1, as the kernel drops the last one
+long setMemoryPolicy(int mode, const HostNumaPlacement::NodeMask* pNodeMask)
+{
+    return syscall(SYS_set_mempolicy, mode, pNodeMask != nullptr ? pNodeMask->data() : nullptr, NODE_MASK_BITS + 1);
+}
+}  // namespace
+
+void HostNumaPlacement::init(const std::string& pciAddr)
+{
+    reset();
+
+    if (!GCFG_ENABLE_NUMA_AWARE_HOST_PLACEMENT.value())
+    {
+        LOG_INFO(SYN_OSAL, "Host NUMA placement: disabled");
+        return;
+    }
+
+    std::string           line;
+    std::vector<unsigned> nodes;
+    if (!readFirstLine(SYSFS_NODES_DIR + "online", line) || !parseList(line, nodes) || (nodes.size() < 2))
+    {
+        LOG_INFO(SYN_OSAL, "Host NUMA placement: not needed, single NUMA node host");
+        return;
+    }
+
+    int node = INVALID_NODE;
+    if (readFirstLine("/sys/bus/pci/devices/" + pciAddr + "/numa_node", line))
+    {
+        try
+        {
+            node = std::stoi(line);
+        }
+        catch (const std::exception&)
+        {
+            node = INVALID_NODE;
+        }
+    }
+    if ((node < 0) || (node >= (int)NODE_MASK_BITS))
+    {
+        LOG_INFO(SYN_OSAL, "Host NUMA placement: device {} NUMA node is unknown, no placement", pciAddr);
+        return;
+    }
+
+    // The completion thread is only placed on the node CPUs the process may run on
+    std::string           cpuList;
+    std::vector<unsigned> cpus;
+    cpu_set_t             allowedCpus;
+    CPU_ZERO(&s_nodeCpus);
+    if (readFirstLine(SYSFS_NODES_DIR + "node" + std::to_string(node) + "/cpulist", cpuList) &&
+        parseList(cpuList, cpus) && (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) == 0))
+    {
+        for (unsigned cpu : cpus)
+        {
+            if ((cpu < CPU_SETSIZE) && CPU_ISSET(cpu, &allowedCpus))
+            {
+                CPU_SET(cpu, &s_nodeCpus);
+            }
+        }
+    }
+
+    s_node.store(node, std::memory_order_release);
+
+    LOG_INFO(SYN_OSAL,
+             "Host NUMA placement: device {} on node {} (of {} nodes), host buffers preferred on node {}, "
+             "completion thread on {} CPUs ({})",
+             pciAddr,
+             node,
+             nodes.size(),
+             node,
+             CPU_COUNT(&s_nodeCpus),
+             cpuList.empty() ? "unknown" : cpuList);
+}
+
+void HostNumaPlacement::reset()
+{
+    s_node.store(INVALID_NODE, std::memory_order_release);
+}
+
+void HostNumaPlacement::bindMemory(void* hostAddress, uint64_t size)
+{
+    const int node = getNode();
+    if (node == INVALID_NODE)
+    {
+        return;
+    }
+
+    // A failure only costs the placement
+    const NodeMask nodeMask = getNodeMask(node);
+    if (syscall(SYS_mbind, hostAddress, size, MEMORY_POLICY_PREFERRED, nodeMask.data(), NODE_MASK_BITS + 1, 0) != 0)
+    {
+        LOG_DEBUG(SYN_OSAL,
+                  "Failed to bind host buffer 0x{:x} size {} to NUMA node {} due to {}",
+                  (uint64_t)hostAddress,
+                  size,
+                  node,
+                  std::strerror(errno));
+    }
+}
+
+void HostNumaPlacement::bindCurrentThread(const char* threadDesc)
+{
+    const int node = getNode();
+    if (node == INVALID_NODE)
+    {
+        return;
+    }
+
+    if ((CPU_COUNT(&s_nodeCpus) != 0) && (pthread_setaffinity_np(pthread_self(), sizeof(s_nodeCpus), &s_nodeCpus) != 0))
+    {
+        LOG_DEBUG(SYN_OSAL, "Failed to bind {} thread to the CPUs of NUMA node {}", threadDesc, node);
+    }
+
+    const NodeMask nodeMask = getNodeMask(node);
+    if (setMemoryPolicy(MEMORY_POLICY_PREFERRED, &nodeMask) != 0)
+    {
+        LOG_DEBUG(SYN_OSAL,
+                  "Failed to set {} thread memory policy to NUMA node {} due to {}",
+                  threadDesc,
+                  node,
+                  std::strerror(errno));
+    }
+
+    LOG_DEBUG(SYN_OSAL, "{} thread placed on NUMA node {}", threadDesc, node);
+}
+
+HostNumaPlacement::ScopedPreferredNode::ScopedPreferredNode()
+{
+    const int node = getNode();
+    if (node == INVALID_NODE)
+    {
+        return;
+    }
+
+    if (syscall(SYS_get_mempolicy, &m_prevMode, m_prevNodeMask.data(), NODE_MASK_BITS + 1, nullptr, 0) != 0)
+    {
+        return;
+    }
+
+    const NodeMask nodeMask = getNodeMask(node);
+    m_isSet                 = (setMemoryPolicy(MEMORY_POLICY_PREFERRED, &nodeMask) == 0);
+}
+
+HostNumaPlacement::ScopedPreferredNode::~ScopedPreferredNode()
+{
+    if (m_isSet)
+    {
+        setMemoryPolicy(m_prevMode, (m_prevMode == MEMORY_POLICY_DEFAULT) ? nullptr : &m_prevNodeMask);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <sched.h>
+#include <string>
+
+/**
+ * NUMA placement of the Runtime host buffers and threads, on the node the acquired device is attached to
+ *
+ * Enabled by GCFG_ENABLE_NUMA_AWARE_HOST_PLACEMENT. The node is read from the device PCI sysfs entry when the device
+ * is acquired (init), and the placement is reported then. Memory gets a preferred policy, so an allocation falls back
+ * to other nodes rather than failing when the device node is full; it has to be bound before it is first touched
+ * (or pinned for the device). Nothing is done on single-node hosts, or when the node of the device is unknown.
+ */
+class HostNumaPlacement
+{
+public:
+    static constexpr int INVALID_NODE = -1;
+
+    // A node bit-mask as taken by the memory policy syscalls (up to 1024 nodes)
+    using NodeMask = std::array<uint64_t, 16>;
+
+    static void init(const std::string& pciAddr);
+    static void reset();
+
+    static int getNode() { return s_node.load(std::memory_order_acquire); }
+
+    // Binds a host buffer, which was not touched yet, to the device node
+    static void bindMemory(void* hostAddress, uint64_t size);
+
+    // Binds the calling (Runtime owned) thread to the CPUs of the device node, and its allocations to the node
+    static void bindCurrentThread(const char* threadDesc);
+
+    // Sets the preferred node of the calling thread allocations for the scope, for the host memory that is allocated
+    // outside of the Runtime (e.g. the SCAL host pools and cyclic buffers, allocated on scal_init)
+    class ScopedPreferredNode
+    {
+    public:
+        ScopedPreferredNode();
+        ~ScopedPreferredNode();
+
+    private:
+        bool     m_isSet    = false;
+        int      m_prevMode = 0;
+        NodeMask m_prevNodeMask {};
+    };
+
+private:
+    static std::atomic<int> s_node;
+    static cpu_set_t        s_nodeCpus;
+};
@@ -32,6 +32,7 @@
 #include "defs.h"
 #include "defenders.h"
 #include "physical_device.hpp"
+#include "host_numa_placement.hpp"
 #include "habana_global_conf.h"
 
 using namespace std;
@@ -513,6 +514,8 @@ synStatus OSAL::deviceInfoSet(synDeviceType deviceType)
     LOG_TRACE(SYN_OSAL, "PciBusId {}", busId);
     m_pciAddr = pciAddr;
 
+    HostNumaPlacement::init(m_pciAddr);
+
     int devHlIdx = s_interface->getDeviceIndexFromPciBusId(busId);
     if (devHlIdx < 0)
     {
@@ -1246,6 +1249,7 @@ void OSAL::deviceInfoReset()
     m_devHlIdx             = -1;
     m_pciAddr              = "";
     m_deviceInfo           = {};
+    HostNumaPlacement::reset();
     m_deviceInfo.fd        = -1;
     m_deviceLimitationInfo = {};
 }
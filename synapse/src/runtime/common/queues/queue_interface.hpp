@@ -68,6 +68,37 @@ public:
                              EventWithMappedTensorDB&      events,
                              uint8_t                       apiId) = 0;
 
+    // Launches the batch entries in order, stopping at the first failure.
+    // rNumOfLaunched is set to the number of the entries that were launched
+    virtual synStatus launchBatch(const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint64_t                  assertAsyncMappedAddress,
+                                  uint8_t                   apiId,
+                                  uint32_t&                 rNumOfLaunched)
+    {
+        EventWithMappedTensorDB events;
+
+        for (rNumOfLaunched = 0; rNumOfLaunched < numberOfLaunches; rNumOfLaunched++)
+        {
+            const synLaunchBatchInfo& rLaunch = launchBatchInfo[rNumOfLaunched];
+
+            synStatus status = launch(rLaunch.launchTensorsInfoExt,
+                                      rLaunch.numberOfTensors,
+                                      rLaunch.pWorkspace,
+                                      rLaunch.pRecipeHandle,
+                                      assertAsyncMappedAddress,
+                                      rLaunch.flags,
+                                      events,
+                                      apiId);
+            if (status != synSuccess)
+            {
+                return status;
+            }
+        }
+
+        return synSuccess;
+    }
+
     virtual void finalize() = 0;
 
     /**
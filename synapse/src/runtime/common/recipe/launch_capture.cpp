@@ -0,0 +1,252 @@
+#include "launch_capture.hpp"
+
+#include "basic_recipe_info.hpp"
+#include "defs.h"
+#include "log_manager.h"
+#include "recipe.h"
+#include "recipe_tensor_info.hpp"
+#include "recipe_utils.hpp"
+
+#include "runtime/common/recipe/patching/host_address_patcher.hpp"
+
+#include <unordered_map>
+
+std::unique_ptr<LaunchCapture> LaunchCapture::create(const basicRecipeInfo&        rBasicRecipeInfo,
+                                                     const RecipeTensorsInfo&      rRecipeTensorsInfo,
+                                                     const synLaunchTensorInfoExt* launchTensorsInfo,
+                                                     uint32_t                      launchTensorsAmount)
+{
+    const recipe_t* pRecipe = rBasicRecipeInfo.recipe;
+
+    if (RecipeUtils::isDsd(rBasicRecipeInfo) || RecipeUtils::isIH2DRecipe(pRecipe))
+    {
+        LOG_DEBUG(SYN_RECIPE, "{}: DSD and IH2D recipes are not captured", HLLOG_FUNC);
+        return nullptr;
+    }
+
+    // The constructor is private, so make_unique can't be used
+    std::unique_ptr<LaunchCapture> capture(new LaunchCapture());
+    capture->m_tensors.resize(launchTensorsAmount);
+
+    std::unordered_map<uint64_t, uint32_t> sectionIdToIdx;
+    std::vector<std::vector<uint32_t>>     sectionsTensors;
+
+    for (uint32_t i = 0; i < launchTensorsAmount; i++)
+    {
+        const synLaunchTensorInfoExt& rLaunchTensor   = launchTensorsInfo[i];
+        CapturedTensor&               rCapturedTensor = capture->m_tensors[i];
+
+        rCapturedTensor = {rLaunchTensor.tensorId,
+                           rLaunchTensor.tensorType,
+                           rLaunchTensor.pTensorAddress,
+                           0,
+                           INVALID_SECTION_ID};
+
+        // Invalid tensors are skipped by the launch as well
+        if (IS_TENSOR_INVALID(rLaunchTensor.tensorId))
+        {
+            continue;
+        }
+
+        const synTensorType tensorType  = TENSOR_INFO_TO_TYPE(rLaunchTensor.tensorId);
+        const uint64_t      tensorIndex = TENSOR_INFO_TO_INDEX(rLaunchTensor.tensorId);
+
+        if (tensorType == HOST_TO_DEVICE_TENSOR)
+        {
+            LOG_DEBUG(SYN_RECIPE, "{}: launches with host-to-device tensors are not captured", HLLOG_FUNC);
+            return nullptr;
+        }
+
+        // Only persistent tensors set their section address
+        if ((tensorType != DATA_TENSOR) && (tensorType != DATA_TENSOR_DYNAMIC) && (tensorType != DEVICE_SHAPE_TENSOR))
+        {
+            continue;
+        }
+
+        if (tensorIndex >= pRecipe->persist_tensors_nr)
+        {
+            LOG_ERR(SYN_RECIPE,
+                    "{}: invalid persist tensorIndex {} max allowed {}",
+                    HLLOG_FUNC,
+                    tensorIndex,
+                    pRecipe->persist_tensors_nr);
+            return nullptr;
+        }
+
+        const uint64_t sectionId = pRecipe->tensors[tensorIndex].section_idx;
+
+        auto sectionIter = sectionIdToIdx.find(sectionId);
+        if (sectionIter == sectionIdToIdx.end())
+        {
+            sectionIter = sectionIdToIdx.emplace(sectionId, (uint32_t)capture->m_sections.size()).first;
+
+            CapturedSection section {};
+            section.sectionId     = sectionId;
+            section.sectionTypeId = rRecipeTensorsInfo.m_sectionToSectionType[sectionId];
+            section.isZeroSize    = (rRecipeTensorsInfo.m_sectionsInfo[sectionId].sectionSize == 0);
+            capture->m_sections.push_back(section);
+            sectionsTensors.emplace_back();
+        }
+
+        rCapturedTensor.offsetInSection = pRecipe->tensors[tensorIndex].offset_in_section;
+        rCapturedTensor.sectionIdx      = sectionIter->second;
+        sectionsTensors[sectionIter->second].push_back(i);
+    }
+
+    for (uint32_t sectionIdx = 0; sectionIdx < capture->m_sections.size(); sectionIdx++)
+    {
+        CapturedSection& rSection = capture->m_sections[sectionIdx];
+
+        rSection.firstTensor = capture->m_sectionsTensors.size();
+        rSection.numTensors  = sectionsTensors[sectionIdx].size();
+        capture->m_sectionsTensors.insert(capture->m_sectionsTensors.end(),
+                                          sectionsTensors[sectionIdx].begin(),
+                                          sectionsTensors[sectionIdx].end());
+
+        if (!capture->resolveSection(rSection))
+        {
+            return nullptr;
+        }
+    }
+
+    capture->m_isSectionChanged.resize(capture->m_sections.size(), false);
+    capture->m_changedSections.reserve(capture->m_sections.size());
+
+    LOG_DEBUG(SYN_RECIPE,
+              "{}: captured {} launch tensors of {} sections",
+              HLLOG_FUNC,
+              capture->m_tensors.size(),
+              capture->m_sections.size());
+
+    return capture;
+}
+
+bool LaunchCapture::matches(const synLaunchTensorInfoExt* launchTensorsInfo, uint32_t launchTensorsAmount) const
+{
+    if (launchTensorsAmount != m_tensors.size())
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < launchTensorsAmount; i++)
+    {
+        if ((launchTensorsInfo[i].tensorId != m_tensors[i].tensorId) ||
+            (launchTensorsInfo[i].tensorType != m_tensors[i].tensorType))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+synStatus LaunchCapture::setSectionsAddresses(const synLaunchTensorInfoExt*             launchTensorsInfo,
+                                              patching::HostAddressPatchingInformation& rPatchInfo,
+                                              bool&                                     rTensorsChanged)
+{
+    rTensorsChanged = false;
+    m_changedSections.clear();
+
+    for (uint32_t i = 0; i < m_tensors.size(); i++)
+    {
+        CapturedTensor& rTensor    = m_tensors[i];
+        const uint64_t  newAddress = launchTensorsInfo[i].pTensorAddress;
+
+        if (newAddress == rTensor.address)
+        {
+            continue;
+        }
+
+        rTensor.address = newAddress;
+
+        if ((rTensor.sectionIdx != INVALID_SECTION_ID) && !m_isSectionChanged[rTensor.sectionIdx])
+        {
+            m_isSectionChanged[rTensor.sectionIdx] = true;
+            m_changedSections.push_back(rTensor.sectionIdx);
+        }
+        rTensorsChanged = true;
+    }
+
+    bool res = true;
+    for (uint32_t sectionIdx : m_changedSections)
+    {
+        m_isSectionChanged[sectionIdx] = false;
+        res                            = res && resolveSection(m_sections[sectionIdx]);
+    }
+    if (!res)
+    {
+        return synFail;
+    }
+
+    for (const CapturedSection& rSection : m_sections)
+    {
+        if (!rSection.isAddressSet)
+        {
+            continue;
+        }
+
+        if (!rPatchInfo.setSectionHostAddress(rSection.sectionId,
+                                              rSection.sectionTypeId,
+                                              rSection.address,
+                                              rSection.isZeroSize))
+        {
+            LOG_ERR(SYN_RECIPE,
+                    "{}: Failed to setSectionHostAddress for section {} with address {:#x}",
+                    HLLOG_FUNC,
+                    rSection.sectionId,
+                    rSection.address);
+            return synFail;
+        }
+    }
+
+    return synSuccess;
+}
+
+bool LaunchCapture::resolveSection(CapturedSection& rSection) const
+{
+    rSection.address      = 0;
+    rSection.isAddressSet = false;
+
+    for (uint32_t i = rSection.firstTensor; i < rSection.firstTensor + rSection.numTensors; i++)
+    {
+        const CapturedTensor& rTensor = m_tensors[m_sectionsTensors[i]];
+
+        if (rTensor.offsetInSection > rTensor.address)
+        {
+            if (rTensor.address == 0)
+            {
+                // We can't deduce the section address from this tensor
+                continue;
+            }
+
+            LOG_ERR(SYN_RECIPE,
+                    "{}: Failed, launch tensor {} (sectionIndex {}) has OffsetInSection {} is bigger than address {}",
+                    HLLOG_FUNC,
+                    m_sectionsTensors[i],
+                    rSection.sectionId,
+                    rTensor.offsetInSection,
+                    rTensor.address);
+            return false;
+        }
+
+        const uint64_t sectionAddress = rTensor.address - rTensor.offsetInSection;
+
+        if (!rSection.isAddressSet || (rSection.address == 0))
+        {
+            rSection.address      = sectionAddress;
+            rSection.isAddressSet = true;
+        }
+        else if ((sectionAddress != 0) && (sectionAddress != rSection.address))
+        {
+            LOG_ERR(SYN_RECIPE,
+                    "{}: section {} has an address conflict: {:#x} vs {:#x}",
+                    HLLOG_FUNC,
+                    rSection.sectionId,
+                    rSection.address,
+                    sectionAddress);
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "synapse_api_types.h"
+#include "synapse_common_types.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct basicRecipeInfo;
+struct RecipeTensorsInfo;
+
+namespace patching
+{
+class HostAddressPatchingInformation;
+}
+
+/**
+ * The resolved launch-tensors of a captured launch (see SYN_FLAGS_LAUNCH_CAPTURE)
+ *
+ * Keeps, per launch-tensor (in the order they were given), its id, address and the section it sets, and the address
+ * each of the captured sections was resolved to. A replay (see SYN_FLAGS_LAUNCH_REPLAY) with the same tensors only
+ * compares the addresses, and re-resolves only the sections of the tensors whose address had changed, instead of
+ * analyzing all of the tensors again.
+ *
+ * Only static recipes of device tensors are captured - DSD and IH2D recipes depend on the launch shapes and host data,
+ * and the address of host-to-device tensors has to be translated on every launch.
+ *
+ * A capture is owned by a single stream and is not thread-safe.
+ */
+class LaunchCapture
+{
+public:
+    // Returns nullptr in case the launch can't be captured
+    static std::unique_ptr<LaunchCapture> create(const basicRecipeInfo&        rBasicRecipeInfo,
+                                                 const RecipeTensorsInfo&      rRecipeTensorsInfo,
+                                                 const synLaunchTensorInfoExt* launchTensorsInfo,
+                                                 uint32_t                      launchTensorsAmount);
+
+    // Whether the launch-tensors are the captured ones (same ids and types, in the same order)
+    bool matches(const synLaunchTensorInfoExt* launchTensorsInfo, uint32_t launchTensorsAmount) const;
+
+    // Sets the captured sections addresses into rPatchInfo, after re-resolving the sections of the changed tensors.
+    // rTensorsChanged is set in case any of the tensors addresses differs from the ones of the previous launch
+    synStatus setSectionsAddresses(const synLaunchTensorInfoExt*             launchTensorsInfo,
+                                   patching::HostAddressPatchingInformation& rPatchInfo,
+                                   bool&                                     rTensorsChanged);
+
+    uint32_t getNumTensors() const { return m_tensors.size(); }
+    uint32_t getNumSections() const { return m_sections.size(); }
+
+private:
+    struct CapturedTensor
+    {
+        uint64_t      tensorId;
+        synTensorType tensorType;
+        uint64_t      address;
+        uint64_t      offsetInSection;
+        uint32_t      sectionIdx;  // Into m_sections, INVALID_SECTION_ID for tensors that don't set a section
+    };
+
+    struct CapturedSection
+    {
+        uint64_t sectionId;
+        uint64_t sectionTypeId;
+        uint64_t address;
+        bool     isAddressSet;
+        bool     isZeroSize;
+        uint32_t firstTensor;  // Into m_sectionsTensors
+        uint32_t numTensors;
+    };
+
+    LaunchCapture() = default;
+
+    // Resolves the section address out of its tensors addresses, the same way a full launch does
+    bool resolveSection(CapturedSection& rSection) const;
+
+    std::vector<CapturedTensor>  m_tensors;
+    std::vector<CapturedSection> m_sections;
+    std::vector<uint32_t>        m_sectionsTensors;  // The launch-tensors indices, grouped by section
+    std::vector<uint32_t>        m_changedSections;  // Scratch, for the replay
+    std::vector<bool>            m_isSectionChanged;
+};
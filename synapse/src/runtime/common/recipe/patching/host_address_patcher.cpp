@@ -19,6 +19,7 @@ using namespace patching;
 HostAddressPatchingInformation::HostAddressPatchingInformation()
 : m_sectionToHostAddressDb(nullptr),
   m_sectionPatchingIndexDb(nullptr),
+  m_sectionChangedDb(nullptr),
   m_sectionIdDbSize(0),
   m_numberOfSectionsChecked(0),
   m_numberOfSectionsUpdated(0),
@@ -36,6 +37,7 @@ HostAddressPatchingInformation::~HostAddressPatchingInformation()
 {
     delete[] m_sectionToHostAddressDb;
     delete[] m_sectionPatchingIndexDb;
+    delete[] m_sectionChangedDb;
 }
 
 bool HostAddressPatchingInformation::initialize(uint64_t maxSectionId, uint64_t numOfSectionsToPatch)
@@ -72,9 +74,11 @@ bool HostAddressPatchingInformation::initialize(uint64_t maxSectionId, uint64_t
 
     m_sectionToHostAddressDb = new uint64_t[sectionIdDbSize];
     m_sectionPatchingIndexDb = new uint32_t[sectionIdDbSize];
+    m_sectionChangedDb       = new uint8_t[sectionIdDbSize];
 
     std::memset(m_sectionToHostAddressDb, 0, sectionIdDbSize * sizeof(uint64_t));
     std::memset(m_sectionPatchingIndexDb, 0, sectionIdDbSize * sizeof(uint32_t));
+    std::memset(m_sectionChangedDb, 1, sectionIdDbSize * sizeof(uint8_t));
 
     m_sectionIdDbSize = sectionIdDbSize;
     m_numOfSections   = numOfSectionsToPatch;
@@ -133,6 +137,18 @@ uint64_t HostAddressPatchingInformation::getSectionsDbSize() const
     return m_sectionIdDbSize;
 }
 
+const uint8_t* HostAddressPatchingInformation::getSectionsChangedDB() const
+{
+    HB_ASSERT(isInitialized(), "HostAddressPatchingInformation is not initialized");
+
+    return m_sectionChangedDb;
+}
+
+void HostAddressPatchingInformation::clearSectionsChanged()
+{
+    std::memset(m_sectionChangedDb, 0, m_sectionIdDbSize * sizeof(uint8_t));
+}
+
 void HostAddressPatchingInformation::markSectionTypeForPatching(uint64_t sectionTypeId)
 {
     m_sectionTypesToPatch.insert(sectionTypeId);
@@ -212,7 +228,8 @@ bool HostAddressPatchingInformation::setSectionHostAddress(uint64_t sectionId,
                           "Updated sectionId {} hostAddress {:#x} (originaly zero-address)",
                           sectionId,
                           hostAddress);
-                sectionCurrentAddress = hostAddress;
+                sectionCurrentAddress         = hostAddress;
+                m_sectionChangedDb[sectionId] = 1;
                 m_numberOfSectionsChecked++;
 
                 return true;
@@ -269,7 +286,8 @@ bool HostAddressPatchingInformation::setSectionHostAddress(uint64_t sectionId,
                       sectionType);
         }
 
-        sectionCurrentAddress = hostAddress;
+        sectionCurrentAddress         = hostAddress;
+        m_sectionChangedDb[sectionId] = 1;
     }
 
     if ((hostAddress != 0) || isZeroSizeSection)
@@ -299,6 +317,7 @@ void HostAddressPatchingInformation::patchingAbort()
 {
     std::memset(m_sectionToHostAddressDb, 0, m_sectionIdDbSize * sizeof(uint64_t));
     std::memset(m_sectionPatchingIndexDb, 0, m_sectionIdDbSize * sizeof(uint32_t));
+    std::memset(m_sectionChangedDb, 1, m_sectionIdDbSize * sizeof(uint8_t));
 
     m_currentPatchingIndex    = 1;
     m_numberOfSectionsUpdated = 0;
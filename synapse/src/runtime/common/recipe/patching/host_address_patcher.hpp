@@ -24,6 +24,12 @@ public:
 
     uint64_t getSectionsDbSize() const;
 
+    // Per section, non-zero if its address had changed since the sections were last marked as patched
+    const uint8_t* getSectionsChangedDB() const;
+
+    // To be called once the data-chunks were patched with the current sections addresses
+    void clearSectionsChanged();
+
     bool markConstZeroSizeSection(uint64_t sectionId);
 
     bool setSectionHostAddress(uint64_t sectionId,
@@ -52,6 +58,7 @@ protected:
     // DBs with size of m_sectionIdDbSize for o(1) access
     uint64_t* m_sectionToHostAddressDb;  // sec -> host addr
     uint32_t* m_sectionPatchingIndexDb;  // sec patching index
+    uint8_t*  m_sectionChangedDb;        // sec addr changed since last patching (see getSectionsChangedDB)
     uint64_t  m_sectionIdDbSize;         // maxID + 1, section Id db (size of the arrays above)
 
     uint32_t m_numberOfSectionsChecked;  // checked
@@ -0,0 +1,522 @@
+#include "recipe_disk_cache.hpp"
+
+#include "basic_recipe_info.hpp"
+#include "recipe_allocator.h"
+#include "recipe_serializer.hpp"
+#include "synapse_runtime_logging.h"
+#include "habana_global_conf_runtime.h"
+#include "habana_graph.h"
+#include "kernel_db.h"
+#include "fasthash.h"
+#include "file_lock.h"
+#include "filesystem.h"
+#include "global_statistics.hpp"
+
+#include <hl_gcfg/hlgcfg.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+extern const char* SYNAPSE_SHA1_VERSION;
+
+namespace
+{
+constexpr const char* LOCK_FILE_NAME  = "recipe_cache.lock";
+constexpr const char* ENTRY_EXTENSION = ".recipe";
+constexpr const char* KEY_EXTENSION   = ".key";
+constexpr const char* TEMP_EXTENSION  = ".tmp";
+constexpr auto        STALE_TEMP_AGE  = std::chrono::hours(1);
+constexpr uint64_t    BYTES_IN_MB     = 1024 * 1024;
+
+// FNV-1a, a second hash of the const data which is independent of fasthash
+uint64_t fnv1aHash(const void* data, uint64_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t       hash  = 0xcbf29ce484222325ULL;
+    for (uint64_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Accumulates the graph description into a flat buffer which is hashed once at the end
+class GraphKeyBuilder
+{
+public:
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be added as raw bytes");
+        m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void add(const std::string& str) { addBytes(str.data(), str.size()); }
+    void add(std::string_view str) { addBytes(str.data(), str.size()); }
+
+    void addBytes(const void* data, uint64_t size)
+    {
+        add(size);
+        if (size != 0)
+        {
+            m_buffer.append(reinterpret_cast<const char*>(data), size);
+        }
+    }
+
+    // Large buffers (const tensors data) are described by their size and two independent hashes, which keeps the key
+    // file small
+    void addDigest(const void* data, uint64_t size)
+    {
+        add(size);
+        add(fasthash(data, size));
+        add(fnv1aHash(data, size));
+    }
+
+    RecipeDiskCache::GraphKey finalize() { return {fasthash(m_buffer), std::move(m_buffer)}; }
+
+private:
+    std::string m_buffer;
+};
+
+void addQuantization(GraphKeyBuilder& key, const TensorPtr& tensor)
+{
+    key.add(tensor->isPerChannelQuant());
+
+    const QuantizationMap& quantization = tensor->getAllQuantizationParams();
+    key.add(quantization.size());
+    for (const std::pair<const uint32_t, QuantizationData>& dtypeQuantization : quantization)
+    {
+        const QuantizationData& data = dtypeQuantization.second;
+        key.add(dtypeQuantization.first);
+        key.add(data.m_qDataType);
+        key.add(data.m_numChannels);
+        key.add(data.m_isUserQuantInfo);
+        key.add(data.m_isUserPCQuantInfo);
+        key.add(data.numOfParams());
+        for (const QuantizationData::QuantizationParams& params : data.getQuantParamsVector())
+        {
+            key.add(params.zp);
+            key.add(params.scale);
+            key.add(params.expBias);
+        }
+    }
+
+    const DynamicRange& dynamicRange = tensor->getDynamicRange();
+    key.add(dynamicRange.isSet);
+    key.add(dynamicRange.min);
+    key.add(dynamicRange.max);
+
+    const PerChannelDynamicRange& perChannelRange = tensor->getPerChannelDynamicRange();
+    key.add(perChannelRange.isSet);
+    key.add(perChannelRange.ranges.size());
+    for (const synQuantDynamicRange& range : perChannelRange.ranges)
+    {
+        key.add(range.min);
+        key.add(range.max);
+    }
+}
+
+void addTensor(GraphKeyBuilder& key, const TensorPtr& tensor)
+{
+    if (tensor == nullptr)
+    {
+        key.add(std::string_view("<null>"));
+        return;
+    }
+
+    key.add(tensor->getName());
+    key.add(tensor->getElementType());
+    key.add(tensor->getTensorType());
+    key.add(tensor->getDim());
+    key.add(tensor->getAllNSizesInElements());
+    key.add(tensor->getAllMinimalSizesInElements());
+    key.addBytes(tensor->getNStridesInBytes(), sizeof(TStride) * (tensor->getDim() + 1));
+    key.add(tensor->isPersistent());
+    key.add(tensor->getMemorySectionID());
+    key.add(tensor->getMemorySectionOffset());
+    key.add(tensor->getTensorIsExternal());
+    key.add(tensor->getPermutation().has_value() ? tensor->getPermutation()->toString() : std::string());
+    addQuantization(key, tensor);
+
+    key.add(tensor->isAliasedTensor());
+    if (tensor->isAliasedTensor())
+    {
+        key.add(tensor->getAliasTensor()->getName());
+        key.add(tensor->getAliasedByteOffset());
+    }
+
+    // Const tensors data is embedded in the recipe
+    key.add(tensor->isStaticParam());
+    if (tensor->isStaticParam() && tensor->getData() != nullptr)
+    {
+        key.addDigest(tensor->getData(), tensor->getBufferSizeInBytes());
+    }
+}
+
+void addNode(GraphKeyBuilder& key, const HabanaGraph& graph, const NodePtr& node)
+{
+    key.add(node->getNodeName());
+    key.add(node->getGUID());
+    key.addBytes(node->getParamsRawData().data(), node->getParamsRawData().size());
+    key.add(node->getRoundingMode());
+    key.add(node->getDeterministic());
+    key.add(gc::Layout::toString(node->getInputLayouts()));
+    key.add(gc::Layout::toString(node->getOutputLayouts()));
+
+    key.add(node->getInputs().size());
+    for (const TensorPtr& input : node->getInputs())
+    {
+        addTensor(key, input);
+    }
+    key.add(node->getOutputs().size());
+    for (const TensorPtr& output : node->getOutputs())
+    {
+        addTensor(key, output);
+    }
+
+    std::set<std::string> blockingNodes;
+    for (const NodePtr& blocking : graph.getBlockingNodes(node))
+    {
+        blockingNodes.insert(blocking->getNodeName());
+    }
+    key.add(blockingNodes.size());
+    for (const std::string& name : blockingNodes)
+    {
+        key.add(name);
+    }
+}
+
+void addGlobalConfigs(GraphKeyBuilder& key)
+{
+    // Knobs which can't affect the generated recipe
+    static const std::set<std::string> SKIP = {GCFG_RECIPE_DISK_CACHE_PATH.primaryName(),
+                                               GCFG_RECIPE_DISK_CACHE_MAX_SIZE.primaryName(),
+                                               GCFG_DUMP_PASSES_FILTER.primaryName(),
+                                               GCFG_DUMP_PASSES_GRAPHS.primaryName(),
+                                               GCFG_DUMP_POST_GRAPHS.primaryName(),
+                                               GCFG_DUMP_PRE_GRAPHS.primaryName()};
+
+    // forEachRegisteredGcfgItem order isn't guaranteed, sort by name
+    std::map<std::string, std::string> configs;
+    hl_gcfg::forEachRegisteredGcfgItem([&](auto& name, auto& item) {
+        if (SKIP.count(name) > 0 || item.isSetFromDefault()) return;
+        configs.emplace(name, item.getValueStr());
+    });
+
+    key.add(configs.size());
+    for (const auto& [name, value] : configs)
+    {
+        key.add(name);
+        key.add(value);
+    }
+}
+
+void addLibraryVersions(GraphKeyBuilder& key)
+{
+    const auto&                     versions = KernelDB::instance().GetLibraryVersions();
+    std::map<std::string, uint32_t> sortedVersions(versions.begin(), versions.end());
+
+    key.add(sortedVersions.size());
+    for (const auto& [libName, version] : sortedVersions)
+    {
+        key.add(libName);
+        key.add(version);
+    }
+}
+}  // anonymous namespace
+
+RecipeDiskCache& RecipeDiskCache::instance()
+{
+    static RecipeDiskCache cache;
+    return cache;
+}
+
+bool RecipeDiskCache::isEnabled(const HabanaGraph& graph) const
+{
+    // Eager recipes are generated by templates and are not worth a file-system access
+    return !GCFG_RECIPE_DISK_CACHE_PATH.value().empty() && graph.getCompilationMode() == CompilationMode::Graph;
+}
+
+RecipeDiskCache::GraphKey RecipeDiskCache::calcGraphKey(const HabanaGraph& graph) const
+{
+    GraphKeyBuilder key;
+
+    key.add(std::string_view(SYNAPSE_SHA1_VERSION));
+    key.add(graph.getDeviceType());
+    key.add(graph.getInferenceMode());
+    key.add(graph.getQuantizationEnabled());
+    key.add(graph.getBackoffFactor());
+
+    addGlobalConfigs(key);
+    addLibraryVersions(key);
+
+    const NodeVector& nodes = graph.getTopoSortedNodes();
+    key.add(nodes.size());
+    for (const NodePtr& node : nodes)
+    {
+        addNode(key, graph, node);
+    }
+
+    return key.finalize();
+}
+
+std::string RecipeDiskCache::getEntryPath(uint64_t key) const
+{
+    return fmt::format("{}/{:016x}{}", GCFG_RECIPE_DISK_CACHE_PATH.value(), key, ENTRY_EXTENSION);
+}
+
+std::string RecipeDiskCache::getKeyPath(uint64_t key) const
+{
+    return fmt::format("{}/{:016x}{}", GCFG_RECIPE_DISK_CACHE_PATH.value(), key, KEY_EXTENSION);
+}
+
+bool RecipeDiskCache::isMatchingKey(const GraphKey& key) const
+{
+    std::ifstream file(getKeyPath(key.hash), std::ios::binary | std::ios::ate);
+    if (!file.good() || static_cast<uint64_t>(file.tellg()) != key.description.size()) return false;
+
+    std::string description(key.description.size(), '\0');
+    file.seekg(0);
+    file.read(description.data(), description.size());
+    return file.good() && description == key.description;
+}
+
+bool RecipeDiskCache::prepareFolder(const std::string& folder) const
+{
+    std::error_code ec;
+    fs::create_directories(folder, ec);
+    if (ec)
+    {
+        LOG_WARN(SYN_RECIPE, "{}: failed to create recipe cache folder {}: {}", HLLOG_FUNC, folder, ec.message());
+        return false;
+    }
+
+    // FileLock expects an existing file
+    std::ofstream lockFile(fmt::format("{}/{}", folder, LOCK_FILE_NAME), std::ios_base::app);
+    return lockFile.good();
+}
+
+bool RecipeDiskCache::load(const GraphKey& key, basicRecipeInfo& rRecipeInfo, const std::string& recipeName)
+{
+    const std::string entryPath = getEntryPath(key.hash);
+
+    std::error_code ec;
+    if (!fs::exists(entryPath, ec))
+    {
+        LOG_DEBUG(SYN_RECIPE, "{}: recipe cache miss, key {:#x}", HLLOG_FUNC, key.hash);
+        m_misses++;
+        STAT_GLBL_COLLECT(1, recipeDiskCacheMiss);
+        return false;
+    }
+    if (!isMatchingKey(key))
+    {
+        // A hash collision with another graph, or an entry without its key file. It is replaced on the next store.
+        LOG_DEBUG(SYN_RECIPE, "{}: recipe cache entry {} doesn't match the graph", HLLOG_FUNC, entryPath);
+        m_misses++;
+        STAT_GLBL_COLLECT(1, recipeDiskCacheMiss);
+        return false;
+    }
+
+    STAT_GLBL_START(recipeLoad);
+
+    RecipeAllocator*     pRecipeAlloc = new RecipeAllocator();
+    recipe_t*            pRecipe      = (recipe_t*)pRecipeAlloc->allocate(sizeof(recipe_t));
+    shape_plane_graph_t* pSpr         = nullptr;
+    memset(pRecipe, 0, sizeof(recipe_t));
+
+    ParamsManager params;
+    params.setFileName(entryPath.c_str(), false);
+
+    synStatus status = synSuccess;
+    try
+    {
+        status = RecipeSerializer::deserialize(pRecipe, pSpr, &params, pRecipeAlloc);
+    }
+    catch (...)
+    {
+        status = synFail;
+    }
+
+    if (status != synSuccess)
+    {
+        // The entry may have been evicted by another process in the meantime, or it is corrupted
+        LOG_WARN(SYN_RECIPE, "{}: failed to load cached recipe {}, compiling instead", HLLOG_FUNC, entryPath);
+        pRecipeAlloc->freeAll();
+        delete pRecipeAlloc;
+        m_misses++;
+        STAT_GLBL_COLLECT(1, recipeDiskCacheMiss);
+        return false;
+    }
+
+    // The key doesn't depend on the recipe name, set the requested one
+    if (pRecipe->name == nullptr || recipeName != pRecipe->name)
+    {
+        pRecipe->nameSize = recipeName.size() + 1;
+        pRecipe->name     = pRecipeAlloc->allocate(pRecipe->nameSize);
+        std::strcpy(pRecipe->name, recipeName.c_str());
+    }
+
+    rRecipeInfo.recipeAllocator   = pRecipeAlloc;
+    rRecipeInfo.recipe            = pRecipe;
+    rRecipeInfo.shape_plan_recipe = pSpr;
+
+    // Mark the entry as recently used
+    fs::last_write_time(entryPath, fs::file_time_type::clock::now(), ec);
+
+    LOG_INFO(SYN_RECIPE, "{}: recipe cache hit, key {:#x} recipe {}", HLLOG_FUNC, key.hash, recipeName);
+    m_hits++;
+    STAT_GLBL_COLLECT(1, recipeDiskCacheHit);
+    STAT_GLBL_COLLECT_TIME(recipeLoad, globalStatPointsEnum::recipeDiskCacheLoad);
+    return true;
+}
+
+void RecipeDiskCache::store(const GraphKey& key, const basicRecipeInfo& rRecipeInfo)
+{
+    const std::string folder = GCFG_RECIPE_DISK_CACHE_PATH.value();
+    if (!prepareFolder(folder)) return;
+
+    const std::string entryPath = getEntryPath(key.hash);
+    const std::string keyPath   = getKeyPath(key.hash);
+    const std::string tempPath =
+        fmt::format("{}.{}.{}{}", entryPath, getpid(), (pid_t)syscall(SYS_gettid), TEMP_EXTENSION);
+    const std::string tempKeyPath =
+        fmt::format("{}.{}.{}{}", keyPath, getpid(), (pid_t)syscall(SYS_gettid), TEMP_EXTENSION);
+
+    {
+        std::ofstream keyFile(tempKeyPath, std::ios::binary | std::ios::trunc);
+        keyFile.write(key.description.data(), key.description.size());
+        if (!keyFile.good())
+        {
+            LOG_WARN(SYN_RECIPE, "{}: failed to write recipe cache key to {}", HLLOG_FUNC, tempKeyPath);
+            keyFile.close();
+            std::error_code ec;
+            fs::remove(tempKeyPath, ec);
+            return;
+        }
+    }
+
+    // Serialize outside of the lock, it is the expensive part
+    ParamsManager params;
+    params.setFileName(tempPath.c_str(), false);
+    synStatus status = RecipeSerializer::serialize(rRecipeInfo.recipe, rRecipeInfo.shape_plan_recipe, &params);
+    if (status != synSuccess)
+    {
+        LOG_WARN(SYN_RECIPE, "{}: failed to serialize recipe to {}", HLLOG_FUNC, tempPath);
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        fs::remove(tempKeyPath, ec);
+        return;
+    }
+
+    try
+    {
+        auto fileLock = FileLock::lock(fmt::format("{}/{}", folder, LOCK_FILE_NAME));
+
+        // The key is published first, a reader of a previous entry of the same hash fails its key match meanwhile
+        std::error_code ec;
+        fs::rename(tempKeyPath, keyPath, ec);
+        if (!ec) fs::rename(tempPath, entryPath, ec);
+        if (ec)
+        {
+            LOG_WARN(SYN_RECIPE, "{}: failed to publish recipe {}: {}", HLLOG_FUNC, entryPath, ec.message());
+            fs::remove(tempPath, ec);
+            fs::remove(tempKeyPath, ec);
+            return;
+        }
+
+        LOG_DEBUG(SYN_RECIPE, "{}: stored recipe, key {:#x}", HLLOG_FUNC, key.hash);
+        m_stores++;
+        STAT_GLBL_COLLECT(1, recipeDiskCacheStore);
+
+        evict(folder, GCFG_RECIPE_DISK_CACHE_MAX_SIZE.value() * BYTES_IN_MB);
+    }
+    catch (const SynapseException& e)
+    {
+        LOG_WARN(SYN_RECIPE, "{}: recipe cache is not updated: {}", HLLOG_FUNC, e.what());
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        fs::remove(tempKeyPath, ec);
+    }
+}
+
+// Must be called while holding the cache lock
+void RecipeDiskCache::evict(const std::string& folder, uint64_t maxSize)
+{
+    struct Entry
+    {
+        fs::file_time_type lastUse;
+        uint64_t           size;
+        fs::path           path;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t           totalSize = 0;
+    const auto         now       = fs::file_time_type::clock::now();
+
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(folder, ec))
+    {
+        std::error_code    fileEc;
+        const fs::path&    path    = file.path();
+        fs::file_time_type lastUse = fs::last_write_time(path, fileEc);
+        if (fileEc) continue;
+
+        if (path.extension() == TEMP_EXTENSION)
+        {
+            // Leftovers of a process that died while storing
+            if (now - lastUse > STALE_TEMP_AGE)
+            {
+                fs::remove(path, fileEc);
+            }
+            continue;
+        }
+        if (path.extension() == KEY_EXTENSION)
+        {
+            // A key whose entry failed to publish
+            if (!fs::exists(fs::path(path).replace_extension(ENTRY_EXTENSION), fileEc) && !fileEc)
+            {
+                fs::remove(path, fileEc);
+            }
+            continue;
+        }
+        if (path.extension() != ENTRY_EXTENSION) continue;
+
+        uint64_t size = fs::file_size(path, fileEc);
+        if (fileEc) continue;
+        // The key file is evicted with its entry
+        const uint64_t keySize = fs::file_size(fs::path(path).replace_extension(KEY_EXTENSION), fileEc);
+        if (!fileEc) size += keySize;
+
+        entries.push_back({lastUse, size, path});
+        totalSize += size;
+    }
+
+    if (totalSize <= maxSize) return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+    for (const Entry& entry : entries)
+    {
+        if (totalSize <= maxSize) break;
+        if (fs::remove(entry.path, ec))
+        {
+            fs::remove(fs::path(entry.path).replace_extension(KEY_EXTENSION), ec);
+            LOG_DEBUG(SYN_RECIPE, "{}: evicted {}", HLLOG_FUNC, entry.path.string());
+            totalSize -= entry.size;
+            m_evictions++;
+            STAT_GLBL_COLLECT(1, recipeDiskCacheEvict);
+        }
+    }
+}
+
+RecipeDiskCache::Stats RecipeDiskCache::getStats() const
+{
+    return {m_hits.load(), m_misses.load(), m_stores.load(), m_evictions.load()};
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+class HabanaGraph;
+struct basicRecipeInfo;
+
+/**
+ * Persistent, content-addressed cache of compiled recipes
+ *
+ * A graph is keyed by a description of its pre-compilation state (nodes, tensors geometry, sections and quantization,
+ * graph attributes, non-default GCFG values and the TPC libraries versions), and the entry file name is its hash.
+ * Each entry is a recipe file written by RecipeSerializer, so a hit is loaded through the same path as
+ * synRecipeDeSerialize, next to a key file holding the full description, which must match for a hit.
+ * The cache folder may be shared by several processes: entries are published by an atomic rename, and publishing
+ * and eviction are serialized between processes using a lock file inside the folder.
+ */
+class RecipeDiskCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t stores;
+        uint64_t evictions;
+    };
+
+    struct GraphKey
+    {
+        uint64_t    hash = 0;
+        std::string description;  // Const tensors data is included by its size and digest
+    };
+
+    static RecipeDiskCache& instance();
+
+    bool isEnabled(const HabanaGraph& graph) const;
+
+    GraphKey calcGraphKey(const HabanaGraph& graph) const;
+
+    // On a hit, rRecipeInfo gets a newly allocated recipe (and shape-plane recipe) owned by its recipe allocator
+    bool load(const GraphKey& key, basicRecipeInfo& rRecipeInfo, const std::string& recipeName);
+
+    void store(const GraphKey& key, const basicRecipeInfo& rRecipeInfo);
+
+    Stats getStats() const;
+
+private:
+    RecipeDiskCache() = default;
+
+    bool prepareFolder(const std::string& folder) const;
+
+    std::string getEntryPath(uint64_t key) const;
+    std::string getKeyPath(uint64_t key) const;
+
+    // Whether the key file of the entry holds the same description, i.e. the hash is not a collision
+    bool isMatchingKey(const GraphKey& key) const;
+
+    void evict(const std::string& folder, uint64_t maxSize);
+
+    std::atomic<uint64_t> m_hits {0};
+    std::atomic<uint64_t> m_misses {0};
+    std::atomic<uint64_t> m_stores {0};
+    std::atomic<uint64_t> m_evictions {0};
+};
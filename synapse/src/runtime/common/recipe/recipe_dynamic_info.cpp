@@ -10,6 +10,7 @@
 #include "recipe_utils.hpp"
 
 #include "infra/defs.h"
+#include "infra/threads/work_stealing_pool.h"
 #include "graph_compiler/smf/shape_func_registry.h"
 
 #include <string.h>
@@ -38,7 +39,11 @@ DynamicRecipe::DynamicRecipe(const basicRecipeInfo&            rRecipeInfo,
   m_pDataChunkSmPatchPointsInfo(pDataChunkSmPatchPointsInfo),
   m_isStaticTensors(rDeviceAgnosticRecipeInfo.m_recipeDsdStaticInfo.m_isStaticTensors),
   m_sfr(ShapeFuncRegistry::instance()),
-  m_patchingStatus({DsdPatchingState::PRE_SIF, nullptr})
+  m_patchingStatus({DsdPatchingState::PRE_SIF, nullptr}),
+  m_sifCacheSize(GCFG_DSD_SIF_CACHE_SIZE.value()),
+  m_isSifCacheable(m_sifCacheSize != 0 && isSifCacheable()),
+  m_sifCacheReplay(nullptr),
+  m_sifCacheReplayTimeNs(0)
 {
     // Allocate memory that is needed per recipe/per stream
 
@@ -98,11 +103,15 @@ DynamicRecipe::DynamicRecipe(const basicRecipeInfo&            rRecipeInfo,
     // Set values that don't change between runs
     const data_chunk_sm_patch_point_t* pCurrentDcSmPatchPoint =
         (m_pDataChunkSmPatchPointsInfo != nullptr) ? m_pDataChunkSmPatchPointsInfo->m_dataChunkSmPatchPoints : nullptr;
+    m_nodeSmPatchPointsStart.reserve(m_NodeParams.size() + 1);
+    m_nodeSmPatchPointsStart.push_back(0);
     for (int node = 0; node < m_NodeParams.size(); node++)
     {
         shape_plane_node_t& currNode       = shapePlaneRecipe->sp_nodes[node];
         auto&               currNodeParams = m_NodeParams[node];
 
+        m_nodeSmPatchPointsStart.push_back(m_nodeSmPatchPointsStart.back() + currNode.node_patch_points_nr);
+
         // SMF info
         // Note: the address of the vectors below are used later in the function so they have to be set first (or at
         // least resized)
@@ -193,6 +202,15 @@ DynamicRecipe::DynamicRecipe(const basicRecipeInfo&            rRecipeInfo,
         currNodeParams.smfParams.nodeIdx = node;
     }
 
+    // Large recipes run the SMF of disjoint node ranges concurrently (the SIF follows the nodes dependencies)
+    m_smfNumThreads               = 1;
+    const uint64_t minPatchPoints = GCFG_PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS.value();
+    if (minPatchPoints != 0 && m_nodeSmPatchPointsStart.back() >= minPatchPoints)
+    {
+        m_smfNumThreads = std::min<uint64_t>(GCFG_PARALLEL_LAUNCH_PREP_NUM_THREADS.value(),
+                                             synapse::WorkStealingPool::instance().getNumOfThreads() + 1);
+    }
+
     STAT_GLBL_COLLECT_TIME(initDynamicRecipe, globalStatPointsEnum::initDynamicRecipe);
 }
 
@@ -211,6 +229,17 @@ bool DynamicRecipe::runSifOnAllNodes(const synLaunchTensorInfoExt* launchTensors
                                      const std::vector<uint32_t>*  tensorIdx2userIdx,
                                      uint64_t                      programDataHostAddress)
 {
+    resetSifCacheRun();
+    if (m_isSifCacheable)
+    {
+        buildSifCacheKey(launchTensorsInfo, tensorIdx2userIdx);
+        if (replaySifFromCache(launchTensorsInfo, launchTensorsAmount, tensorIdx2userIdx))
+        {
+            return true;
+        }
+    }
+
+    StatTimeStart sifStart(m_isSifCacheable && g_globalStat.isEnabled());
     bool status = runSifOnNodes(launchTensorsInfo, launchTensorsAmount, tensorIdx2userIdx, programDataHostAddress);
     if (!status)
     {
@@ -229,6 +258,10 @@ bool DynamicRecipe::runSifOnAllNodes(const synLaunchTensorInfoExt* launchTensors
         STAT_GLBL_COLLECT_TIME(verifyOutputsTime, globalStatPointsEnum::DsdSVerifyOutputs);
     }
 
+    if (m_isSifCacheable)
+    {
+        startSifCacheRecording(g_globalStat.isEnabled() ? TimeTools::timeFromNs(sifStart.startTime) : 0);
+    }
     return true;
 }
 
@@ -331,8 +364,13 @@ bool DynamicRecipe::runSmfOnNodes(const std::vector<uint64_t>& dataChunksHostAdd
         if (!resRunInference)
         {
             STAT_EXIT_NO_COLLECT();
+            m_sifCacheRecording.reset();
             return resRunInference;
         }
+        if (lastNodeIndex == nodesNr)
+        {
+            completeSifCacheRun(g_globalStat.isEnabled() ? TimeTools::timeFromNs(smfTime.startTime) : 0);
+        }
         STAT_GLBL_COLLECT_TIME(smfTime, globalStatPointsEnum::DsdSmf);
     }
 
@@ -362,6 +400,7 @@ bool DynamicRecipe::runSmfOnAllNodes(const std::vector<uint64_t>& dataChunksHost
 void DynamicRecipe::patchAbort()
 {
     m_patchingStatus.patchingState = DsdPatchingState::PRE_SIF;
+    resetSifCacheRun();
 }
 
 bool DynamicRecipe::takeOwnership()
@@ -610,14 +649,39 @@ bool DynamicRecipe::runSmf(const std::vector<uint64_t>& dataChunksHostAddresses,
         m_patchingStatus.current_dc_pp_smf = m_pDataChunkSmPatchPointsInfo->m_dataChunkSmPatchPoints;
     }
 
+    if (m_sifCacheReplay != nullptr)
+    {
+        replaySmfFromCache(dataChunksHostAddresses, firstNodeIndex, lastNodeIndex, stats);
+
+        STAT_GLBL_COLLECT(stats.totalBypass, DsdBypass);
+        STAT_GLBL_COLLECT(stats.totalSkipPP, DsdSkipPP);
+        STAT_GLBL_COLLECT(stats.totalNoPatch, DsdNoPatch);
+        return true;
+    }
+
+    // The SMF may run on a range of nodes at a time, a recording must cover the nodes by order
+    if (m_sifCacheRecording != nullptr && m_sifCacheRecording->nodeStats.size() != firstNodeIndex)
+    {
+        m_sifCacheRecording.reset();
+    }
+
     const data_chunk_sm_patch_point_t* pCurrentDcSmPatchPoint = m_patchingStatus.current_dc_pp_smf;
 
-    for (uint64_t nodeIdx = firstNodeIndex; nodeIdx < lastNodeIndex; nodeIdx++)
+    const uint64_t rangeSmPatchPoints =
+        m_nodeSmPatchPointsStart[lastNodeIndex] - m_nodeSmPatchPointsStart[firstNodeIndex];
+    if (m_smfNumThreads > 1 && rangeSmPatchPoints >= GCFG_PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS.value())
     {
-        patchPPs(nodeIdx,
-                 pCurrentDcSmPatchPoint,
-                 dataChunksHostAddresses,
-                 stats);  // is it a function call or does the compiler optimize it?
+        runSmfParallel(dataChunksHostAddresses, firstNodeIndex, lastNodeIndex, pCurrentDcSmPatchPoint, stats);
+        pCurrentDcSmPatchPoint += rangeSmPatchPoints;
+    }
+    else
+    {
+        patchNodes(firstNodeIndex,
+                   lastNodeIndex,
+                   pCurrentDcSmPatchPoint,
+                   dataChunksHostAddresses,
+                   stats,
+                   m_sifCacheRecording.get());
     }
 
     m_patchingStatus.current_dc_pp_smf = (data_chunk_sm_patch_point_t*)pCurrentDcSmPatchPoint;
@@ -629,6 +693,113 @@ bool DynamicRecipe::runSmf(const std::vector<uint64_t>& dataChunksHostAddresses,
     return true;
 }
 
+/*
+ ***************************************************************************************************
+ *   @brief Runs the SMF of a range of nodes, pCurrentDcSmPatchPoint is advanced over the nodes
+ *          patch-points. The SMF results are added to 'recording', if given
+ ***************************************************************************************************
+ */
+void DynamicRecipe::patchNodes(uint32_t                            firstNodeIndex,
+                               uint32_t                            lastNodeIndex,
+                               const data_chunk_sm_patch_point_t*& pCurrentDcSmPatchPoint,
+                               const std::vector<uint64_t>&        dataChunksHostAddresses,
+                               StatsCol&                           stats,
+                               SifCacheEntry*                      recording)
+{
+    for (uint64_t nodeIdx = firstNodeIndex; nodeIdx < lastNodeIndex; nodeIdx++)
+    {
+        const StatsCol nodeStartStats = stats;
+        patchPPs(nodeIdx,
+                 pCurrentDcSmPatchPoint,
+                 dataChunksHostAddresses,
+                 stats,
+                 recording);  // is it a function call or does the compiler optimize it?
+
+        if (recording != nullptr)
+        {
+            recording->nodeStats.push_back({stats.totalBypass - nodeStartStats.totalBypass,
+                                            stats.totalSkipPP - nodeStartStats.totalSkipPP,
+                                            stats.totalNoPatch - nodeStartStats.totalNoPatch});
+            recording->nodeRecordsStart.push_back(recording->records.size());
+        }
+    }
+}
+
+/*
+ ***************************************************************************************************
+ *   @brief Same as patchNodes, with the node range split to sub-ranges of about the same number of
+ *          patch-points, run by the calling thread and threads of the shared pool.
+ *          The nodes patch distinct locations, and the statistics and SIF cache recording of the
+ *          sub-ranges are merged by node order, so the results are the same as a sequential run
+ ***************************************************************************************************
+ */
+void DynamicRecipe::runSmfParallel(const std::vector<uint64_t>&       dataChunksHostAddresses,
+                                   uint32_t                           firstNodeIndex,
+                                   uint32_t                           lastNodeIndex,
+                                   const data_chunk_sm_patch_point_t* pFirstDcSmPatchPoint,
+                                   StatsCol&                          stats)
+{
+    const uint64_t firstPatchPoint = m_nodeSmPatchPointsStart[firstNodeIndex];
+    const uint64_t numPatchPoints  = m_nodeSmPatchPointsStart[lastNodeIndex] - firstPatchPoint;
+
+    // First node per chunk, plus the range end
+    std::vector<uint32_t> chunksStart = {firstNodeIndex};
+    for (uint32_t chunk = 1; chunk < m_smfNumThreads; chunk++)
+    {
+        const uint64_t chunkStartPatchPoint = firstPatchPoint + numPatchPoints * chunk / m_smfNumThreads;
+        const uint32_t chunkStartNode       = std::lower_bound(m_nodeSmPatchPointsStart.begin() + chunksStart.back(),
+                                                         m_nodeSmPatchPointsStart.begin() + lastNodeIndex,
+                                                         chunkStartPatchPoint) -
+                                        m_nodeSmPatchPointsStart.begin();
+        if (chunkStartNode > chunksStart.back())
+        {
+            chunksStart.push_back(chunkStartNode);
+        }
+    }
+    chunksStart.push_back(lastNodeIndex);
+
+    const uint32_t             numChunks = chunksStart.size() - 1;
+    std::vector<StatsCol>      chunksStats(numChunks);
+    std::vector<SifCacheEntry> chunksRecording(m_sifCacheRecording != nullptr ? numChunks : 0);
+
+    auto runChunk = [&](uint32_t chunk) {
+        const data_chunk_sm_patch_point_t* pChunkDcSmPatchPoint =
+            pFirstDcSmPatchPoint + (m_nodeSmPatchPointsStart[chunksStart[chunk]] - firstPatchPoint);
+        SifCacheEntry* recording = chunksRecording.empty() ? nullptr : &chunksRecording[chunk];
+        if (recording != nullptr)
+        {
+            recording->nodeRecordsStart.push_back(0);
+        }
+        patchNodes(chunksStart[chunk],
+                   chunksStart[chunk + 1],
+                   pChunkDcSmPatchPoint,
+                   dataChunksHostAddresses,
+                   chunksStats[chunk],
+                   recording);
+    };
+
+    {
+        synapse::TaskGroup tasks;
+        for (uint32_t chunk = 1; chunk < numChunks; chunk++)
+        {
+            tasks.run([&runChunk, chunk]() { runChunk(chunk); });
+        }
+        runChunk(0);
+        tasks.wait();
+    }
+
+    for (uint32_t chunk = 0; chunk < numChunks; chunk++)
+    {
+        stats.totalBypass += chunksStats[chunk].totalBypass;
+        stats.totalSkipPP += chunksStats[chunk].totalSkipPP;
+        stats.totalNoPatch += chunksStats[chunk].totalNoPatch;
+        if (m_sifCacheRecording != nullptr)
+        {
+            appendSifCacheRecording(chunksRecording[chunk]);
+        }
+    }
+}
+
 /*
 ***************************************************************************************************
 *   @brief This function verify that the output dynamic persistent tensors (calculated by SIF) comply with the min/max
@@ -1214,7 +1385,8 @@ void DynamicRecipe::getFuserNodeSifParams(uint32_t    nodeIdx,
 bool DynamicRecipe::patchPPs(int                                 nodeIdx,
                              const data_chunk_sm_patch_point_t*& pCurrentDcSmPatchPoint,
                              const std::vector<uint64_t>&        dataChunksHostAddresses,
-                             StatsCol&                           stats)
+                             StatsCol&                           stats,
+                             SifCacheEntry*                      recording)
 {
     STAT_FUNCTION();
     shape_plane_graph_t* shapePlanRecipe  = m_rRecipeInfo.shape_plan_recipe;
@@ -1271,6 +1443,10 @@ bool DynamicRecipe::patchPPs(int                                 nodeIdx,
             {
                 return res;  // Error is logged in the function
             }
+            if (recording != nullptr)
+            {
+                recordSmfOutputs(*recording, *pCurrentPatchPoint, currNodePpParams->shapeManOut);
+            }
             if (shouldBypass)
             {
                 stats.totalBypass++;
@@ -1341,8 +1517,7 @@ bool DynamicRecipe::runSmf(int                                nodeIdx,
         auto pp_high = currentPatchPoint.patch_point_idx_high;
         if (pp_high != -1)
         {
-            std::memcpy(m_patchPoints.size() > 0 ?
-                        &m_patchPoints[pp_high].memory_patch_point.effective_address : m_recipeAddrPatcher.getPatchPointEffectiveAddr(pp_high),
+            std::memcpy(getPatchPointEffectiveAddr(pp_high),
                         outputs.outputPatchValues,
                         outputs.outPatchValuesNr * sizeof(uint32_t));
         }
@@ -1653,3 +1828,231 @@ void DynamicRecipe::_setDataChunkNodeParams(PPparams&                          n
         nodePatchPointParams.shapeManOut.outputPatchValues = patchAddr;
     }
 }
+
+uint64_t* DynamicRecipe::getPatchPointEffectiveAddr(uint32_t patchPointIdx)
+{
+    return (m_originalPatchPoints != nullptr) ? &m_patchPoints[patchPointIdx].memory_patch_point.effective_address
+                                              : m_recipeAddrPatcher.getPatchPointEffectiveAddr(patchPointIdx);
+}
+
+/*
+ ***************************************************************************************************
+ *   SIF cache
+ *
+ *   Serving workloads cycle through a small set of shapes. The SIF and SMF results depend only on
+ *   the launch-tensors shapes (the recipe inputs and outputs), so for a repeated set of shapes the
+ *   results of the previous run are replayed instead of running the functions again.
+ *   Recipes with host tensors are not cached, their SIF results depend on the host data as well.
+ ***************************************************************************************************
+ */
+size_t DynamicRecipe::SifCacheKeyHash::operator()(const std::vector<TSize>& key) const
+{
+    size_t hash = key.size();
+    for (TSize size : key)
+    {
+        hash ^= std::hash<TSize>()(size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+bool DynamicRecipe::isSifCacheable() const
+{
+    if (RecipeUtils::isIH2DRecipe(m_rRecipeInfo.recipe)) return false;
+
+    const shape_plane_graph_t* spg = m_rRecipeInfo.shape_plan_recipe;
+    for (uint64_t tensorIdx = 0; tensorIdx < spg->sp_tensors_nr; tensorIdx++)
+    {
+        const tensor_info_t& tensor = spg->sp_tensors[tensorIdx];
+        if ((tensor.tensor_flags & tensor_info_t::HAS_HOST_ADDRESS) ||
+            (tensor.user_tensor_type == HOST_SHAPE_TENSOR) || (tensor.user_tensor_type == HOST_TO_DEVICE_TENSOR))
+        {
+            LOG_DSD_DEBUG("SIF cache is disabled, recipe has host tensors");
+            return false;
+        }
+    }
+    return true;
+}
+
+void DynamicRecipe::buildSifCacheKey(const synLaunchTensorInfoExt* launchTensorsInfo,
+                                     const std::vector<uint32_t>*  tensorIdx2userIdx)
+{
+    const auto& dsdStaticInfo = m_rDeviceAgnosticRecipeInfo.m_recipeDsdStaticInfo;
+
+    // The sizes of the dynamic inputs determine the SIF results, the sizes of the outputs determine its verification
+    auto addTensorSizes = [&](uint64_t tensorIdx) {
+        const tensor_info_t&          currTensor   = m_sp_tensors_private[tensorIdx];
+        uint32_t                      idxLaunch    = tensorIdx2userIdx[currTensor.tensor_type][currTensor.tensor_db_index];
+        const synLaunchTensorInfoExt& launchTensor = launchTensorsInfo[idxLaunch];
+        m_sifCacheKey.insert(m_sifCacheKey.end(),
+                             launchTensor.tensorSize,
+                             launchTensor.tensorSize + tpc_lib_api::MAX_TENSOR_DIM);
+    };
+
+    m_sifCacheKey.clear();
+    for (auto tensorIdx : dsdStaticInfo.m_recipeInputs)
+    {
+        if (!m_isStaticTensors[tensorIdx])
+        {
+            addTensorSizes(tensorIdx);
+        }
+    }
+    for (auto tensorIdx : dsdStaticInfo.m_recipeOutputs)
+    {
+        addTensorSizes(tensorIdx);
+    }
+}
+
+bool DynamicRecipe::replaySifFromCache(const synLaunchTensorInfoExt* launchTensorsInfo,
+                                       const uint32_t                launchTensorsAmount,
+                                       const std::vector<uint32_t>*  tensorIdx2userIdx)
+{
+    auto it = m_sifCache.find(m_sifCacheKey);
+    if (it == m_sifCache.end())
+    {
+        STAT_GLBL_COLLECT(1, DsdSifCacheMiss);
+        m_sifCacheStats.misses++;
+        return false;
+    }
+
+    StatTimeStart replayStart(g_globalStat.isEnabled());
+    STAT_GLBL_COLLECT(1, DsdSifCacheHit);
+    m_sifCacheStats.hits++;
+    LOG_DSD_DEBUG("SIF cache hit");
+
+    m_launchTensorsInfo   = launchTensorsInfo;
+    m_launchTensorsAmount = launchTensorsAmount;
+    m_tensorIdx2userIdx   = tensorIdx2userIdx;
+    initRecipe();
+
+    const SifCacheEntry& entry = *it->second;
+    for (size_t tensorIdx = 0; tensorIdx < m_sp_tensors_private.size(); tensorIdx++)
+    {
+        m_sp_tensors_private[tensorIdx].infer_info = entry.tensorsInferInfo[tensorIdx];
+    }
+
+    m_sifCacheReplay               = &entry;
+    m_patchingStatus.patchingState = DsdPatchingState::SIF_EXECUTED;
+    m_sifCacheReplayTimeNs         = g_globalStat.isEnabled() ? TimeTools::timeFromNs(replayStart.startTime) : 0;
+    return true;
+}
+
+void DynamicRecipe::startSifCacheRecording(uint64_t sifTimeNs)
+{
+    m_sifCacheRecording = std::make_unique<SifCacheEntry>();
+    m_sifCacheRecording->tensorsInferInfo.reserve(m_sp_tensors_private.size());
+    for (const tensor_info_t& tensor : m_sp_tensors_private)
+    {
+        m_sifCacheRecording->tensorsInferInfo.push_back(tensor.infer_info);
+    }
+    m_sifCacheRecording->nodeRecordsStart.push_back(0);
+    m_sifCacheRecording->runTimeNs = sifTimeNs;
+}
+
+void DynamicRecipe::recordSmfOutputs(SifCacheEntry&                     entry,
+                                     const data_chunk_sm_patch_point_t& currentPatchPoint,
+                                     const ShapeManipulationOutputs&    outputs)
+{
+    if (outputs.outPatchValuesNr == 0) return;
+
+    const uint32_t* patchValues = outputs.outputPatchValues;
+    if (currentPatchPoint.patch_point_type == FIELD_DYNAMIC_ADDRESS)
+    {
+        // The SMF output is written to the effective address of the low patch-point and copied to the high one
+        for (auto ppIdx : {currentPatchPoint.patch_point_idx_low, currentPatchPoint.patch_point_idx_high})
+        {
+            if (ppIdx == -1) continue;
+
+            entry.records.push_back({ppIdx, (uint32_t)entry.values.size(), outputs.outPatchValuesNr, true, 0});
+            entry.values.insert(entry.values.end(), patchValues, patchValues + outputs.outPatchValuesNr);
+        }
+        return;
+    }
+
+    // The SMF patches the data-chunk in place
+    entry.records.push_back({currentPatchPoint.offset_in_data_chunk,
+                             (uint32_t)entry.values.size(),
+                             outputs.outPatchValuesNr,
+                             false,
+                             currentPatchPoint.data_chunk_index});
+    entry.values.insert(entry.values.end(), patchValues, patchValues + outputs.outPatchValuesNr);
+}
+
+// Appends the recording of the next nodes, recorded on its own
+void DynamicRecipe::appendSifCacheRecording(const SifCacheEntry& nextNodes)
+{
+    SifCacheEntry& entry        = *m_sifCacheRecording;
+    const uint32_t recordsStart = entry.records.size();
+    const uint32_t valuesStart  = entry.values.size();
+
+    for (SifCacheEntry::PatchRecord record : nextNodes.records)
+    {
+        record.valuesStart += valuesStart;
+        entry.records.push_back(record);
+    }
+    entry.values.insert(entry.values.end(), nextNodes.values.begin(), nextNodes.values.end());
+    entry.nodeStats.insert(entry.nodeStats.end(), nextNodes.nodeStats.begin(), nextNodes.nodeStats.end());
+    // skip the leading 0
+    for (auto it = nextNodes.nodeRecordsStart.begin() + 1; it != nextNodes.nodeRecordsStart.end(); ++it)
+    {
+        entry.nodeRecordsStart.push_back(*it + recordsStart);
+    }
+}
+
+void DynamicRecipe::replaySmfFromCache(const std::vector<uint64_t>& dataChunksHostAddresses,
+                                       uint32_t                     firstNodeIndex,
+                                       uint32_t                     lastNodeIndex,
+                                       StatsCol&                    stats)
+{
+    const SifCacheEntry& entry = *m_sifCacheReplay;
+
+    for (uint32_t nodeIdx = firstNodeIndex; nodeIdx < lastNodeIndex; nodeIdx++)
+    {
+        for (uint32_t recordIdx = entry.nodeRecordsStart[nodeIdx]; recordIdx < entry.nodeRecordsStart[nodeIdx + 1];
+             recordIdx++)
+        {
+            const SifCacheEntry::PatchRecord& record = entry.records[recordIdx];
+            const uint32_t*                   values = &entry.values[record.valuesStart];
+            uint8_t* dst = record.isEffectiveAddress
+                               ? (uint8_t*)getPatchPointEffectiveAddr(record.location)
+                               : (uint8_t*)dataChunksHostAddresses[record.dataChunkIndex] + record.location;
+            std::memcpy(dst, values, record.valuesNr * sizeof(uint32_t));
+        }
+
+        const StatsCol& nodeStats = entry.nodeStats[nodeIdx];
+        stats.totalBypass += nodeStats.totalBypass;
+        stats.totalSkipPP += nodeStats.totalSkipPP;
+        stats.totalNoPatch += nodeStats.totalNoPatch;
+    }
+}
+
+void DynamicRecipe::completeSifCacheRun(uint64_t smfTimeNs)
+{
+    if (m_sifCacheReplay != nullptr)
+    {
+        const uint64_t replayTimeNs = m_sifCacheReplayTimeNs + smfTimeNs;
+        if (m_sifCacheReplay->runTimeNs > replayTimeNs)
+        {
+            STAT_GLBL_COLLECT(m_sifCacheReplay->runTimeNs - replayTimeNs, DsdSifCacheSaved);
+        }
+        m_sifCacheReplay = nullptr;
+        return;
+    }
+
+    if (m_sifCacheRecording == nullptr) return;
+
+    if (m_sifCache.size() >= m_sifCacheSize)
+    {
+        m_sifCache.erase(m_sifCacheOrder.front());
+        m_sifCacheOrder.pop_front();
+    }
+    m_sifCacheRecording->runTimeNs += smfTimeNs;
+    m_sifCacheOrder.push_back(m_sifCacheKey);
+    m_sifCache.emplace(m_sifCacheKey, std::move(m_sifCacheRecording));
+    LOG_DSD_DEBUG("SIF cache stored run, {} entries", m_sifCache.size());
+}
+
+void DynamicRecipe::resetSifCacheRun()
+{
+    m_sifCacheReplay = nullptr;
+    m_sifCacheRecording.reset();
+}
@@ -8,7 +8,10 @@
 #include "runtime/common/recipe/patching/define.hpp"
 #include "runtime/scal/common/patching/recipe_addr_patcher.hpp"
 
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #define LOG_DSD_EXTRA(...) do { if (false) LOG_DSD_TRACE(__VA_ARGS__) } while(false);
 #ifndef VTUNE_ENABLED
@@ -31,6 +34,8 @@ class DynamicRecipe
         uint64_t totalNoPatch = 0;
     };
 
+    struct SifCacheEntry;
+
 public:
     // Gaudi Ctor
     DynamicRecipe(const basicRecipeInfo&            rRecipeInfo,
@@ -46,6 +51,7 @@ public:
                   const RecipeAddrPatcher*          pRecipeAddrPatcher)
                   : DynamicRecipe(rRecipeInfo, rDeviceAgnosticRecipeInfo, pDataChunkSmPatchPointsInfo, nullptr, pRecipeAddrPatcher) {}
 
+    // A repeated set of launch-tensors shapes replays the cached SIF and SMF results (see SifCacheEntry)
     bool runSifOnAllNodes(const synLaunchTensorInfoExt* launchTensorsInfo,
                           const uint32_t                launchTensorsAmount,
                           const std::vector<uint32_t>*  tensorIdx2userIdx,
@@ -74,6 +80,15 @@ public:
     data_chunk_patch_point_t*  getPatchPoints() { return m_patchPoints.data(); }
     std::vector<tensor_info_t> getDynamicShapesTensorInfoArray() const { return m_sp_tensors_private; };
 
+    struct SifCacheStats
+    {
+        uint64_t hits   = 0;
+        uint64_t misses = 0;
+    };
+    const SifCacheStats& getSifCacheStats() const { return m_sifCacheStats; }
+
+    uint32_t getSmfNumThreads() const { return m_smfNumThreads; }
+
 private:
 #if 0
     void dumpBlobData(); // For dbug only (prints to screen)
@@ -105,7 +120,21 @@ private:
     bool patchPPs(int                                 nodeIdx,
                   const data_chunk_sm_patch_point_t*& pCurrentDcSmPatchPoint,
                   const std::vector<uint64_t>&        dataChunksHostAddresses,
-                  StatsCol&                           stats);
+                  StatsCol&                           stats,
+                  SifCacheEntry*                      recording);
+
+    void patchNodes(uint32_t                            firstNodeIndex,
+                    uint32_t                            lastNodeIndex,
+                    const data_chunk_sm_patch_point_t*& pCurrentDcSmPatchPoint,
+                    const std::vector<uint64_t>&        dataChunksHostAddresses,
+                    StatsCol&                           stats,
+                    SifCacheEntry*                      recording);
+
+    void runSmfParallel(const std::vector<uint64_t>&       dataChunksHostAddresses,
+                        uint32_t                           firstNodeIndex,
+                        uint32_t                           lastNodeIndex,
+                        const data_chunk_sm_patch_point_t* pFirstDcSmPatchPoint,
+                        StatsCol&                          stats);
 
     bool runSmf(int                                nodeIdx,
                 int                                ppIdx,
@@ -124,6 +153,26 @@ private:
                                  uint32_t     subNode);
     const char* getTensorName(uint64_t tensor) { return staticGetTensorName(tensor, &m_rRecipeInfo); };
 
+    uint64_t* getPatchPointEffectiveAddr(uint32_t patchPointIdx);
+
+    // SIF cache
+    bool isSifCacheable() const;
+    void buildSifCacheKey(const synLaunchTensorInfoExt* launchTensorsInfo, const std::vector<uint32_t>* tensorIdx2userIdx);
+    bool replaySifFromCache(const synLaunchTensorInfoExt* launchTensorsInfo,
+                            const uint32_t                launchTensorsAmount,
+                            const std::vector<uint32_t>*  tensorIdx2userIdx);
+    void startSifCacheRecording(uint64_t sifTimeNs);
+    void recordSmfOutputs(SifCacheEntry&                     entry,
+                          const data_chunk_sm_patch_point_t& currentPatchPoint,
+                          const ShapeManipulationOutputs&    outputs);
+    void appendSifCacheRecording(const SifCacheEntry& nextNodes);
+    void replaySmfFromCache(const std::vector<uint64_t>& dataChunksHostAddresses,
+                            uint32_t                     firstNodeIndex,
+                            uint32_t                     lastNodeIndex,
+                            StatsCol&                    stats);
+    void completeSifCacheRun(uint64_t smfTimeNs);
+    void resetSifCacheRun();
+
 private:
     static const uint64_t NODE_IDX_FOR_INIT_TENSOR    = 0xFFFFFFFFFFFFFFFF;
     static const uint64_t NODE_IDX_FOR_VERIFY_OUTPUTS = 0xFFFFFFFFFFFFFFFE;
@@ -209,6 +258,9 @@ private:
     const std::vector<bool>& m_isStaticTensors;  // bitmap which tensors are static
     ShapeFuncRegistry&       m_sfr;
 
+    std::vector<uint64_t> m_nodeSmPatchPointsStart;  // index of the first SMF patch-point per node, plus the end
+    uint32_t              m_smfNumThreads;           // 1 unless the recipe is large enough for parallel SMF
+
     // Fuser
     std::vector<TensorShapeInfo*> m_fuserSifInTensors;
     std::vector<TensorShapeInfo*> m_fuserSifOutTensors;
@@ -227,4 +279,42 @@ private:
     std::vector<bool> m_tensorSizeInferred;  // bitmap indicates which tensors has its size calculated
     std::vector<bool> m_fuserNodeTensorSizeInferred;
 #endif
+
+    // The results of a SIF + SMF run, for a given set of launch-tensors shapes. Replaying them (after initRecipe) gives
+    // the same tensors shapes, patch-points effective addresses and data-chunks patching as running the functions
+    struct SifCacheEntry
+    {
+        struct PatchRecord
+        {
+            uint32_t location;     // offset in data-chunk, or patch-point index of a dynamic address
+            uint32_t valuesStart;  // index of the first value in values
+            uint32_t valuesNr : 31;
+            uint32_t isEffectiveAddress : 1;
+            uint32_t dataChunkIndex;
+        };
+
+        std::vector<tensor_shape_infer_info_t> tensorsInferInfo;  // SIF results, per shape-plane tensor
+        std::vector<uint32_t>                  nodeRecordsStart;  // per node, plus a terminating index
+        std::vector<PatchRecord>               records;           // SMF results, by node order
+        std::vector<uint32_t>                  values;
+        std::vector<StatsCol>                  nodeStats;         // bypass / skip decisions, per node
+        uint64_t                               runTimeNs = 0;     // SIF + SMF time, when collected
+    };
+
+    struct SifCacheKeyHash
+    {
+        size_t operator()(const std::vector<TSize>& key) const;
+    };
+
+    using SifCache = std::unordered_map<std::vector<TSize>, std::unique_ptr<SifCacheEntry>, SifCacheKeyHash>;
+
+    const uint64_t                 m_sifCacheSize;
+    const bool                     m_isSifCacheable;
+    SifCache                       m_sifCache;
+    std::deque<std::vector<TSize>> m_sifCacheOrder;         // for eviction, oldest first
+    std::vector<TSize>             m_sifCacheKey;           // key of the current run
+    const SifCacheEntry*           m_sifCacheReplay;        // entry replayed by the current run
+    std::unique_ptr<SifCacheEntry> m_sifCacheRecording;     // entry recorded by the current run
+    uint64_t                       m_sifCacheReplayTimeNs;
+    SifCacheStats                  m_sifCacheStats;
 };
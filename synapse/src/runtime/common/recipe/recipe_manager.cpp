@@ -3,6 +3,7 @@
 #include "synapse_runtime_logging.h"
 #include "recipe_handle_impl.hpp"
 #include "recipe_allocator.h"
+#include "recipe_disk_cache.hpp"
 #include "recipe_serializer.hpp"
 #include "recipe_logger.hpp"
 #include "habana_graph.h"
@@ -285,6 +286,20 @@ synStatus RecipeManager::compileGraph(HabanaGraph*                graph,
 
     graph->dumpGraphToJson(graph_serializer::GraphState::PRE_COMPILE);
 
+    // The persistent cache holds serialized recipes only, hence it is skipped when a recipe isn't requested
+    RecipeDiskCache&          diskCache    = RecipeDiskCache::instance();
+    const bool                useDiskCache = !isProtobuf && (fileName != nullptr) && diskCache.isEnabled(*graph);
+    RecipeDiskCache::GraphKey graphKey;
+    if (useDiskCache)
+    {
+        HB_ASSERT_PTR(ppRecipeHandle);
+        graphKey = diskCache.calcGraphKey(*graph);
+        if (diskCache.load(graphKey, (*ppRecipeHandle)->basicRecipeHandle, graph->getRecipeName()))
+        {
+            return synSuccess;
+        }
+    }
+
     bool ret = true;
 
     // measure compilation time only if logger is in debug level
@@ -337,6 +352,11 @@ synStatus RecipeManager::compileGraph(HabanaGraph*                graph,
                 basicRecipeHandle.shape_plan_recipe = graph->serializeShapePlane(basicRecipeHandle.recipeAllocator);
             }
 
+            if (useDiskCache)
+            {
+                diskCache.store(graphKey, basicRecipeHandle);
+            }
+
             ETL_DEBUG(EVENT_LOGGER_LOG_TYPE_CHECK_OPCODES,
                       SYN_RECIPE,
                       "Recipe Name {} Recipe ID {:#x}",
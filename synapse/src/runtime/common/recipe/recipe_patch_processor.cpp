@@ -1,6 +1,7 @@
 #include "runtime/common/recipe/recipe_patch_processor.hpp"
 #include "runtime/common/recipe/recipe_tensor_processor.hpp"
 #include "runtime/common/recipe/basic_recipe_info.hpp"
+#include "runtime/common/recipe/launch_capture.hpp"
 #include "runtime/common/recipe/patching/host_address_patcher.hpp"
 #include "utils.h"
 #include "habana_global_conf_runtime.h"
@@ -104,6 +105,63 @@ synStatus RecipePatchProcessor::process(const basicRecipeInfo&
     return status;
 }
 
+synStatus RecipePatchProcessor::processReplay(const basicRecipeInfo&                    rBasicRecipeInfo,
+                                              const RecipeTensorsInfo&                  rRecipeTensorsInfo,
+                                              LaunchCapture&                            rLaunchCapture,
+                                              const synLaunchTensorInfoExt*             enqueueTensorsInfo,
+                                              const WorkSpacesInformation&              rWorkSpacesInformation,
+                                              patching::HostAddressPatchingInformation& rPatchInfo,
+                                              const ValidSectionAddresses*              pValidSectionAddresses,
+                                              bool&                                     rTensorsChanged)
+{
+    rPatchInfo.initialize(rRecipeTensorsInfo.m_maxSectionId, rRecipeTensorsInfo.m_numSectionsToPatch);
+
+    bool res = _setWorkspacesSectionAddress(rBasicRecipeInfo,
+                                            rWorkSpacesInformation,
+                                            rPatchInfo,
+                                            &rRecipeTensorsInfo.m_sectionToSectionType);
+    if (!res)
+    {
+        return synFail;
+    }
+
+    synStatus status = synFail;
+    if (_checkWorkspaceAddresses(rBasicRecipeInfo, rWorkSpacesInformation, pValidSectionAddresses))
+    {
+        status = rLaunchCapture.setSectionsAddresses(enqueueTensorsInfo, rPatchInfo, rTensorsChanged);
+    }
+
+    if (status == synSuccess)
+    {
+        // some sections may be 0 size, and the user didn't give a tensorInfo for them
+        for (auto sectionId : rRecipeTensorsInfo.m_constZeroSizeSections)
+        {
+            if (!rPatchInfo.markConstZeroSizeSection(sectionId))
+            {
+                status = synFail;
+                break;
+            }
+        }
+    }
+
+    if ((status == synSuccess) && !rPatchInfo.validateAllSectionsAddressSet())
+    {
+        LOG_ERR(SYN_RECIPE, "{}: Invalid patching information, some sections were not set", HLLOG_FUNC);
+        status = synFail;
+    }
+
+    if (status != synSuccess)
+    {
+        rPatchInfo.patchingAbort();
+    }
+    else
+    {
+        rPatchInfo.patchingCompletion();
+    }
+
+    return status;
+}
+
 bool RecipePatchProcessor::_setWorkspacesSectionAddress(
     const basicRecipeInfo&                    rBasicRecipeInfo,
     const WorkSpacesInformation&              workspaceInfo,
@@ -561,6 +619,10 @@ synStatus RecipePatchProcessor::resolveSectionsAddresses(const basicRecipeInfo&
               launchTensorsAmount,
               (uint64_t)launchTensorsInfo);
 
+    const uint64_t numberPersistTensors = rBasicRecipeInfo.recipe->persist_tensors_nr;
+    const uint64_t numberShapeTensors   = rBasicRecipeInfo.shape_plan_recipe != nullptr ?
+                                          rBasicRecipeInfo.shape_plan_recipe->shape_tensors_list_nr : 0;
+
     tensor_info_t::ETensorType tensorRecipeType = tensor_info_t::PERSISTENT_TENSOR;
     synTensorType              tensorType       = TENSOR_TYPE_INVALID;
     uint64_t                   tensorIndex      = 0;
@@ -584,6 +646,14 @@ synStatus RecipePatchProcessor::resolveSectionsAddresses(const basicRecipeInfo&
 
         _retrieveTensorInfo(tensorRecipeType, tensorType, tensorIndex, tensorId);
 
+        if (!_resolveSingleTensorIdToTensorIndex(tensorRecipeType,
+                                                 tensorIndex,
+                                                 numberShapeTensors,
+                                                 numberPersistTensors))
+        {
+            return synFail;
+        }
+
         if (tensorRecipeType != tensor_info_t::PERSISTENT_TENSOR)  // code below relevant only for persistent Tensors
         {
             continue;
@@ -614,13 +684,7 @@ synStatus RecipePatchProcessor::resolveSectionsAddresses(const basicRecipeInfo&
         }
     }
 
-    if (!hostAddressPatchingInfo.validateAllSectionsAddressSet())
-    {
-        LOG_ERR(SYN_RECIPE, "{}: Invalid patching information, some sections were not set", HLLOG_FUNC);
-        hostAddressPatchingInfo.patchingAbort();
-        return synFail;
-    }
-
+    // The sections are validated by the caller, once the const zero-size ones (not given by the user) are marked
     return synSuccess;
 }
 
@@ -17,6 +17,7 @@ class RecipeStaticInfo;
 class DevMemoryAllocInterface;
 struct WorkSpacesInformation;
 struct DeviceAgnosticRecipeInfo;
+class LaunchCapture;
 
 namespace patching
 {
@@ -96,6 +97,16 @@ public:
                              bool                                      shouldResolveTensorsIndices,
                              const ValidSectionAddresses*              pValidSectionAddresses);
 
+    // Same as process, for the launch-tensors of a captured launch (resolves only the sections of changed tensors)
+    static synStatus processReplay(const basicRecipeInfo&                    rBasicRecipeInfo,
+                                   const RecipeTensorsInfo&                  rRecipeTensorsInfo,
+                                   LaunchCapture&                            rLaunchCapture,
+                                   const synLaunchTensorInfoExt*             enqueueTensorsInfo,
+                                   const WorkSpacesInformation&              rWorkSpacesInformation,
+                                   patching::HostAddressPatchingInformation& rPatchInfo,
+                                   const ValidSectionAddresses*              pValidSectionAddresses,
+                                   bool&                                     rTensorsChanged);
+
     // validate the sections new base offset for given tensors.
     static synStatus validateSectionsInfo(const basicRecipeInfo&         rBasicRecipeInfo,
                                           const RecipeTensorsInfo&       rRecipeInfo,
@@ -70,58 +70,28 @@ RecipeTensorsInfo::tensorRetrieveIds(const char** tensorNames, uint64_t* tensorI
 
 synStatus RecipeTensorsInfo::tensorRetrieveId(const char* tensorName, uint64_t* tensorId) const
 {
+    CHECK_POINTER(SYN_RECIPE, tensorName, "tensorName", synInvalidArgument);
+
     if (m_recipe == nullptr)
     {
         LOG_WARN(SYN_RECIPE, "{}: Can't get tensor {} id, recipe not processed", HLLOG_FUNC, tensorName);
         return synFail;
     }
 
-    if (m_shapePlanRecipe != nullptr)
-    {
-        for (uint64_t i = 0; i < m_shapePlanRecipe->sp_tensors_nr; i++)
-        {
-            tensor_info_t& curr      = m_shapePlanRecipe->sp_tensors[i];
-            if (isInternalTensor(curr)) continue;
-            uint64_t       tensorIdx = curr.tensor_db_index;
-            const char* name = curr.tensor_type == tensor_info_t::PERSISTENT_TENSOR ?
-                                    m_recipe->tensors[tensorIdx].name : m_shapePlanRecipe->shape_tensors[tensorIdx].name;
-            if (strcmp(name, tensorName) == 0)
-            {
-                *tensorId = GET_TENSOR_INFO(tensorIdx, curr.user_tensor_type);
-                LOG_DEBUG(SYN_RECIPE,
-                          "{}: DSD recipe: tensorName {} tensorId {} tensorType {} user_tensor_type {} dataType {} recipe {}",
-                          HLLOG_FUNC,
-                          tensorName,
-                          *tensorId,
-                          curr.tensor_type,
-                          curr.user_tensor_type,
-                          curr.data_type,
-                          TO64(m_recipe));
-                return synSuccess;
-            }
-        }
-    }
-    else
+    auto tensorIter = m_tensorName2id.find(tensorName);
+    if (tensorIter != m_tensorName2id.end())
     {
-        const uint64_t numPersistTensors = m_recipe->persist_tensors_nr;
-        for (uint64_t i = 0; i < numPersistTensors; i++)
-        {
-            auto& curr = m_recipe->tensors[i];
-            if (strcmp(curr.name, tensorName) == 0)
-            {
-                *tensorId = GET_TENSOR_INFO(i, DATA_TENSOR);
-                LOG_DEBUG(SYN_RECIPE,
-                          "{}: Static recipe: tensorName {} tensorId {}, dataType {}, sectionIdx {}, recipe {}",
-                          HLLOG_FUNC,
-                          tensorName,
-                          *tensorId,
-                          curr.elementType,
-                          curr.section_idx,
-                          TO64(m_recipe));
-                return synSuccess;
-            }
-        }
+        *tensorId = tensorIter->second;
+        LOG_DEBUG(SYN_RECIPE,
+                  "{}: {} recipe: tensorName {} tensorId {} recipe {}",
+                  HLLOG_FUNC,
+                  (m_shapePlanRecipe != nullptr) ? "DSD" : "Static",
+                  tensorName,
+                  *tensorId,
+                  TO64(m_recipe));
+        return synSuccess;
     }
+
     *tensorId = TENSOR_INVALID_ID;
     LOG_DEBUG(SYN_RECIPE, "{}: Given tensor not in persist/shape list: {}", HLLOG_FUNC, tensorName);
 
@@ -4,6 +4,7 @@
 #include "synapse_common_types.h"
 #include "recipe_patch_processor.hpp"
 #include <unordered_set>
+#include <string_view>
 #include "types.h"
 
 typedef std::pair<uint64_t, synTensorType> IdxAndType;
@@ -25,6 +26,11 @@ struct RecipeTensorsInfo
     std::unordered_set<uint64_t> m_constZeroSizeTensors;
     std::unordered_set<uint64_t> m_constZeroSizeSections;
 
+    // Launch tensor ID of each tensor name, built once on recipe processing, so launching by names (and retrieving
+    // the IDs by names) costs a lookup per tensor rather than a scan over all the tensors of the recipe.
+    // The names are owned by the recipe
+    std::unordered_map<std::string_view, uint64_t> m_tensorName2id;
+
     shape_plane_graph_t*                      m_shapePlanRecipe = nullptr;
     recipe_t*                                 m_recipe          = nullptr;
 
@@ -32,4 +38,6 @@ struct RecipeTensorsInfo
     uint64_t m_maxSectionId         = 0;
     uint64_t m_numSectionsToPatch   = 0;
 };
-#pragma pack(pop)
\ No newline at end of file
+#pragma pack(pop)
+
+bool isInternalTensor(const tensor_info_t& tInfo);
\ No newline at end of file
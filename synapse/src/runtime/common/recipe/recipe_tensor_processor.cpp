@@ -38,9 +38,60 @@ void RecipeTensorsProcessor::initTensorInfo(const basicRecipeInfo& rBasicRecipeI
 
     rRecipeTensorsInfo.m_recipe               = rBasicRecipeInfo.recipe;
     rRecipeTensorsInfo.m_shapePlanRecipe      = rBasicRecipeInfo.shape_plan_recipe;
+
+    setTensorNamesDb(rBasicRecipeInfo, rRecipeTensorsInfo);
     rRecipeTensorsInfo.m_isTensorName2idxInit = true;
 }
 
+/* Maps the name of each launch tensor to its tensor ID (the DSD recipe tensors are the non-internal shape-plan ones).
+ * On a duplicated name the first tensor is kept, as the tensors were searched in that order */
+void RecipeTensorsProcessor::setTensorNamesDb(const basicRecipeInfo& rBasicRecipeInfo,
+                                              RecipeTensorsInfo&     rRecipeTensorsInfo)
+{
+    const recipe_t*            pRecipe          = rBasicRecipeInfo.recipe;
+    const shape_plane_graph_t* pShapePlanRecipe = rBasicRecipeInfo.shape_plan_recipe;
+    auto&                      tensorName2id    = rRecipeTensorsInfo.m_tensorName2id;
+
+    tensorName2id.clear();
+
+    if (pShapePlanRecipe != nullptr)
+    {
+        tensorName2id.reserve(pShapePlanRecipe->sp_tensors_nr);
+        for (uint64_t i = 0; i < pShapePlanRecipe->sp_tensors_nr; i++)
+        {
+            const tensor_info_t& curr = pShapePlanRecipe->sp_tensors[i];
+            if (isInternalTensor(curr)) continue;
+
+            uint64_t    tensorIdx = curr.tensor_db_index;
+            const char* name      = curr.tensor_type == tensor_info_t::PERSISTENT_TENSOR
+                                        ? pRecipe->tensors[tensorIdx].name
+                                        : pShapePlanRecipe->shape_tensors[tensorIdx].name;
+            if (name != nullptr)
+            {
+                tensorName2id.emplace(name, GET_TENSOR_INFO(tensorIdx, curr.user_tensor_type));
+            }
+        }
+    }
+    else
+    {
+        const uint64_t numPersistTensors = pRecipe->persist_tensors_nr;
+        tensorName2id.reserve(numPersistTensors);
+        for (uint64_t i = 0; i < numPersistTensors; i++)
+        {
+            const char* name = pRecipe->tensors[i].name;
+            if (name != nullptr)
+            {
+                tensorName2id.emplace(name, GET_TENSOR_INFO(i, DATA_TENSOR));
+            }
+        }
+    }
+
+    LOG_DEBUG(SYN_RECIPE,
+              "Tensor names: recipe 0x{:x} has {} named launch tensors",
+              TO64(pRecipe),
+              tensorName2id.size());
+}
+
 void RecipeTensorsProcessor::setSectionsInfo(const basicRecipeInfo& rBasicRecipeInfo,
                                              RecipeTensorsInfo&     rRecipeTensorsInfo)
 {
@@ -22,6 +22,7 @@ private:
     static void setSectionsInfo(const basicRecipeInfo& rBasicRecipeInfo, RecipeTensorsInfo& rRecipeTensorsInfo);
     static void setSectionTypesInfo(const basicRecipeInfo& rBasicRecipeInfo, RecipeTensorsInfo& rRecipeTensorsInfo);
     static void initTensorInfo(const basicRecipeInfo& rBasicRecipeInfo, RecipeTensorsInfo& rRecipeTensorsInfo);
+    static void setTensorNamesDb(const basicRecipeInfo& rBasicRecipeInfo, RecipeTensorsInfo& rRecipeTensorsInfo);
 
     static bool processShapePlanRecipe(const basicRecipeInfo& rBasicRecipeInfo,
                                        RecipeTensorsInfo&     rRecipeTensorsInfo,
@@ -117,6 +117,12 @@ ENUM_TXT_COL(RecipeCacheFreeMemory,                       "RCRecipeCacheFreeMemo
 ENUM_TXT_COL(recipeCacheNoMemoryAfterFree,                "RCNoMemoryAfterFree"                           )
 ENUM_TXT_COL(recipeCacheUniqueReUse,                      "RCUniqueReUse"                                 )
 
+ENUM_TXT_COL(recipeDiskCacheHit,                          "RDCHit"                                        )
+ENUM_TXT_COL(recipeDiskCacheMiss,                         "RDCMiss"                                       )
+ENUM_TXT_COL(recipeDiskCacheStore,                        "RDCStore"                                      )
+ENUM_TXT_COL(recipeDiskCacheEvict,                        "RDCEvict"                                      )
+ENUM_TXT_COL(recipeDiskCacheLoad,                         "RDCLoad (ns)"                                  )
+
 ENUM_TXT_COL(initDynamicRecipe,                           "initDynamicRecipe (ns)"                        )
 ENUM_TXT_COL(DsdPatchDynamicRecipe,                       "DsdPatchDynamicRecipe (ns)"                    )
 ENUM_TXT_COL(DsdShapeTensors,                             "DsdShapeTensors"                               )
@@ -132,6 +138,9 @@ ENUM_TXT_COL(DsdSVerifyOutputs,                           "DsdSVerifyOut (verify
 ENUM_TXT_COL(DsdNoPatch,                                  "DsdNoPatch (PP size=0)"                        )
 ENUM_TXT_COL(DsdSifOnly,                                  "DsdSifTime (only sif)"                         )
 ENUM_TXT_COL(DsdSmfOnly,                                  "DsdSmfTime (only smf)"                         )
+ENUM_TXT_COL(DsdSifCacheHit,                              "DsdSifCacheHit"                                )
+ENUM_TXT_COL(DsdSifCacheMiss,                             "DsdSifCacheMiss"                               )
+ENUM_TXT_COL(DsdSifCacheSaved,                            "DsdSifCacheSaved (ns)"                         )
 
 ENUM_TXT_COL(scalMemcpy2Mapped,                           "scalMemcpy2Mapped (ns)"                        )
 ENUM_TXT_COL(ih2dBufferMemAlloc,                          "ih2dBufferMemAlloc (ns)"                       )
@@ -144,6 +153,8 @@ ENUM_TXT_COL(scalSubmitCompute,                           "scalSubmitCompute (ns
 ENUM_TXT_COL(scalGetMapped,                               "scalGetMapped (ns)"                            )
 ENUM_TXT_COL(scalGetHbms,                                 "scalGetHbms (ns)"                              )
 ENUM_TXT_COL(scalChkCompletion,                           "scalChkCompletion"                             )
+ENUM_TXT_COL(launchReplayHit,                             "launchReplayHit"                               )
+ENUM_TXT_COL(launchReplayMiss,                            "launchReplayMiss"                              )
 ENUM_TXT_COL(mappedOutBits,                               "mappedOutBits NP/P (1/2)"                      )
 ENUM_TXT_COL(mmmCouldNotRelease,                          "mmmCouldNotRelease"                            )
 ENUM_TXT_COL(mmmReleasedEntry,                            "mmmReleasedEntry"                              )
@@ -74,6 +74,37 @@ std::string ComputeJob::getJobParams() const
     return buff;
 }
 
+ComputeBatchJob::ComputeBatchJob(const synLaunchBatchInfo* launchBatchInfo,
+                                 uint32_t                  numberOfLaunches,
+                                 uint64_t                  assertAsyncMappedAddress,
+                                 uint8_t                   apiId,
+                                 uint32_t&                 rNumOfLaunched)
+: StreamJob(JobType::COMPUTE),
+  m_launchBatchInfo(launchBatchInfo),
+  m_numberOfLaunches(numberOfLaunches),
+  m_assertAsyncMappedAddress(assertAsyncMappedAddress),
+  m_apiId(apiId),
+  m_rNumOfLaunched(rNumOfLaunched)
+{
+}
+
+synStatus ComputeBatchJob::run(QueueInterface* pStreamInterface)
+{
+    HB_ASSERT_PTR(pStreamInterface);
+    return pStreamInterface->launchBatch(m_launchBatchInfo,
+                                         m_numberOfLaunches,
+                                         m_assertAsyncMappedAddress,
+                                         m_apiId,
+                                         m_rNumOfLaunched);
+}
+
+std::string ComputeBatchJob::getJobParams() const
+{
+    char buff[100];
+    snprintf(buff, sizeof(buff), "launchBatchInfo=%p, m_numberOfLaunches=%d", m_launchBatchInfo, m_numberOfLaunches);
+    return buff;
+}
+
 MemcopyJob::MemcopyJob(internalMemcopyParams& memcpyParams,
                        const internalDmaDir   direction,
                        bool                   isUserRequest,
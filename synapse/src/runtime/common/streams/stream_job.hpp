@@ -63,6 +63,28 @@ protected:
     const uint8_t                 m_apiId;
 };
 
+// Launches the batch entries (see synLaunchBatch) by a single job, so the stream is locked once for all of them
+class ComputeBatchJob : public StreamJob
+{
+public:
+    ComputeBatchJob(const synLaunchBatchInfo* launchBatchInfo,
+                    uint32_t                  numberOfLaunches,
+                    uint64_t                  assertAsyncMappedAddress,
+                    uint8_t                   apiId,
+                    uint32_t&                 rNumOfLaunched);
+
+    virtual synStatus run(QueueInterface* pStreamInterface) override;
+
+    virtual std::string getJobParams() const override;
+
+protected:
+    const synLaunchBatchInfo* m_launchBatchInfo;
+    uint32_t                  m_numberOfLaunches;
+    uint64_t                  m_assertAsyncMappedAddress;
+    const uint8_t             m_apiId;
+    uint32_t&                 m_rNumOfLaunched;
+};
+
 class MemcopyJob : public StreamJob
 {
 public:
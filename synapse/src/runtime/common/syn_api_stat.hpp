@@ -7,6 +7,7 @@ enum class StatApiPoints
 {
     synLaunchP,
     synLaunchWithExternalEventsP,
+    synLaunchBatchP,
     synStreamWaitEventP,
     synStreamQueryP,
     synEventCreateP,
@@ -146,6 +147,7 @@ enum class StatApiPoints
 inline constexpr auto enumNameSynApi = toStatArray<StatApiPoints>({
     { StatApiPoints::synLaunchP,                                        "synLaunch"                                     },
     { StatApiPoints::synLaunchWithExternalEventsP,                      "synLaunchWithExternalEvents"                   },
+    { StatApiPoints::synLaunchBatchP,                                   "synLaunchBatch"                                },
     { StatApiPoints::synStreamWaitEventP,                               "synStreamWaitEvent"                            },
     { StatApiPoints::synStreamQueryP,                                   "synStreamQuery"                                },
     { StatApiPoints::synEventCreateP,                                   "synEventCreate"                                },
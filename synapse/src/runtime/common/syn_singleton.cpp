@@ -14,6 +14,7 @@
 #include "infra/containers/slot_map.hpp"
 #include "infra/global_conf_manager.h"
 #include "runtime/common/device/device_common.hpp"
+#include "runtime/common/launch_latency_stats.hpp"
 #include "runtime/common/osal/osal.hpp"
 #include "runtime/common/queues/basic_queue_info.hpp"
 #include "runtime/common/queues/queue_interface.hpp"
@@ -597,6 +598,9 @@ synStatus synSingleton::destroy()
 {
     synStatus status = _destroy();
 
+    LaunchLatencyStats::dumpAll();
+    eager_mode::clearEagerRecipeCache();
+
     LOG_DEBUG_T(SYN_API, "dfa: setting DfaPhase::NONE");
 
     bool notifyHcl           = (m_dfaGlblStatus.dfaPhase != DfaPhase::NONE); // check if phase change
@@ -1421,6 +1425,92 @@ synStatus synSingleton::enqueueWithExternalEventsExt(const synStreamHandle
     return status;
 }
 
+synStatus synSingleton::enqueueBatch(const synStreamHandle     streamHandle,
+                                     const synLaunchBatchInfo* launchBatchInfo,
+                                     const uint32_t            numberOfLaunches,
+                                     uint32_t&                 rNumberOfLaunched)
+{
+    rNumberOfLaunched = 0;
+
+    VERIFY_IS_NULL_POINTER(SYN_API, streamHandle, "Stream handle");
+    VERIFY_IS_NULL_POINTER(SYN_API, launchBatchInfo, "Launch batch info");
+
+    uint64_t numOfTensors = 0;
+    for (uint32_t i = 0; i < numberOfLaunches; i++)
+    {
+        VERIFY_IS_NULL_POINTER(SYN_API, launchBatchInfo[i].pRecipeHandle, "Recipe handle");
+        if (launchBatchInfo[i].numberOfTensors != 0)
+        {
+            VERIFY_IS_NULL_POINTER(SYN_API, launchBatchInfo[i].launchTensorsInfoExt, "Launch tensors info");
+        }
+        numOfTensors += launchBatchInfo[i].numberOfTensors;
+    }
+
+    GET_DEV_INTERFACE();
+
+    if (deviceInterface == nullptr)
+    {
+        LOG_ERR(SYN_API, "{}: Invalid streamHandle", HLLOG_FUNC);
+        return synFail;
+    }
+
+    // As enqueue does, the launches are made with a copy of the user's tensors (the launch may set their ids)
+    std::vector<synLaunchTensorInfoExt> launchTensorsInfo;
+    launchTensorsInfo.reserve(numOfTensors);
+    std::vector<synLaunchBatchInfo> launchBatchInfoCopy(launchBatchInfo, launchBatchInfo + numberOfLaunches);
+    for (synLaunchBatchInfo& rLaunch : launchBatchInfoCopy)
+    {
+        const synLaunchTensorInfoExt* pUserTensors = rLaunch.launchTensorsInfoExt;
+        rLaunch.launchTensorsInfoExt               = launchTensorsInfo.data() + launchTensorsInfo.size();
+        launchTensorsInfo.insert(launchTensorsInfo.end(), pUserTensors, pUserTensors + rLaunch.numberOfTensors);
+    }
+
+    // The launches that precede the failing one (if any) were enqueued
+    synStatus status;
+    try
+    {
+        status = deviceInterface->launchBatch(streamHandle,
+                                              launchBatchInfoCopy.data(),
+                                              numberOfLaunches,
+                                              rNumberOfLaunched);
+    }
+    catch (const std::exception& error)
+    {
+        if (rNumberOfLaunched < numberOfLaunches)
+        {
+            const synLaunchBatchInfo& rFailedLaunch = launchBatchInfo[rNumberOfLaunched];
+            RecipeManager::notifyRecipeLaunchFailure(rFailedLaunch.pRecipeHandle,
+                                                     rFailedLaunch.launchTensorsInfoExt,
+                                                     rFailedLaunch.numberOfTensors,
+                                                     rFailedLaunch.flags);
+        }
+
+        throw;
+    }
+
+    for (uint32_t i = 0; i < rNumberOfLaunched; i++)
+    {
+        launchBatchInfo[i].pRecipeHandle->basicRecipeHandle.recipeStats.numbSuccessfulLaunch++;
+    }
+
+    if ((status != synSuccess) && (rNumberOfLaunched < numberOfLaunches))
+    {
+        const synLaunchBatchInfo& rFailedLaunch = launchBatchInfo[rNumberOfLaunched];
+        LOG_ERR(SYN_API,
+                "{}: launch {} out of {} of the batch failed with status {}",
+                HLLOG_FUNC,
+                rNumberOfLaunched,
+                numberOfLaunches,
+                status);
+        RecipeManager::notifyRecipeLaunchFailure(rFailedLaunch.pRecipeHandle,
+                                                 rFailedLaunch.launchTensorsInfoExt,
+                                                 rFailedLaunch.numberOfTensors,
+                                                 rFailedLaunch.flags);
+    }
+
+    return status;
+}
+
 synStatus synSingleton::deviceGetCount(uint32_t* pCount)
 {
     LOG_SINGLETON_API();
@@ -1637,6 +1727,9 @@ synStatus synSingleton::setCfg(const char* cfgName, const char* cfgValue)
         return synInvalidArgument;
     }
 
+    // The cached eager recipes were compiled with the previous configuration
+    eager_mode::clearEagerRecipeCache();
+
     return synSuccess;
 }
 
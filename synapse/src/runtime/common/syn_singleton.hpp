@@ -385,6 +385,11 @@ public:
                                                    uint32_t                      numberOfEvents,
                                                    uint32_t                      flags) override;
 
+    virtual synStatus enqueueBatch(const synStreamHandle     streamHandle,
+                                   const synLaunchBatchInfo* launchBatchInfo,
+                                   const uint32_t            numberOfLaunches,
+                                   uint32_t&                 rNumberOfLaunched) override;
+
     virtual synStatus enqueue(const synStreamHandle         streamHandle,
                               const synLaunchTensorInfoExt* enqueueTensorsInfo,
                               const uint32_t                enqueueTensorsAmount,
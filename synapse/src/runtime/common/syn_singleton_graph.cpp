@@ -653,6 +653,8 @@ synStatus synSingleton::compileGraph(synRecipeHandle*     pRecipeHandle,
 
     std::unique_lock<std::mutex> guard(m_graphsMutex);
     HabanaGraph*                 graph = _getGraphForCompilation(graphHandle);
+    // The compilation only accesses the graph and read-only process state (KernelDB, global configuration), so once
+    // the graph was taken, other graphs may be compiled concurrently
     if (GCFG_ENABLE_PARALLEL_COMPILATION.value())
     {
         guard.unlock();
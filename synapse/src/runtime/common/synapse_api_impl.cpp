@@ -400,6 +400,33 @@ synStatus SYN_API_CALL synLaunchWithExternalEventsExt(const synStreamHandle
     API_EXIT_STATUS_TIMED(status, synLaunchWithExternalEventsP);
 }
 
+synStatus SYN_API_CALL synLaunchBatch(const synStreamHandle     streamHandle,
+                                      const synLaunchBatchInfo* launchBatchInfo,
+                                      const uint32_t            numberOfLaunches,
+                                      uint32_t*                 pNumberOfLaunched)
+{
+    API_ENTRY_STATUS_TIMED()
+    LOG_SYN_API("streamHandle 0x{:x} launchBatchInfo 0x{:x} numberOfLaunches {}",
+                TO64(streamHandle),
+                TO64(launchBatchInfo),
+                numberOfLaunches);
+
+    STAT_GLBL_START(timeStart);
+    uint32_t numberOfLaunched = 0;
+    status = _SYN_SINGLETON_->enqueueBatch(streamHandle, launchBatchInfo, numberOfLaunches, numberOfLaunched);
+    if (pNumberOfLaunched != nullptr)
+    {
+        *pNumberOfLaunched = numberOfLaunched;
+    }
+
+    STAT_GLBL_COLLECT_TIME(timeStart, globalStatPointsEnum::LaunchUser);
+    if (status != synSuccess)
+    {
+        LOG_SYN_API("done status {} ({} out of {} launched)", status, numberOfLaunched, numberOfLaunches);
+    }
+    API_EXIT_STATUS_TIMED(status, synLaunchBatchP);
+}
+
 synStatus SYN_API_CALL synWorkspaceGetSize(uint64_t* pWorkspaceSize, const synRecipeHandle recipeHandle)
 {
     API_ENTRY_STATUS_TIMED()
@@ -9,6 +9,7 @@
 #include "hlthunk.h"
 #include "debug_define.hpp"
 #include "event_triggered_logger.hpp"
+#include "runtime/common/osal/host_numa_placement.hpp"
 
 //WCM multi CS query duration at LKD in microseconds units.
 //Driver returns earlier in case one of CSs completed. 0 duration means non-blocking query
@@ -136,6 +137,8 @@ void WorkCompletionManager::dump()
 
 void WorkCompletionManager::mainLoop()
 {
+    HostNumaPlacement::bindCurrentThread("WCM");
+
     while (true)
     {
         bool                               work;
@@ -1088,6 +1088,55 @@ synStatus DeviceScal::launch(Stream*                       pStream,
     return synSuccess;
 }
 
+/*
+ ***************************************************************************************************
+ *   @brief launchBatch() synLaunchBatch
+ *          launches all of the batch entries by a single compute job, so the stream is locked
+ *          (and its completions are checked) once per batch.
+ *          A batch with a kernels-printf recipe is launched one by one, as each of these
+ *          launches has to be followed by its printing
+ *
+ *   @param  pStream, batch entries and their amount, rNumOfLaunched (number of entries launched)
+ *   @return status
+ *
+ ***************************************************************************************************
+ */
+synStatus DeviceScal::launchBatch(Stream*                   pStream,
+                                  const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint32_t&                 rNumOfLaunched)
+{
+    for (uint32_t i = 0; i < numberOfLaunches; i++)
+    {
+        if (RecipeUtils::isKernelPrintf(*launchBatchInfo[i].pRecipeHandle))
+        {
+            return DeviceCommon::launchBatch(pStream, launchBatchInfo, numberOfLaunches, rNumOfLaunched);
+        }
+    }
+
+    rNumOfLaunched = 0;
+
+    uint64_t                   assertAsyncMappedAddress = (uint64_t)getAssertAsyncMappedAddress();
+    std::unique_ptr<StreamJob> job                      = std::make_unique<ComputeBatchJob>(launchBatchInfo,
+                                                                       numberOfLaunches,
+                                                                       assertAsyncMappedAddress,
+                                                                       generateApiId(),
+                                                                       rNumOfLaunched);
+    synStatus status = m_streamsContainer.addJob(pStream, job);
+    if (status != synSuccess)
+    {
+        LOG_ERR(SYN_DEVICE,
+                "{}: Failed to launch batch status {} ({} out of {} launched)",
+                HLLOG_FUNC,
+                status,
+                rNumOfLaunched,
+                numberOfLaunches);
+        return status;
+    }
+
+    return synSuccess;
+}
+
 /*
  ***************************************************************************************************
  *   @brief clearKernelsPrintfWs() Optionally clears (if the user has a dev-dev stream)
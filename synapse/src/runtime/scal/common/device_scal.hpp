@@ -123,6 +123,11 @@ private:
                              EventWithMappedTensorDB&      events,
                              uint32_t                      flags) override;
 
+    virtual synStatus launchBatch(Stream*                   pStream,
+                                  const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint32_t&                 rNumOfLaunched) override;
+
     const static uint64_t hbmSharedSize = 32 * 1024 * 1024;
 
     synStatus preAllocateMemoryForComputeStreams();
@@ -6,6 +6,7 @@
 
 #include "runtime/scal/common/entities/scal_completion_group.hpp"
 #include "runtime/scal/common/entities/scal_memory_pool.hpp"
+#include "runtime/common/osal/host_numa_placement.hpp"
 
 #include "log_manager.h"
 
@@ -71,6 +72,9 @@ synStatus ScalDev::acquire(int hlthunkFd, const std::string& scalCfgFile)
 
     LOG_INFO(SYN_DEVICE, "fd {} initializing", hlthunkFd);
 
+    // The host memory-pools and the streams cyclic buffers are allocated by SCAL
+    HostNumaPlacement::ScopedPreferredNode preferredNode;
+
     synStatus status = initScalDevice(hlthunkFd, scalCfgFile);
     if (status != synSuccess)
     {
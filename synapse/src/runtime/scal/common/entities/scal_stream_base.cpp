@@ -493,6 +493,35 @@ synStatus ScalStreamBase::doneChunkOfCommands(bool isUserReq, ScalLongSyncObject
     return synSuccess;
 }
 
+synStatus ScalStreamBase::submitPending()
+{
+    CommandSubmissionData commandSubmissionData {0, 0, nullptr, false};
+
+    synStatus status = getStreamCyclicBuffer()->addPendingSubmission(commandSubmissionData);
+    if ((status != synSuccess) || !commandSubmissionData.valid)
+    {
+        return status;
+    }
+
+    return submit(commandSubmissionData);
+}
+
+synStatus ScalStreamBase::submit(const CommandSubmissionData& rCommandSubmissionData)
+{
+    STAT_GLBL_START(scalSubmit);
+    // for Gaudi3 auto fetcher mode we need the unwrapped pi counter ccb m_pi
+    // Gaudi2 scal code will wrap it if needed
+    ScalRtn rc = scal_stream_submit(m_streamHndl, rCommandSubmissionData.pi, m_submitAlign);
+    STAT_GLBL_COLLECT_TIME(scalSubmit, m_submitStatPoint);
+    if (rc != SCAL_SUCCESS)
+    {
+        LOG_CRITICAL(SYN_STREAM, "stream {}: {} failed to submit rc {}", m_name, rCommandSubmissionData.desc, rc);
+        return synFailedToSubmitWorkload;
+    }
+
+    return synSuccess;
+}
+
 void ScalStreamBase::printCgTdrInfo(bool tdr) const
 {
     const CgTdrInfo* pTdrInfo = nullptr;
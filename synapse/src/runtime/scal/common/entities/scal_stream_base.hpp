@@ -97,6 +97,11 @@ protected:
     template<class TPacketBuildFunc>
     synStatus addCmd(uint32_t cmdSize, bool send, TPacketBuildFunc packetBuildFunc);
 
+    // Submits the commands that were added without send (if any)
+    synStatus submitPending();
+
+    synStatus submit(const CommandSubmissionData& rCommandSubmissionData);
+
     uint8_t* getCommandBufferHostAddress() { return static_cast<uint8_t*>(m_cmdBufferInfo.host_address); };
 
     synStatus doneChunkOfCommands(bool isUserReq, ScalLongSyncObject& rLongSo);
@@ -210,16 +215,10 @@ synStatus ScalStreamBase::addCmd(uint32_t cmdSize, bool send, TPacketBuildFunc p
     {
         if (commandSubmissionDataElement.valid)
         {
-            STAT_GLBL_START(scalSubmit);
-            // for Gaudi3 auto fetcher mode we need the unwrapped pi counter ccb m_pi
-            // Gaudi2 scal code will wrap it if needed
-            ScalRtn rc = scal_stream_submit(m_streamHndl, commandSubmissionDataElement.pi, m_submitAlign);
-            STAT_GLBL_COLLECT_TIME(scalSubmit, m_submitStatPoint);
-            if (rc != SCAL_SUCCESS)
+            status = submit(commandSubmissionDataElement);
+            if (status != synSuccess)
             {
-                LOG_CRITICAL(SYN_STREAM, "stream {}: {} failed to submit rc {}",
-                                  m_name, commandSubmissionDataElement.desc, rc);
-                return synFailedToSubmitWorkload;
+                return status;
             }
         }
     }
@@ -53,6 +53,8 @@ public:
                                                 bool     shouldUseGcNopKernel,
                                                 bool     send) override;
 
+    virtual synStatus submitPendingCommands() override { return submitPending(); };
+
     virtual synStatus addBarrierOrEmptyPdma(ScalLongSyncObject& rLongSo) override;
 
 protected:
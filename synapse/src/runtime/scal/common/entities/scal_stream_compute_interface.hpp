@@ -37,4 +37,7 @@ public:
                                                 uint32_t sizeDynamic,
                                                 bool     shouldUseGcNopKernel,
                                                 bool     send) = 0;
+
+    // Submits the commands that were added without send (if any)
+    virtual synStatus submitPendingCommands() = 0;
 };
@@ -164,6 +164,28 @@ synStatus StreamCyclicBufferBase::preSubmit(CommandSubmissionData& csDataInfo,
     return synSuccess;
 }
 
+/*
+ ***************************************************************************************************
+ *   @brief addPendingSubmission() -
+ *      Prepares the CS-Data of the commands that were added without being submitted, if any.
+ *      Commands are not pending across a cmdAlign boundary (see addCommand), so these are all
+ *      in the current chunk
+ *
+ *   @param  commandSubmissionData - set (valid) only in case there are pending commands
+ *   @return status
+ *
+ ***************************************************************************************************
+ */
+synStatus StreamCyclicBufferBase::addPendingSubmission(CommandSubmissionData& commandSubmissionData)
+{
+    if (m_offsetInBuffer == m_prevOffsetInBuffer)
+    {
+        return synSuccess;
+    }
+
+    return preSubmit(commandSubmissionData, "pending");
+}
+
 void StreamCyclicBufferBase::logAddCmd(uint32_t cmdSize, bool send)
 {
     LOG_TRACE(SYN_STREAM,
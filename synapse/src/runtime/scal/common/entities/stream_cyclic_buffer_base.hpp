@@ -8,6 +8,7 @@
 
 #include "runtime/scal/common/infra/scal_types.hpp"
 #include "log_manager.h"
+#include "runtime/common/launch_latency_stats.hpp"
 
 #include <string>
 #include <variant>
@@ -66,6 +67,9 @@ public:
 
     uint64_t getStreamCyclicBufferOccupancyWatermark() { return m_ccbOccupancyWatermark; };
 
+    // Prepares the submission of the commands that were added (without send) since the last submission, if any
+    synStatus addPendingSubmission(CommandSubmissionData& commandSubmissionData);
+
 protected:
     void init(ScalCompletionGroupBase* pScalCompletionGroup,
               uint8_t*                 cyclicBufferBaseAddress,
@@ -148,6 +152,8 @@ synStatus StreamCyclicBufferBase::addCommand(
     TPacketBuildFunc&                   packetBuildFunc,
     std::vector<CommandSubmissionData>& commandSubmissionDataList)
 {
+    LAUNCH_LATENCY_SCOPE(CYCLIC_BUFFER_ADD);
+
     if (!m_isInitialized)
     {
         LOG_ERR(SYN_STREAM, "{} uninitialized element", HLLOG_FUNC);
@@ -4,12 +4,24 @@
 #include "log_manager.h"
 #include "utils.h"
 
+#include "infra/threads/work_stealing_pool.h"
 #include "memory_management/memory_protection.hpp"
 
 #include "runtime/scal/common/infra/scal_types.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 RecipeAddrPatcher::RecipeAddrPatcher()
-: m_protectMem((GCFG_SCAL_RECIPE_LAUNCHER_DEBUG_MODE.value() & PROTECT_MAPPED_MEM) == PROTECT_MAPPED_MEM)
+: m_recipe(nullptr),
+  m_dcSize(0),
+  m_protectMem((GCFG_SCAL_RECIPE_LAUNCHER_DEBUG_MODE.value() & PROTECT_MAPPED_MEM) == PROTECT_MAPPED_MEM),
+  m_useSimd(GCFG_ENABLE_SIMD_PATCHING.value())
 {
 }
 
@@ -18,8 +30,8 @@ RecipeAddrPatcher::RecipeAddrPatcher()
  *   @brief init() - translates the recipe patch-points to a new database that is more efficient
  *                   when doing the patching. Needs to be called once
  *
- *   Note: we have one set of patch-points that includes all.
- *         And N sets of patch points, one per section type
+ *   Note: the patch-points are sorted by section, data-chunk, type and offset, and kept in
+ *         groups of the same section, data-chunk and type
  *
  *   @param  recipe, data-chunk size (that we later do the patching on)
  *   @return bool (false-fail, true-OK)
@@ -28,8 +40,6 @@ RecipeAddrPatcher::RecipeAddrPatcher()
  */
 bool RecipeAddrPatcher::init(const recipe_t& recipe, uint32_t dcSize)
 {
-    static_assert((1 << PP_TYPE_SIZE_BITS) >= patch_point_t::PP_TYPE_LAST, "not enough bits");
-
     m_recipe = &recipe;
 
     if (dcSize == 0)
@@ -38,16 +48,6 @@ bool RecipeAddrPatcher::init(const recipe_t& recipe, uint32_t dcSize)
         return false;
     }
 
-    if ((1 << OFFSET_SIZE_BITS) < dcSize)
-    {
-        LOG_ERR(SYN_RECIPE,
-                "not enough bits 2^{}={:x} to cover dc size {:x}",
-                OFFSET_SIZE_BITS,
-                1 << OFFSET_SIZE_BITS,
-                dcSize);
-        return false;
-    }
-
     // dc is only 8 bits, make sure patchable is not more than 256 dc
     if (recipe.patching_blobs_buffer_size > ((1 << 8) * dcSize))
     {
@@ -58,43 +58,315 @@ bool RecipeAddrPatcher::init(const recipe_t& recipe, uint32_t dcSize)
 
     m_dcSize = dcSize;
 
-    // build the data base for all the patch-points
-    uint64_t     numPP = recipe.patch_points_nr;
-    m_dcPp.resize(numPP);
-
+    // location of each patch point in the data-chunks
+    const uint32_t        numPP = recipe.patch_points_nr;
+    std::vector<uint64_t> ppOffset(numPP);
     for (uint32_t pp = 0; pp < numPP; pp++)
     {
-        const uint32_t ppIdx    = pp;
-        patch_point_t& recipePp = recipe.patch_points[ppIdx];
+        const patch_point_t& recipePp   = recipe.patch_points[pp];
+        uint8_t*             ppBlobAddr = (uint8_t*)(((uint32_t*)recipe.blobs[recipePp.blob_idx].data) +
+                                         recipePp.dw_offset_in_blob);
+        ppOffset[pp] = ppBlobAddr - (uint8_t*)recipe.patching_blobs_buffer;
+    }
+
+    std::vector<uint32_t> order(numPP);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        const patch_point_t& ppA = recipe.patch_points[a];
+        const patch_point_t& ppB = recipe.patch_points[b];
+        // offsets in the patching buffer are sorted by data-chunk
+        return std::make_tuple(ppA.memory_patch_point.section_idx, ppOffset[a] / dcSize, ppA.type, ppOffset[a]) <
+               std::make_tuple(ppB.memory_patch_point.section_idx, ppOffset[b] / dcSize, ppB.type, ppOffset[b]);
+    });
+
+    m_sectionsGroups.clear();
+    m_groups.clear();
+    m_ppOffsetInDc.resize(numPP);
+    m_ppEffectiveAddr.resize(numPP);
+    m_ppPosition.resize(numPP);
 
-        setDcPp(m_dcPp[pp], recipePp, recipe, dcSize);
+    for (uint32_t pos = 0; pos < numPP; pos++)
+    {
+        const uint32_t       ppIdx      = order[pos];
+        const patch_point_t& recipePp   = recipe.patch_points[ppIdx];
+        const uint16_t       sectionIdx = recipePp.memory_patch_point.section_idx;
+        const uint8_t        dcIdx      = ppOffset[ppIdx] / dcSize;
+
+        m_ppOffsetInDc[pos]    = ppOffset[ppIdx] - (uint64_t)dcIdx * dcSize;
+        m_ppEffectiveAddr[pos] = recipePp.memory_patch_point.effective_address;
+        m_ppPosition[ppIdx]    = pos;
+
+        if (m_sectionsGroups.empty() || m_sectionsGroups.back().section_idx != sectionIdx)
+        {
+            m_sectionsGroups.push_back({sectionIdx, (uint32_t)m_groups.size(), (uint32_t)m_groups.size()});
+        }
+        if (m_groups.empty() || m_sectionsGroups.back().end_group == m_sectionsGroups.back().first_group ||
+            m_groups.back().data_chunk_index != dcIdx || m_groups.back().type != recipePp.type ||
+            m_groups.back().end - m_groups.back().start == MAX_PATCH_POINTS_IN_GROUP)
+        {
+            m_groups.push_back({pos, pos, dcIdx, recipePp.type, sectionIdx});
+            m_sectionsGroups.back().end_group++;
+        }
+        m_groups.back().end++;
     }
+
+    initParallelChunks();
+
+    LOG_DEBUG(SYN_RECIPE,
+              "{}: {} patch-points, {} sections, {} groups, simd {}, patching threads {}",
+              HLLOG_FUNC,
+              numPP,
+              m_sectionsGroups.size(),
+              m_groups.size(),
+              m_useSimd,
+              getNumPatchingThreads());
     return true;
 }
 
 /*
  ***************************************************************************************************
- *   @brief setDcPp() - utility function used by init
+ *   @brief initParallelChunks() - splits the groups to consecutive chunks of about the same number
+ *                                 of patch-points, one per patching thread. Recipes below
+ *                                 GCFG_PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS are patched by the
+ *                                 calling thread only
  *
- *   @param
- *   @return None
+ *   The chunks patch distinct locations, so the result doesn't depend on the threads timing
+ *
+ ***************************************************************************************************
+ */
+void RecipeAddrPatcher::initParallelChunks()
+{
+    m_parallelChunks.clear();
+
+    const uint64_t minPatchPoints = GCFG_PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS.value();
+    const uint32_t numPP          = m_ppEffectiveAddr.size();
+    if (minPatchPoints == 0 || numPP < minPatchPoints) return;
+
+    // The calling thread patches a chunk as well
+    const uint32_t numChunks =
+        std::min<uint64_t>({GCFG_PARALLEL_LAUNCH_PREP_NUM_THREADS.value(),
+                            synapse::WorkStealingPool::instance().getNumOfThreads() + 1,
+                            m_groups.size()});
+    if (numChunks < 2) return;
+
+    m_parallelChunks.push_back(0);
+    for (uint32_t groupIdx = 0; groupIdx < m_groups.size(); groupIdx++)
+    {
+        const uint64_t chunkEndPp = (uint64_t)numPP * m_parallelChunks.size() / numChunks;
+        if (m_groups[groupIdx].start >= chunkEndPp && m_parallelChunks.size() < numChunks)
+        {
+            m_parallelChunks.push_back(groupIdx);
+        }
+    }
+    m_parallelChunks.push_back(m_groups.size());
+}
+
+/*
+ ***************************************************************************************************
+ *   @brief patchGroupScalar() / patchGroupAvx2() - patch a group of patch-points of the same
+ *                                                  section, data-chunk and type
+ *
+ *   Per patch-point, the value is section address + effective address. Low type patches the
+ *   low dword, high type (and SOB) the high dword and DDW both
+ *
+ ***************************************************************************************************
+ */
+static inline void patchGroupScalar(uint8_t*        dcHostAddr,
+                                    uint8_t         type,
+                                    const uint32_t* offsets,
+                                    const uint64_t* effectiveAddr,
+                                    uint32_t        numPp,
+                                    uint64_t        sectionAddress)
+{
+    if (type == patch_point_t::SIMPLE_DDW_MEM_PATCH_POINT)
+    {
+        for (uint32_t i = 0; i < numPp; i++)
+        {
+            const uint64_t value = sectionAddress + effectiveAddr[i];
+            memcpy(dcHostAddr + offsets[i], &value, sizeof(value));
+        }
+    }
+    else
+    {
+        const uint32_t shift = (type & 1) * 32;
+        for (uint32_t i = 0; i < numPp; i++)
+        {
+            const uint32_t value = (sectionAddress + effectiveAddr[i]) >> shift;
+            memcpy(dcHostAddr + offsets[i], &value, sizeof(value));
+        }
+    }
+}
+
+#ifdef __AVX2__
+static inline void patchGroupAvx2(uint8_t*        dcHostAddr,
+                                  uint8_t         type,
+                                  const uint32_t* offsets,
+                                  const uint64_t* effectiveAddr,
+                                  uint32_t        numPp,
+                                  uint64_t        sectionAddress)
+{
+    const __m256i sectionAddressVec = _mm256_set1_epi64x(sectionAddress);
+    uint32_t      i                 = 0;
+
+    if (type == patch_point_t::SIMPLE_DDW_MEM_PATCH_POINT)
+    {
+        alignas(32) uint64_t values[4];
+        for (; i + 4 <= numPp; i += 4)
+        {
+            __m256i value = _mm256_loadu_si256((const __m256i*)(effectiveAddr + i));
+            _mm256_store_si256((__m256i*)values, _mm256_add_epi64(value, sectionAddressVec));
+            memcpy(dcHostAddr + offsets[i], &values[0], sizeof(uint64_t));
+            memcpy(dcHostAddr + offsets[i + 1], &values[1], sizeof(uint64_t));
+            memcpy(dcHostAddr + offsets[i + 2], &values[2], sizeof(uint64_t));
+            memcpy(dcHostAddr + offsets[i + 3], &values[3], sizeof(uint64_t));
+        }
+    }
+    else
+    {
+        // move the low (or high) dword of the 4 values to the low 128 bits
+        const __m256i dwSelect = (type & 1) ? _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7)
+                                            : _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+        alignas(16) uint32_t values[4];
+        for (; i + 4 <= numPp; i += 4)
+        {
+            __m256i value = _mm256_loadu_si256((const __m256i*)(effectiveAddr + i));
+            value         = _mm256_permutevar8x32_epi32(_mm256_add_epi64(value, sectionAddressVec), dwSelect);
+            _mm_store_si128((__m128i*)values, _mm256_castsi256_si128(value));
+            memcpy(dcHostAddr + offsets[i], &values[0], sizeof(uint32_t));
+            memcpy(dcHostAddr + offsets[i + 1], &values[1], sizeof(uint32_t));
+            memcpy(dcHostAddr + offsets[i + 2], &values[2], sizeof(uint32_t));
+            memcpy(dcHostAddr + offsets[i + 3], &values[3], sizeof(uint32_t));
+        }
+    }
+
+    patchGroupScalar(dcHostAddr, type, offsets + i, effectiveAddr + i, numPp - i, sectionAddress);
+}
+#endif
+
+/*
+ ***************************************************************************************************
+ *   @brief patchGroups() - patches the patch-points of a range of groups
+ *
+ *   @param  firstGroup, endGroup - the groups range
+ *   @param  sectionAddrDb        - array of the section addresses
+ *   @param  sectionsChangedDb    - if not null, only the groups of sections flagged here are patched
+ *   @param  dcAddr               - vector of data chunks addresses
+ *   @param  shouldLog            - log each patch-point
+ *   @return number of patched patch-points
+ *
+ ***************************************************************************************************
+ */
+uint32_t RecipeAddrPatcher::patchGroups(uint32_t             firstGroup,
+                                        uint32_t             endGroup,
+                                        const uint64_t*      sectionAddrDb,
+                                        const uint8_t*       sectionsChangedDb,
+                                        MemoryMappedAddrVec& dcAddr,
+                                        bool                 shouldLog) const
+{
+    uint32_t numPatched = 0;
+    for (uint32_t groupIdx = firstGroup; groupIdx < endGroup; groupIdx++)
+    {
+        const PatchPointsGroup& group = m_groups[groupIdx];
+        if (sectionsChangedDb != nullptr && sectionsChangedDb[group.section_idx] == 0) continue;
+
+        const uint64_t sectionAddress = sectionAddrDb[group.section_idx];
+        uint8_t*       dcHostAddr     = dcAddr[group.data_chunk_index].hostAddr;
+        const uint32_t numPp          = group.end - group.start;
+
+#ifdef __AVX2__
+        if (m_useSimd)
+        {
+            patchGroupAvx2(dcHostAddr,
+                           group.type,
+                           &m_ppOffsetInDc[group.start],
+                           &m_ppEffectiveAddr[group.start],
+                           numPp,
+                           sectionAddress);
+        }
+        else
+#endif
+        {
+            patchGroupScalar(dcHostAddr,
+                             group.type,
+                             &m_ppOffsetInDc[group.start],
+                             &m_ppEffectiveAddr[group.start],
+                             numPp,
+                             sectionAddress);
+        }
+
+        if (unlikely(shouldLog))
+        {
+            logGroup(group, group.section_idx, sectionAddress, dcHostAddr);
+        }
+        numPatched += numPp;
+    }
+    return numPatched;
+}
+
+/*
+ ***************************************************************************************************
+ *   @brief patch() - patches all the groups (of the changed sections, if sectionsChangedDb is given)
+ *
+ *   Large recipes are split between the calling thread and threads of the shared pool (see
+ *   initParallelChunks). Trace logging keeps the patching on the calling thread, so the log is
+ *   ordered
  *
  ***************************************************************************************************
  */
-void RecipeAddrPatcher::setDcPp(DataChunkPatchPoint& dcPp,
-                                const patch_point_t& recipePp,
-                                const recipe_t&      recipe,
-                                uint32_t             dcSize)
+uint32_t RecipeAddrPatcher::patch(const uint64_t*      sectionAddrDb,
+                                  const uint8_t*       sectionsChangedDb,
+                                  MemoryMappedAddrVec& dcAddr) const
+{
+    bool shouldLog = LOG_LEVEL_AT_LEAST_TRACE(SYN_PATCHING);
+
+    if (m_parallelChunks.empty() || shouldLog)
+    {
+        return patchGroups(0, m_groups.size(), sectionAddrDb, sectionsChangedDb, dcAddr, shouldLog);
+    }
+
+    const uint32_t        numChunks = m_parallelChunks.size() - 1;
+    std::vector<uint32_t> numPatched(numChunks, 0);
+    {
+        synapse::TaskGroup tasks;
+        for (uint32_t chunk = 1; chunk < numChunks; chunk++)
+        {
+            tasks.run([&, chunk]() {
+                numPatched[chunk] = patchGroups(m_parallelChunks[chunk],
+                                                m_parallelChunks[chunk + 1],
+                                                sectionAddrDb,
+                                                sectionsChangedDb,
+                                                dcAddr,
+                                                false);
+            });
+        }
+        numPatched[0] =
+            patchGroups(m_parallelChunks[0], m_parallelChunks[1], sectionAddrDb, sectionsChangedDb, dcAddr, false);
+        tasks.wait();
+    }
+    return std::accumulate(numPatched.begin(), numPatched.end(), 0U);
+}
+
+void RecipeAddrPatcher::logGroup(const PatchPointsGroup& group,
+                                 uint16_t                sectionIdx,
+                                 uint64_t                sectionAddress,
+                                 const uint8_t*          dcHostAddr) const
 {
-    uint32_t recipeBlobIdx = recipePp.blob_idx;
-    uint8_t* ppBlobAddr    = (uint8_t*)(((uint32_t*)recipe.blobs[recipeBlobIdx].data) + recipePp.dw_offset_in_blob);
-    uint64_t offset        = ppBlobAddr - (uint8_t*)recipe.patching_blobs_buffer;
-
-    dcPp.type                                 = recipePp.type;
-    dcPp.memory_patch_point.section_idx       = recipePp.memory_patch_point.section_idx;
-    dcPp.memory_patch_point.effective_address = recipePp.memory_patch_point.effective_address;
-    dcPp.data_chunk_index                     = offset / dcSize;
-    dcPp.offset_in_data_chunk                 = offset - (dcPp.data_chunk_index * dcSize);
+    for (uint32_t pos = group.start; pos < group.end; pos++)
+    {
+        LOG_TRACE(SYN_PATCHING,
+                  "{}: Patching (DC {} PP-Index in Stage {:x}) DC-Address 0x{:x} Offset-in-DC 0x{:x},"
+                  " section {}, effective-address 0x{:x} patched-location 0x{:x} patch-type {} value 0x{:x}",
+                  HLLOG_FUNC,
+                  group.data_chunk_index,
+                  pos,
+                  (uint64_t)dcHostAddr,
+                  m_ppOffsetInDc[pos],
+                  sectionIdx,
+                  m_ppEffectiveAddr[pos],
+                  (uint64_t)dcHostAddr + m_ppOffsetInDc[pos],
+                  group.type,
+                  sectionAddress + m_ppEffectiveAddr[pos]);
+    }
 }
 
 /*
@@ -110,57 +382,57 @@ void RecipeAddrPatcher::setDcPp(DataChunkPatchPoint& dcPp,
  */
 void RecipeAddrPatcher::patchAll(const uint64_t* sectionAddrDb, MemoryMappedAddrVec& dcAddr) const
 {
-    bool shouldLog = LOG_LEVEL_AT_LEAST_TRACE(SYN_PATCHING);
-
     if (m_protectMem)
     {
         unprotectDcs(dcAddr);
     }
 
-    // Go over the patch points and do the patching
-    for (uint32_t ppIdx = 0; ppIdx < m_dcPp.size(); ppIdx++)
+    patch(sectionAddrDb, nullptr, dcAddr);
+    LOG_TRACE(SYN_PATCHING,
+              "{}: Patching execution successfully completed {} patch-points",
+              HLLOG_FUNC,
+              m_ppEffectiveAddr.size());
+
+    if (m_protectMem)
     {
-        auto&          pp                          = m_dcPp[ppIdx];
-        const auto     dataChunkIdx                = pp.data_chunk_index;
-        const uint64_t currentDataChunkHostAddress = (uint64_t)dcAddr[dataChunkIdx].hostAddr;
-        uint64_t       offsetInDataChunk           = pp.offset_in_data_chunk;
-
-        // calculate patch point value
-        uint64_t sectionAddress    = sectionAddrDb[pp.memory_patch_point.section_idx];
-        ptrToInt patchedPointValue = {.u64 = sectionAddress + pp.memory_patch_point.effective_address};
-
-        // actual patching
-        uint32_t* pPatchedLocation = (uint32_t*)(currentDataChunkHostAddress + offsetInDataChunk);
-        *pPatchedLocation          = patchedPointValue.u32[(pp.type & 1)];
-        if (pp.type == patch_point_t::SIMPLE_DDW_MEM_PATCH_POINT)
-        {
-            *(pPatchedLocation + 1) = patchedPointValue.u32[1];
-        }
+        protectDcs(dcAddr);
+    }
+}
 
-        if (unlikely(shouldLog))
-        {
-            LOG_TRACE(SYN_PATCHING,
-                      "{}: Patching (DC {} PP-Index in Stage {:x}) DC-Address 0x{:x} Offset-in-DC 0x{:x},"
-                      " section {}, effective-address 0x{:x} patched-location 0x{:x} patch-type {} value 0x{:x}",
-                      HLLOG_FUNC,
-                      dataChunkIdx,
-                      ppIdx,
-                      currentDataChunkHostAddress,
-                      offsetInDataChunk,
-                      pp.memory_patch_point.section_idx,
-                      //                pp.node_exe_index,
-                      pp.memory_patch_point.effective_address,
-                      (uint64_t)currentDataChunkHostAddress + offsetInDataChunk,
-                      pp.type,
-                      patchedPointValue.u64);
-        }
+/*
+ ***************************************************************************************************
+ *   @brief patchChangedSections() - Same as patchAll(), but only for the sections whose address
+ *                                   had changed. Used when the data-chunks are reused, and hold
+ *                                   the patching of the previous launch of the recipe
+ *
+ *   @param  sectionAddrDb     - array of the section addresses
+ *   @param  sectionsChangedDb - array of the sections changed indications (non-zero if changed)
+ *   @param  dcAddr            - vector of data chunks addresses
+ *   @return number of patched patch-points
+ *
+ ***************************************************************************************************
+ */
+uint32_t RecipeAddrPatcher::patchChangedSections(const uint64_t*      sectionAddrDb,
+                                                 const uint8_t*       sectionsChangedDb,
+                                                 MemoryMappedAddrVec& dcAddr) const
+{
+    if (m_protectMem)
+    {
+        unprotectDcs(dcAddr);
     }
-    LOG_TRACE(SYN_PATCHING, "{}: Patching execution successfully completed {} patch-points", HLLOG_FUNC, m_dcPp.size());
+
+    uint32_t numPatched = patch(sectionAddrDb, sectionsChangedDb, dcAddr);
+    LOG_TRACE(SYN_PATCHING,
+              "{}: Patching execution successfully completed {} of {} patch-points",
+              HLLOG_FUNC,
+              numPatched,
+              m_ppEffectiveAddr.size());
 
     if (m_protectMem)
     {
         protectDcs(dcAddr);
     }
+    return numPatched;
 }
 
 /*
@@ -269,10 +541,13 @@ bool RecipeAddrPatcher::verifySectionsAddrFromDc(const MemoryMappedAddrVec dcVec
 
 void RecipeAddrPatcher::copyPatchPointDb(const RecipeAddrPatcher& recipeAddrPatcherToCopy)
 {
-    HB_ASSERT(m_dcPp.size() == recipeAddrPatcherToCopy.m_dcPp.size(),
+    HB_ASSERT(m_ppEffectiveAddr.size() == recipeAddrPatcherToCopy.m_ppEffectiveAddr.size(),
         "copyPatchPointDb called with different vector sizes");
 
-    memcpy(m_dcPp.data(), recipeAddrPatcherToCopy.m_dcPp.data(), m_dcPp.size() * sizeof(m_dcPp[0]));
+    // Only the effective addresses are modified (by DSD), the rest of the DB is the same
+    memcpy(m_ppEffectiveAddr.data(),
+           recipeAddrPatcherToCopy.m_ppEffectiveAddr.data(),
+           m_ppEffectiveAddr.size() * sizeof(m_ppEffectiveAddr[0]));
 }
 
 /*
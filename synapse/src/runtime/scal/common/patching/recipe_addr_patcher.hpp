@@ -5,31 +5,34 @@
 #include "runtime/scal/common/recipe_launcher/mem_mgrs_types.hpp"
 #include "types.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <unordered_map>
+#include <vector>
 
 /**************************************************************************************/
-/* The structure DataChunkPatchPoint holds information based on the patch points from */
-/* the recipe. The patch point location is hold in terms of data-chunk/offset         */
-/* instead of blobIdx/offset that is given by the recipe                              */
+/* The patch points are kept grouped by section, and within a section by data-chunk   */
+/* and patch-point type, in struct-of-arrays form (offset in data-chunk, effective    */
+/* address). This way the patching loops are branch free (and vectorized), and the    */
+/* patch points of a section can be patched on their own (see patchChangedSections)   */
+/* Groups are also the work units of parallel patching, so their size is bounded      */
 /**************************************************************************************/
-static const uint32_t PP_TYPE_SIZE_BITS = 2;
-static const uint32_t OFFSET_SIZE_BITS  = (32 - PP_TYPE_SIZE_BITS);
-
-struct DataChunkPatchPoint
+// A run of patch points of the same section, data-chunk and type
+struct PatchPointsGroup
 {
-    // offset (in Bytes) to the patch-point location inside the data-chunk
-    uint32_t offset_in_data_chunk : OFFSET_SIZE_BITS;
-    uint32_t type : PP_TYPE_SIZE_BITS;
-
-    uint8_t data_chunk_index;
+    uint32_t start;  // index of the first patch point of the group (in the patch-points arrays)
+    uint32_t end;
+    uint8_t  data_chunk_index;
+    uint8_t  type;
+    uint16_t section_idx;
+};
 
-    struct
-    {
-        uint16_t section_idx;
-        uint64_t effective_address;
-    } memory_patch_point;
+struct SectionPatchPointsGroups
+{
+    uint16_t section_idx;
+    uint32_t first_group;  // index of the first group of the section (in the groups array)
+    uint32_t end_group;
 };
 
 struct UnpatchSingleRes
@@ -53,6 +56,12 @@ public:
 
     void patchAll(const uint64_t* sectionAddrDb, MemoryMappedAddrVec& dcAddr) const;
 
+    // Patches only the sections flagged in sectionsChangedDb, the data-chunks must already hold the recipe patched with
+    // the current address of all the other sections. Returns the number of patch points that were patched
+    uint32_t patchChangedSections(const uint64_t*      sectionAddrDb,
+                                  const uint8_t*       sectionsChangedDb,
+                                  MemoryMappedAddrVec& dcAddr) const;
+
     bool verifySectionsAddrFromDc(const MemoryMappedAddrVec dcVec,
                                   uint32_t                  dcSize,
                                   const uint64_t*           expectedAddr,
@@ -60,13 +69,32 @@ public:
 
     uint64_t* getPatchPointEffectiveAddr(uint32_t patchPointIndex)
     {
-        return &m_dcPp[patchPointIndex].memory_patch_point.effective_address;
+        return &m_ppEffectiveAddr[m_ppPosition[patchPointIndex]];
     }
 
+    uint32_t getNumPatchPoints() const { return m_ppEffectiveAddr.size(); }
+    uint32_t getNumSections() const { return m_sectionsGroups.size(); }
+
+    // Number of threads patching the recipe (1 unless the recipe is large enough for parallel patching)
+    uint32_t getNumPatchingThreads() const { return std::max<uint32_t>(m_parallelChunks.size(), 2) - 1; }
+
     void copyPatchPointDb(const RecipeAddrPatcher& recipeAddrPatcherToCopy);
 
 private:
-    static void setDcPp(DataChunkPatchPoint& dcPp, const patch_point_t& recipePp, const recipe_t& recipe, uint32_t dcSize);
+    static constexpr uint32_t MAX_PATCH_POINTS_IN_GROUP = 4096;
+
+    void        initParallelChunks();
+    uint32_t    patch(const uint64_t* sectionAddrDb, const uint8_t* sectionsChangedDb, MemoryMappedAddrVec& dcAddr) const;
+    uint32_t    patchGroups(uint32_t             firstGroup,
+                            uint32_t             endGroup,
+                            const uint64_t*      sectionAddrDb,
+                            const uint8_t*       sectionsChangedDb,
+                            MemoryMappedAddrVec& dcAddr,
+                            bool                 shouldLog) const;
+    void        logGroup(const PatchPointsGroup& group,
+                         uint16_t                sectionIdx,
+                         uint64_t                sectionAddress,
+                         const uint8_t*          dcHostAddr) const;
     uint8_t*    getPpAddr(std::vector<patch_point_t>& sortedPp, uint32_t ppIdx) const;
     bool        getSectionsAddrFromDc(const MemoryMappedAddrVec&     dcVec,
                                    uint32_t                       dcSize,
@@ -74,10 +102,14 @@ private:
     void        unprotectDcs(MemoryMappedAddrVec& dcAddr) const;
     void        protectDcs(MemoryMappedAddrVec& dcAddr) const;
 
-    using DcPpDb = SmallVector<DataChunkPatchPoint, 8>;
-
-    DcPpDb          m_dcPp;
-    const recipe_t* m_recipe;
-    uint64_t        m_dcSize;
-    bool            m_protectMem;
+    std::vector<SectionPatchPointsGroups> m_sectionsGroups;
+    std::vector<PatchPointsGroup>         m_groups;
+    std::vector<uint32_t>                 m_ppOffsetInDc;     // per patch point, by group order
+    std::vector<uint64_t>                 m_ppEffectiveAddr;  // per patch point, by group order
+    std::vector<uint32_t>                 m_ppPosition;       // recipe patch point index -> group order index
+    std::vector<uint32_t>                 m_parallelChunks;   // first group per patching thread, plus the groups end
+    const recipe_t*                       m_recipe;
+    uint64_t                              m_dcSize;
+    bool                                  m_protectMem;
+    bool                                  m_useSimd;
 };
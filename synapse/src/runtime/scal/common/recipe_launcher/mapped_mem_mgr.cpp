@@ -4,10 +4,13 @@
 #include "habana_global_conf_runtime.h"
 
 #include "log_manager.h"
+#include "runtime/common/launch_latency_stats.hpp"
 #include "runtime/scal/common/recipe_static_info_scal.hpp"
 
 #include <utils.inl>
 
+#include <algorithm>
+
 /*
  ***************************************************************************************************
  *   @brief MappedMemMgr() - constructor
@@ -137,10 +140,61 @@ uint64_t MappedMemMgr::getNumDc()
     return GCFG_STREAM_COMPUTE_ARC_DATACHUNK_CACHE_AMOUNT_LOWER_CP.value();
 }
 
+/*
+ ***************************************************************************************************
+ *   @brief findRecipe() - looks up a recipe entry in its shard
+ *
+ *   @param  recipeId - the recipe to look for
+ *   @return the entry, nullptr if not found
+ *
+ ***************************************************************************************************
+ */
+MappedMemMgr::MappedRecipeInfoPtr MappedMemMgr::findRecipe(uint64_t recipeId)
+{
+    RecipeDbShard&                      shard = getShard(recipeId);
+    std::shared_lock<std::shared_mutex> shardLock(shard.mutex);
+
+    auto it = shard.recipes.find(recipeId);
+    return (it == shard.recipes.end()) ? nullptr : it->second;
+}
+
+size_t MappedMemMgr::getNumRecipes() const
+{
+    size_t numRecipes = 0;
+    for (const RecipeDbShard& shard : m_recipeDb)
+    {
+        std::shared_lock<std::shared_mutex> shardLock(shard.mutex);
+        numRecipes += shard.recipes.size();
+    }
+    return numRecipes;
+}
+
+/*
+ ***************************************************************************************************
+ *   @brief releaseSegments() - returns segments to the segment allocator
+ *
+ *   @param  segments - the segments to release
+ *   @return None
+ *
+ ***************************************************************************************************
+ */
+void MappedMemMgr::releaseSegments(const std::vector<uint16_t>& segments)
+{
+    if (segments.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_segmentAllocMutex);
+    m_segmentAlloc.releaseSegments(segments);
+}
+
 /*
  ***************************************************************************************************
  *   @brief freeEntryMemory() - frees the memory for a given entry. It will free the chunk for the
- *                              non-patchable sections and all the chunks for the patchable sections
+ *                              non-patchable sections and all the chunks for the patchable sections.
+ *                              The entry is marked as removed and threads waiting on it are woken up.
+ *                              The caller holds the entry lock and removes the entry from its shard.
  *
  *   @param  info - the info on this entry
  *   @return None
@@ -157,12 +211,17 @@ void MappedMemMgr::freeEntryMemory(MappedRecipeInfo& info)
     {
         LOG_TRACE(SYN_PROG_DWNLD, "Going to release non-patchable {:x}", TO64(info.nonPatchableAddr[i]));
     }
-    m_segmentAlloc.releaseSegments(info.nonPatchableAddr);
+    releaseSegments(info.nonPatchableAddr);
+    info.nonPatchableAddr.clear();
+
+    info.removed = true;
+    info.nonPatchableReadyCv.notify_all();
 }
 
 /*
  ***************************************************************************************************
  *   @brief freeSingleFreePatchableEntry() - frees a single patchable free-memory chunk for a givne entry.
+ *                                           The caller holds the entry lock.
  *
  *   @param  pSelectedMmi - A pointer to the info of that entry
  *   @return None
@@ -183,7 +242,7 @@ void MappedMemMgr::freeSingleFreePatchableEntry(MappedRecipeInfo& selectedMmi)
     {
         LOG_TRACE(SYN_PROG_DWNLD, "Going to release patchable segment {:x}", TO64(segments[i]));
     }
-    m_segmentAlloc.releaseSegments(segments);
+    releaseSegments(segments);
     selectedMmi.patchableFree.pop_front();
 }
 
@@ -200,50 +259,62 @@ void MappedMemMgr::freeSingleFreePatchableEntry(MappedRecipeInfo& selectedMmi)
  */
 void MappedMemMgr::removeId(RecipeSeqId id)
 {
-    auto it = m_recipeDb.find(id.val);
-    if (it == m_recipeDb.end())
+    RecipeDbShard&                      shard = getShard(id.val);
+    std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+
+    auto it = shard.recipes.find(id.val);
+    if (it == shard.recipes.end())
     {
         // This can happen if recipe was evicted from the mmm (because we needed its space for a different recipe_
         LOG_DEBUG_T(SYN_PROG_DWNLD, "removeId not found {:x}", id.val);
         return;
     }
 
-    MappedRecipeInfo& info = it->second;
+    MappedRecipeInfoPtr         pInfo = it->second;  // keeps the entry (and its lock) alive after the erase
+    std::lock_guard<std::mutex> lock(pInfo->mutex);
 
-    if (!info.patchableUsed.empty())
+    if (!pInfo->patchableUsed.empty())
     {
-        LOG_ERR_T(SYN_PROG_DWNLD, "removeId is still used {:x}, has {:x} used", id.val, info.patchableUsed.size());
+        LOG_ERR_T(SYN_PROG_DWNLD, "removeId is still used {:x}, has {:x} used", id.val, pInfo->patchableUsed.size());
         return;
     }
 
-    freeEntryMemory(info);
+    freeEntryMemory(*pInfo);
 
-    m_recipeDb.erase(it);
+    shard.recipes.erase(it);
 }
 
 void MappedMemMgr::removeAllId()
 {
-    for (auto& recipeDb : m_recipeDb)
+    for (RecipeDbShard& shard : m_recipeDb)
     {
-        RecipeSeqId       id(recipeDb.first);
-        MappedRecipeInfo& info = recipeDb.second;
+        std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
 
-        if (!info.patchableUsed.empty())
+        for (auto it = shard.recipes.begin(); it != shard.recipes.end();)
         {
-            LOG_ERR_T(SYN_PROG_DWNLD, "removeId is still used {:x}, has {:x} used", id.val, info.patchableUsed.size());
-            return;
-        }
+            RecipeSeqId                 id(it->first);
+            MappedRecipeInfoPtr         pInfo = it->second;
+            std::lock_guard<std::mutex> lock(pInfo->mutex);
 
-        freeEntryMemory(info);
-    }
+            if (!pInfo->patchableUsed.empty())
+            {
+                LOG_ERR_T(SYN_PROG_DWNLD,
+                          "removeId is still used {:x}, has {:x} used",
+                          id.val,
+                          pInfo->patchableUsed.size());
+                return;
+            }
 
-    m_recipeDb.clear();
+            freeEntryMemory(*pInfo);
+            it = shard.recipes.erase(it);
+        }
+    }
 }
 
 /*
  ***************************************************************************************************
  *   @brief fillSectionsInfo() - This function is called to update the sections' information with the
- *                               addresses/status
+ *                               addresses/status. The caller holds the entry lock.
  *
  *   @param  runningId - free running counter, for sanity checks, debug
  *   @param  Info      - the information in the DB for this recipe
@@ -327,6 +398,7 @@ void MappedMemMgr::getAddrForId(const RecipeStaticInfoScal& rRecipeStaticInfoSca
                                 EntryIds                    entryIds,
                                 MemorySectionsScal&         rSections)
 {
+    LAUNCH_LATENCY_SCOPE(MAPPED_MEM);
     LOG_TRACE(SYN_PROG_DWNLD, "seqId {:x} runningId {:x}", entryIds.recipeId.val, entryIds.runningId);
     while (true)
     {
@@ -357,9 +429,11 @@ void MappedMemMgr::getAddrForId(const RecipeStaticInfoScal& rRecipeStaticInfoSca
     m_stat.collect(StatPoints::requests, 1);
 }
 
+
 /*
  ***************************************************************************************************
  *   @brief releaseEntry() - This function releases an unused entry. For now, it just releases the first one it finds.
+ *                           Entries locked by another thread are skipped, they are being used.
  *                           TODO: release the oldest one?
  *
  *   @param  None
@@ -369,36 +443,53 @@ void MappedMemMgr::getAddrForId(const RecipeStaticInfoScal& rRecipeStaticInfoSca
  */
 bool MappedMemMgr::releaseEntry()
 {
-    MappedRecipeInfo* pSelectedMmi                    = nullptr;
-    unsigned          selectedMmiFreePatchableEntries = 0;
+    MappedRecipeInfoPtr pSelectedMmi                    = nullptr;
+    unsigned            selectedMmiFreePatchableEntries = 0;
 
     // For now, just release the first one. TODO: release the oldest one? Release if more than X copies of patchable?
-    for (auto it = m_recipeDb.begin(); it != m_recipeDb.end(); it++)
+    for (RecipeDbShard& shard : m_recipeDb)
     {
-        MappedRecipeInfo& info = it->second;
-        if (info.patchableUsed.empty())  // not in use
+        std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+
+        for (auto it = shard.recipes.begin(); it != shard.recipes.end(); it++)
         {
-            LOG_TRACE(SYN_PROG_DWNLD, "For recipe {:x}, no patchable used, releasing", it->first);
-            freeEntryMemory(info);
-            m_recipeDb.erase(it);
+            MappedRecipeInfoPtr          pInfo = it->second;
+            std::unique_lock<std::mutex> lock(pInfo->mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                continue;
+            }
 
-            STAT_GLBL_COLLECT(1, mmmReleasedEntry);
-            return true;  // released
-        }
+            if (pInfo->patchableUsed.empty())  // not in use
+            {
+                LOG_TRACE(SYN_PROG_DWNLD, "For recipe {:x}, no patchable used, releasing", it->first);
+                freeEntryMemory(*pInfo);
+                shard.recipes.erase(it);
 
-        unsigned freePatchableEntries = info.patchableFree.size();
-        if (freePatchableEntries > selectedMmiFreePatchableEntries)
-        {
-            selectedMmiFreePatchableEntries = freePatchableEntries;
-            pSelectedMmi                    = &info;
+                STAT_GLBL_COLLECT(1, mmmReleasedEntry);
+                return true;  // released
+            }
+
+            unsigned freePatchableEntries = pInfo->patchableFree.size();
+            if (freePatchableEntries > selectedMmiFreePatchableEntries)
+            {
+                selectedMmiFreePatchableEntries = freePatchableEntries;
+                pSelectedMmi                    = pInfo;
+            }
         }
     }
 
     if (pSelectedMmi != nullptr)
     {
-        freeSingleFreePatchableEntry(*pSelectedMmi);
-        STAT_GLBL_COLLECT(1, mmmReleasedSegment);
-        return true;
+        std::lock_guard<std::mutex> lock(pSelectedMmi->mutex);
+
+        // Another thread may have re-used its free entries since the scan
+        if (!pSelectedMmi->patchableFree.empty())
+        {
+            freeSingleFreePatchableEntry(*pSelectedMmi);
+            STAT_GLBL_COLLECT(1, mmmReleasedSegment);
+            return true;
+        }
     }
 
     STAT_GLBL_COLLECT(1, mmmCouldNotRelease);
@@ -444,7 +535,10 @@ bool MappedMemMgr::getDcIfNeeded(std::vector<uint16_t>& segments, uint64_t dataS
 
     uint16_t neededSegments = (dataSize + (m_segmentSize - 1)) / m_segmentSize;
 
-    segments = m_segmentAlloc.getSegments(neededSegments);
+    {
+        std::lock_guard<std::mutex> lock(m_segmentAllocMutex);
+        segments = m_segmentAlloc.getSegments(neededSegments);
+    }
 
     if (segments.empty())
     {
@@ -464,6 +558,9 @@ bool MappedMemMgr::getDcIfNeeded(std::vector<uint16_t>& segments, uint64_t dataS
  *
  *                           if recipe not in DB - try to allocate for all. Return OUT or BUSY
  *
+ *                           If the recipe was just added by another thread which didn't copy its non-patchable
+ *                           sections yet, waits for it to do so
+ *
  *   @param  entryIds - recipe + runningId
  *   @param  recipeSections - information per section - to be updated
  *   @return None (status in recipeSections)
@@ -478,97 +575,158 @@ void MappedMemMgr::tryGetAddrForId(const RecipeStaticInfoScal& rRecipeStaticInfo
     uint64_t& recipeId  = entryIds.recipeId.val;
     uint64_t& runningId = entryIds.runningId;
 
-    auto it = m_recipeDb.find(entryIds.recipeId.val);
-    if (it != m_recipeDb.end())  // Recipe already in mapped
+    while (true)
     {
-        MappedRecipeInfo& info = it->second;
-
-        PatchableInfo patchableInfo;
-        if (info.patchableFree.empty())  // We don't have a patchable we can use, allocate one
+        MappedRecipeInfoPtr pInfo = findRecipe(recipeId);
+        if (pInfo != nullptr)  // Recipe already in mapped
         {
-            bool ok = getDcIfNeeded(patchableInfo.segments, rRecipeStaticInfoScal.m_mappedSizePatch);
-            if (ok == false)  // NP in, P Allocation failed
+            MappedRecipeInfo&            info = *pInfo;
+            std::unique_lock<std::mutex> lock(info.mutex);
+
+            // A thread asking again for the recipe it added is past its copy
+            if (!info.nonPatchableReady && (info.copyOwner == std::this_thread::get_id()))
             {
-                rSections.m_inMappedPatch   = BUSY;
-                rSections.m_inMappedNoPatch = IN;
+                info.nonPatchableReady = true;
+            }
+            info.nonPatchableReadyCv.wait(lock, [&info]() { return info.nonPatchableReady || info.removed; });
 
-                LOG_TRACE(SYN_PROG_DWNLD,
-                               "Recipe {:x} runId {:x} is in (except patchable) but can not allocate for patchable",
-                               recipeId,
-                               runningId);
-                m_stat.collect(StatPoints::recipePatchBusy, 1);
-                return;
+            if (info.removed)  // evicted, or its first launch failed, look it up again
+            {
+                continue;
+            }
+
+            PatchableInfo patchableInfo;
+            if (info.patchableFree.empty())  // We don't have a patchable we can use, allocate one
+            {
+                bool ok = getDcIfNeeded(patchableInfo.segments, rRecipeStaticInfoScal.m_mappedSizePatch);
+                if (ok == false)  // NP in, P Allocation failed
+                {
+                    rSections.m_inMappedPatch   = BUSY;
+                    rSections.m_inMappedNoPatch = IN;
+
+                    LOG_TRACE(SYN_PROG_DWNLD,
+                                   "Recipe {:x} runId {:x} is in (except patchable) but can not allocate for patchable",
+                                   recipeId,
+                                   runningId);
+                    m_stat.collect(StatPoints::recipePatchBusy, 1);
+                    return;
+                }
+                else  // NP in, P allocation OK
+                {
+                    m_stat.collect(StatPoints::recipeNewPatch, 1);
+                    rSections.m_inMappedPatch   = OUT;
+                    rSections.m_inMappedNoPatch = IN;
+
+                    logPatchableDb(entryIds, patchableInfo.segments, "got new patchable");
+                }
             }
-            else  // NP in, P allocation OK
+            else  // NP in, reuse P
             {
-                m_stat.collect(StatPoints::recipeNewPatch, 1);
-                rSections.m_inMappedPatch   = OUT;
+                m_stat.collect(StatPoints::recipePatchFound, 1);
+                patchableInfo = std::move(info.patchableFree.front());
+                info.patchableFree.pop_front();
+
+                rSections.m_inMappedPatch   = IN;
                 rSections.m_inMappedNoPatch = IN;
 
-                logPatchableDb(entryIds, patchableInfo.segments, "got new patchable");
+                logPatchableDb(entryIds, patchableInfo.segments, "is all in patcable");
             }
+            fillSectionsInfo(entryIds.runningId, info, rSections, patchableInfo);
+            return;
         }
-        else  // NP in, reuse P
+        else  // recipe not in mapped memory, need to allocate for it
         {
-            m_stat.collect(StatPoints::recipePatchFound, 1);
-            patchableInfo = std::move(info.patchableFree.front());
-            info.patchableFree.pop_front();
+            PatchableInfo patchableInfo;
+            bool          ok = getDcIfNeeded(patchableInfo.segments, rRecipeStaticInfoScal.m_mappedSizePatch);
 
-            rSections.m_inMappedPatch   = IN;
-            rSections.m_inMappedNoPatch = IN;
+            if (ok == false)  // NP out, failed P
+            {
+                LOG_TRACE(SYN_PROG_DWNLD,
+                               "Recipe {:x} runId {:x} out, can not allocate for patchable",
+                               recipeId,
+                               runningId);
 
-            logPatchableDb(entryIds, patchableInfo.segments, "is all in patcable");
-        }
-        fillSectionsInfo(entryIds.runningId, info, rSections, patchableInfo);
-        return;
-    }
-    else  // recipe not in mapped memory, need to allocate for it
-    {
-        PatchableInfo patchableInfo;
-        bool          ok = getDcIfNeeded(patchableInfo.segments, rRecipeStaticInfoScal.m_mappedSizePatch);
+                rSections.m_inMappedPatch   = BUSY;
+                rSections.m_inMappedNoPatch = BUSY;
 
-        if (ok == false)  // NP out, failed P
-        {
-            LOG_TRACE(SYN_PROG_DWNLD,
-                           "Recipe {:x} runId {:x} out, can not allocate for patchable",
-                           recipeId,
-                           runningId);
+                m_stat.collect(StatPoints::newRecipeBusyPatch, 1);
+                return;
+            }
 
-            rSections.m_inMappedPatch   = BUSY;
-            rSections.m_inMappedNoPatch = BUSY;
+            std::vector<uint16_t> nonPatchableSegments;
+            ok = getDcIfNeeded(nonPatchableSegments, rRecipeStaticInfoScal.m_mappedSizeNoPatch);
 
-            m_stat.collect(StatPoints::newRecipeBusyPatch, 1);
-            return;
-        }
+            if (ok == false)  // NP out, failed NP
+            {
+                LOG_TRACE(SYN_PROG_DWNLD,
+                               "Recipe {:x} runId {:x} out, can not allocate for non-patchable",
+                               recipeId,
+                               runningId);
 
-        std::vector<uint16_t> nonPatchableSegments;
-        ok = getDcIfNeeded(nonPatchableSegments, rRecipeStaticInfoScal.m_mappedSizeNoPatch);
+                releaseSegments(patchableInfo.segments);
 
-        if (ok == false)  // NP out, failed NP
-        {
-            LOG_TRACE(SYN_PROG_DWNLD,
-                           "Recipe {:x} runId {:x} out, can not allocate for non-patchable",
-                           recipeId,
-                           runningId);
+                rSections.m_inMappedNoPatch = BUSY;
+                rSections.m_inMappedPatch   = BUSY;
+
+                m_stat.collect(StatPoints::newRecipeBusyNonPatch, 1);
+                return;
+            }
+
+            MappedRecipeInfoPtr pNewInfo = std::make_shared<MappedRecipeInfo>();
+            pNewInfo->nonPatchableAddr   = std::move(nonPatchableSegments);
+            pNewInfo->copyOwner          = std::this_thread::get_id();
+
+            RecipeDbShard&                      shard = getShard(recipeId);
+            std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+
+            if (!shard.recipes.emplace(recipeId, pNewInfo).second)
+            {
+                // Another thread added the recipe meanwhile, use its non-patchable sections
+                shardLock.unlock();
+                releaseSegments(patchableInfo.segments);
+                releaseSegments(pNewInfo->nonPatchableAddr);
+                continue;
+            }
 
-            m_segmentAlloc.releaseSegments(patchableInfo.segments);
+            std::lock_guard<std::mutex> lock(pNewInfo->mutex);
+            shardLock.unlock();
 
-            rSections.m_inMappedNoPatch = BUSY;
-            rSections.m_inMappedPatch   = BUSY;
+            m_stat.collect(StatPoints::newRecipeOK, 1);
+            rSections.m_inMappedPatch   = OUT;
+            rSections.m_inMappedNoPatch = OUT;
 
-            m_stat.collect(StatPoints::newRecipeBusyNonPatch, 1);
+            fillSectionsInfo(entryIds.runningId, *pNewInfo, rSections, patchableInfo);
             return;
         }
-        m_stat.collect(StatPoints::newRecipeOK, 1);
-        rSections.m_inMappedPatch   = OUT;
-        rSections.m_inMappedNoPatch = OUT;
-
-        MappedRecipeInfo& info = m_recipeDb[entryIds.recipeId.val];
-        info.nonPatchableAddr  = std::move(nonPatchableSegments);
+    }
+}
 
-        fillSectionsInfo(entryIds.runningId, info, rSections, patchableInfo);
+/*
+ ***************************************************************************************************
+ *   @brief nonPatchableCopied() - This function is called after the non-patchable sections (given as OUT by
+ *                                 getAddrForId) were copied to the mapped memory. Wakes up the threads waiting
+ *                                 for this recipe
+ *
+ *   @param  entryIds - recipe + runningId
+ *   @return None
+ *
+ ***************************************************************************************************
+ */
+void MappedMemMgr::nonPatchableCopied(EntryIds ids)
+{
+    MappedRecipeInfoPtr pInfo = findRecipe(ids.recipeId.val);
+    if (pInfo == nullptr)
+    {
+        LOG_ERR_T(SYN_PROG_DWNLD, "recipe {:x}, running id {:x} not found", ids.recipeId.val, ids.runningId);
         return;
     }
+
+    std::lock_guard<std::mutex> lock(pInfo->mutex);
+    if (!pInfo->nonPatchableReady)
+    {
+        pInfo->nonPatchableReady = true;
+        pInfo->nonPatchableReadyCv.notify_all();
+    }
 }
 
 /*
@@ -588,70 +746,79 @@ bool MappedMemMgr::unuseId(EntryIds ids, bool error)
 {
     LOG_TRACE(SYN_PROG_DWNLD, "seqId {:x} runningID {:x}", ids.recipeId.val, ids.runningId);
 
-    bool rtn = true;  // assume all is good
-
-    auto it = m_recipeDb.find(ids.recipeId.val);
-    if (it == m_recipeDb.end())  // something is wrong
+    MappedRecipeInfoPtr pInfo = findRecipe(ids.recipeId.val);
+    if (pInfo == nullptr)  // something is wrong
     {
         LOG_ERR_T(SYN_PROG_DWNLD, "recipe {:x}, running id {:x} not found for unset", ids.recipeId.val, ids.runningId);
         return false;
     }
 
-    MappedRecipeInfo& info = it->second;
-
-    // If error, remove last one added. If not, remove older one
-    PatchableUsedInfo usedInfo = error ? std::move(info.patchableUsed.back()) : std::move(info.patchableUsed.front());
-    uint64_t          expectedRunningId = usedInfo.runningId;
-    if (expectedRunningId != ids.runningId)  // we expect the recipes to finish in order (FIFO)
+    bool removeRecipe = false;
     {
-        LOG_ERR_T(SYN_PROG_DWNLD,
-                  "for patchable, expectedRunningId != runningId {:x} != {:x}",
-                  expectedRunningId,
-                  ids.runningId);
-        HB_ASSERT(0, "for patchable, expectedRunningId != runningId");
-        return false;
-    }
-
-    // If error, remove last one added. If not, remove older one
-    // On normal case, move from used to free for re-use of the entry
-    // On error case, do not move to free since the data is not valid and also free all segments
-    auto& segments = usedInfo.patchableInfo.segments;
-    if (error)
-    {
-        LOG_TRACE(SYN_PROG_DWNLD, "Error in patching for recipe {} runningId {}, releasing patchable segments", ids.recipeId.val, ids.runningId);
-        for (int i = 0; i < segments.size(); i++)
+        MappedRecipeInfo&           info = *pInfo;
+        std::lock_guard<std::mutex> lock(info.mutex);
+
+        // Launches of the same recipe by different threads may finish out of order, so look for the running id.
+        // If error, it is the last one added. If not, it is usually the oldest one
+        auto usedIt = std::find_if(info.patchableUsed.begin(),
+                                   info.patchableUsed.end(),
+                                   [&ids](const PatchableUsedInfo& usedInfo) {
+                                       return usedInfo.runningId == ids.runningId;
+                                   });
+        if (usedIt == info.patchableUsed.end())
         {
-            LOG_TRACE(SYN_PROG_DWNLD, "Due to error, going to release patchable segment {:x}", TO64(segments[i]));
+            LOG_ERR_T(SYN_PROG_DWNLD,
+                      "for patchable, runningId {:x} is not used by recipe {:x}",
+                      ids.runningId,
+                      ids.recipeId.val);
+            HB_ASSERT(0, "for patchable, runningId is not used");
+            return false;
         }
-        m_segmentAlloc.releaseSegments(segments);
-        info.patchableUsed.pop_back();
 
-        // If the failed launch was the first launch of this recipe, we need to remove the recipe from the DB
-        // since the nonPatchable entry is not filled and we want to create it from the beginning on the next launch
-        if (info.patchableUsed.size() == 0)
+        // On normal case, move from used to free for re-use of the entry
+        // On error case, do not move to free since the data is not valid and also free all segments
+        auto& segments = usedIt->patchableInfo.segments;
+        if (error)
         {
-            removeId(ids.recipeId);
+            LOG_TRACE(SYN_PROG_DWNLD, "Error in patching for recipe {} runningId {}, releasing patchable segments", ids.recipeId.val, ids.runningId);
+            for (int i = 0; i < segments.size(); i++)
+            {
+                LOG_TRACE(SYN_PROG_DWNLD, "Due to error, going to release patchable segment {:x}", TO64(segments[i]));
+            }
+            releaseSegments(segments);
+
+            // If the failed launch was the one that should have copied the nonPatchable sections, we need to remove
+            // the recipe from the DB since the nonPatchable entry is not filled and we want to create it from the
+            // beginning on the next launch. Threads waiting for it are woken up by the removal
+            removeRecipe = !info.nonPatchableReady;
         }
-    }
-    else
-    {
-        for (int i = 0; i < segments.size(); i++)
+        else
         {
-            LOG_TRACE(SYN_MEM_MAP,
-                           "Unuse (moving from used to free) {:x}/{:x} num used patchable before {:x} segment {:x} "
-                           "from err flow {}",
-                           ids.recipeId.val,
-                           ids.runningId,
-                           info.patchableUsed.size(),
-                           TO64(usedInfo.patchableInfo.segments[i]),
-                           error);
+            for (int i = 0; i < segments.size(); i++)
+            {
+                LOG_TRACE(SYN_MEM_MAP,
+                               "Unuse (moving from used to free) {:x}/{:x} num used patchable before {:x} segment {:x} "
+                               "from err flow {}",
+                               ids.recipeId.val,
+                               ids.runningId,
+                               info.patchableUsed.size(),
+                               TO64(segments[i]),
+                               error);
+            }
+
+            info.patchableFree.push_back(std::move(usedIt->patchableInfo));
         }
+        info.patchableUsed.erase(usedIt);
 
-        info.patchableFree.push_back(std::move(usedInfo.patchableInfo));
-        info.patchableUsed.pop_front();
+        removeRecipe = removeRecipe && info.patchableUsed.empty();
     }
 
-    return rtn;
+    if (removeRecipe)
+    {
+        removeId(ids.recipeId);
+    }
+
+    return true;
 }
 
 void MappedMemMgr::unuseIdOnError(EntryIds ids)
@@ -8,8 +8,13 @@
 
 #include "runtime/scal/common/infra/scal_types.hpp"
 
+#include <array>
+#include <condition_variable>
 #include <deque>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include "device/device_mem_alloc.hpp"
 
@@ -35,6 +40,13 @@ struct MappedRecipeInfo
     std::vector<uint16_t>         nonPatchableAddr;
     std::deque<PatchableInfo>     patchableFree;
     std::deque<PatchableUsedInfo> patchableUsed;
+
+    // All the fields (above and below) are protected by the mutex
+    std::mutex              mutex;
+    std::condition_variable nonPatchableReadyCv;
+    bool                    nonPatchableReady = false;  // non-patchable sections were copied to the mapped memory
+    bool                    removed           = false;  // entry was removed from the DB, lookups should retry
+    std::thread::id         copyOwner;                  // thread that got the non-patchable sections as OUT
 };
 
 /*********************************************************************************
@@ -43,9 +55,14 @@ struct MappedRecipeInfo
  * Per recipe it allocates one chunk of memory for all the non-patchable sections and
  * multiple chunks of memory (as needed) for the patchable section
  *
- * NOTE: This class assumes only one thread is using it. If we need to make it thread safe:
- *       There is a gap between getting the memory and copying to it, need to handle  the case where
- *       another thread asks for the same recipe during this gap.
+ * Thread safety: the recipes DB is sharded by the recipe id, each shard with its own (shared) lock, and each
+ * recipe entry has its own lock. Re-using a free patchable entry of a recipe that is already in the mapped memory
+ * takes a shard lock for reading and the recipe lock only, so launches of different recipes do not block each other.
+ * The segment allocator has its own lock, taken only when segments are allocated or released.
+ * Lock order is shard -> recipe -> segment allocator.
+ *
+ * Copy gap: the thread that gets the non-patchable sections as OUT copies them after getAddrForId returns. Until
+ * it calls nonPatchableCopied() (or fails, see unuseId()), other threads asking for the same recipe wait for it.
  *********************************************************************************/
 class MappedMemMgr
 {
@@ -95,7 +112,9 @@ public:
     void
     getAddrForId(const RecipeStaticInfoScal& rRecipeStaticInfoScal, EntryIds entryIds, MemorySectionsScal& rSections);
 
-    size_t getNumRecipes() const { return m_recipeDb.size(); }
+    void nonPatchableCopied(EntryIds ids);
+
+    size_t getNumRecipes() const;
 
     uint64_t getMappedMemorySize() const { return m_segmentSize * m_numSegments; }
 
@@ -106,7 +125,21 @@ public:
     static uint64_t getNumDc();
 
 private:
+    using MappedRecipeInfoPtr = std::shared_ptr<MappedRecipeInfo>;
+
+    struct RecipeDbShard
+    {
+        mutable std::shared_mutex                         mutex;
+        std::unordered_map<uint64_t, MappedRecipeInfoPtr> recipes;
+    };
+
+    static constexpr unsigned NUM_DB_SHARDS = 16;
+
+    RecipeDbShard&      getShard(uint64_t recipeId) { return m_recipeDb[recipeId % NUM_DB_SHARDS]; }
+    MappedRecipeInfoPtr findRecipe(uint64_t recipeId);
+
     bool getDcIfNeeded(std::vector<uint16_t>& segments, uint64_t dataSize);
+    void releaseSegments(const std::vector<uint16_t>& segments);
     void tryGetAddrForId(const RecipeStaticInfoScal& rRecipeStaticInfoScal,
                          EntryIds                    entryIds,
                          MemorySectionsScal&         rSections);
@@ -129,8 +162,9 @@ private:
     uint8_t*                 m_hostAddr = nullptr;
     uint64_t                 m_mappedAddr;
     DevMemoryAllocInterface& m_devMemoryAllocInterface;
+    std::mutex               m_segmentAllocMutex;
     SegmentAlloc             m_segmentAlloc;
 
-    std::unordered_map<uint64_t, MappedRecipeInfo> m_recipeDb;
-    const bool                                     m_protectMem;
+    std::array<RecipeDbShard, NUM_DB_SHARDS> m_recipeDb;
+    const bool                               m_protectMem;
 };
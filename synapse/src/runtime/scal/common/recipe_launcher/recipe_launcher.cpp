@@ -7,6 +7,7 @@
 #include "synapse_common_types.h"
 #include "device/device_mem_alloc.hpp"
 #include "runtime/common/recipe/patching/host_address_patcher.hpp"
+#include "runtime/common/recipe/launch_capture.hpp"
 #include "runtime/common/recipe/recipe_dynamic_info.hpp"
 #include "runtime/common/recipe/recipe_handle_impl.hpp"
 #include "runtime/common/recipe/recipe_patch_processor.hpp"
@@ -23,6 +24,7 @@
 #include <limits>
 #include "infra/memory_utils.h"
 #include "global_statistics.hpp"
+#include "runtime/common/launch_latency_stats.hpp"
 /*
  ***************************************************************************************************
  *   @brief RecipeLauncher() - constructor, keeps some needed pointer/references needed for the launch
@@ -92,14 +94,21 @@ synStatus validateEvents(EventWithMappedTensorDB& events)
  *   deletes the pre_launch info (m_pre)
  *
  *   @param  launchInfo - needed launch information (tensors, workspace addr, flags, etc.)
+ *   @param  pReplayCapture - if given, the tensors are resolved against it instead of being analyzed
+ *   @param  pBatchState - if given, the compute commands are left pending (not submitted)
  *   @return synStatus
  *
  ***************************************************************************************************
  */
-synStatus RecipeLauncher::launch(const LaunchInfo& launchInfo)
+synStatus RecipeLauncher::launch(const LaunchInfo& launchInfo,
+                                 LaunchCapture*    pReplayCapture,
+                                 LaunchBatchState* pBatchState)
 {
     LOG_TRACE(SYN_STREAM, "Start on recipe {:x} runningId {:x}", m_entryIds.recipeId.val, m_entryIds.runningId);
 
+    m_pReplayCapture = pReplayCapture;
+    m_pBatchState    = pBatchState;
+
     // events validation should be out of unrecoverable region
     synStatus status = validateEvents(launchInfo.events);
     if (status != synSuccess)
@@ -155,7 +164,10 @@ synStatus RecipeLauncher::launch(const LaunchInfo& launchInfo)
     updateSfgLongSos(nbExtTensors, launchInfo.events);
 
     STAT_GLBL_START(scalEnqueueStat);
-    status = scalEnqueue(nbExtTensors);  // enqueue, event record for next launch
+    {
+        LAUNCH_LATENCY_SCOPE(ENQUEUE);
+        status = scalEnqueue(nbExtTensors);  // enqueue, event record for next launch
+    }
     if (status != synSuccess)
     {
         // if enqueue failed, the assumption is that we didn't reach the device
@@ -170,7 +182,9 @@ synStatus RecipeLauncher::launch(const LaunchInfo& launchInfo)
     STAT_GLBL_COLLECT_TIME(scalEnqueueStat, globalStatPointsEnum::scalEnqueue);
 
     STAT_GLBL_START(tensorsValidate);
-    if (launchInfo.pRecipeHandle->basicRecipeHandle.recipe->patch_points_nr != 0)
+    // A replay with the tensors addresses of the previous (already validated) launch needs no validation
+    bool isValidationNeeded = (m_pReplayCapture == nullptr) || m_replayTensorsChanged;
+    if ((launchInfo.pRecipeHandle->basicRecipeHandle.recipe->patch_points_nr != 0) && isValidationNeeded)
     {
         status = validateSectionsInfo(launchInfo);
         if (status != synSuccess)
@@ -438,14 +452,22 @@ synStatus RecipeLauncher::scalEnqueue(uint64_t nbExtTensors)
         return status;
     }
 
-    status = addEcbListWithBarrierAndSend(nbExtTensors);
+    // A launch of a batch leaves its commands pending, to be submitted with the rest of the batch
+    const bool send = (m_pBatchState == nullptr);
+
+    status = addEcbListWithBarrierAndSend(nbExtTensors, send);
     if (status != synSuccess)
     {
         return status;
     }
 
     // release global fence
-    getComputeScalStream()->addGlobalFenceInc(true);
+    getComputeScalStream()->addGlobalFenceInc(send);
+
+    if (!send && (m_pBatchState->pendingLongSo == 0))
+    {
+        m_pBatchState->pendingLongSo = m_longSoCompute.m_targetValue;
+    }
 
     // set the longSo on the HBM allocators (record an event to get the current longSo)
     ScalLongSyncObject scalLongSyncObject;
@@ -489,18 +511,33 @@ synStatus RecipeLauncher::analyzeTensors(const LaunchInfo& launchInfo)
     ValidSectionAddresses validSectionAddresses {launchInfo.devSpecificInfo.dramBaseAddr,
                                                  launchInfo.devSpecificInfo.dramEndAddr};
 
-    synStatus status = RecipePatchProcessor::process(launchInfo.pRecipeHandle->basicRecipeHandle,
+    synStatus status = synSuccess;
+    if (m_pReplayCapture != nullptr)
+    {
+        status = RecipePatchProcessor::processReplay(launchInfo.pRecipeHandle->basicRecipeHandle,
                                                      launchInfo.pRecipeHandle->deviceAgnosticRecipeHandle.m_recipeTensorInfo,
+                                                     *m_pReplayCapture,
                                                      launchInfo.pEnqueueTensorsInfo,
-                                                     launchInfo.pEnqueueTensorsInfoAmount,
-                                                     launchInfo.launchFlags,
                                                      m_wsInfo,
                                                      *hostAddrPatchInfo,
-                                                     m_devMemoryAlloc,
-                                                     m_tensorIdx2userIdx,
-                                                     true /* isInitAndCompletionRequired */,
-                                                     true /* shouldResolveTensorsIndices */,
-                                                     &validSectionAddresses);
+                                                     &validSectionAddresses,
+                                                     m_replayTensorsChanged);
+    }
+    else
+    {
+        status = RecipePatchProcessor::process(launchInfo.pRecipeHandle->basicRecipeHandle,
+                                               launchInfo.pRecipeHandle->deviceAgnosticRecipeHandle.m_recipeTensorInfo,
+                                               launchInfo.pEnqueueTensorsInfo,
+                                               launchInfo.pEnqueueTensorsInfoAmount,
+                                               launchInfo.launchFlags,
+                                               m_wsInfo,
+                                               *hostAddrPatchInfo,
+                                               m_devMemoryAlloc,
+                                               m_tensorIdx2userIdx,
+                                               true /* isInitAndCompletionRequired */,
+                                               m_isDsd /* shouldResolveTensorsIndices */,
+                                               &validSectionAddresses);
+    }
     // NOTE: at this point hostAddrPatchInfo doesn't hold the sectionTypes anymore because process() is calling
     //       patchingCompletion. I think we should solve it inside process() - maybe call patching completion
     //       before we start the process or something similar
@@ -602,8 +639,15 @@ synStatus RecipeLauncher::prepareForDownload(const LaunchInfo& launchInfo)
     uint64_t maxLongSo            = std::max(longSoGlbHbm, longSoArcHbm);
     m_longSoHbmBuff.m_targetValue = maxLongSo;
 
+    // The buffers may be freed only by a launch of the batch whose compute commands are still pending
+    synStatus status = submitPendingComputeIfWaitedFor(maxLongSo);
+    if (status != synSuccess)
+    {
+        return status;
+    }
+
     LOG_DEBUG(SYN_PROG_DWNLD, "waiting for max({:x},{:x})", longSoGlbHbm, longSoArcHbm);
-    synStatus status = getTxCommandsScalStream()->longSoWaitOnDevice(m_longSoHbmBuff, false);
+    status = getTxCommandsScalStream()->longSoWaitOnDevice(m_longSoHbmBuff, false);
     if (status != synSuccess)
     {
         return status;
@@ -620,13 +664,19 @@ synStatus RecipeLauncher::prepareForDownload(const LaunchInfo& launchInfo)
     }
     STAT_GLBL_COLLECT_TIME(scalGetMapped, globalStatPointsEnum::scalGetMapped);
 
-    status = analyzeTensors(launchInfo);
+    {
+        LAUNCH_LATENCY_SCOPE(ANALYZE_TENSORS);
+        status = analyzeTensors(launchInfo);
+    }
     if (status != synSuccess)
     {
         return status;
     }
 
-    status = runSifPreDownload(launchInfo);
+    {
+        LAUNCH_LATENCY_SCOPE(SIF);
+        status = runSifPreDownload(launchInfo);
+    }
     if (status != synSuccess)
     {
         return status;
@@ -654,14 +704,27 @@ synStatus RecipeLauncher::prepareForDownload(const LaunchInfo& launchInfo)
 synStatus RecipeLauncher::downloadToDev(const LaunchInfo& launchInfo)
 {
     STAT_GLBL_START(scalMemcpy2Mapped);
-    MappedMemorySectionsUtils::memcpyToMapped(
-        m_sections,
-        m_pRecipeHandle->deviceAgnosticRecipeHandle.m_recipeStaticInfoScal.recipeSections,
-        m_isDsd,
-        m_isIH2DRecipe);
+    {
+        LAUNCH_LATENCY_SCOPE(COPY_TO_MAPPED);
+        MappedMemorySectionsUtils::memcpyToMapped(
+            m_sections,
+            m_pRecipeHandle->deviceAgnosticRecipeHandle.m_recipeStaticInfoScal.recipeSections,
+            m_isDsd,
+            m_isIH2DRecipe);
+    }
     STAT_GLBL_COLLECT_TIME(scalMemcpy2Mapped, globalStatPointsEnum::scalMemcpy2Mapped);
 
-    synStatus status = patch(launchInfo);
+    if (m_sections.m_inMappedNoPatch == OUT)
+    {
+        // Other launches of this recipe may wait for its non-patchable sections
+        m_memMgrs.mappedMemMgr.nonPatchableCopied(m_entryIds);
+    }
+
+    synStatus status;
+    {
+        LAUNCH_LATENCY_SCOPE(PATCHING);
+        status = patch(launchInfo);
+    }
     if (status != synSuccess)
     {
         clearMemMgrs();
@@ -670,7 +733,10 @@ synStatus RecipeLauncher::downloadToDev(const LaunchInfo& launchInfo)
 
     // Now everything in the Mapped memory, download it
     STAT_GLBL_START(scalPdmaDownload);
-    status = pdmaDownload(m_sections);
+    {
+        LAUNCH_LATENCY_SCOPE(DOWNLOAD);
+        status = pdmaDownload(m_sections);
+    }
     if (status != synSuccess)
     {
         return status;
@@ -1338,7 +1404,21 @@ synStatus RecipeLauncher::patch(const LaunchInfo& launchInfo)
                                                  m_pDynamicRecipeProcessor->getRecipeAddrPatcher() :
                                                  launchInfo.pRecipeHandle->deviceAgnosticRecipeHandle.m_recipeStaticInfoScal.recipeAddrPatcher;
 
-    recipeAddrPatcher.patchAll(sectionAddrDb, m_sections.m_patchableMappedAddr);
+    // When the patchable data-chunks are reused (and were not re-copied), they hold the patching of the previous
+    // launch of the recipe, so only the sections whose address had changed need to be patched
+    const bool isDeltaPatching =
+        (m_sections.m_inMappedPatch == IN) && !m_isDsd && GCFG_ENABLE_DELTA_PATCHING.value();
+    if (isDeltaPatching)
+    {
+        recipeAddrPatcher.patchChangedSections(sectionAddrDb,
+                                               hostAddrPatchInfo->getSectionsChangedDB(),
+                                               m_sections.m_patchableMappedAddr);
+    }
+    else
+    {
+        recipeAddrPatcher.patchAll(sectionAddrDb, m_sections.m_patchableMappedAddr);
+    }
+    hostAddrPatchInfo->clearSectionsChanged();
     STAT_GLBL_COLLECT_TIME(patchingAll, globalStatPointsEnum::patchingAll);
 
     return synSuccess;
@@ -1388,11 +1468,12 @@ synStatus RecipeLauncher::addBaseAddresses(const EngineGrpArr& engineGrpArr)
  *   @brief handleEcbList() sends all the dcb lists as part of the launch
  *
  *   @param  LaunchAddr - addresses where all the parts of the recipe are
+ *   @param  send - submit the commands (with the dispatch barrier)
  *   @return status
  *
  ***************************************************************************************************
  */
-synStatus RecipeLauncher::addEcbListWithBarrierAndSend(uint64_t nbExtTensors)
+synStatus RecipeLauncher::addEcbListWithBarrierAndSend(uint64_t nbExtTensors, bool send)
 {
     const recipe_t*             recipe    = m_pRecipeHandle->basicRecipeHandle.recipe;
     const MemorySectionsScal&   rSections = m_sections;
@@ -1448,7 +1529,7 @@ synStatus RecipeLauncher::addEcbListWithBarrierAndSend(uint64_t nbExtTensors)
 
     status = getComputeScalStream()->addDispatchBarrier(ResourceStreamType::COMPUTE,
                                                         true,
-                                                        true,
+                                                        send,
                                                         m_longSoCompute,
                                                         nbExtTensors);
     if (status != synSuccess)
@@ -1461,6 +1542,53 @@ synStatus RecipeLauncher::addEcbListWithBarrierAndSend(uint64_t nbExtTensors)
     return synSuccess;
 }
 
+/*
+ ***************************************************************************************************
+ *   @brief submitPendingCompute() submits the pending compute commands of the batch (see LaunchBatchState)
+ *
+ *   @return status
+ *
+ ***************************************************************************************************
+ */
+synStatus RecipeLauncher::submitPendingCompute()
+{
+    LOG_DEBUG(SYN_STREAM,
+              "{}: submitting the batch compute commands pending since longSo {:#x}",
+              HLLOG_FUNC,
+              m_pBatchState->pendingLongSo);
+
+    synStatus status = getComputeScalStream()->submitPendingCommands();
+    if (status != synSuccess)
+    {
+        LOG_ERR(SYN_STREAM, "submitPendingCommands failed with status {}", status);
+        return status;
+    }
+
+    m_pBatchState->pendingLongSo = 0;
+    return synSuccess;
+}
+
+/*
+ ***************************************************************************************************
+ *   @brief submitPendingComputeIfWaitedFor() submits the pending compute commands of the batch if the
+ *          given compute longSo is of one of them. Otherwise, a wait for it (and any host wait for the
+ *          waiting operation) would never end
+ *
+ *   @param  longSo - the compute longSo to be waited for
+ *   @return status
+ *
+ ***************************************************************************************************
+ */
+synStatus RecipeLauncher::submitPendingComputeIfWaitedFor(uint64_t longSo)
+{
+    if ((m_pBatchState == nullptr) || (m_pBatchState->pendingLongSo == 0) || (longSo < m_pBatchState->pendingLongSo))
+    {
+        return synSuccess;
+    }
+
+    return submitPendingCompute();
+}
+
 /*
  ***************************************************************************************************
  *   @brief getHbmAddr() utility to get hte hbm addr from the section tyep
@@ -25,6 +25,7 @@ struct InternalRecipeHandle;
 class LaunchTracker;
 class MemMgrs;
 class DynamicRecipe;
+class LaunchCapture;
 class ScalStreamCopyInterface;
 class ScalStreamComputeInterface;
 
@@ -67,6 +68,13 @@ struct LaunchInfo
     const uint8_t                 m_apiId;
 };
 
+// The compute-stream submission state of a batch of launches (see synLaunchBatch), shared by its RecipeLaunchers.
+// The launches of a batch leave their compute commands pending, and the batch submits them all once it is done
+struct LaunchBatchState
+{
+    uint64_t pendingLongSo = 0;  // The compute longSo of the first launch with pending commands, 0 if there are none
+};
+
 /**********************************************************************************/
 /* An instance of this class (RecipeLauncher) is created for every synLaunch      */
 /* and it is responsible to handle the launch. Part of it (m_pre) is needed only  */
@@ -76,6 +84,8 @@ struct LaunchInfo
 /**********************************************************************************/
 class RecipeLauncher : public RecipeLauncherInterface
 {
+    friend class UTRecipeLauncherTest;
+
 public:
     RecipeLauncher(ScalStreamComputeInterface*     pComputeScalStream,
                    const ComputeCompoundResources* pComputeResources,
@@ -105,7 +115,11 @@ public:
 
     virtual const InternalRecipeHandle& getInternalRecipeHandle() const override { return *m_pRecipeHandle; }
 
-    synStatus launch(const LaunchInfo& launchInfo);
+    // pReplayCapture - the capture of a previous launch with the same tensors (see SYN_FLAGS_LAUNCH_REPLAY), if any
+    // pBatchState    - the state of the batch the launch is part of (its compute commands are not submitted), if any
+    synStatus launch(const LaunchInfo& launchInfo,
+                     LaunchCapture*    pReplayCapture = nullptr,
+                     LaunchBatchState* pBatchState    = nullptr);
 
 private:
     void updateSfgLongSos(uint64_t nbExtTensors, EventWithMappedTensorDB& events);
@@ -142,7 +156,11 @@ private:
 
     synStatus addBaseAddresses(const EngineGrpArr& engineGrpArr);
 
-    synStatus addEcbListWithBarrierAndSend(uint64_t nbExtTensors);
+    synStatus addEcbListWithBarrierAndSend(uint64_t nbExtTensors, bool send);
+
+    synStatus submitPendingCompute();
+
+    synStatus submitPendingComputeIfWaitedFor(uint64_t longSo);
 
     // Needed until launch (unless for debug)
 
@@ -170,6 +188,9 @@ private:
     MemorySectionsScal          m_sections;
     WorkSpacesInformation       m_wsInfo;
     std::vector<uint32_t>       m_tensorIdx2userIdx[tensor_info_t::ETensorType::INTERNAL_TENSOR];
+    LaunchCapture*              m_pReplayCapture       = nullptr;
+    bool                        m_replayTensorsChanged = false;
+    LaunchBatchState*           m_pBatchState          = nullptr;
 
     // need after queueing on device
     MemMgrs&                        m_memMgrs;
@@ -29,6 +29,7 @@ QueueComputeScal::QueueComputeScal(const BasicQueueInfo&           rBasicQueueIn
   m_rDevSpecificInfo(rDevSpecificInfo),
   m_memMgrs(m_scalStream->getName(), devMemoryAlloc),
   m_launchTracker(GCFG_NUM_OF_CSDC_TO_CHK.value()),
+  m_launchLatencyStats(LaunchLatencyStats::create(m_scalStream->getName())),
   m_devMemoryAlloc(devMemoryAlloc),
   m_computeResources(*pComputeResources)
 {
@@ -219,6 +220,54 @@ DynamicRecipe* QueueComputeScal::getDynamicShapeProcessor(const LaunchInfo& laun
     return m_dynamicShapeProcessor[recipeId].get();
 }
 
+LaunchCapture* QueueComputeScal::getReplayCapture(const LaunchInfo& launchInfo)
+{
+    const uint64_t recipeId   = launchInfo.pRecipeHandle->recipeSeqNum;
+    auto           captureItr = m_launchCaptures.find(recipeId);
+
+    if (captureItr == m_launchCaptures.end())
+    {
+        LOG_DEBUG_T(SYN_STREAM, "Recipe 0x{:x} was not captured on stream, launching it fully", recipeId);
+    }
+    else if (GCFG_CHECK_SECTION_OVERLAP.value())
+    {
+        LOG_DEBUG_T(SYN_STREAM, "Section overlap check is on, launching recipe 0x{:x} fully", recipeId);
+    }
+    else if (!captureItr->second->matches(launchInfo.pEnqueueTensorsInfo, launchInfo.pEnqueueTensorsInfoAmount))
+    {
+        LOG_DEBUG_T(SYN_STREAM,
+                    "Launch tensors of recipe 0x{:x} differ from the captured ones, launching it fully",
+                    recipeId);
+    }
+    else
+    {
+        STAT_GLBL_COLLECT(1, launchReplayHit);
+        return captureItr->second.get();
+    }
+
+    STAT_GLBL_COLLECT(1, launchReplayMiss);
+    return nullptr;
+}
+
+void QueueComputeScal::captureLaunch(const LaunchInfo& launchInfo)
+{
+    const uint64_t recipeId = launchInfo.pRecipeHandle->recipeSeqNum;
+
+    std::unique_ptr<LaunchCapture> capture =
+        LaunchCapture::create(launchInfo.pRecipeHandle->basicRecipeHandle,
+                              launchInfo.pRecipeHandle->deviceAgnosticRecipeHandle.m_recipeTensorInfo,
+                              launchInfo.pEnqueueTensorsInfo,
+                              launchInfo.pEnqueueTensorsInfoAmount);
+    if (capture == nullptr)
+    {
+        LOG_DEBUG_T(SYN_STREAM, "Launch of recipe 0x{:x} can't be captured", recipeId);
+        m_launchCaptures.erase(recipeId);
+        return;
+    }
+
+    m_launchCaptures[recipeId] = std::move(capture);
+}
+
 synStatus QueueComputeScal::launch(const synLaunchTensorInfoExt* launchTensorsInfo,
                                    uint32_t                      launchTensorsAmount,
                                    uint64_t                      workspaceAddress,
@@ -227,6 +276,103 @@ synStatus QueueComputeScal::launch(const synLaunchTensorInfoExt* launchTensorsIn
                                    uint32_t                      flags,
                                    EventWithMappedTensorDB&      events,
                                    uint8_t                       apiId)
+{
+    return launch(launchTensorsInfo,
+                  launchTensorsAmount,
+                  workspaceAddress,
+                  pRecipeHandle,
+                  assertAsyncMappedAddress,
+                  flags,
+                  events,
+                  apiId,
+                  nullptr /* pBatchState */);
+}
+
+/*
+ ***************************************************************************************************
+ *   @brief launchBatch() launches the batch entries (see synLaunchBatch) in order.
+ *   The stream is locked and checked for completions once for the whole batch, and the compute
+ *   commands of its launches are submitted together, once all of them are enqueued (or one fails)
+ *
+ *   @param  launchBatchInfo, numberOfLaunches - the batch entries
+ *   @param  rNumOfLaunched - set to the number of entries that were launched
+ *   @return status
+ *
+ ***************************************************************************************************
+ */
+synStatus QueueComputeScal::launchBatch(const synLaunchBatchInfo* launchBatchInfo,
+                                        uint32_t                  numberOfLaunches,
+                                        uint64_t                  assertAsyncMappedAddress,
+                                        uint8_t                   apiId,
+                                        uint32_t&                 rNumOfLaunched)
+{
+    ScopedLaunchLatencyStats latencyStats(m_launchLatencyStats.get());
+
+    std::lock_guard<std::timed_mutex> lock(m_userOpLock);
+
+    // Each check releases a bounded amount of completed launches; keep checking (while there are
+    // completions) until as many launches as the batch adds are released, so the tracker does not grow
+    uint64_t numOfReleased = 0;
+    uint64_t numOfCompleted;
+    do
+    {
+        numOfCompleted = checkForCompletion();
+        numOfReleased += numOfCompleted;
+    } while ((numOfCompleted != 0) && (numOfReleased < numberOfLaunches));
+
+    LaunchBatchState        batchState;
+    EventWithMappedTensorDB events;
+    synStatus               status = synSuccess;
+
+    for (rNumOfLaunched = 0; rNumOfLaunched < numberOfLaunches; rNumOfLaunched++)
+    {
+        const synLaunchBatchInfo& rLaunch = launchBatchInfo[rNumOfLaunched];
+
+        status = launch(rLaunch.launchTensorsInfoExt,
+                        rLaunch.numberOfTensors,
+                        rLaunch.pWorkspace,
+                        rLaunch.pRecipeHandle,
+                        assertAsyncMappedAddress,
+                        rLaunch.flags,
+                        events,
+                        apiId,
+                        &batchState);
+        if (status != synSuccess)
+        {
+            LOG_ERR_T(SYN_STREAM, "launch {} out of {} of the batch failed", rNumOfLaunched, numberOfLaunches);
+            break;
+        }
+    }
+
+    // The launches that were enqueued (even if a later one failed) are submitted
+    if (batchState.pendingLongSo != 0)
+    {
+        ScalStreamComputeInterface* pComputeScalStream = dynamic_cast<ScalStreamComputeInterface*>(m_scalStream);
+        VERIFY_IS_NULL_POINTER(SYN_STREAM, pComputeScalStream, "pComputeScalStream");
+
+        synStatus submitStatus = pComputeScalStream->submitPendingCommands();
+        if (submitStatus != synSuccess)
+        {
+            LOG_ERR_T(SYN_STREAM, "Failed to submit the batch compute commands, status {}", submitStatus);
+            if (status == synSuccess)
+            {
+                status = submitStatus;
+            }
+        }
+    }
+
+    return status;
+}
+
+synStatus QueueComputeScal::launch(const synLaunchTensorInfoExt* launchTensorsInfo,
+                                   uint32_t                      launchTensorsAmount,
+                                   uint64_t                      workspaceAddress,
+                                   InternalRecipeHandle*         pRecipeHandle,
+                                   uint64_t                      assertAsyncMappedAddress,
+                                   uint32_t                      flags,
+                                   EventWithMappedTensorDB&      events,
+                                   uint8_t                       apiId,
+                                   LaunchBatchState*             pBatchState)
 {
     CHECK_POINTER(SYN_STREAM, pRecipeHandle, "pRecipeHandle", synFail);
     basicRecipeInfo& basicRecipeHandle = pRecipeHandle->basicRecipeHandle;
@@ -280,7 +426,7 @@ synStatus QueueComputeScal::launch(const synLaunchTensorInfoExt* launchTensorsIn
                           events,
                           apiId);
 
-    status = launch(launchInfo);
+    status = launch(launchInfo, pBatchState);
 
     if (status != synSuccess)
     {
@@ -308,18 +454,23 @@ synStatus QueueComputeScal::launch(const synLaunchTensorInfoExt* launchTensorsIn
  *   Skips sending the commands to scal (for testing)
  *
  *   @param  LaunchInfo - all information needed for this specific launch
+ *   @param  pBatchState - the state of the batch (see launchBatch) the launch is part of, if any
  *   @return status
  *
  ***************************************************************************************************
  */
-synStatus QueueComputeScal::launch(const LaunchInfo& launchInfo)
+synStatus QueueComputeScal::launch(const LaunchInfo& launchInfo, LaunchBatchState* pBatchState)
 {
-    std::lock_guard<std::timed_mutex> lock(m_userOpLock);
+    ScopedLaunchLatencyStats latencyStats(m_launchLatencyStats.get());
+    LAUNCH_LATENCY_SCOPE(TOTAL);
 
-    STAT_GLBL_START(scalChkCompletion);
-    uint64_t numOfCompletionsCopy, numOfCompletionsCompute;
-    m_launchTracker.checkForCompletion(numOfCompletionsCopy, numOfCompletionsCompute);
-    STAT_GLBL_COLLECT_TIME(scalChkCompletion, globalStatPointsEnum::scalChkCompletion);
+    // A batch launch is made under the lock (and after the completion check) of its batch
+    std::unique_lock<std::timed_mutex> lock(m_userOpLock, std::defer_lock);
+    if (pBatchState == nullptr)
+    {
+        lock.lock();
+        checkForCompletion();
+    }
 
     DynamicRecipe* dsdProcessor = nullptr;
     bool           isDsd        = RecipeUtils::isDsd(launchInfo.pRecipeHandle->basicRecipeHandle);
@@ -342,13 +493,26 @@ synStatus QueueComputeScal::launch(const LaunchInfo& launchInfo)
                                                                                       ++m_runningId,
                                                                                       launchInfo.m_apiId);
 
-    synStatus status = recipeLauncher->launch(launchInfo);
+    // A capture launch always runs fully, and (re)captures the recipe launch
+    const bool     isCapture      = (launchInfo.launchFlags & SYN_FLAGS_LAUNCH_CAPTURE) != 0;
+    LaunchCapture* pReplayCapture = nullptr;
+    if (!isCapture && ((launchInfo.launchFlags & SYN_FLAGS_LAUNCH_REPLAY) != 0))
+    {
+        pReplayCapture = getReplayCapture(launchInfo);
+    }
+
+    synStatus status = recipeLauncher->launch(launchInfo, pReplayCapture, pBatchState);
     if (status != synSuccess)
     {
         LOG_ERR(SYN_STREAM,
                 "{}: recipeLauncher launch failed, recipe seq {}",
                 HLLOG_FUNC,
                 launchInfo.pRecipeHandle->recipeSeqNum);
+        if (pReplayCapture != nullptr)
+        {
+            // The capture may be left with the tensors of the failed launch
+            m_launchCaptures.erase(launchInfo.pRecipeHandle->recipeSeqNum);
+        }
         // in case of failure after enqueue, add launcher to tracker anyway
         if (status == synFailedSectionValidation)
         {
@@ -357,12 +521,30 @@ synStatus QueueComputeScal::launch(const LaunchInfo& launchInfo)
         return status;
     }
 
+    if (isCapture)
+    {
+        captureLaunch(launchInfo);
+    }
+
     updateSfgEventsScalStream(launchInfo.events);
     m_launchTracker.add(std::move(recipeLauncher));
 
     return synSuccess;
 }
 
+uint64_t QueueComputeScal::checkForCompletion()
+{
+    STAT_GLBL_START(scalChkCompletion);
+    uint64_t numOfCompletionsCopy, numOfCompletionsCompute;
+    {
+        LAUNCH_LATENCY_SCOPE(CHECK_COMPLETION);
+        m_launchTracker.checkForCompletion(numOfCompletionsCopy, numOfCompletionsCompute);
+    }
+    STAT_GLBL_COLLECT_TIME(scalChkCompletion, globalStatPointsEnum::scalChkCompletion);
+
+    return numOfCompletionsCompute;
+}
+
 /*
  ***************************************************************************************************
  *   @brief getMappedMemorySize() returns the size of mapped memory used by this stream
@@ -393,6 +575,8 @@ void QueueComputeScal::notifyRecipeRemoval(InternalRecipeHandle& rRecipeHandle)
     {
         m_dynamicShapeProcessor.erase(recipeProcessorsIter);
     }
+
+    m_launchCaptures.erase(rRecipeHandle.recipeSeqNum);
 }
 
 void QueueComputeScal::notifyAllRecipeRemoval()
@@ -404,6 +588,8 @@ void QueueComputeScal::notifyAllRecipeRemoval()
     m_memMgrs.mappedMemMgr.removeAllId();
 
     m_dynamicShapeProcessor.clear();
+
+    m_launchCaptures.clear();
 }
 
 /**
@@ -5,6 +5,8 @@
 
 #include "runtime/scal/common/recipe_launcher/mem_mgrs.hpp"
 #include "runtime/scal/common/recipe_launcher/recipe_launcher.hpp"
+#include "runtime/common/launch_latency_stats.hpp"
+#include "runtime/common/recipe/launch_capture.hpp"
 
 #include <array>
 
@@ -63,6 +65,12 @@ public:
                              EventWithMappedTensorDB&      events,
                              uint8_t                       apiId) override;
 
+    virtual synStatus launchBatch(const synLaunchBatchInfo* launchBatchInfo,
+                                  uint32_t                  numberOfLaunches,
+                                  uint64_t                  assertAsyncMappedAddress,
+                                  uint8_t                   apiId,
+                                  uint32_t&                 rNumOfLaunched) override;
+
     virtual void notifyRecipeRemoval(InternalRecipeHandle& rRecipeHandle);
 
     virtual void    notifyAllRecipeRemoval();
@@ -77,10 +85,25 @@ public:
     virtual synStatus getDynamicShapesTensorInfoArray(synRecipeHandle             recipeHandle,
                                                       std::vector<tensor_info_t>& tensorInfoArray) const;
 
+    // Null unless GCFG_ENABLE_LAUNCH_LATENCY_STATS was set when the stream was created
+    LaunchLatencyStats* getLaunchLatencyStats() const { return m_launchLatencyStats.get(); }
+
 private:
     synStatus initMemMgrs();
-    synStatus      launch(const LaunchInfo& launchInfo);
+    synStatus      launch(const synLaunchTensorInfoExt* launchTensorsInfo,
+                          uint32_t                      launchTensorsAmount,
+                          uint64_t                      workspaceAddress,
+                          InternalRecipeHandle*         pRecipeHandle,
+                          uint64_t                      assertAsyncMappedAddress,
+                          uint32_t                      flags,
+                          EventWithMappedTensorDB&      events,
+                          uint8_t                       apiId,
+                          LaunchBatchState*             pBatchState);
+    synStatus      launch(const LaunchInfo& launchInfo, LaunchBatchState* pBatchState);
+    uint64_t       checkForCompletion();
     DynamicRecipe* getDynamicShapeProcessor(const LaunchInfo& launchInfo);
+    LaunchCapture* getReplayCapture(const LaunchInfo& launchInfo);
+    void           captureLaunch(const LaunchInfo& launchInfo);
 
     void updateSfgEventsScalStream(EventWithMappedTensorDB& events);
     virtual std::set<ScalStreamCopyInterface*> dfaGetQueueScalStreams() override;
@@ -92,6 +115,9 @@ private:
     MemMgrs       m_memMgrs;
     LaunchTracker m_launchTracker;
 
+    // Null unless GCFG_ENABLE_LAUNCH_LATENCY_STATS is set
+    std::shared_ptr<LaunchLatencyStats> m_launchLatencyStats;
+
     DevMemoryAllocInterface& m_devMemoryAlloc;
 
     uint64_t m_runningId = 0;
@@ -107,5 +133,8 @@ private:
 
     std::unordered_map<uint64_t, std::unique_ptr<DynamicRecipe>> m_dynamicShapeProcessor;
 
+    // Per recipe (seq-num), its last launch made with SYN_FLAGS_LAUNCH_CAPTURE
+    std::unordered_map<uint64_t, std::unique_ptr<LaunchCapture>> m_launchCaptures;
+
     const ComputeCompoundResources m_computeResources;
 };
@@ -1,6 +1,7 @@
 #include <shared_layer_agent_api.hpp>
 #include "op_validator.h"
 #include "gc_ops_db.h"
+#include "habana_global_conf.h"
 #include "log_manager.h"
 #include "data_type_utils.h"
 #include "defs.h"
@@ -12,6 +13,8 @@
 static gc::ops::OpValidationContext sharedLayerParamsToOpValidationContext(const SharedLayer::Params_t* pParams)
 {
     gc::ops::OpValidationContext ovc {};
+    // Validated outside of a graph, so only the global data type selection setting applies
+    ovc.setDataTypeSelectionEnabled(GCFG_SYNAPSE_DATA_TYPE_SELECTION.value());
     if (!pParams) return ovc;
     ovc.getInputs().reserve(pParams->inputTensorNr);
     for (unsigned inIdx = 0; inIdx < pParams->inputTensorNr; ++inIdx)
@@ -1,4 +1,6 @@
 #include "eager_tests_defs.h"
+#include "eager/eager_interface.h"
+#include "habana_global_conf.h"
 #include "scoped_configuration_change.h"
 #include "synapse_common_types.h"
 #include "transpose_utils.h"
@@ -7,6 +9,7 @@
 #include <array>
 #include <cstddef>
 #include <random>
+#include <string>
 #include <vector>
 
 using namespace eager_mode;
@@ -798,6 +801,75 @@ TEST_F_GC(SynTrainingEagerTests, consecutive_add_test)
     }
 }
 
+// Graphs of the same op and geometry get the cached recipe of the first compilation, bound to their own tensors
+TEST_F_GC(SynTrainingEagerTests, recipe_cache_reuse)
+{
+    const uint32_t dims             = 2;
+    unsigned       add_dimensions[] = {64, 16};
+    const unsigned graphsNr         = 3;
+
+    // The cache is off by default, start it empty as the knob is changed without synConfigurationSet
+    ScopedConfigurationChange recipeCache("EAGER_RECIPE_CACHE_MAX_ENTRIES", "4096");
+    eager_mode::clearEagerRecipeCache();
+
+    const eager_mode::EagerRecipeCacheStats statsBefore = eager_mode::getEagerRecipeCacheStats();
+
+    std::vector<std::array<unsigned, 3>> graphsTensors;
+    for (unsigned graphIndex = 0; graphIndex < graphsNr; ++graphIndex)
+    {
+        if (graphIndex > 0)
+        {
+            ASSERT_EQ(createGraph(), graphIndex);
+        }
+        const std::string suffix = "_g" + std::to_string(graphIndex);
+
+        std::array<unsigned, 3> tensors;
+        for (unsigned i = 0; i < 2; ++i)
+        {
+            tensors[i] = createPersistTensor(INPUT_TENSOR,
+                                             MEM_INIT_RANDOM_WITH_NEGATIVE,
+                                             nullptr,  // initializer
+                                             add_dimensions,
+                                             dims,
+                                             syn_type_single,
+                                             nullptr,
+                                             ("in" + std::to_string(i) + suffix).c_str(),
+                                             graphIndex);
+        }
+        tensors[2] = createPersistTensor(OUTPUT_TENSOR,
+                                         MEM_INIT_ALL_ZERO,
+                                         nullptr,  // initializer
+                                         add_dimensions,
+                                         dims,
+                                         syn_type_single,
+                                         nullptr,
+                                         ("out" + suffix).c_str(),
+                                         graphIndex);
+        addNodeToGraph("add_fwd_f32", {tensors[0], tensors[1]}, {tensors[2]}, nullptr, 0, nullptr, graphIndex);
+        compileTopology("recipe_cache_reuse" + suffix, graphIndex);
+        runTopology(graphIndex);
+        graphsTensors.push_back(tensors);
+    }
+
+    for (const auto& tensors : graphsTensors)
+    {
+        const float* in1        = (float*)m_hostBuffers[tensors[0]];
+        const float* in2        = (float*)m_hostBuffers[tensors[1]];
+        const float* outputData = (float*)m_hostBuffers[tensors[2]];
+        for (uint32_t i = 0; i < multiplyElements(add_dimensions, add_dimensions + dims); ++i)
+        {
+            ASSERT_EQ(outputData[i], in1[i] + in2[i]);
+        }
+    }
+
+    const eager_mode::EagerRecipeCacheStats statsAfter = eager_mode::getEagerRecipeCacheStats();
+    eager_mode::clearEagerRecipeCache();
+    ASSERT_GE(statsAfter.hits - statsBefore.hits, graphsNr - 1);
+    ASSERT_GT(statsAfter.lookupTimeNs, statsBefore.lookupTimeNs);
+    ASSERT_GT(statsAfter.entriesNr, 0U);
+    ASSERT_GT(statsAfter.sizeInBytes, 0U);
+}
+
 // this test also makes sure these nodes work with 16 tensors
 TEST_F_GC(SynTrainingEagerTests, multiple_logical_ops)
 {
@@ -0,0 +1,221 @@
+#include <graph_compiler/habana_nodes/node_factory.h>
+#include "../graph_optimizer_test.h"
+#include "platform/gaudi/graph_compiler/gaudi_graph.h"
+#include "graph_editor.h"
+#include "memory_aware_scheduler.h"
+#include "scoped_configuration_change.h"
+#include "synapse_common_types.h"
+
+#include <unordered_map>
+
+class MemoryAwareScheduleTest : public GraphOptimizerTest
+{
+protected:
+    static TensorPtr createTensor(TSize size)
+    {
+        TensorPtr t(new Tensor(1, &size, syn_type_float));
+        t->setTensorInDram();
+        return t;
+    }
+
+    // A producer of a large tensor for each of numOfBranches consumers, which reduce it to a small one, joined at the end.
+    // The max-path order runs all the producers first, so all the large tensors are live together.
+    static void createFanOutGraph(GaudiGraph& g, unsigned numOfBranches)
+    {
+        TensorPtr in = createTensor(1);
+        in->setMemoryDescriptor(synMemoryDescriptor(true));
+        in->setMemorySectionID(MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR);
+        TensorPtr out = createTensor(1);
+        out->setMemoryDescriptor(synMemoryDescriptor(true));
+        out->setMemorySectionID(MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR + 1);
+
+        TensorPtr  source = createTensor(1);
+        TensorVector joinInputs;
+        GraphEditor::addNode(g, NodeFactory::createNode({in}, {source}, nullptr, NOP_KERNEL_NAME, "source"));
+        for (unsigned i = 0; i < numOfBranches; i++)
+        {
+            TensorPtr large = createTensor(1024 * 1024);
+            TensorPtr small = createTensor(1);
+            GraphEditor::addNode(g,
+                                 NodeFactory::createNode({source},
+                                                         {large},
+                                                         nullptr,
+                                                         NOP_KERNEL_NAME,
+                                                         "producer_" + std::to_string(i)));
+            GraphEditor::addNode(g,
+                                 NodeFactory::createNode({large},
+                                                         {small},
+                                                         nullptr,
+                                                         NOP_KERNEL_NAME,
+                                                         "consumer_" + std::to_string(i)));
+            joinInputs.push_back(small);
+        }
+        GraphEditor::addNode(g, NodeFactory::createNode(joinInputs, {out}, nullptr, NOP_KERNEL_NAME, "join"));
+    }
+
+    static void validateTopologicalOrder(const GaudiGraph& g, const NodeList& schedule)
+    {
+        ASSERT_EQ(schedule.size(), g.getNumNodes());
+        std::unordered_map<NodePtr, unsigned> position;
+        for (const NodePtr& n : schedule)
+        {
+            position.emplace(n, position.size());
+        }
+        for (const NodePtr& n : schedule)
+        {
+            for (const NodePtr& producer : g.getNodeProducers(n, Node::TENSOR_TYPE_ALL))
+            {
+                EXPECT_LT(position.at(producer), position.at(n));
+            }
+        }
+    }
+};
+
+TEST_F(MemoryAwareScheduleTest, memory_weight_reduces_peak_of_fan_out)
+{
+    static constexpr unsigned numOfBranches = 8;
+
+    GaudiGraph g;
+    createFanOutGraph(g, numOfBranches);
+
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocking = [&](const NodePtr& n) {
+        return g.getNodeProducers(n, Node::TENSOR_TYPE_ALL);
+    };
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocked = [&](const NodePtr& n) {
+        return g.getNodeConsumers(n, Node::TENSOR_TYPE_ALL);
+    };
+
+    ScopedConfigurationChange weight("MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT", "1");
+    ScopedConfigurationChange candidates("MEMORY_AWARE_SCHEDULE_CANDIDATES", "2");
+
+    MemoryAwareScheduler scheduler(&g, getBlocking, getBlocked);
+    const NodeList       maxPathSchedule = GaudiMaxPathScheduler(&g, getBlocking, getBlocked).scheduleNodes();
+    const NodeList       schedule        = scheduler.scheduleNodes();
+    validateTopologicalOrder(g, schedule);
+
+    const MemoryAwareScheduler::CandidateMetrics maxPathMetrics = scheduler.evaluate(maxPathSchedule);
+    const MemoryAwareScheduler::CandidateMetrics metrics        = scheduler.evaluate(schedule);
+    // Each large tensor is released by its consumer before the next producer runs
+    EXPECT_GE(maxPathMetrics.peakLiveBytes, numOfBranches * 1024 * 1024 * sizeof(float));
+    EXPECT_LT(metrics.peakLiveBytes, 2 * 1024 * 1024 * sizeof(float));
+    EXPECT_LE(maxPathMetrics.criticalPath, metrics.criticalPath);
+}
+
+TEST_F(MemoryAwareScheduleTest, budget_chooses_fastest_fitting_candidate)
+{
+    GaudiGraph g;
+    createFanOutGraph(g, 4);
+
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocking = [&](const NodePtr& n) {
+        return g.getNodeProducers(n, Node::TENSOR_TYPE_ALL);
+    };
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocked = [&](const NodePtr& n) {
+        return g.getNodeConsumers(n, Node::TENSOR_TYPE_ALL);
+    };
+
+    MemoryAwareScheduler scheduler(&g, getBlocking, getBlocked);
+    const NodeList       maxPathSchedule = GaudiMaxPathScheduler(&g, getBlocking, getBlocked).scheduleNodes();
+    const MemoryAwareScheduler::CandidateMetrics maxPathMetrics = scheduler.evaluate(maxPathSchedule);
+
+    {
+        // The max-path schedule fits a budget of its own peak
+        ScopedConfigurationChange budget("MEMORY_AWARE_SCHEDULE_BUDGET",
+                                         std::to_string(maxPathMetrics.peakLiveBytes));
+        const NodeList schedule = scheduler.scheduleNodes();
+        validateTopologicalOrder(g, schedule);
+        EXPECT_LE(scheduler.evaluate(schedule).criticalPath, maxPathMetrics.criticalPath);
+    }
+    {
+        ScopedConfigurationChange budget("MEMORY_AWARE_SCHEDULE_BUDGET",
+                                         std::to_string(maxPathMetrics.peakLiveBytes - 1));
+        const NodeList schedule = scheduler.scheduleNodes();
+        validateTopologicalOrder(g, schedule);
+        EXPECT_LT(scheduler.evaluate(schedule).peakLiveBytes, maxPathMetrics.peakLiveBytes);
+    }
+}
+
+TEST_F(MemoryAwareScheduleTest, scanning_one_free_node_keeps_max_path_order)
+{
+    GaudiGraph g;
+    createFanOutGraph(g, 4);
+
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocking = [&](const NodePtr& n) {
+        return g.getNodeProducers(n, Node::TENSOR_TYPE_ALL);
+    };
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocked = [&](const NodePtr& n) {
+        return g.getNodeConsumers(n, Node::TENSOR_TYPE_ALL);
+    };
+
+    ScopedConfigurationChange weight("MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT", "1");
+    ScopedConfigurationChange candidates("MEMORY_AWARE_SCHEDULE_CANDIDATES", "2");
+    ScopedConfigurationChange scanned("MEMORY_AWARE_SCHEDULE_MAX_SCANNED_NODES", "1");
+
+    // Only the first free node in the max-path order is scored, so it is always the one picked
+    MemoryAwareScheduler scheduler(&g, getBlocking, getBlocked);
+    const NodeList       maxPathSchedule = GaudiMaxPathScheduler(&g, getBlocking, getBlocked).scheduleNodes();
+    const NodeList       schedule        = scheduler.scheduleNodes();
+    validateTopologicalOrder(g, schedule);
+    EXPECT_EQ(schedule, maxPathSchedule);
+}
+
+// The graph execution schedule goes through the memory-aware scheduler when the knob is on
+TEST_F(MemoryAwareScheduleTest, graph_execution_schedule_is_memory_aware)
+{
+    static constexpr unsigned numOfBranches = 8;
+
+    ScopedConfigurationChange maxPath("ENABLE_MAX_PATH_SCHEDULE", "true");
+    ScopedConfigurationChange weight("MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT", "1");
+    ScopedConfigurationChange candidates("MEMORY_AWARE_SCHEDULE_CANDIDATES", "2");
+
+    GaudiGraph g;
+    createFanOutGraph(g, numOfBranches);
+
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocking = [&](const NodePtr& n) {
+        return g.getNodeProducers(n, Node::TENSOR_TYPE_ALL);
+    };
+    GaudiMaxPathScheduler::ConnectivityFunc getBlocked = [&](const NodePtr& n) {
+        return g.getNodeConsumers(n, Node::TENSOR_TYPE_ALL);
+    };
+    MemoryAwareScheduler scheduler(&g, getBlocking, getBlocked);
+
+    NodeList defaultSchedule;
+    {
+        ScopedConfigurationChange memoryAware("ENABLE_MEMORY_AWARE_SCHEDULE", "false");
+        const NodeVector& exeSortedNodes = g.getExeSortedNodes();
+        defaultSchedule.assign(exeSortedNodes.begin(), exeSortedNodes.end());
+    }
+    g.invalidateExecutionSchedule();
+
+    ScopedConfigurationChange memoryAware("ENABLE_MEMORY_AWARE_SCHEDULE", "true");
+    const NodeVector&         exeSortedNodes = g.getExeSortedNodes();
+    const NodeList            schedule(exeSortedNodes.begin(), exeSortedNodes.end());
+    validateTopologicalOrder(g, schedule);
+
+    EXPECT_GE(scheduler.evaluate(defaultSchedule).peakLiveBytes, numOfBranches * 1024 * 1024 * sizeof(float));
+    EXPECT_LT(scheduler.evaluate(schedule).peakLiveBytes, 2 * 1024 * 1024 * sizeof(float));
+}
+
+// A bundled node makes the graph take the default schedule, with or without the memory-aware knob
+TEST_F(MemoryAwareScheduleTest, bundled_graph_keeps_default_schedule)
+{
+    ScopedConfigurationChange maxPath("ENABLE_MAX_PATH_SCHEDULE", "true");
+    ScopedConfigurationChange weight("MEMORY_AWARE_SCHEDULE_MEMORY_WEIGHT", "1");
+    ScopedConfigurationChange candidates("MEMORY_AWARE_SCHEDULE_CANDIDATES", "2");
+
+    GaudiGraph g;
+    createFanOutGraph(g, 4);
+    const NodePtr bundled = *g.getNodes().begin();
+    bundled->getNodeAnnotation().bundleInfo.set(BundleInfo(0, BundleType::UNDEFINED, 0));
+
+    NodeList defaultSchedule;
+    {
+        ScopedConfigurationChange memoryAware("ENABLE_MEMORY_AWARE_SCHEDULE", "false");
+        const NodeVector& exeSortedNodes = g.getExeSortedNodes();
+        defaultSchedule.assign(exeSortedNodes.begin(), exeSortedNodes.end());
+    }
+    g.invalidateExecutionSchedule();
+
+    ScopedConfigurationChange memoryAware("ENABLE_MEMORY_AWARE_SCHEDULE", "true");
+    const NodeVector&         exeSortedNodes = g.getExeSortedNodes();
+    EXPECT_EQ(NodeList(exeSortedNodes.begin(), exeSortedNodes.end()), defaultSchedule);
+}
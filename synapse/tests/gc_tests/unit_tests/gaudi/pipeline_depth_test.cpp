@@ -14,12 +14,13 @@ class PipelineDepthTest : public GraphOptimizerTest
         // disabling this for test verification
         setGlobalConfForTest(GCFG_ENABLE_TPC_TENSOR_SHAPE_MANIPULATION, "false");
     }
+
+protected:
+    void runConcatReluPipeline(GaudiGraph& graph, unsigned expectedPipelineDepth);
 };
 
-TEST_F(PipelineDepthTest, concat_relu_pipeline)
+void PipelineDepthTest::runConcatReluPipeline(GaudiGraph& graph, unsigned expectedPipelineDepth)
 {
-    setGlobalConfForTest(GCFG_DEFAULT_PIPELINE_DEPTH, "3");
-
     SizeArray singleSize = {100, 100, 100, 1, 1};
     constexpr uint32_t concatNumInputs = 5;
     TensorVector       concatInputs;
@@ -40,7 +41,6 @@ TEST_F(PipelineDepthTest, concat_relu_pipeline)
 
     pTensor secondReluOut(new Tensor(4, singleSize.data(), syn_type_bf16));
 
-    GaudiGraph graph;
     unsigned int concatDim = 3;
     pNode concat = NodeFactory::createNode(concatInputs,
                                            {concatTOut},
@@ -87,8 +87,28 @@ TEST_F(PipelineDepthTest, concat_relu_pipeline)
             }
             else
             {
-                ASSERT_EQ(GCFG_DEFAULT_PIPELINE_DEPTH.value(), graph.GetNodeROIs(node)->size());
+                ASSERT_EQ(expectedPipelineDepth, graph.GetNodeROIs(node)->size());
             }
         }
     }
 }
+
+TEST_F(PipelineDepthTest, concat_relu_pipeline)
+{
+    setGlobalConfForTest(GCFG_DEFAULT_PIPELINE_DEPTH, "3");
+
+    GaudiGraph graph;
+    runConcatReluPipeline(graph, 3);
+}
+
+// The graph pipeline depth overrides the global one for this graph only
+TEST_F(PipelineDepthTest, concat_relu_graph_pipeline_depth)
+{
+    setGlobalConfForTest(GCFG_DEFAULT_PIPELINE_DEPTH, "3");
+
+    GaudiGraph graph;
+    graph.setDefaultPipelineDepth(2);
+    runConcatReluPipeline(graph, 2);
+    EXPECT_EQ(GCFG_DEFAULT_PIPELINE_DEPTH.value(), 3);
+    EXPECT_EQ(GaudiGraph().getDefaultPipelineDepth(), 3);
+}
@@ -0,0 +1,177 @@
+#include "allocators_utils.h"
+#include "code_generator.h"
+#include "compilation_hal_reader.h"
+#include "gaudi_graph.h"
+#include "graph_optimizer_test.h"
+#include "habana_global_conf.h"
+#include "habana_pass.h"
+#include "hal_reader/gaudi1/hal_reader.h"
+#include "node_factory.h"
+#include "tensor.h"
+#include "workspace_planner.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+class WorkspacePlannerGraphTest : public GraphOptimizerTest
+{
+protected:
+    void SetUp() override
+    {
+        GraphOptimizerTest::SetUp();
+        CompilationHalReader::setHalReader(GaudiHalReader::instance(synDeviceGaudi));
+    }
+
+    // Workspace tensors A, B (small) and C (large), copied out to persistent tensors, in this execution order:
+    // memset A, memset B, copy A out, memset C, copy B and C out. The heap places C after B, as the hole A leaves is
+    // too small for it, while the plan places A and C (which aren't live together) at the same address.
+    static void createGraph(GaudiGraph& g)
+    {
+        std::unique_ptr<CodeGenerator>& codeGenerator = g.getCodeGenerator();
+        codeGenerator->getWorkspaceAllocator().Init(codeGenerator->getDramSize(), codeGenerator->getDramBaseAddr());
+        codeGenerator->getSramAllocator().Init(codeGenerator->getSramSize(), codeGenerator->getSramBaseAddr());
+
+        TSize               smallSizes[] = {1024, 4};
+        TSize               largeSizes[] = {2048, 4};
+        synMemoryDescriptor persistentMemoryDesc(true);
+        uint64_t            memSecId   = MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR;
+        uint64_t            dramOffset = 0x10000;
+
+        auto createPersistent = [&](TSize* sizes) {
+            TensorPtr t(new Tensor(2, sizes, syn_type_float));
+            t->setMemoryDescriptor(persistentMemoryDesc);
+            t->setMemorySectionID(memSecId++);
+            t->setDramOffset(dramOffset);
+            dramOffset += 0x10000;
+            return t;
+        };
+
+        TensorPtr a(new Tensor(2, smallSizes, syn_type_float));
+        TensorPtr b(new Tensor(2, smallSizes, syn_type_float));
+        TensorPtr c(new Tensor(2, largeSizes, syn_type_float));
+
+        NodePtr memsetA = NodeFactory::createNode({}, {a}, nullptr, "memset", "memsetA");
+        NodePtr memsetB = NodeFactory::createNode({}, {b}, nullptr, "memset", "memsetB");
+        NodePtr copyA   = NodeFactory::createNode({a}, {createPersistent(smallSizes)}, nullptr, "memcpy", "copyA");
+        NodePtr memsetC = NodeFactory::createNode({}, {c}, nullptr, "memset", "memsetC");
+        NodePtr copyB   = NodeFactory::createNode({b}, {createPersistent(smallSizes)}, nullptr, "memcpy", "copyB");
+        NodePtr copyC   = NodeFactory::createNode({c}, {createPersistent(largeSizes)}, nullptr, "memcpy", "copyC");
+        for (const NodePtr& n : {memsetA, memsetB, copyA, memsetC, copyB, copyC})
+        {
+            ASSERT_TRUE(GraphEditor::addNode(g, n));
+        }
+        g.addControlDependency(memsetA, memsetB);
+        g.addControlDependency(memsetB, copyA);
+        g.addControlDependency(copyA, memsetC);
+        g.addControlDependency(memsetC, copyB);
+
+        setNonPersistentSectionInfo(g);
+        ASSERT_TRUE(allocateTensors(g));
+    }
+
+    struct WorkspaceTensor
+    {
+        uint64_t firstUse;
+        uint64_t lastUse;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    // The real workspace tensors, with their lifetime in execution order
+    static std::vector<WorkspaceTensor> getWorkspaceTensors(GaudiGraph& g)
+    {
+        std::map<TensorPtr, WorkspaceTensor> tensors;
+        const NodeVector&                    nodes = g.getExeSortedNodes();
+        for (uint64_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            for (const TensorPtr& operand : nodes[nodeIndex]->getOperands())
+            {
+                if (operand == nullptr) continue;
+                const TensorPtr t = operand->getRealTensor(operand);
+                if (t->isPersistent() || t->getMemorySectionID() != MEMORY_ID_RESERVED_FOR_WORKSPACE) continue;
+                EXPECT_TRUE(t->isDramOffsetSet());
+
+                auto it = tensors.find(t);
+                if (it == tensors.end())
+                {
+                    const WorkspaceTensor workspaceTensor {nodeIndex,
+                                                           nodeIndex,
+                                                           t->getDramOffset(),
+                                                           getWriteSpaceForTensor(t)};
+                    tensors.emplace(t, workspaceTensor);
+                }
+                else
+                {
+                    it->second.lastUse = nodeIndex;
+                }
+            }
+        }
+
+        std::vector<WorkspaceTensor> workspaceTensors;
+        for (const auto& [t, workspaceTensor] : tensors)
+        {
+            workspaceTensors.push_back(workspaceTensor);
+        }
+        return workspaceTensors;
+    }
+
+    static uint64_t getWorkspaceEnd(const std::vector<WorkspaceTensor>& tensors)
+    {
+        uint64_t end = 0;
+        for (const WorkspaceTensor& t : tensors)
+        {
+            end = std::max(end, t.offset + t.size);
+        }
+        return end;
+    }
+};
+
+TEST_F(WorkspacePlannerGraphTest, planned_workspace_is_valid_and_smaller)
+{
+    setGlobalConfForTest(GCFG_ENABLE_WORKSPACE_PLANNER, "false");
+    GaudiGraph defaultGraph;
+    createGraph(defaultGraph);
+    const std::vector<WorkspaceTensor> defaultTensors = getWorkspaceTensors(defaultGraph);
+    EXPECT_EQ(defaultGraph.getGraphAnnotation().workspacePlan, nullptr);
+
+    setGlobalConfForTest(GCFG_ENABLE_WORKSPACE_PLANNER, "true");
+    GaudiGraph plannedGraph;
+    createGraph(plannedGraph);
+    const std::vector<WorkspaceTensor> plannedTensors = getWorkspaceTensors(plannedGraph);
+
+    ASSERT_EQ(plannedTensors.size(), 3u);
+    ASSERT_EQ(plannedTensors.size(), defaultTensors.size());
+
+    // The plan was taken, and the tensors got its addresses
+    const std::shared_ptr<WorkspacePlanner>& plan = plannedGraph.getGraphAnnotation().workspacePlan;
+    ASSERT_NE(plan, nullptr);
+    std::vector<uint64_t> plannedAddresses;
+    for (size_t i = 0; i < plan->getIntervals().size(); ++i)
+    {
+        plannedAddresses.push_back(plan->getIntervalAddress(i));
+    }
+    std::vector<uint64_t> tensorsAddresses;
+    for (const WorkspaceTensor& t : plannedTensors)
+    {
+        tensorsAddresses.push_back(t.offset);
+    }
+    std::sort(plannedAddresses.begin(), plannedAddresses.end());
+    std::sort(tensorsAddresses.begin(), tensorsAddresses.end());
+    EXPECT_EQ(tensorsAddresses, plannedAddresses);
+
+    // No two workspace tensors that are live together overlap
+    for (unsigned i = 0; i < plannedTensors.size(); ++i)
+    {
+        for (unsigned j = i + 1; j < plannedTensors.size(); ++j)
+        {
+            const WorkspaceTensor& t1 = plannedTensors[i];
+            const WorkspaceTensor& t2 = plannedTensors[j];
+            if (t1.lastUse < t2.firstUse || t2.lastUse < t1.firstUse) continue;
+            EXPECT_TRUE(t1.offset + t1.size <= t2.offset || t2.offset + t2.size <= t1.offset)
+                << "workspace tensors " << i << " and " << j << " are live together and overlap";
+        }
+    }
+
+    EXPECT_LT(getWorkspaceEnd(plannedTensors), getWorkspaceEnd(defaultTensors));
+}
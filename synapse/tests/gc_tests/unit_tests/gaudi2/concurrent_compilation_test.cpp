@@ -0,0 +1,132 @@
+#include "compilation_config_snapshot.h"
+#include "graph_optimizer_test.h"
+#include "habana_global_conf.h"
+#include "infra/recipe/recipe_compare.hpp"
+#include "node_factory.h"
+#include "platform/gaudi2/graph_compiler/gaudi2_graph.h"
+#include "recipe_allocator.h"
+#include "tensor.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+class ConcurrentCompilationTest : public GraphOptimizerTest
+{
+protected:
+    struct CompiledGraph
+    {
+        std::unique_ptr<Gaudi2Graph>     graph;
+        std::unique_ptr<RecipeAllocator> recipeAlloc;
+        recipe_t*                        recipe = nullptr;
+    };
+
+    // GEMM followed by a TPC node, graphs of different indices have different sizes
+    static std::unique_ptr<Gaudi2Graph> createGraph(unsigned graphIdx);
+    static bool                         compile(CompiledGraph& compiled);
+};
+
+std::unique_ptr<Gaudi2Graph> ConcurrentCompilationTest::createGraph(unsigned graphIdx)
+{
+    auto g = std::make_unique<Gaudi2Graph>();
+
+    const TSize batch         = 64 * (graphIdx % 4 + 1);
+    const TSize aSizes[]      = {256, batch};
+    const TSize bSizes[]      = {128, 256};
+    const TSize gemmOutSize[] = {128, batch};
+
+    TensorPtr a       = std::make_shared<Tensor>(2U, aSizes, syn_type_bf16);
+    TensorPtr b       = std::make_shared<Tensor>(2U, bSizes, syn_type_bf16);
+    TensorPtr gemmOut = std::make_shared<Tensor>(2U, gemmOutSize, syn_type_bf16);
+    TensorPtr out     = std::make_shared<Tensor>(2U, gemmOutSize, syn_type_bf16);
+    a->setName("a");
+    b->setName("b");
+    gemmOut->setName("gemm_out");
+    out->setName("out");
+
+    synMemoryDescriptor memDesc(true);  // persistent
+    a->setDramOffset(0x1000);
+    b->setDramOffset(0x100000);
+    out->setDramOffset(0x200000);
+    for (const TensorPtr& t : {a, b, out})
+    {
+        t->setMemoryDescriptor(memDesc);
+    }
+
+    synGEMMParams gemmParams {};
+    NodePtr       gemm = NodeFactory::createNode({a, b}, {gemmOut}, &gemmParams, NodeFactory::gemmNodeTypeName, "gemm");
+    NodePtr       relu = NodeFactory::createNode({gemmOut}, {out}, nullptr, "relu_fwd_bf16", "relu");
+    EXPECT_TRUE(GraphEditor::addNode(*g, gemm));
+    EXPECT_TRUE(GraphEditor::addNode(*g, relu));
+    return g;
+}
+
+bool ConcurrentCompilationTest::compile(CompiledGraph& compiled)
+{
+    try
+    {
+        if (!compiled.graph->compile()) return false;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERR(GO_TEST, "Compilation failed: {}", e.what());
+        return false;
+    }
+    compiled.recipeAlloc = std::make_unique<RecipeAllocator>();
+    compiled.recipe      = compiled.graph->serializeDataPlane(compiled.recipeAlloc.get());
+    return compiled.recipe != nullptr;
+}
+
+TEST_F(ConcurrentCompilationTest, concurrent_compilation_matches_serial_compilation)
+{
+    constexpr unsigned NUM_GRAPHS = 16;
+
+    std::vector<CompiledGraph> serial(NUM_GRAPHS);
+    for (unsigned graphIdx = 0; graphIdx < NUM_GRAPHS; ++graphIdx)
+    {
+        serial[graphIdx].graph = createGraph(graphIdx);
+        ASSERT_TRUE(compile(serial[graphIdx])) << "serial compilation of graph " << graphIdx << " failed";
+    }
+
+    std::vector<CompiledGraph> concurrent(NUM_GRAPHS);
+    for (unsigned graphIdx = 0; graphIdx < NUM_GRAPHS; ++graphIdx)
+    {
+        concurrent[graphIdx].graph = createGraph(graphIdx);
+    }
+
+    const CompilationConfigSnapshot configBefore;
+    std::vector<char>               succeeded(NUM_GRAPHS, false);  // not vector<bool>, written by different threads
+    std::vector<std::thread>        threads;
+    for (unsigned graphIdx = 0; graphIdx < NUM_GRAPHS; ++graphIdx)
+    {
+        threads.emplace_back([&, graphIdx]() { succeeded[graphIdx] = compile(concurrent[graphIdx]); });
+    }
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_TRUE(configBefore.getChangedKnobs().empty()) << "compilation changed the global configuration";
+    for (unsigned graphIdx = 0; graphIdx < NUM_GRAPHS; ++graphIdx)
+    {
+        ASSERT_TRUE(succeeded[graphIdx]) << "concurrent compilation of graph " << graphIdx << " failed";
+        EXPECT_TRUE(RecipeCompare::compare(*serial[graphIdx].recipe, *concurrent[graphIdx].recipe, false))
+            << "recipe of graph " << graphIdx << " differs from its serial compilation";
+    }
+}
+
+TEST_F(ConcurrentCompilationTest, training_graph_keeps_data_type_selection_of_other_graphs)
+{
+    setGlobalConfForTest(GCFG_SYNAPSE_DATA_TYPE_SELECTION, "true");
+
+    Gaudi2Graph trainingGraph;
+    Gaudi2Graph inferenceGraph;
+    trainingGraph.setInferenceMode(false);
+    inferenceGraph.setInferenceMode(true);
+
+    EXPECT_FALSE(trainingGraph.isDataTypeSelectionEnabled());
+    EXPECT_TRUE(inferenceGraph.isDataTypeSelectionEnabled());
+    EXPECT_TRUE(GCFG_SYNAPSE_DATA_TYPE_SELECTION.value());
+}
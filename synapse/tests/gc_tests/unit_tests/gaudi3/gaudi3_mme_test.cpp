@@ -1,12 +1,17 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include "compilation_hal_reader.h"
 #include "graph_optimizer_test.h"
+#include "mme/mme_services.h"
+#include "scoped_configuration_change.h"
 #include "synapse_common_types.h"
 #include "tensor.h"
 #include "node_factory.h"
 #include "platform/gaudi3/graph_compiler/gaudi3_graph.h"
 #include "transpose_utils.h"
 
+#include <thread>
+
 class Gaudi3GraphTest
 : public GraphOptimizerTest
 , public testing::WithParamInterface<std::tuple<const char*, synDataType>>
@@ -301,3 +306,36 @@ TEST_F(Gaudi3GraphTest, gaudi3_mme_transpose_node_gc_test4)
 
     ASSERT_TRUE(g.compile());
 }
+
+// Transpose via gemm is disabled per graph, so the setting applies to every thread compiling the graph nodes, such as
+// the workers of the concurrent passes
+TEST_F(Gaudi3GraphTest, transpose_via_gemm_disabled_per_graph_on_all_threads)
+{
+    ScopedConfigurationChange xposeViaGemm("ENABLE_TRANSPOSE_VIA_GEMM", "true");
+
+    Gaudi3Graph   g;
+    const TSize   sizes[] = {256, 256};
+    TensorPtr     a       = TensorPtr(new Tensor(2U, sizes, syn_type_bf16));
+    TensorPtr     b       = TensorPtr(new Tensor(2U, sizes, syn_type_bf16));
+    TensorPtr     out     = TensorPtr(new Tensor(2U, sizes, syn_type_bf16));
+    synGEMMParams params {};
+    NodePtr       gemm = NodeFactory::createNode({a, b}, {out}, &params, NodeFactory::gemmNodeTypeName, "gemm");
+    ASSERT_TRUE(GraphEditor::addNode(g, gemm));
+    MMENodePtr mmeNode = std::dynamic_pointer_cast<MmeNode>(gemm);
+    ASSERT_NE(mmeNode, nullptr);
+
+    auto checkOnWorkerThread = [&]() {
+        bool        matched = false;
+        std::thread worker([&]() {
+            CompilationHalReaderSetter halReaderSetter(&g);
+            matched = MmeCommon::MmeServices::checkTransposeViaGemmPattern(mmeNode);
+        });
+        worker.join();
+        return matched;
+    };
+
+    EXPECT_TRUE(checkOnWorkerThread());
+    g.setTransposeViaGemmAllowed(false);
+    EXPECT_FALSE(checkOnWorkerThread());
+    EXPECT_TRUE(GCFG_ENABLE_TRANSPOSE_VIA_GEMM.value());
+}
@@ -0,0 +1,154 @@
+#include "brain_data.h"
+#include "compilation_hal_reader.h"
+#include "graph_optimizer_test.h"
+#include "gaudi3_graph.h"
+#include "node_factory.h"
+#include "scoped_configuration_change.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class LayeredBrainConcurrencyTest : public GraphOptimizerTest
+{
+protected:
+    struct CompiledNode
+    {
+        std::string           guid;
+        Node::eNodeType       type;
+        std::vector<TSize>    sizes;
+        std::vector<uint64_t> offsets;
+
+        bool operator==(const CompiledNode& other) const
+        {
+            return guid == other.guid && type == other.type && sizes == other.sizes && offsets == other.offsets;
+        }
+    };
+
+    // Pipeline depth and number of slices per bundle view of the final strategy
+    using StrategySummary = std::vector<uint64_t>;
+
+    struct CompiledGraph
+    {
+        std::vector<CompiledNode>                               nodes;
+        std::map<gc::layered_brain::BundleIdx, StrategySummary> strategies;
+    };
+
+    // Compiles independent chains of relu->GEMM links, each GEMM seeds a layered brain bundle. The bundles of the same
+    // chain depend on each other, the bundles of different chains don't. Returns the executed nodes with their operands
+    // geometry and allocation, and the strategy of every bundle.
+    static CompiledGraph compileGemmChains(unsigned nofChains, unsigned chainLength)
+    {
+        Gaudi3Graph                g;
+        CompilationHalReaderSetter halReaderSetter(&g);
+        SizeVector                 fmSize  = {512, 8192};
+        SizeVector                 wghSize = {512, 512};
+        unsigned                   sectionId = MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR;
+
+        auto createTensor = [&](const SizeVector& sizes, synDataType dtype, bool persistent) {
+            auto t = std::make_shared<Tensor>(sizes.size(), sizes.data(), dtype);
+            if (persistent)
+            {
+                t->setMemoryDescriptor(synMemoryDescriptor(true));
+                t->setMemorySectionID(sectionId++);
+            }
+            return t;
+        };
+
+        for (unsigned i = 0; i < nofChains; i++)
+        {
+            TensorPtr in = createTensor(fmSize, syn_type_bf16, true);
+            for (unsigned j = 0; j < chainLength; j++)
+            {
+                const std::string idx           = std::to_string(i) + "_" + std::to_string(j);
+                const bool        isLastInChain = j == chainLength - 1;
+                TensorPtr         t             = createTensor(fmSize, syn_type_bf16, false);
+                TensorPtr         wgh           = createTensor(wghSize, syn_type_bf16, true);
+                TensorPtr         out           = createTensor(fmSize, syn_type_bf16, isLastInChain);
+                synGEMMParams     gemmParams {};
+                if (!GraphEditor::addNode(g,
+                                          NodeFactory::createNode({in}, {t}, nullptr, "relu_fwd_bf16", "relu" + idx)) ||
+                    !GraphEditor::addNode(g,
+                                          NodeFactory::createNode({t, wgh},
+                                                                  {out},
+                                                                  &gemmParams,
+                                                                  NodeFactory::gemmNodeTypeName,
+                                                                  "gemm" + idx)))
+                {
+                    return {};
+                }
+                in = out;
+            }
+        }
+        if (!g.compile()) return {};
+
+        CompiledGraph compiled;
+        for (const NodePtr& node : g.getExeSortedNodes())
+        {
+            CompiledNode compiledNode {node->getGUID(), node->getNodeType(), {}, {}};
+            for (const auto* tensors : {&node->getInputs(), &node->getOutputs()})
+            {
+                for (const TensorPtr& t : *tensors)
+                {
+                    if (t == nullptr) continue;
+                    const auto sizes = t->getAllNSizesInElements();
+                    compiledNode.sizes.insert(compiledNode.sizes.end(), sizes.begin(), sizes.begin() + t->getDim());
+                    compiledNode.offsets.push_back(t->getTensorOffset());
+                }
+            }
+            compiled.nodes.push_back(std::move(compiledNode));
+        }
+        if (g.getLayeredBrainData() != nullptr)
+        {
+            for (const auto& [bundleIdx, bundleData] : g.getLayeredBrainData()->m_bundleData)
+            {
+                StrategySummary summary {bundleData.getPipelineDepth()};
+                for (unsigned bvd = 0; bvd < bundleData.getBundleViews()->getNumOfBundleViews(); bvd++)
+                {
+                    summary.push_back(bundleData.getNumOfSlicesPerBVD(bvd));
+                }
+                compiled.strategies.emplace(bundleIdx, std::move(summary));
+            }
+        }
+        return compiled;
+    }
+
+    // Compiles the graph with the serial flow and with concurrent bundle solving, and expects the same result
+    static void compareConcurrentToSerial(unsigned nofChains, unsigned chainLength)
+    {
+        ScopedConfigurationChange iterativeMode("GC_BRAIN_MODE", "1");
+        ScopedConfigurationChange enableBrain("ENABLE_LAYERED_PIPELINE_BRAIN", "true");
+
+        CompiledGraph serial;
+        {
+            ScopedConfigurationChange threads("LAYERED_BRAIN_NUM_THREADS", "1");
+            serial = compileGemmChains(nofChains, chainLength);
+        }
+        CompiledGraph concurrent;
+        {
+            ScopedConfigurationChange threads("LAYERED_BRAIN_NUM_THREADS", "4");
+            concurrent = compileGemmChains(nofChains, chainLength);
+        }
+
+        ASSERT_FALSE(serial.nodes.empty()) << "failed to compile graph";
+        ASSERT_EQ(serial.nodes.size(), concurrent.nodes.size());
+        for (unsigned i = 0; i < serial.nodes.size(); i++)
+        {
+            EXPECT_TRUE(serial.nodes[i] == concurrent.nodes[i])
+                << "node " << i << " (" << serial.nodes[i].guid << ") differs";
+        }
+
+        ASSERT_FALSE(serial.strategies.empty()) << "no layered brain bundles";
+        EXPECT_EQ(serial.strategies, concurrent.strategies);
+    }
+};
+
+TEST_F(LayeredBrainConcurrencyTest, concurrent_bundles_solving_matches_serial)
+{
+    compareConcurrentToSerial(4 /*chains*/, 1 /*chain length*/);
+}
+
+TEST_F(LayeredBrainConcurrencyTest, concurrent_dependent_bundles_solving_matches_serial)
+{
+    compareConcurrentToSerial(2 /*chains*/, 3 /*chain length*/);
+}
@@ -1,6 +1,10 @@
+#include <chrono>
 #include <memory>
+#include <random>
 #include <tuple>
 #include <gtest/gtest.h>
+#include "flat_graph.h"
+#include "scoped_configuration_change.h"
 #include "tensor.h"
 #include "node.h"
 #include "node_factory.h"
@@ -675,3 +679,186 @@ TEST_F(GraphFixture, get_intersecting_nodes3)
     EXPECT_TRUE(intersectingNodes.find(n9) != intersectingNodes.end());
     EXPECT_TRUE(intersectingNodes.find(n10) != intersectingNodes.end());
 }
+
+TEST_F(GraphFixture, flat_graph_matches_graph_queries)
+{
+    for (const char* maxReachabilityNodes : {"4096", "0"})  // with and without ancestor bitsets
+    {
+        ScopedConfigurationChange reachabilityCfg("FLAT_GRAPH_REACHABILITY_MAX_NODES", maxReachabilityNodes);
+        SimGraph                  graph(preMadeGraph);
+        const FlatGraph&          flatGraph = graph.getFlatGraph();
+
+        ASSERT_TRUE(flatGraph.isTopologicallySorted());
+        ASSERT_EQ(flatGraph.numNodes(), graph.getNumNodes());
+        ASSERT_EQ(flatGraph.numTensors(), graph.getTensors().size());
+
+        for (FlatGraph::Index nodeIdx = 0; nodeIdx < flatGraph.numNodes(); ++nodeIdx)
+        {
+            const NodePtr& node = flatGraph.node(nodeIdx);
+            EXPECT_EQ(flatGraph.nodeIndex(node), nodeIdx);
+
+            NodeSet producers;
+            for (FlatGraph::Index producerIdx : flatGraph.producers(nodeIdx))
+            {
+                EXPECT_LT(producerIdx, nodeIdx);
+                producers.insert(flatGraph.node(producerIdx));
+            }
+            EXPECT_EQ(producers, graph.getNodeProducers(node, Node::TENSOR_TYPE_ALL));
+
+            NodeSet consumers;
+            for (FlatGraph::Index consumerIdx : flatGraph.consumers(nodeIdx))
+            {
+                consumers.insert(flatGraph.node(consumerIdx));
+            }
+            EXPECT_EQ(consumers, graph.getNodeConsumers(node, Node::TENSOR_TYPE_ALL));
+
+            for (FlatGraph::Index otherIdx = 0; otherIdx < flatGraph.numNodes(); ++otherIdx)
+            {
+                EXPECT_EQ(flatGraph.isAncestor(nodeIdx, otherIdx), graph.isAncestor(node, flatGraph.node(otherIdx)));
+            }
+        }
+
+        for (const TensorPtr& t : graph.getTensors())
+        {
+            const FlatGraph::Index tensorIdx = flatGraph.tensorIndex(t);
+            ASSERT_NE(tensorIdx, FlatGraph::INVALID_IDX);
+            const FlatGraph::Index producerIdx = flatGraph.tensorProducer(tensorIdx);
+            EXPECT_EQ(producerIdx == FlatGraph::INVALID_IDX ? nullptr : flatGraph.node(producerIdx),
+                      graph.getTensorProducer(t));
+            EXPECT_EQ(flatGraph.tensorConsumers(tensorIdx).size(), graph.getNumberOfTensorConsumers(t));
+        }
+    }
+}
+
+TEST_F(GraphFixture, flat_graph_dropped_on_graph_change)
+{
+    EXPECT_TRUE(preMadeGraph.getFlatGraph().isAncestor(preMadeGraph.getFlatGraph().nodeIndex(n4),
+                                                       preMadeGraph.getFlatGraph().nodeIndex(n10)));
+
+    GraphEditor::removeNode(preMadeGraph, n7);
+    const FlatGraph& flatGraph = preMadeGraph.getFlatGraph();
+    EXPECT_EQ(flatGraph.numNodes(), 9);
+    EXPECT_EQ(flatGraph.nodeIndex(n7), FlatGraph::INVALID_IDX);
+    EXPECT_FALSE(flatGraph.isAncestor(flatGraph.nodeIndex(n4), flatGraph.nodeIndex(n10)));
+    EXPECT_TRUE(flatGraph.isAncestor(flatGraph.nodeIndex(n2), flatGraph.nodeIndex(n10)));
+}
+
+// Reference reachability, by walking the node consumers
+static bool reachesThroughConsumers(const Graph& graph, const NodePtr& source, const NodePtr& target)
+{
+    NodeSet              visited = {source};
+    std::vector<NodePtr> stack   = {source};
+    while (!stack.empty())
+    {
+        NodePtr node = stack.back();
+        stack.pop_back();
+        if (node == target) return true;
+        for (const NodePtr& consumer : graph.getNodeConsumers(node, Node::TENSOR_TYPE_ALL))
+        {
+            if (visited.insert(consumer).second) stack.push_back(consumer);
+        }
+    }
+    return false;
+}
+
+static void expectReachabilityMatchesGraph(const Graph& graph)
+{
+    for (const NodePtr& source : graph.getNodes())
+    {
+        for (const NodePtr& target : graph.getNodes())
+        {
+            EXPECT_EQ(graph.isAncestor(source, target), reachesThroughConsumers(graph, source, target))
+                << source->getNodeName() << " -> " << target->getNodeName();
+        }
+    }
+}
+
+TEST_F(GraphFixture, is_ancestor_follows_graph_edits)
+{
+    expectReachabilityMatchesGraph(preMadeGraph);
+
+    // Arc against the current topological order: n10 -> n3
+    preMadeGraph.attachNodes(n10, n3, 0, 0);
+    EXPECT_TRUE(preMadeGraph.isAncestor(n8, n3));
+    EXPECT_FALSE(preMadeGraph.isAncestor(n3, n10));
+    expectReachabilityMatchesGraph(preMadeGraph);
+
+    // New node hanging from n3
+    NodePtr tail = NodeFactory::createDebugNode(z, zz, "");
+    GraphEditor::addNode(preMadeGraph, tail);
+    EXPECT_TRUE(preMadeGraph.isAncestor(n4, tail));
+    expectReachabilityMatchesGraph(preMadeGraph);
+
+    // Removal drops paths: n4 reached n10 only through n7
+    GraphEditor::removeNode(preMadeGraph, n7);
+    EXPECT_FALSE(preMadeGraph.isAncestor(n4, n10));
+    EXPECT_TRUE(preMadeGraph.isAncestor(n2, tail));
+    expectReachabilityMatchesGraph(preMadeGraph);
+
+    // Closing a cycle n2 -> ... -> n10 -> n2, and breaking it again
+    preMadeGraph.attachNodes(n10, n2, 0, 0);
+    EXPECT_TRUE(preMadeGraph.isAncestor(n9, n6));
+    expectReachabilityMatchesGraph(preMadeGraph);
+    GraphEditor::removeNode(preMadeGraph, n9);
+    EXPECT_FALSE(preMadeGraph.isAncestor(n6, n2));
+    expectReachabilityMatchesGraph(preMadeGraph);
+}
+
+TEST_F(GraphFixture, is_ancestor_interleaved_with_edits_performance)
+{
+#ifndef NDEBUG
+    GTEST_SKIP();  // no point in measuring perf in debug mode
+    return;
+#endif
+
+    // Chain of diamonds, each edit is followed by a batch of queries, as in passes which query the graph while they
+    // fuse or insert nodes
+    const unsigned NUM_DIAMONDS             = 5000;
+    const unsigned NUM_EDITS                = 5000;
+    const unsigned QUERIES_PER_EDIT         = 20;
+    const unsigned MAX_EDITS_AND_QUERIES_MS = 5000;
+
+    SimGraph     graph;
+    NodeVector   nodes;
+    TensorVector joinInputs;
+    TensorPtr    in = TensorPtr(new Tensor(tensor_dim, &size, syn_type_single));
+    for (unsigned i = 0; i < NUM_DIAMONDS; ++i)
+    {
+        TensorPtr left  = TensorPtr(new Tensor(tensor_dim, &size, syn_type_single));
+        TensorPtr right = TensorPtr(new Tensor(tensor_dim, &size, syn_type_single));
+        TensorPtr out   = TensorPtr(new Tensor(tensor_dim, &size, syn_type_single));
+        for (const NodePtr& node : {NodeFactory::createDebugNode(in, left, ""),
+                                    NodeFactory::createDebugNode(in, right, ""),
+                                    NodeFactory::createDebugJoinNode(left, right, out, "")})
+        {
+            ASSERT_TRUE(GraphEditor::addNode(graph, node));
+            nodes.push_back(node);
+        }
+        in = out;
+    }
+
+    std::mt19937                            rng(0);
+    std::uniform_int_distribution<unsigned> nodeDist(0, nodes.size() - 1);
+    unsigned                                nofReachable = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < NUM_EDITS; ++i)
+    {
+        // Side branch from a random node, removed again on the next edit
+        const NodePtr& producer  = nodes[nodeDist(rng)];
+        TensorPtr      branchOut = TensorPtr(new Tensor(tensor_dim, &size, syn_type_single));
+        NodePtr        branch    = NodeFactory::createDebugNode(producer->getOutput(0), branchOut, "");
+        GraphEditor::addNode(graph, branch);
+        for (unsigned q = 0; q < QUERIES_PER_EDIT; ++q)
+        {
+            nofReachable += graph.isAncestor(nodes[nodeDist(rng)], nodes[nodeDist(rng)]) ? 1 : 0;
+            nofReachable += graph.isAncestor(nodes[nodeDist(rng)], branch) ? 1 : 0;
+        }
+        GraphEditor::removeNode(graph, branch);
+    }
+    const unsigned durationMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_GT(nofReachable, 0);
+    EXPECT_LE(durationMs, MAX_EDITS_AND_QUERIES_MS);
+}
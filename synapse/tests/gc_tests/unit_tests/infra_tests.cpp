@@ -1,11 +1,18 @@
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <thread>
 
 #include "infra/global_conf_manager.h"
 #include "infra/threads/thread_pool.h"
 #include "infra/threads/thread_work_item.h"
+#include "infra/threads/work_stealing_pool.h"
 #include "graph_optimizer_test.h"
 
 class InfraTest : public GraphOptimizerTest {};
@@ -143,3 +150,144 @@ TEST_F(InfraTest, thread_pool_work)
     tp.finish();
     ASSERT_EQ(count, numOfWorks);
 }
+
+TEST_F(InfraTest, work_stealing_deque_concurrent_steal)
+{
+    static const uint32_t numOfWorks   = 10000;
+    static const uint32_t numOfThieves = 4;
+
+    std::atomic<int>          count(0);
+    synapse::WorkStealingDeque deque(2);  // small capacity to exercise growing
+    std::atomic<bool>         done(false);
+
+    std::vector<std::thread> thieves;
+    for (uint32_t i = 0; i < numOfThieves; ++i)
+    {
+        thieves.emplace_back([&]() {
+            while (!done || !deque.empty())
+            {
+                if (synapse::ThreadWorkItem* wi = deque.steal())
+                {
+                    wi->call();
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < numOfWorks; ++i)
+    {
+        deque.push(new TestWorkItem(count));
+        if (i % 3 == 0)
+        {
+            if (synapse::ThreadWorkItem* wi = deque.pop())
+            {
+                wi->call();
+            }
+        }
+    }
+    while (synapse::ThreadWorkItem* wi = deque.pop())
+    {
+        wi->call();
+    }
+    done = true;
+    for (std::thread& t : thieves)
+    {
+        t.join();
+    }
+    ASSERT_EQ(count, numOfWorks);
+}
+
+TEST_F(InfraTest, work_stealing_pool_async)
+{
+    synapse::WorkStealingPool pool(4);
+
+    std::vector<std::future<uint64_t>> futures;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        futures.push_back(pool.async([i]() { return i * i; }));
+    }
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(futures[i].get(), i * i);
+    }
+
+    auto failing = pool.async([]() -> int { throw std::runtime_error("task failure"); });
+    ASSERT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST_F(InfraTest, work_stealing_pool_nested_task_groups)
+{
+    static const uint32_t numOfOuterTasks = 16;
+    static const uint32_t numOfInnerTasks = 64;
+
+    // Outer tasks wait for their inner groups on the pool threads, which requires helping while waiting
+    synapse::WorkStealingPool pool(2);
+    std::atomic<int>          count(0);
+    synapse::TaskGroup        outer(pool);
+    for (uint32_t i = 0; i < numOfOuterTasks; ++i)
+    {
+        outer.run([&]() {
+            synapse::TaskGroup inner(pool);
+            for (uint32_t j = 0; j < numOfInnerTasks; ++j)
+            {
+                inner.run([&]() { ++count; });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    ASSERT_EQ(count, numOfOuterTasks * numOfInnerTasks);
+}
+
+TEST_F(InfraTest, work_stealing_pool_task_group_exception)
+{
+    synapse::WorkStealingPool pool(4);
+    std::atomic<int>          count(0);
+    synapse::TaskGroup        group(pool);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        group.run([&, i]() {
+            ++count;
+            if (i == 5) throw std::runtime_error("task failure");
+        });
+    }
+    ASSERT_THROW(group.wait(), std::runtime_error);
+    ASSERT_EQ(count, 10);
+}
+
+TEST_F(InfraTest, work_stealing_pool_pins_to_allowed_cpus)
+{
+    const std::vector<uint32_t> allowedCpus = synapse::WorkStealingPool::getAllowedCpus();
+    ASSERT_FALSE(allowedCpus.empty());
+
+    // More workers than allowed cpus, so some of them share a cpu
+    synapse::WorkStealingPool pool(allowedCpus.size() + 2, true /*pinThreads*/);
+    std::mutex                mutex;
+    std::vector<uint32_t>     workerCpus;
+    synapse::TaskGroup        group(pool);
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        group.run([&]() {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet), 0);
+            // A pinned worker runs on a single cpu, the calling thread helping the group isn't pinned
+            if (CPU_COUNT(&cpuSet) != 1) return;
+            for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &cpuSet))
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    workerCpus.push_back(cpu);
+                }
+            }
+        });
+    }
+    group.wait();
+
+    for (uint32_t cpu : workerCpus)
+    {
+        EXPECT_TRUE(std::find(allowedCpus.begin(), allowedCpus.end(), cpu) != allowedCpus.end())
+            << "worker pinned to cpu " << cpu << " which isn't in the process affinity mask";
+    }
+}
@@ -4,8 +4,15 @@
 
 #include "memory_management/heap_allocator.h"
 #include "memory_management/multi_buckets_allocator.h"
+#include "memory_management/workspace_planner.h"
 #include "gtest/gtest.h"
 
+#include <list>
+#include <map>
+#include <optional>
+#include <random>
+#include <vector>
+
 class BucketMemoryTest : public GraphOptimizerTest
 {
 };
@@ -57,4 +64,375 @@ TEST_F(BucketMemoryTest, multi_buckets_allocation)
     // Uses the bucket that was free before
     multi.Allocate(BUCKET_SIZE / 2, ALIGNMENT);
     ASSERT_EQ(multi.GetCurrentlyUsed(), BUCKET_SIZE * 3 + 1);
-}
\ No newline at end of file
+}
+class HeapAllocatorTest : public GraphOptimizerTest
+{
+protected:
+    // The walk over the free ranges list which HeapAllocator used to do, as a reference for its indexed free ranges
+    class ReferenceHeap
+    {
+    public:
+        ReferenceHeap(uint64_t memorySize, bool cyclic, bool bestFit) : m_cyclic(cyclic), m_bestFit(bestFit)
+        {
+            m_freeRanges.push_back({0, memorySize});
+            m_candidate = m_freeRanges.begin();
+        }
+
+        Settable<deviceAddrOffset> allocate(uint64_t size, uint64_t alignment)
+        {
+            Settable<deviceAddrOffset> addr;
+            if (m_freeRanges.empty()) return addr;
+            if (!m_cyclic || m_candidate == m_freeRanges.end()) m_candidate = m_freeRanges.begin();
+
+            size       = (size + alignment - 1) / alignment * alignment;
+            auto start = m_candidate;
+            auto found = m_freeRanges.end();
+            do
+            {
+                uint64_t padded = size + padding(m_candidate->base, alignment);
+                if (m_candidate->size >= padded)
+                {
+                    if (!m_bestFit || m_candidate->size == padded)
+                    {
+                        found = m_candidate;
+                        break;
+                    }
+                    if (found == m_freeRanges.end() || m_candidate->size < found->size) found = m_candidate;
+                }
+                if (++m_candidate == m_freeRanges.end()) m_candidate = m_freeRanges.begin();
+            } while (m_candidate != start);
+            if (found == m_freeRanges.end()) return addr;
+
+            uint64_t pad = padding(found->base, alignment);
+            addr         = found->base + pad;
+            m_occupied[addr.value()] = {found->base, size + pad};
+            if (found->size == size + pad)
+            {
+                if (found == m_candidate) ++m_candidate;
+                m_freeRanges.erase(found);
+            }
+            else
+            {
+                found->base += size + pad;
+                found->size -= size + pad;
+            }
+            return addr;
+        }
+
+        void free(deviceAddrOffset addr)
+        {
+            Range allocation = m_occupied.at(addr);
+            m_occupied.erase(addr);
+            uint64_t allocationEnd = allocation.base + allocation.size;
+
+            auto next = m_freeRanges.begin();
+            while (next != m_freeRanges.end() && next->base < allocationEnd)
+                ++next;
+            auto prev = next == m_freeRanges.begin() ? m_freeRanges.end() : std::prev(next);
+            bool withPrev = prev != m_freeRanges.end() && prev->base + prev->size == allocation.base;
+            bool withNext = next != m_freeRanges.end() && next->base == allocationEnd;
+            if (withPrev)
+            {
+                prev->size += allocation.size;
+                if (withNext)
+                {
+                    prev->size += next->size;
+                    if (next == m_candidate) ++m_candidate;
+                    m_freeRanges.erase(next);
+                }
+            }
+            else if (withNext)
+            {
+                next->base -= allocation.size;
+                next->size += allocation.size;
+            }
+            else
+            {
+                m_freeRanges.insert(next, allocation);
+            }
+        }
+
+        const std::list<Range>& getFreeRanges() const { return m_freeRanges; }
+
+    private:
+        static uint64_t padding(uint64_t base, uint64_t alignment)
+        {
+            return base % alignment == 0 ? 0 : alignment - base % alignment;
+        }
+
+        bool                             m_cyclic;
+        bool                             m_bestFit;
+        std::list<Range>                 m_freeRanges;
+        std::list<Range>::iterator       m_candidate;
+        std::map<deviceAddrOffset, Range> m_occupied;
+    };
+
+    static void runRandomTrace(bool cyclic, bool bestFit)
+    {
+        static constexpr uint64_t MEMORY_SIZE = 64 * 1024 * 1024;
+        static constexpr unsigned NUM_OPS     = 20000;
+
+        HeapAllocator allocator("HeapAllocatorTest", 0, cyclic);
+        allocator.setBestFitAllocation(bestFit);
+        allocator.Init(MEMORY_SIZE);
+        ReferenceHeap reference(MEMORY_SIZE, cyclic, bestFit);
+
+        std::mt19937                          gen(cyclic * 2 + bestFit);
+        std::uniform_int_distribution<uint64_t> smallSize(1, 16 * 1024);
+        std::uniform_int_distribution<uint64_t> largeSize(64 * 1024, 2 * 1024 * 1024);
+        const uint64_t                        alignments[] = {1, 64, 128, 4096};
+        std::vector<deviceAddrOffset>         allocated;
+
+        for (unsigned op = 0; op < NUM_OPS; op++)
+        {
+            if (!allocated.empty() && gen() % 5 < 2)
+            {
+                size_t           index = gen() % allocated.size();
+                deviceAddrOffset addr  = allocated[index];
+                allocated[index]       = allocated.back();
+                allocated.pop_back();
+                allocator.Free(addr);
+                reference.free(addr);
+                continue;
+            }
+
+            uint64_t size      = gen() % 10 == 0 ? largeSize(gen) : smallSize(gen);
+            uint64_t alignment = alignments[gen() % 4];
+            auto     addr      = allocator.Allocate(size, alignment, 0, true);
+            auto     expected  = reference.allocate(size, alignment);
+            ASSERT_EQ(addr.is_set(), expected.is_set()) << "op " << op;
+            if (!addr.is_set()) continue;
+            ASSERT_EQ(addr.value(), expected.value()) << "op " << op;
+            allocated.push_back(addr.value());
+        }
+
+        auto freeRanges = allocator.getFreeRanges();
+        ASSERT_EQ(freeRanges.size(), reference.getFreeRanges().size());
+        uint64_t maxFree = 0;
+        auto     refIt   = reference.getFreeRanges().begin();
+        for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it, ++refIt)
+        {
+            EXPECT_EQ(it->base, refIt->base);
+            EXPECT_EQ(it->size, refIt->size);
+            maxFree = std::max(maxFree, refIt->size);
+        }
+        EXPECT_EQ(allocator.getMaxFreeContiguous(), maxFree);
+
+        for (deviceAddrOffset addr : allocated)
+        {
+            allocator.Free(addr);
+        }
+        EXPECT_EQ(allocator.GetCurrentlyUsed(), 0u);
+        EXPECT_EQ(allocator.getMaxFreeContiguous(), MEMORY_SIZE);
+    }
+};
+
+TEST_F(HeapAllocatorTest, first_fit_cyclic_matches_list_walk)
+{
+    runRandomTrace(true, false);
+}
+
+TEST_F(HeapAllocatorTest, first_fit_matches_list_walk)
+{
+    runRandomTrace(false, false);
+}
+
+TEST_F(HeapAllocatorTest, best_fit_matches_list_walk)
+{
+    runRandomTrace(true, true);
+}
+
+TEST_F(HeapAllocatorTest, requested_ranges_and_clone)
+{
+    static constexpr uint64_t MEMORY_SIZE = 1024 * 1024;
+
+    HeapAllocator allocator("HeapAllocatorTest");
+    allocator.Init(MEMORY_SIZE);
+    ASSERT_TRUE(allocator.allocateReqRange({4096, 4096}, 0));
+    ASSERT_FALSE(allocator.allocateReqRange({6144, 4096}, 0));
+    auto addr = allocator.Allocate(1024, 128, 0, false, 16384);
+    ASSERT_TRUE(addr.is_set());
+    EXPECT_EQ(addr.value(), 16384u);
+
+    auto start = allocator.GetStartOfFreeRangeContaningOffset(12288);
+    ASSERT_TRUE(start.is_set());
+    EXPECT_EQ(start.value(), 8192u);
+    EXPECT_FALSE(allocator.GetStartOfFreeRangeContaningOffset(5000).is_set());
+
+    // The clone has its own free ranges
+    std::unique_ptr<MemoryAllocator> clone = allocator.Clone();
+    auto cloneAddr = clone->Allocate(8192, 128);
+    auto addr2     = allocator.Allocate(8192, 128);
+    ASSERT_TRUE(cloneAddr.is_set());
+    ASSERT_TRUE(addr2.is_set());
+    EXPECT_EQ(cloneAddr.value(), addr2.value());
+    clone->Free(cloneAddr.value());
+    EXPECT_TRUE(allocator.IsAllocated(addr2.value()));
+    EXPECT_FALSE(clone->IsAllocated(cloneAddr.value()));
+}
+
+class WorkspacePlannerTest : public GraphOptimizerTest
+{
+protected:
+    static constexpr uint64_t MEMORY_SIZE = 1ULL << 32;
+    static constexpr uint64_t BASE        = 0x1000;
+
+    struct Op
+    {
+        bool     isAlloc;
+        uint64_t sizeOrId;  // The size of an allocation, or the index of the freed allocation
+    };
+
+    // Runs the ops on a heap with the planner recording, returns the peak of the heap
+    static uint64_t
+    record(WorkspacePlanner& planner, const std::vector<Op>& ops, uint64_t alignment, deviceAddrOffset base = BASE)
+    {
+        HeapAllocator allocator("WorkspacePlannerTest", 0, false);
+        allocator.Init(MEMORY_SIZE, base);
+        planner.startRecording();
+
+        std::vector<deviceAddrOffset> addresses;
+        uint64_t                      peakEnd = base;
+        for (const Op& op : ops)
+        {
+            if (op.isAlloc)
+            {
+                auto addr = allocator.Allocate(op.sizeOrId, alignment);
+                EXPECT_TRUE(addr.is_set());
+                planner.recordAllocation(op.sizeOrId, alignment, 0, addr.value());
+                addresses.push_back(addr.value());
+                peakEnd = std::max(peakEnd, addr.value() + op.sizeOrId);
+            }
+            else
+            {
+                allocator.Free(addresses[op.sizeOrId]);
+                planner.recordFree(addresses[op.sizeOrId]);
+            }
+        }
+        return peakEnd - base;
+    }
+
+    static void validatePlan(const WorkspacePlanner& planner, uint64_t alignment, deviceAddrOffset base = BASE)
+    {
+        const auto& intervals = planner.getIntervals();
+        for (size_t i = 0; i < intervals.size(); i++)
+        {
+            const deviceAddrOffset addr = planner.getIntervalAddress(i);
+            EXPECT_EQ(addr % alignment, 0u);
+            EXPECT_GE(addr, base);
+            EXPECT_LE(addr + intervals[i].size, base + planner.getPlannedPeak());
+            for (size_t j = i + 1; j < intervals.size(); j++)
+            {
+                const bool liveTogether = intervals[i].start < intervals[j].end && intervals[j].start < intervals[i].end;
+                if (!liveTogether) continue;
+                const deviceAddrOffset otherAddr = planner.getIntervalAddress(j);
+                EXPECT_TRUE(addr + intervals[i].size <= otherAddr || otherAddr + intervals[j].size <= addr)
+                    << "intervals " << i << " and " << j << " overlap";
+            }
+        }
+        EXPECT_GE(planner.getPlannedPeak(), planner.getLowerBound());
+    }
+
+    // Runs the ops again on a heap at the addresses of the plan, which it must reproduce
+    static void
+    replay(WorkspacePlanner& planner, const std::vector<Op>& ops, uint64_t alignment, deviceAddrOffset base = BASE)
+    {
+        HeapAllocator allocator("WorkspacePlannerTest", 0, false);
+        allocator.Init(MEMORY_SIZE, base);
+        planner.startReplay();
+
+        std::vector<deviceAddrOffset> addresses;
+        for (const Op& op : ops)
+        {
+            if (op.isAlloc)
+            {
+                const std::optional<deviceAddrOffset> planned = planner.getPlannedAddress(op.sizeOrId, alignment, 0);
+                ASSERT_TRUE(planned.has_value());
+                auto addr = allocator.AllocateAt(op.sizeOrId, alignment, 0, *planned);
+                ASSERT_TRUE(addr.is_set());
+                EXPECT_EQ(addr.value(), *planned);
+                addresses.push_back(addr.value());
+            }
+            else
+            {
+                allocator.Free(addresses[op.sizeOrId]);
+            }
+        }
+        EXPECT_FALSE(planner.getPlannedAddress(1, alignment, 0).has_value());
+    }
+};
+
+TEST_F(WorkspacePlannerTest, plan_reaches_lower_bound_of_fragmenting_trace)
+{
+    // The heap places C after B, as A's hole is too small for it
+    WorkspacePlanner planner;
+    uint64_t         heapPeak = record(planner,
+                                       {{true, 1024} /* A */,
+                                        {true, 1024} /* B */,
+                                        {false, 0},
+                                        {true, 2048} /* C */,
+                                        {false, 1},
+                                        {false, 2}},
+                                       128);
+    EXPECT_EQ(heapPeak, 4096u);
+
+    ASSERT_TRUE(planner.plan(BASE, 0, 100));
+    EXPECT_EQ(planner.getPlannedPeak(), 3072u);
+    EXPECT_EQ(planner.getLowerBound(), 3072u);
+    validatePlan(planner, 128);
+
+    // A and C aren't live together, B is live with both of them
+    EXPECT_FALSE(planner.plan(BASE, 0, 1));
+}
+
+TEST_F(WorkspacePlannerTest, replay_from_zero_base)
+{
+    // The first planned interval is at the base, which is a valid address to replay
+    const std::vector<Op> ops = {{true, 1024}, {true, 1024}, {false, 0}, {true, 2048}, {false, 1}, {false, 2}};
+    WorkspacePlanner      planner;
+    record(planner, ops, 128, 0);
+    ASSERT_TRUE(planner.plan(0, 0, 100));
+    validatePlan(planner, 128, 0);
+
+    bool isBasePlanned = false;
+    for (size_t i = 0; i < planner.getIntervals().size(); i++)
+    {
+        isBasePlanned |= (planner.getIntervalAddress(i) == 0);
+    }
+    EXPECT_TRUE(isBasePlanned);
+
+    replay(planner, ops, 128, 0);
+}
+
+TEST_F(WorkspacePlannerTest, random_trace_plan_and_replay)
+{
+    static constexpr uint64_t ALIGNMENT = 256;
+    static constexpr unsigned NUM_OPS   = 2000;
+
+    std::mt19937                            gen(0);
+    std::uniform_int_distribution<uint64_t> size(1, 64 * 1024);
+    std::vector<Op>                         ops;
+    std::vector<uint64_t>                   live;
+    uint64_t                                numAllocs = 0;
+    for (unsigned i = 0; i < NUM_OPS; i++)
+    {
+        if (live.empty() || gen() % 2 == 0)
+        {
+            ops.push_back({true, size(gen)});
+            live.push_back(numAllocs++);
+        }
+        else
+        {
+            const size_t idx = gen() % live.size();
+            ops.push_back({false, live[idx]});
+            live.erase(live.begin() + idx);
+        }
+    }
+
+    WorkspacePlanner planner;
+    record(planner, ops, ALIGNMENT);
+    ASSERT_TRUE(planner.plan(BASE, 8, NUM_OPS * NUM_OPS));
+    validatePlan(planner, ALIGNMENT);
+
+    replay(planner, ops, ALIGNMENT);
+}
@@ -275,4 +275,27 @@ INSTANTIATE_TEST_SUITE_P(concat_dynamic_shape,
                                             ::testing::Values(std::vector<unsigned>(7, 4)),
                                             ::testing::Values(std::vector<synDataType>(1, syn_type_bf16)),
                                             ::testing::Values(std::vector<unsigned>(1, 4)),
-                                            ::testing::Values(synDeviceGaudi, synDeviceGaudi2, synDeviceGaudi3)));
\ No newline at end of file
+                                            ::testing::Values(synDeviceGaudi, synDeviceGaudi2, synDeviceGaudi3)));
+
+class SynOpValidatorDataTypeSelectionTest : public SynOpValidatorTest
+{
+};
+
+// Operands without a data type are valid only when the validated op's graph selects the data types, regardless of
+// the global data type selection setting
+TEST_P(SynOpValidatorDataTypeSelectionTest, undefined_dtype_validation)
+{
+    auto params = makeValidationContext();
+    ASSERT_EQ(OpValidator::validateOp(m_guid.c_str(), params, m_device), ValidationResult::INCOMPATIBLE_DATA_TYPE);
+    params.setDataTypeSelectionEnabled(true);
+    ASSERT_EQ(OpValidator::validateOp(m_guid.c_str(), params, m_device), ValidationResult::SUCCESS);
+}
+
+INSTANTIATE_TEST_SUITE_P(conv2d,
+                         SynOpValidatorDataTypeSelectionTest,
+                         ::testing::Combine(::testing::Values(NodeFactory::convolutionNodeTypeName),
+                                            ::testing::Values(std::vector<synDataType>(2, syn_type_na)),
+                                            ::testing::Values(std::vector<unsigned>(2, 4)),
+                                            ::testing::Values(std::vector<synDataType>(1, syn_type_na)),
+                                            ::testing::Values(std::vector<unsigned>(1, 4)),
+                                            ::testing::Values(synDeviceGaudi, synDeviceGaudi2, synDeviceGaudi3)));
@@ -3,7 +3,13 @@
 //
 
 #include "pass_manager_test.h"
+#include "compilation_profiler.h"
 #include "gaudi_graph.h"
+#include "graph_arena.h"
+#include "graph_editor.h"
+#include "scoped_configuration_change.h"
+
+#include <atomic>
 
 void PassManagerTest::assertExecutionOrder(const PassManager& passManager, const std::vector<PassId>& expExecOrder)
 {
@@ -403,3 +409,245 @@ TEST_F(PassManagerTest, priority_with_predicates)
 
     assertExecutionOrder(passManager, {PASS_A_ID, PASS_B_ID, PASS_A_ID, PASS_C_ID, PASS_D_ID, PASS_A_ID, PASS_D_ID});
 }
+
+/*
+ * A adds a node, B removes it and C turns on A's predicate, so A re-runs and adds another node.
+ * Every execution is expected in the compilation profile, with its graph changes.
+ */
+TEST_F(PassManagerTest, compilation_profile_records_pass_executions)
+{
+    ScopedConfigurationChange enableProfile("ENABLE_COMPILATION_PROFILE", "true");
+
+    PassA*      passA = new PassA();
+    PassB*      passB = new PassB();
+    PassC*      passC = new PassC();
+    PassManager passManager;
+    GaudiGraph  g;
+
+    NodePtr addedNode;
+    passA->setApply([&g, &addedNode]() mutable -> void {
+        const TSize sizes[] = {64};
+        TensorPtr   in      = std::make_shared<Tensor>(1, sizes, syn_type_single);
+        TensorPtr   out     = std::make_shared<Tensor>(1, sizes, syn_type_single);
+        addedNode           = NodeFactory::createNode({in}, {out}, nullptr, NodeFactory::memcpyNodeTypeName, "memcpy");
+        GraphEditor::addNode(g, addedNode);
+    });
+    passB->setApply([&g, &addedNode]() mutable -> void { GraphEditor::removeNode(g, addedNode); });
+    passC->setApply([&passManager]() mutable -> void { passManager.turnOnPredicate(PREDICATE_1_ID); });
+
+    passManager.registerPass(pPass(passA));
+    passManager.registerPass(pPass(passB));
+    passManager.registerPass(pPass(passC));
+    ASSERT_TRUE(passManager.run(g));
+    assertExecutionOrder(passManager, {PASS_A_ID, PASS_B_ID, PASS_C_ID, PASS_A_ID});
+
+    const CompilationProfiler* profile = passManager.getCompilationProfile();
+    ASSERT_NE(profile, nullptr);
+    const auto executions = profile->getExecutions();
+    ASSERT_EQ(executions.size(), 4);
+
+    EXPECT_EQ(executions[0].id, PASS_A_ID);
+    EXPECT_EQ(executions[0].runIdx, 0);
+    EXPECT_EQ(executions[0].nodesAdded, 1);
+    EXPECT_EQ(executions[0].tensorsAdded, 2);
+    EXPECT_EQ(executions[1].id, PASS_B_ID);
+    EXPECT_EQ(executions[1].nodesRemoved, 1);
+    EXPECT_EQ(executions[2].id, PASS_C_ID);
+    EXPECT_EQ(executions[2].nodesAdded + executions[2].nodesRemoved, 0);
+    EXPECT_EQ(executions[3].id, PASS_A_ID);
+    EXPECT_EQ(executions[3].runIdx, 1);
+    EXPECT_EQ(executions[3].nodesAdded, 1);
+    // Passes run serially, so each execution starts after the previous one ended
+    for (unsigned i = 0; i < executions.size(); i++)
+    {
+        if (i > 0)
+        {
+            EXPECT_GE(executions[i].startUs, executions[i - 1].startUs + executions[i - 1].wallUs);
+        }
+    }
+
+    const auto trace = profile->toChromeTrace();
+    EXPECT_EQ(trace["traceEvents"].size(), 4);
+    EXPECT_EQ(trace["traceEvents"][0]["ph"], "X");
+
+    const auto summary = profile->toSummary();
+    EXPECT_EQ(summary["total"]["runs"], 4);
+    EXPECT_EQ(summary["total"]["nodesAdded"], 2);
+    EXPECT_EQ(summary["passes"].size(), 3);
+    for (const auto& passSummary : summary["passes"])
+    {
+        EXPECT_EQ(passSummary["runs"], passSummary["pass"] == passA->getName() ? 2 : 1);
+    }
+}
+
+TEST_F(PassManagerTest, graph_arena_backs_objects_created_by_passes)
+{
+    ScopedConfigurationChange enableArena("ENABLE_GRAPH_ARENA", "true");
+
+    const TSize sizes[] = {64};
+    TensorPtr   origTensor = std::make_shared<Tensor>(1, sizes, syn_type_single);
+    TensorPtr   clonedTensor;
+    {
+        PassA*      passA = new PassA();
+        PassManager passManager;
+        GaudiGraph  g;
+        passA->setApply([&origTensor, &clonedTensor]() mutable -> void { clonedTensor = origTensor->clone(); });
+        passManager.registerPass(pPass(passA));
+        ASSERT_TRUE(passManager.run(g));
+        EXPECT_EQ(GraphArena::current(), nullptr);
+
+        const GraphArena* arena = g.getArena();
+        ASSERT_NE(arena, nullptr);
+        const uint64_t nofAllocations = arena->getNumAllocations();
+        EXPECT_GE(nofAllocations, 1);
+        EXPECT_GT(arena->getBytesInUse(), sizeof(Tensor));
+
+        // Outside of a compilation objects come from the heap
+        TensorPtr heapClone = origTensor->clone();
+        EXPECT_EQ(arena->getNumAllocations(), nofAllocations);
+    }
+
+    // The clone keeps the arena alive after the graph is gone
+    ASSERT_NE(clonedTensor, nullptr);
+    EXPECT_EQ(clonedTensor->getDim(), 1);
+    EXPECT_EQ(clonedTensor->getSizeInElements(0), 64);
+}
+
+class ReadOnlyTestPass : public Pass
+{
+public:
+    ReadOnlyTestPass(std::string_view                  name,
+                     PassId                            id,
+                     PassIDSet                         dependencySet,
+                     std::atomic<unsigned>&            nofApplies,
+                     std::function<void(HabanaGraph&)> apply = nullptr)
+    : Pass(name, id, PASS_DEF_PRIO, {}, dependencySet), m_nofApplies(nofApplies), m_apply(std::move(apply))
+    {
+    }
+
+    bool Apply(HabanaGraph& g) const override
+    {
+        m_nofApplies++;
+        if (m_apply)
+        {
+            m_apply(g);
+        }
+        return true;
+    }
+
+    bool isGraphReadOnly() const override { return true; }
+
+    pPass create() const override
+    {
+        return pPass(new ReadOnlyTestPass(getName(), getId(), getDependencySet(), m_nofApplies, m_apply));
+    }
+
+private:
+    std::atomic<unsigned>&            m_nofApplies;
+    std::function<void(HabanaGraph&)> m_apply;
+};
+
+/*
+ * B is marked read-only but adds a node. It is rejected whether it runs with A concurrently or alone.
+ */
+TEST_F(PassManagerTest, read_only_pass_editing_graph_is_rejected)
+{
+    auto addNode = [](HabanaGraph& g) {
+        const TSize sizes[] = {64};
+        TensorPtr   in      = std::make_shared<Tensor>(1, sizes, syn_type_single);
+        TensorPtr   out     = std::make_shared<Tensor>(1, sizes, syn_type_single);
+        GraphEditor::addNode(g,
+                             NodeFactory::createNode({in}, {out}, nullptr, NodeFactory::memcpyNodeTypeName, "memcpy"));
+    };
+
+    for (const char* numThreads : {"1", "4"})
+    {
+        ScopedConfigurationChange threads("PARALLEL_PASSES_NUM_THREADS", numThreads);
+        std::atomic<unsigned>     nofAppliesA = 0;
+        std::atomic<unsigned>     nofAppliesB = 0;
+
+        PassManager passManager;
+        passManager.registerPass(pPass(new ReadOnlyTestPass("A", PASS_A_ID, {}, nofAppliesA)));
+        passManager.registerPass(pPass(new ReadOnlyTestPass("B", PASS_B_ID, {}, nofAppliesB, addNode)));
+
+        GaudiGraph g;
+        EXPECT_FALSE(passManager.run(g)) << "with " << numThreads << " threads";
+        EXPECT_EQ(nofAppliesB, 1);
+    }
+}
+
+namespace
+{
+struct CompiledNode
+{
+    std::string           guid;
+    Node::eNodeType       type;
+    std::vector<uint64_t> tensorsSizes;
+    std::vector<uint64_t> tensorsOffsets;
+
+    bool operator==(const CompiledNode& other) const
+    {
+        return guid == other.guid && type == other.type && tensorsSizes == other.tensorsSizes &&
+               tensorsOffsets == other.tensorsOffsets;
+    }
+};
+
+// Returns the executed nodes of a compiled graph and their tensors allocation
+std::vector<CompiledNode> getCompiledNodes(const HabanaGraph& g)
+{
+    std::vector<CompiledNode> compiled;
+    for (const NodePtr& node : g.getExeSortedNodes())
+    {
+        CompiledNode compiledNode {node->getGUID(), node->getNodeType(), {}, {}};
+        for (const auto* tensors : {&node->getInputs(), &node->getOutputs()})
+        {
+            for (const TensorPtr& t : *tensors)
+            {
+                if (t == nullptr) continue;
+                compiledNode.tensorsSizes.push_back(t->getTotalSizeInBytes());
+                compiledNode.tensorsOffsets.push_back(t->getTensorOffset());
+            }
+        }
+        compiled.push_back(std::move(compiledNode));
+    }
+    return compiled;
+}
+
+// Compiles a chain of TPC nodes with the real passes and returns the executed nodes and their tensors allocation
+std::vector<CompiledNode> compileChain()
+{
+    GaudiGraph  g;
+    const TSize sizes[] = {256, 64};
+    TensorPtr   in      = std::make_shared<Tensor>(2, sizes, syn_type_single);
+    in->setMemoryDescriptor(synMemoryDescriptor(true));
+    in->setMemorySectionID(MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR);
+    TensorPtr relu = std::make_shared<Tensor>(2, sizes, syn_type_single);
+    TensorPtr neg  = std::make_shared<Tensor>(2, sizes, syn_type_single);
+    TensorPtr out  = std::make_shared<Tensor>(2, sizes, syn_type_single);
+    out->setMemoryDescriptor(synMemoryDescriptor(true));
+    out->setMemorySectionID(MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR + 1);
+
+    GraphEditor::addNode(g, NodeFactory::createNode({in}, {relu}, nullptr, "relu_fwd_f32", "relu"));
+    GraphEditor::addNode(g, NodeFactory::createNode({relu}, {neg}, nullptr, "neg_fwd_f32", "neg"));
+    GraphEditor::addNode(g, NodeFactory::createNode({relu, neg}, {out}, nullptr, "add_fwd_f32", "add"));
+    if (!g.compile()) return {};
+    return getCompiledNodes(g);
+}
+
+}  // anonymous namespace
+
+TEST_F(PassManagerTest, concurrent_and_serial_passes_compile_identical_graphs)
+{
+    std::vector<CompiledNode> serial;
+    {
+        ScopedConfigurationChange threads("PARALLEL_PASSES_NUM_THREADS", "1");
+        serial = compileChain();
+    }
+    std::vector<CompiledNode> concurrent;
+    {
+        ScopedConfigurationChange threads("PARALLEL_PASSES_NUM_THREADS", "4");
+        concurrent = compileChain();
+    }
+    ASSERT_FALSE(serial.empty());
+    EXPECT_TRUE(serial == concurrent);
+}
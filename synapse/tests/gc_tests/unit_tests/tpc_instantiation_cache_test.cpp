@@ -0,0 +1,165 @@
+#include "gaudi_graph.h"
+#include "graph_optimizer_test.h"
+#include "habana_global_conf.h"
+#include "habana_nodes/tpc_instantiation_cache.h"
+#include "node_factory.h"
+#include "tensor.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+class TpcInstantiationCacheTest : public GraphOptimizerTest
+{
+protected:
+    static NodePtr createAndInitAddNode(GaudiGraph& g, TSize* sizes, unsigned dim)
+    {
+        TensorPtr in1(new Tensor(dim, sizes, syn_type_single));
+        TensorPtr in2(new Tensor(dim, sizes, syn_type_single));
+        TensorPtr out(new Tensor(dim, sizes, syn_type_single));
+        NodePtr   n = NodeFactory::createNode({in1, in2}, {out}, nullptr, "add_f32", "add");
+        GraphEditor::addNode(g, n);
+        dynamic_cast<TPCNode*>(n.get())->init(tpc_lib_api::DEVICE_ID_GAUDI, nullptr, g.getNextTPCKernelUniqueId());
+        return n;
+    }
+
+    static void expectSameKernel(const NodePtr& a, const NodePtr& b)
+    {
+        const KernelInfo infoA = dynamic_cast<TPCNode*>(a.get())->getKernelInfo();
+        const KernelInfo infoB = dynamic_cast<TPCNode*>(b.get())->getKernelInfo();
+        ASSERT_NE(infoA.kernelBinary, nullptr);
+        ASSERT_NE(infoB.kernelBinary, nullptr);
+        ASSERT_EQ(infoA.kernelSize, infoB.kernelSize);
+        // Each node owns its copy of the kernel
+        EXPECT_NE(infoA.kernelBinary, infoB.kernelBinary);
+        EXPECT_EQ(std::memcmp(infoA.kernelBinary, infoB.kernelBinary, infoA.kernelSize), 0);
+
+        const auto& instA = dynamic_cast<TPCNode*>(a.get())->getInstance();
+        const auto& instB = dynamic_cast<TPCNode*>(b.get())->getInstance();
+        EXPECT_EQ(instA.indexSpaceRank, instB.indexSpaceRank);
+        EXPECT_EQ(std::memcmp(instA.indexSpaceGeometry, instB.indexSpaceGeometry, sizeof(instA.indexSpaceGeometry)), 0);
+        EXPECT_EQ(instA.kernel.paramsNr, instB.kernel.paramsNr);
+        EXPECT_EQ(instA.auxiliaryTensorNr, instB.auxiliaryTensorNr);
+    }
+};
+
+TEST_F(TpcInstantiationCacheTest, identical_nodes_share_instantiation)
+{
+    TpcInstantiationCache& cache = TpcInstantiationCache::instance();
+    cache.clear();
+    ASSERT_TRUE(cache.isEnabled());
+
+    GaudiGraph g;
+    TSize      sizes[] = {64, 32, 2};
+    NodePtr    first   = createAndInitAddNode(g, sizes, 3);
+
+    const TpcInstantiationCache::Stats before = cache.getStats();
+    NodePtr                            second = createAndInitAddNode(g, sizes, 3);
+    const TpcInstantiationCache::Stats after  = cache.getStats();
+
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_GT(after.sizeInBytes, 0U);
+    expectSameKernel(first, second);
+
+    // A different geometry is a different instantiation
+    TSize   otherSizes[] = {128, 32, 2};
+    NodePtr third        = createAndInitAddNode(g, otherSizes, 3);
+    EXPECT_EQ(cache.getStats().misses, after.misses + 1);
+}
+
+TEST_F(TpcInstantiationCacheTest, disabled_cache)
+{
+    setGlobalConfForTest(GCFG_TPC_INSTANTIATION_CACHE_MAX_ENTRIES, "0");
+    TpcInstantiationCache& cache = TpcInstantiationCache::instance();
+    ASSERT_FALSE(cache.isEnabled());
+
+    GaudiGraph g;
+    TSize      sizes[] = {64, 32, 2};
+    createAndInitAddNode(g, sizes, 3);
+
+    const TpcInstantiationCache::Stats before = cache.getStats();
+    createAndInitAddNode(g, sizes, 3);
+    const TpcInstantiationCache::Stats after = cache.getStats();
+    EXPECT_EQ(after.hits, before.hits);
+    EXPECT_EQ(after.misses, before.misses);
+}
+
+TEST_F(TpcInstantiationCacheTest, memory_size_limit)
+{
+    TpcInstantiationCache& cache = TpcInstantiationCache::instance();
+    cache.clear();
+    // Any instantiation is larger than the limit, so none is kept
+    setGlobalConfForTest(GCFG_TPC_INSTANTIATION_CACHE_MAX_MEMORY_SIZE, "0");
+
+    GaudiGraph g;
+    TSize      sizes[] = {64, 32, 2};
+    createAndInitAddNode(g, sizes, 3);
+
+    const TpcInstantiationCache::Stats before = cache.getStats();
+    createAndInitAddNode(g, sizes, 3);
+    const TpcInstantiationCache::Stats after = cache.getStats();
+    EXPECT_EQ(after.hits, before.hits);
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.sizeInBytes, 0U);
+}
+
+TEST_F(TpcInstantiationCacheTest, disk_cache_survives_clear)
+{
+    const std::string folder = std::filesystem::temp_directory_path() /
+                               ("tpc_instantiation_cache_test_" + std::to_string(getpid()));
+    setGlobalConfForTest(GCFG_TPC_INSTANTIATION_CACHE_PATH, folder);
+
+    TpcInstantiationCache& cache = TpcInstantiationCache::instance();
+    cache.clear();
+
+    GaudiGraph g;
+    TSize      sizes[] = {48, 16};
+    NodePtr    first   = createAndInitAddNode(g, sizes, 2);
+
+    // Drops the in-memory entries, as a new process would start with
+    cache.clear();
+
+    const TpcInstantiationCache::Stats before = cache.getStats();
+    NodePtr                            second = createAndInitAddNode(g, sizes, 2);
+    const TpcInstantiationCache::Stats after  = cache.getStats();
+    EXPECT_EQ(after.diskHits, before.diskHits + 1);
+    expectSameKernel(first, second);
+
+    std::filesystem::remove_all(folder);
+}
+
+TEST_F(TpcInstantiationCacheTest, disk_cache_size_limit)
+{
+    const std::string folder = std::filesystem::temp_directory_path() /
+                               ("tpc_instantiation_cache_size_test_" + std::to_string(getpid()));
+    setGlobalConfForTest(GCFG_TPC_INSTANTIATION_CACHE_PATH, folder);
+    // Any entry crosses the limit, so each store evicts the folder
+    setGlobalConfForTest(GCFG_TPC_INSTANTIATION_CACHE_MAX_SIZE, "0");
+
+    TpcInstantiationCache& cache = TpcInstantiationCache::instance();
+    cache.clear();
+
+    GaudiGraph g;
+    TSize      sizes[]      = {48, 16};
+    TSize      otherSizes[] = {96, 16};
+    createAndInitAddNode(g, sizes, 2);
+    createAndInitAddNode(g, otherSizes, 2);
+
+    for (const auto& file : std::filesystem::directory_iterator(folder))
+    {
+        EXPECT_NE(file.path().extension(), ".tpcinst") << file.path() << " was not evicted";
+    }
+
+    cache.clear();
+    const TpcInstantiationCache::Stats before = cache.getStats();
+    createAndInitAddNode(g, sizes, 2);
+    const TpcInstantiationCache::Stats after = cache.getStats();
+    EXPECT_EQ(after.diskHits, before.diskHits);
+    EXPECT_EQ(after.misses, before.misses + 1);
+
+    std::filesystem::remove_all(folder);
+}
@@ -0,0 +1,337 @@
+/*
+ * Benchmark of the graph compiler heap allocator, replaying allocation traces
+ *
+ * The traces are taken from the logs of a compilation with the HEAP_ALLOC log level set to trace: every HeapAllocator
+ * logs its Init, Allocate, Free and allocateReqRange calls (the "trace <allocator> <op> ..." lines), and each Init
+ * starts a new trace of that allocator. Without log files, a synthetic trace of a graph is replayed, where each node
+ * allocates an output of a random size and frees the tensors whose last consumer it is.
+ * Every trace is replayed into a new HeapAllocator, the addresses of the allocations are mapped to the replayed ones,
+ * and allocations which got a different address than the recorded one are counted (e.g. when the allocator was
+ * switched to best-fit during the compilation, which is not traced).
+ *
+ * Usage: heap_allocator_benchmark [--iterations N] [--tensors N] [--json <file>] [<log file>...]
+ */
+
+#include "json_utils.h"
+#include "memory_management/heap_allocator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+struct TraceOp
+{
+    enum class Type
+    {
+        alloc,
+        free,
+        reqRange
+    };
+
+    Type     type;
+    uint64_t size             = 0;
+    uint64_t alignment        = 0;
+    uint64_t offset           = 0;
+    bool     allowFailure     = false;
+    uint64_t requestedAddress = 0;
+    uint64_t address          = 0;  // The allocated (0 if failed) or freed address, or the requested range base
+    unsigned pad              = 0;
+};
+
+struct Trace
+{
+    std::string          name;
+    uint64_t             memorySize = 0;
+    uint64_t             base       = 0;
+    std::vector<TraceOp> ops;
+};
+
+struct BenchmarkParams
+{
+    uint64_t                 iterations = 1;
+    uint64_t                 tensors    = 200000;
+    std::string              jsonFile;
+    std::vector<std::string> logFiles;
+};
+
+uint64_t parseNumber(const std::string& value)
+{
+    return value == "-" ? 0 : std::stoull(value, nullptr, 0);
+}
+
+bool parseLog(const std::string& logFile, std::vector<Trace>& rTraces)
+{
+    std::ifstream file(logFile);
+    if (!file.good())
+    {
+        std::cerr << logFile << ": failed to open" << std::endl;
+        return false;
+    }
+
+    static const std::regex traceLine(R"(trace (\S+) (init|alloc|free|reqrange) (.*)$)");
+
+    std::unordered_map<std::string, size_t> nameToTrace;  // The last trace of every allocator name
+    std::string                             line;
+    std::smatch                             match;
+    while (std::getline(file, line))
+    {
+        if (!std::regex_search(line, match, traceLine)) continue;
+
+        const std::string  name = match[1];
+        const std::string  op   = match[2];
+        std::istringstream args(match[3].str());
+        std::string        a, b, c, d, e, f;
+        args >> a >> b >> c >> d >> e >> f;
+
+        if (op == "init")
+        {
+            nameToTrace[name] = rTraces.size();
+            rTraces.push_back({name, parseNumber(a), parseNumber(b), {}});
+            continue;
+        }
+
+        auto traceIt = nameToTrace.find(name);
+        if (traceIt == nameToTrace.end()) continue;  // Its init is not in the log
+
+        TraceOp traceOp;
+        if (op == "alloc")
+        {
+            traceOp.type             = TraceOp::Type::alloc;
+            traceOp.size             = parseNumber(a);
+            traceOp.alignment        = parseNumber(b);
+            traceOp.offset           = parseNumber(c);
+            traceOp.allowFailure     = (d == "true");
+            traceOp.requestedAddress = parseNumber(e);
+            traceOp.address          = parseNumber(f);
+        }
+        else if (op == "free")
+        {
+            traceOp.type    = TraceOp::Type::free;
+            traceOp.address = parseNumber(a);
+        }
+        else
+        {
+            traceOp.type    = TraceOp::Type::reqRange;
+            traceOp.address = parseNumber(a);
+            traceOp.size    = parseNumber(b);
+            traceOp.pad     = parseNumber(c);
+        }
+        rTraces[traceIt->second].ops.push_back(traceOp);
+    }
+    return true;
+}
+
+// Tensors of a graph executed in order, with sizes spread over a few orders of magnitude. Half of them are consumed
+// shortly after they are produced, the others live for a part of the graph (e.g. activations kept for the backward).
+Trace createSyntheticTrace(uint64_t numOfTensors)
+{
+    static constexpr uint64_t ALIGNMENT = 128;
+
+    Trace trace;
+    trace.name       = "synthetic";
+    trace.memorySize = 1ULL << 40;
+
+    std::mt19937                            gen(0);
+    std::uniform_real_distribution<double>  log2Size(8, 24);
+    std::geometric_distribution<uint64_t>   shortLifetime(0.1);
+    std::uniform_int_distribution<uint64_t> longLifetime(1, std::max<uint64_t>(numOfTensors / 4, 1));
+
+    std::multimap<uint64_t, uint64_t> freeAtNode;  // The node which frees every tensor
+    uint64_t                          nextAddress = 0;
+    for (uint64_t node = 0; node < numOfTensors; node++)
+    {
+        TraceOp alloc;
+        alloc.type      = TraceOp::Type::alloc;
+        alloc.size      = (uint64_t)std::exp2(log2Size(gen));
+        alloc.alignment = ALIGNMENT;
+        alloc.address   = ++nextAddress;  // Only an id, the addresses are replayed without a recorded reference
+        trace.ops.push_back(alloc);
+        const uint64_t lifetime = gen() % 2 == 0 ? shortLifetime(gen) : longLifetime(gen);
+        freeAtNode.emplace(node + 1 + lifetime, alloc.address);
+
+        auto range = freeAtNode.equal_range(node);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            TraceOp free;
+            free.type    = TraceOp::Type::free;
+            free.address = it->second;
+            trace.ops.push_back(free);
+        }
+        freeAtNode.erase(range.first, range.second);
+    }
+    return trace;
+}
+
+struct ReplayResult
+{
+    uint64_t timeNs     = 0;
+    uint64_t allocs     = 0;
+    uint64_t frees      = 0;
+    uint64_t failures   = 0;
+    uint64_t mismatches = 0;
+    uint64_t maxFree    = 0;
+};
+
+ReplayResult replay(const Trace& trace, bool isRecorded)
+{
+    ReplayResult  result;
+    HeapAllocator allocator(trace.name, 0, true, false);
+    allocator.SetPrintStatus(false);
+    allocator.Init(trace.memorySize, trace.base);
+
+    std::unordered_map<uint64_t, deviceAddrOffset> recordedToReplayed;
+    recordedToReplayed.reserve(trace.ops.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const TraceOp& op : trace.ops)
+    {
+        switch (op.type)
+        {
+            case TraceOp::Type::alloc:
+            {
+                auto addr = allocator.Allocate(op.size, op.alignment, op.offset, true, op.requestedAddress);
+                result.allocs++;
+                if (!addr.is_set())
+                {
+                    result.failures++;
+                    if (isRecorded && op.address != 0) result.mismatches++;
+                    break;
+                }
+                if (isRecorded && addr.value() != op.address) result.mismatches++;
+                if (op.address != 0) recordedToReplayed[op.address] = addr.value();
+                break;
+            }
+            case TraceOp::Type::free:
+            {
+                auto it = recordedToReplayed.find(op.address);
+                if (it == recordedToReplayed.end()) break;  // Its allocation failed on replay
+                allocator.Free(it->second);
+                recordedToReplayed.erase(it);
+                result.frees++;
+                break;
+            }
+            case TraceOp::Type::reqRange:
+            {
+                allocator.allocateReqRange({op.address, op.size}, op.pad);
+                break;
+            }
+        }
+    }
+    result.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                        .count();
+    result.maxFree = allocator.getMaxFreeContiguous();
+    return result;
+}
+
+bool parseArgs(int argc, char* argv[], BenchmarkParams& rParams)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations" || arg == "--tensors" || arg == "--json")
+        {
+            if (i + 1 >= argc) return false;
+            const std::string value = argv[++i];
+            if (arg == "--iterations")
+            {
+                rParams.iterations = std::stoull(value);
+            }
+            else if (arg == "--tensors")
+            {
+                rParams.tensors = std::stoull(value);
+            }
+            else
+            {
+                rParams.jsonFile = value;
+            }
+        }
+        else if (arg.rfind("--", 0) == 0)
+        {
+            return false;
+        }
+        else
+        {
+            rParams.logFiles.push_back(arg);
+        }
+    }
+    return rParams.iterations > 0;
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    BenchmarkParams params;
+    if (!parseArgs(argc, argv, params))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--iterations N] [--tensors N] [--json <file>] [<log file>...]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Trace> traces;
+    for (const std::string& logFile : params.logFiles)
+    {
+        if (!parseLog(logFile, traces)) return EXIT_FAILURE;
+    }
+    const bool isRecorded = !params.logFiles.empty();
+    if (!isRecorded)
+    {
+        traces.push_back(createSyntheticTrace(params.tensors));
+    }
+
+    nlohmann_hcl::json results = nlohmann_hcl::json::array();
+    for (const Trace& trace : traces)
+    {
+        if (trace.ops.empty()) continue;
+
+        ReplayResult result;
+        uint64_t     totalTimeNs = 0;
+        for (uint64_t i = 0; i < params.iterations; i++)
+        {
+            result = replay(trace, isRecorded);
+            totalTimeNs += result.timeNs;
+        }
+        const double meanTimeNs = (double)totalTimeNs / params.iterations;
+        const double nsPerOp    = meanTimeNs / trace.ops.size();
+
+        std::cout << trace.name << ": " << trace.ops.size() << " ops (" << result.allocs << " allocs, " << result.frees
+                  << " frees, " << result.failures << " failures), " << std::fixed << std::setprecision(3)
+                  << meanTimeNs / 1e6 << " ms, " << std::setprecision(1) << nsPerOp << " ns/op";
+        if (isRecorded)
+        {
+            std::cout << ", " << result.mismatches << " addresses differ from the trace";
+        }
+        std::cout << std::endl;
+
+        nlohmann_hcl::json json;
+        json["allocator"]      = trace.name;
+        json["ops"]            = trace.ops.size();
+        json["allocs"]         = result.allocs;
+        json["frees"]          = result.frees;
+        json["failures"]       = result.failures;
+        json["mismatches"]     = result.mismatches;
+        json["max_free_bytes"] = result.maxFree;
+        json["mean_time_ns"]   = meanTimeNs;
+        json["ns_per_op"]      = nsPerOp;
+        results.push_back(std::move(json));
+    }
+
+    if (!params.jsonFile.empty())
+    {
+        json_utils::jsonToFile(results, params.jsonFile, 4);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,563 @@
+/*
+ * Device-free benchmark of the host side of synLaunch on SCAL devices
+ *
+ * Deserializes recipes (as written by synRecipeSerialize) and launches each of them repeatedly through the real
+ * QueueComputeScal, on real Gaudi2 SCAL streams (compute and PDMA commands download, with their cyclic buffers and
+ * completion groups) that run over a mock libscal (mock_scal.hpp: submissions are counted and complete immediately),
+ * with host memory standing for the mapped memory. Reports, per recipe, launches/sec, the latency of every launch
+ * stage (LaunchLatencyStats), heap allocations and submissions per launch.
+ * With --by-name the tensors are given by their names (SYN_FLAGS_TENSOR_NAME) and resolved on every launch, as
+ * synLaunch does; recipes with thousands of persistent tensors (e.g. full-weight LLM graphs) show the cost of resolving
+ * the launch tensors.
+ *
+ * Usage: launch_benchmark [--iterations N] [--warmup N] [--by-name] [--json <file>] <recipe file>...
+ */
+
+#include "mock_scal.hpp"
+
+#include "habana_global_conf_runtime.h"
+#include "json_utils.h"
+#include "infra/global_conf_manager.h"
+#include "runtime/common/launch_latency_stats.hpp"
+#include "runtime/common/queues/basic_queue_info.hpp"
+#include "runtime/common/recipe/recipe_handle_impl.hpp"
+#include "runtime/common/recipe/recipe_manager.hpp"
+#include "runtime/scal/common/entities/scal_completion_group.hpp"
+#include "runtime/scal/common/entities/scal_memory_pool.hpp"
+#include "runtime/scal/common/stream_compute_scal.hpp"
+#include "runtime/scal/gaudi2/entities/device_info.hpp"
+#include "runtime/scal/gaudi2/entities/scal_stream.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Every heap allocation of the process is counted, the benchmark is single threaded so the count of a launch is the
+// count of the launch path (and of background threads, if any)
+static std::atomic<uint64_t> s_numOfAllocations {0};
+
+void* operator new(size_t size)
+{
+    s_numOfAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace
+{
+// Fake device addresses, only the host side of the launch is run
+const uint64_t DRAM_BASE_ADDR      = 0x1000000000ULL;
+const uint64_t DRAM_SIZE           = 0x10000000000ULL;
+const uint64_t SECTION_ADDR_STRIDE = 0x100000000ULL;
+const uint64_t HBM_GLBL_ADDR       = 0x2000000000ULL;
+const uint64_t HBM_GLBL_SIZE       = 256 * 1024 * 1024;
+const uint32_t ARC_HBM_ADDR_CORE   = 0x10000000;
+const uint64_t ARC_HBM_ADDR_DEV    = 0x3000000000ULL;
+const uint32_t ARC_HBM_SIZE        = 32 * 1024 * 1024;
+
+// The streams of the queue, named as the streams container names them
+const std::string   COMPUTE_STREAM_NAME          = "compute";
+const std::string   TX_STREAM_NAME               = "pdma_tx_commands";
+const FenceIdType   GLOBAL_FENCE_ID              = 0;
+const FenceIdType   TX_FENCE_ID                  = 1;
+const FenceIdType   COMPUTE_FENCE_ID             = 2;
+const FenceIdType   COMPUTE_FENCE_ID_FOR_COMPUTE = 3;
+const MonitorIdType TX_SYNC_MONITOR_ID           = 0;
+const MonitorIdType COMPUTE_SYNC_MONITOR_ID      = 4;
+
+// Host memory stands for the device mapped memory, the device VA of a buffer is its host address
+class HostMemoryAlloc : public DevMemoryAllocInterface
+{
+public:
+    synStatus allocate() override { return synSuccess; }
+
+    synStatus release() override { return synSuccess; }
+
+    synStatus allocateMemory(uint64_t           size,
+                             uint32_t           flags,
+                             void**             buffer,
+                             bool               isUserRequest,
+                             uint64_t           reqVAAddress,
+                             const std::string& mappingDesc,
+                             uint64_t*          deviceVA = nullptr) override
+    {
+        *buffer = new uint8_t[size];
+        if (deviceVA != nullptr)
+        {
+            *deviceVA = (uint64_t)*buffer;
+        }
+        return synSuccess;
+    }
+
+    synStatus deallocateMemory(void* pBuffer, uint32_t flags, bool isUserRequest) override
+    {
+        delete[](uint8_t*) pBuffer;
+        return synSuccess;
+    }
+
+    eMappingStatus getDeviceVirtualAddress(bool      isUserRequest,
+                                           void*     hostAddress,
+                                           uint64_t  bufferSize,
+                                           uint64_t* pDeviceVA,
+                                           bool*     pIsExactKeyFound = nullptr) override
+    {
+        *pDeviceVA = (uint64_t)hostAddress;
+        if (pIsExactKeyFound != nullptr)
+        {
+            *pIsExactKeyFound = true;
+        }
+        return HATVA_MAPPING_STATUS_FOUND;
+    }
+
+    synStatus mapBufferToDevice(uint64_t           size,
+                                void*              buffer,
+                                bool               isUserRequest,
+                                uint64_t           reqVAAddress,
+                                const std::string& mappingDesc) override
+    {
+        return synSuccess;
+    }
+
+    synStatus unmapBufferFromDevice(void* buffer, bool isUserRequest, uint64_t* bufferSize) override
+    {
+        return synSuccess;
+    }
+
+    synStatus getDramMemInfo(uint64_t& free, uint64_t& total) const override
+    {
+        free  = DRAM_SIZE;
+        total = DRAM_SIZE;
+        return synSuccess;
+    }
+
+    void getValidAddressesRange(uint64_t& lowestValidAddress, uint64_t& highestValidAddress) const override
+    {
+        lowestValidAddress  = DRAM_BASE_ADDR;
+        highestValidAddress = DRAM_BASE_ADDR + DRAM_SIZE;
+    }
+
+    void dfaLogMappedMem() const override {}
+
+    synStatus destroyHostAllocations(bool isUserAllocations) override { return synSuccess; }
+};
+
+// A compute queue on SCAL streams, created as the Gaudi2 streams container creates them: the real QueueComputeScal on
+// a ScalStreamComputeGaudi2 and its PDMA (commands download) stream, over the mock libscal
+class BenchmarkComputeQueue
+{
+public:
+    BenchmarkComputeQueue()
+    : m_devHndl(mock_scal::getDeviceHandle()),
+      m_mpHostShared(m_devHndl, "host_shared"),
+      m_computeCompletionGroup(m_devHndl, COMPUTE_STREAM_NAME + "_completion_queue0"),
+      m_txCompletionGroup(m_devHndl, TX_STREAM_NAME + "_completion_queue0")
+    {
+        m_devSpecificInfo.dramBaseAddr = DRAM_BASE_ADDR;
+        m_devSpecificInfo.dramEndAddr  = DRAM_BASE_ADDR + DRAM_SIZE;
+
+        m_basicQueueInfo.handle         = 0;
+        m_basicQueueInfo.queueType      = INTERNAL_STREAM_TYPE_COMPUTE;
+        m_basicQueueInfo.userQueueIndex = 0;
+    }
+
+    synStatus init()
+    {
+        if ((m_mpHostShared.init() != synSuccess) || (m_computeCompletionGroup.init() != synSuccess) ||
+            (m_txCompletionGroup.init() != synSuccess))
+        {
+            return synFail;
+        }
+
+        initDevStreamInfo();
+
+        const std::string txStreamName = TX_STREAM_NAME + "0";
+        ScalStreamCtorInfoBase txCtorInfo {.name                 = txStreamName,
+                                           .mpHostShared         = m_mpHostShared,
+                                           .devHndl              = m_devHndl,
+                                           .devStreamInfo        = &m_devStreamInfo,
+                                           .deviceInfoInterface  = &m_deviceInfo,
+                                           .pScalCompletionGroup = &m_txCompletionGroup,
+                                           .devType              = synDeviceGaudi2,
+                                           .fenceId              = TX_FENCE_ID,
+                                           .streamIdx            = 0,
+                                           .syncMonitorId        = TX_SYNC_MONITOR_ID,
+                                           .resourceType         = ResourceStreamType::SYNAPSE_DMA_DOWN};
+        m_txStream = std::make_unique<ScalStreamCopyGaudi2>(&txCtorInfo);
+        if (m_txStream->init() != synSuccess)
+        {
+            return synFail;
+        }
+
+        const std::string  computeStreamName = COMPUTE_STREAM_NAME + "0";
+        ScalStreamCtorInfo computeCtorInfo {{.name                 = computeStreamName,
+                                             .mpHostShared         = m_mpHostShared,
+                                             .devHndl              = m_devHndl,
+                                             .devStreamInfo        = &m_devStreamInfo,
+                                             .deviceInfoInterface  = &m_deviceInfo,
+                                             .pScalCompletionGroup = &m_computeCompletionGroup,
+                                             .devType              = synDeviceGaudi2,
+                                             .fenceId              = COMPUTE_FENCE_ID,
+                                             .fenceIdForCompute    = COMPUTE_FENCE_ID_FOR_COMPUTE,
+                                             .streamIdx            = 0,
+                                             .syncMonitorId        = COMPUTE_SYNC_MONITOR_ID,
+                                             .resourceType         = ResourceStreamType::COMPUTE},
+                                            .globalFenceId = GLOBAL_FENCE_ID};
+        m_computeStream = std::make_unique<ScalStreamComputeGaudi2>(&computeCtorInfo);
+        if ((m_computeStream->init() != synSuccess) || (m_computeStream->addGlobalFenceInc(true) != synSuccess))
+        {
+            return synFail;
+        }
+
+        m_computeResources.m_pRxCommandsStream      = m_txStream.get();
+        m_computeResources.m_pTxCommandsStream      = m_txStream.get();
+        m_computeResources.m_pDev2DevCommandsStream = m_txStream.get();
+        m_computeResources.m_streamIndex            = 0;
+
+        m_queue = std::make_unique<QueueComputeScal>(m_basicQueueInfo,
+                                                     m_computeStream.get(),
+                                                     &m_computeResources,
+                                                     synDeviceGaudi2,
+                                                     m_devSpecificInfo,
+                                                     m_devMemoryAlloc);
+
+        PreAllocatedStreamMemoryAll preAllocatedMemory;
+        preAllocatedMemory.global.AddrDev  = HBM_GLBL_ADDR;
+        preAllocatedMemory.global.Size     = HBM_GLBL_SIZE;
+        preAllocatedMemory.shared.AddrCore = ARC_HBM_ADDR_CORE;
+        preAllocatedMemory.shared.AddrDev  = ARC_HBM_ADDR_DEV;
+        preAllocatedMemory.shared.Size     = ARC_HBM_SIZE;
+        return m_queue->init(preAllocatedMemory);
+    }
+
+    synStatus launch(const std::vector<synLaunchTensorInfoExt>& rLaunchTensors,
+                     InternalRecipeHandle*                      pRecipeHandle,
+                     uint32_t                                   launchFlags)
+    {
+        EventWithMappedTensorDB events;
+        return m_queue->launch(rLaunchTensors.data(),
+                               rLaunchTensors.size(),
+                               DRAM_BASE_ADDR /* workspaceAddress */,
+                               pRecipeHandle,
+                               0 /* assertAsyncMappedAddress */,
+                               launchFlags,
+                               events,
+                               0 /* apiId */);
+    }
+
+    // Releases the recipe, as synRecipeDestroy does
+    void removeRecipe(InternalRecipeHandle& rRecipeHandle) { m_queue->notifyRecipeRemoval(rRecipeHandle); }
+
+    LaunchLatencyStats* getLaunchLatencyStats() const { return m_queue->getLaunchLatencyStats(); }
+
+private:
+    // Each engine group signals a single completion
+    void initDevStreamInfo()
+    {
+        m_devStreamInfo.clusterTypeCompletionsAmountDB.fill(std::numeric_limits<uint32_t>::max());
+        setResourceInfo(ResourceStreamType::SYNAPSE_DMA_DOWN, {SCAL_PDMA_TX_CMD_GROUP});
+        setResourceInfo(
+            ResourceStreamType::COMPUTE,
+            {SCAL_MME_COMPUTE_GROUP, SCAL_TPC_COMPUTE_GROUP, SCAL_EDMA_COMPUTE_GROUP, SCAL_RTR_COMPUTE_GROUP});
+    }
+
+    void setResourceInfo(ResourceStreamType resourceType, const std::vector<uint8_t>& clustersType)
+    {
+        ResourceInformation& rResourceInfo = m_devStreamInfo.resourcesInfo[(uint8_t)resourceType];
+
+        rResourceInfo.engineGrpArr.numEngineGroups = 0;
+        rResourceInfo.targetVal                    = 0;
+        for (uint8_t clusterType : clustersType)
+        {
+            m_devStreamInfo.clusterTypeCompletionsAmountDB[clusterType]                    = 1;
+            rResourceInfo.engineGrpArr.eng[rResourceInfo.engineGrpArr.numEngineGroups++] = clusterType;
+            rResourceInfo.targetVal++;
+        }
+    }
+
+    scal_handle_t       m_devHndl;
+    ScalMemoryPool      m_mpHostShared;
+    ScalCompletionGroup m_computeCompletionGroup;
+    ScalCompletionGroup m_txCompletionGroup;
+    gaudi2::DeviceInfo  m_deviceInfo;
+    DevStreamInfo       m_devStreamInfo {};
+
+    std::unique_ptr<ScalStreamCopyGaudi2>    m_txStream;
+    std::unique_ptr<ScalStreamComputeGaudi2> m_computeStream;
+    ComputeCompoundResources                 m_computeResources;
+
+    ScalDevSpecificInfo               m_devSpecificInfo;
+    BasicQueueInfo                    m_basicQueueInfo;
+    HostMemoryAlloc                   m_devMemoryAlloc;
+    std::unique_ptr<QueueComputeScal> m_queue;
+};
+
+// All the launch tensors of the recipe, at fake addresses (each section gets its own range), with their max sizes.
+// The tensor names point to rTensorsInfo
+bool createLaunchTensors(const InternalRecipeHandle&                   rRecipeHandle,
+                         std::vector<synRetrievedLaunchTensorInfoExt>& rTensorsInfo,
+                         std::vector<synLaunchTensorInfoExt>&          rLaunchTensors)
+{
+    const uint32_t numOfTensors = rRecipeHandle.deviceAgnosticRecipeHandle.m_recipeTensorInfo.getTensorAmount();
+
+    std::vector<uint64_t> tensorIds(numOfTensors);
+    if (rRecipeHandle.deviceAgnosticRecipeHandle.m_recipeTensorInfo.tensorRetrieveIds(tensorIds.data(),
+                                                                                      numOfTensors) != synSuccess)
+    {
+        return false;
+    }
+
+    rTensorsInfo.resize(numOfTensors);
+    for (uint32_t i = 0; i < numOfTensors; i++)
+    {
+        rTensorsInfo[i].tensorId = tensorIds[i];
+    }
+    if (rRecipeHandle.basicRecipeHandle.tensorRetrieveLaunchInfoById(numOfTensors, rTensorsInfo.data()) != synSuccess)
+    {
+        return false;
+    }
+
+    rLaunchTensors.resize(numOfTensors);
+    for (uint32_t i = 0; i < numOfTensors; i++)
+    {
+        const synRetrievedLaunchTensorInfoExt& tensorInfo   = rTensorsInfo[i];
+        synLaunchTensorInfoExt&                launchTensor = rLaunchTensors[i];
+
+        launchTensor.tensorName     = tensorInfo.tensorName;
+        launchTensor.tensorId       = tensorInfo.tensorId;
+        launchTensor.tensorType     = tensorInfo.tensorType;
+        switch (tensorInfo.tensorType)
+        {
+            case DATA_TENSOR:
+            case DATA_TENSOR_DYNAMIC:
+            case DEVICE_SHAPE_TENSOR:
+                launchTensor.pTensorAddress = DRAM_BASE_ADDR + tensorInfo.tensorSectionId * SECTION_ADDR_STRIDE +
+                                              tensorInfo.tensorOffsetInSection;
+                break;
+            case HOST_TO_DEVICE_TENSOR:
+                // Its content is read on launch, a fake one can't be given
+                return false;
+            default:
+                launchTensor.pTensorAddress = 0;
+                break;
+        }
+        memcpy(launchTensor.tensorSize, tensorInfo.tensorMaxSize, sizeof(launchTensor.tensorSize));
+    }
+    return true;
+}
+
+struct BenchmarkParams
+{
+    uint64_t                 iterations = 1000;
+    uint64_t                 warmup     = 10;
+    bool                     byName     = false;
+    std::string              jsonFile;
+    std::vector<std::string> recipeFiles;
+};
+
+bool parseArgs(int argc, char* argv[], BenchmarkParams& rParams)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "--iterations" || arg == "--warmup" || arg == "--json") && (i + 1 < argc))
+        {
+            const std::string value = argv[++i];
+            if (arg == "--iterations")
+            {
+                rParams.iterations = std::stoull(value);
+            }
+            else if (arg == "--warmup")
+            {
+                rParams.warmup = std::stoull(value);
+            }
+            else
+            {
+                rParams.jsonFile = value;
+            }
+        }
+        else if (arg == "--by-name")
+        {
+            rParams.byName = true;
+        }
+        else if (arg.rfind("--", 0) == 0)
+        {
+            return false;
+        }
+        else
+        {
+            rParams.recipeFiles.push_back(arg);
+        }
+    }
+    return !rParams.recipeFiles.empty() && rParams.iterations > 0;
+}
+
+void printResult(const std::string& recipeFile, const nlohmann_hcl::json& result)
+{
+    std::cout << recipeFile << ": " << result["tensors"] << " tensors"
+              << (result["by_name"].get<bool>() ? " (by name), " : ", ") << result["launches"] << " launches, "
+              << std::fixed << std::setprecision(0)
+              << result["launches_per_sec"].get<double>() << " launches/sec, " << std::setprecision(1)
+              << result["allocations_per_launch"].get<double>() << " allocations/launch, "
+              << result["submissions_per_launch"].get<double>() << " submissions ("
+              << result["submitted_bytes_per_launch"].get<double>() << " bytes)/launch" << std::endl;
+
+    std::cout << "    " << std::left << std::setw(20) << "stage [ns]" << std::right;
+    for (const char* column : {"mean", "p50", "p99", "p999", "max"})
+    {
+        std::cout << std::setw(12) << column;
+    }
+    std::cout << std::endl;
+
+    const nlohmann_hcl::json& stages = result["stages"];
+    for (auto stageIt = stages.begin(); stageIt != stages.end(); ++stageIt)
+    {
+        std::cout << "    " << std::left << std::setw(20) << stageIt.key() << std::right;
+        for (const char* column : {"mean_ns", "p50_ns", "p99_ns", "p999_ns", "max_ns"})
+        {
+            const uint64_t valueNs = stageIt.value()[column];
+            std::cout << std::setw(12) << valueNs;
+        }
+        std::cout << std::endl;
+    }
+}
+
+bool runRecipe(BenchmarkComputeQueue& rQueue,
+               InternalRecipeHandle*  pRecipeHandle,
+               const std::string&     recipeFile,
+               const BenchmarkParams& rParams,
+               nlohmann_hcl::json&    rResult)
+{
+    std::vector<synRetrievedLaunchTensorInfoExt> tensorsInfo;
+    std::vector<synLaunchTensorInfoExt>          launchTensors;
+    if (!createLaunchTensors(*pRecipeHandle, tensorsInfo, launchTensors))
+    {
+        std::cerr << recipeFile << ": failed to create the launch tensors (host-to-device tensors are not supported)"
+                  << std::endl;
+        return false;
+    }
+
+    LaunchLatencyStats* stats       = rQueue.getLaunchLatencyStats();
+    const uint32_t      launchFlags = rParams.byName ? SYN_FLAGS_TENSOR_NAME : 0;
+
+    for (uint64_t i = 0; i < rParams.warmup; i++)
+    {
+        const synStatus status = rQueue.launch(launchTensors, pRecipeHandle, launchFlags);
+        if (status != synSuccess)
+        {
+            std::cerr << recipeFile << ": warmup launch " << i << " failed with status " << status << std::endl;
+            return false;
+        }
+    }
+
+    stats->reset();
+    mock_scal::resetCounters();
+    s_numOfAllocations = 0;
+
+    // The whole synLaunch path of the stream (including the launch tensors resolution) is timed, the stages only
+    // cover the launch on the stream
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < rParams.iterations; i++)
+    {
+        const synStatus status = rQueue.launch(launchTensors, pRecipeHandle, launchFlags);
+        if (status != synSuccess)
+        {
+            std::cerr << recipeFile << ": launch " << i << " failed with status " << status << std::endl;
+            return false;
+        }
+    }
+    const double totalNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    const uint64_t numOfAllocations = s_numOfAllocations;
+    const double   launches         = rParams.iterations;
+
+    rResult["recipe"]                     = recipeFile;
+    rResult["tensors"]                    = launchTensors.size();
+    rResult["by_name"]                    = rParams.byName;
+    rResult["launches"]                   = rParams.iterations;
+    rResult["launches_per_sec"]           = totalNs > 0 ? launches * 1e9 / totalNs : 0;
+    rResult["allocations_per_launch"]     = numOfAllocations / launches;
+    rResult["submissions_per_launch"]     = mock_scal::getNumOfSubmissions() / launches;
+    rResult["submitted_bytes_per_launch"] = mock_scal::getNumOfSubmittedBytes() / launches;
+    rResult["stages"]                     = stats->toJson()["stages"];
+    return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchmarkParams params;
+    if (!parseArgs(argc, argv, params))
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--iterations N] [--warmup N] [--by-name] [--json <file>] <recipe file>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    GlobalConfManager::instance().init("");
+    GCFG_ENABLE_LAUNCH_LATENCY_STATS.setValue(true);
+
+    BenchmarkComputeQueue queue;
+    if (queue.init() != synSuccess)
+    {
+        std::cerr << "Failed to init the compute queue" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    RecipeManager      recipeManager;
+    nlohmann_hcl::json results = nlohmann_hcl::json::array();
+    bool               passed  = true;
+
+    for (const std::string& recipeFile : params.recipeFiles)
+    {
+        InternalRecipeHandle* pRecipeHandle = nullptr;
+        if (recipeManager.recipeDeSerialize(pRecipeHandle, recipeFile.c_str()) != synSuccess)
+        {
+            std::cerr << recipeFile << ": failed to deserialize" << std::endl;
+            passed = false;
+            continue;
+        }
+
+        nlohmann_hcl::json result;
+        if (runRecipe(queue, pRecipeHandle, recipeFile, params, result))
+        {
+            printResult(recipeFile, result);
+            results.push_back(std::move(result));
+        }
+        else
+        {
+            passed = false;
+        }
+
+        // The recipe is released before the next one
+        queue.removeRecipe(*pRecipeHandle);
+    }
+
+    recipeManager.removeAllRecipeHandle();
+
+    if (!params.jsonFile.empty())
+    {
+        json_utils::jsonToFile(results, params.jsonFile, 4);
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,301 @@
+#include "mock_scal.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace
+{
+const unsigned MOCK_COMMAND_ALIGNMENT    = 0x100;
+const unsigned MOCK_SUBMISSION_ALIGNMENT = 0x100;
+const uint64_t MOCK_BUFFER_ALIGNMENT     = 0x1000;
+const uint64_t MOCK_POOL_SIZE            = 1ULL << 32;
+const uint64_t MOCK_DCCM_QUEUE_ADDRESS   = 0xF000000000ULL;
+const unsigned MOCK_LONG_SO_WA_INDEX     = 8184;
+
+struct MockDevice
+{
+};
+
+struct MockCore
+{
+    const std::string name = "mock_scheduler";
+};
+
+struct MockPool
+{
+    std::string name;
+};
+
+struct MockBuffer
+{
+    MockPool* pPool;
+    void*     hostAddress;
+};
+
+struct MockCompletionGroup
+{
+    unsigned index;
+    uint64_t expectedCounter = 0;
+};
+
+struct MockStream
+{
+    std::string name;
+    unsigned    index;
+    unsigned    priority = SCAL_LOW_PRIORITY_STREAM;
+    MockBuffer* pBuffer  = nullptr;
+    unsigned    lastPi   = 0;
+};
+
+struct MockSoPool
+{
+};
+
+MockDevice s_device;
+MockCore   s_scheduler;
+MockSoPool s_soPool;
+
+std::map<std::string, std::unique_ptr<MockPool>>            s_pools;
+std::map<std::string, std::unique_ptr<MockCompletionGroup>> s_completionGroups;
+std::map<std::string, std::unique_ptr<MockStream>>          s_streams;
+
+uint64_t s_numOfSubmissions    = 0;
+uint64_t s_numOfSubmittedBytes = 0;
+
+template<class Handle, class T>
+Handle toHandle(T* pObject)
+{
+    return reinterpret_cast<Handle>(pObject);
+}
+
+template<class T, class Handle>
+T* fromHandle(Handle handle)
+{
+    return reinterpret_cast<T*>(handle);
+}
+
+// Any name is found, the same name gives the same object
+template<class T>
+T* getByName(std::map<std::string, std::unique_ptr<T>>& rObjects, const char* name, T&& rNewObject)
+{
+    std::unique_ptr<T>& rObject = rObjects[name];
+    if (rObject == nullptr)
+    {
+        rObject = std::make_unique<T>(std::move(rNewObject));
+    }
+    return rObject.get();
+}
+}  // namespace
+
+namespace mock_scal
+{
+scal_handle_t getDeviceHandle()
+{
+    return toHandle<scal_handle_t>(&s_device);
+}
+
+uint64_t getNumOfSubmissions()
+{
+    return s_numOfSubmissions;
+}
+
+uint64_t getNumOfSubmittedBytes()
+{
+    return s_numOfSubmittedBytes;
+}
+
+void resetCounters()
+{
+    s_numOfSubmissions    = 0;
+    s_numOfSubmittedBytes = 0;
+}
+}  // namespace mock_scal
+
+extern "C" {
+
+int scal_get_pool_handle_by_name(const scal_handle_t scal, const char* pool_name, scal_pool_handle_t* pool)
+{
+    *pool = toHandle<scal_pool_handle_t>(getByName(s_pools, pool_name, MockPool {pool_name}));
+    return SCAL_SUCCESS;
+}
+
+int scal_pool_get_info(const scal_pool_handle_t pool, scal_memory_pool_info* info)
+{
+    memset(info, 0, sizeof(*info));
+    info->scal      = mock_scal::getDeviceHandle();
+    info->name      = fromHandle<MockPool>(pool)->name.c_str();
+    info->totalSize = MOCK_POOL_SIZE;
+    info->freeSize  = MOCK_POOL_SIZE;
+    return SCAL_SUCCESS;
+}
+
+int scal_allocate_buffer(const scal_pool_handle_t pool, const uint64_t size, scal_buffer_handle_t* buff)
+{
+    const uint64_t alignedSize = (size + MOCK_BUFFER_ALIGNMENT - 1) / MOCK_BUFFER_ALIGNMENT * MOCK_BUFFER_ALIGNMENT;
+    void*          hostAddress = aligned_alloc(MOCK_BUFFER_ALIGNMENT, alignedSize);
+    if (hostAddress == nullptr)
+    {
+        return SCAL_OUT_OF_MEMORY;
+    }
+    memset(hostAddress, 0, alignedSize);
+
+    *buff = toHandle<scal_buffer_handle_t>(new MockBuffer {fromHandle<MockPool>(pool), hostAddress});
+    return SCAL_SUCCESS;
+}
+
+int scal_free_buffer(const scal_buffer_handle_t buff)
+{
+    MockBuffer* pBuffer = fromHandle<MockBuffer>(buff);
+    free(pBuffer->hostAddress);
+    delete pBuffer;
+    return SCAL_SUCCESS;
+}
+
+int scal_buffer_get_info(const scal_buffer_handle_t buff, scal_buffer_info_t* info)
+{
+    const MockBuffer* pBuffer = fromHandle<MockBuffer>(buff);
+
+    info->pool           = toHandle<scal_pool_handle_t>(pBuffer->pPool);
+    info->core_address   = 0;
+    info->host_address   = pBuffer->hostAddress;
+    info->device_address = (uint64_t)pBuffer->hostAddress;
+    return SCAL_SUCCESS;
+}
+
+int scal_control_core_get_info(const scal_core_handle_t core, scal_control_core_info_t* info)
+{
+    info->scal                       = mock_scal::getDeviceHandle();
+    info->name                       = fromHandle<MockCore>(core)->name.c_str();
+    info->idx                        = 0;
+    info->dccm_message_queue_address = MOCK_DCCM_QUEUE_ADDRESS;
+    return SCAL_SUCCESS;
+}
+
+int scal_control_core_get_infoV2(const scal_core_handle_t core, scal_control_core_infoV2_t* info)
+{
+    info->scal                       = mock_scal::getDeviceHandle();
+    info->name                       = fromHandle<MockCore>(core)->name.c_str();
+    info->idx                        = 0;
+    info->dccm_message_queue_address = MOCK_DCCM_QUEUE_ADDRESS;
+    info->hdCore                     = 0;
+    return SCAL_SUCCESS;
+}
+
+int scal_get_completion_group_handle_by_name(const scal_handle_t       scal,
+                                             const char*               cg_name,
+                                             scal_comp_group_handle_t* comp_grp)
+{
+    const unsigned index = s_completionGroups.size();
+    *comp_grp =
+        toHandle<scal_comp_group_handle_t>(getByName(s_completionGroups, cg_name, MockCompletionGroup {index}));
+    return SCAL_SUCCESS;
+}
+
+int scal_completion_group_get_infoV2(const scal_comp_group_handle_t comp_grp, scal_completion_group_infoV2_t* info)
+{
+    const MockCompletionGroup* pCompletionGroup = fromHandle<MockCompletionGroup>(comp_grp);
+
+    memset(info, 0, sizeof(*info));
+    info->scheduler_handle   = toHandle<scal_core_handle_t>(&s_scheduler);
+    info->index_in_scheduler = pCompletionGroup->index;
+    // Every monitor guards a group of 8 long-SOs
+    info->long_so_index = pCompletionGroup->index * 8;
+    info->current_value = pCompletionGroup->expectedCounter;
+    info->force_order   = true;
+    info->isDirectMode  = false;
+    return SCAL_SUCCESS;
+}
+
+int scal_completion_group_set_expected_ctr(scal_comp_group_handle_t comp_grp, uint64_t val)
+{
+    fromHandle<MockCompletionGroup>(comp_grp)->expectedCounter = val;
+    return SCAL_SUCCESS;
+}
+
+int scal_completion_group_wait(const scal_comp_group_handle_t comp_grp, const uint64_t target, const uint64_t timeout)
+{
+    return (target <= fromHandle<MockCompletionGroup>(comp_grp)->expectedCounter) ? SCAL_SUCCESS : SCAL_TIMED_OUT;
+}
+
+int scal_completion_group_wait_always_interupt(const scal_comp_group_handle_t comp_grp,
+                                               const uint64_t                 target,
+                                               const uint64_t                 timeout)
+{
+    return scal_completion_group_wait(comp_grp, target, timeout);
+}
+
+int scal_completion_group_register_timestamp(const scal_comp_group_handle_t comp_grp,
+                                             const uint64_t                 target,
+                                             uint64_t                       timestamps_handle,
+                                             uint32_t                       timestamps_offset)
+{
+    return SCAL_SUCCESS;
+}
+
+int scal_get_stream_handle_by_name(const scal_handle_t scal, const char* stream_name, scal_stream_handle_t* stream)
+{
+    const unsigned index = s_streams.size();
+    *stream = toHandle<scal_stream_handle_t>(getByName(s_streams, stream_name, MockStream {stream_name, index}));
+    return SCAL_SUCCESS;
+}
+
+int scal_stream_set_priority(const scal_stream_handle_t stream, const unsigned priority)
+{
+    fromHandle<MockStream>(stream)->priority = priority;
+    return SCAL_SUCCESS;
+}
+
+int scal_stream_set_commands_buffer(const scal_stream_handle_t stream, const scal_buffer_handle_t buffer)
+{
+    fromHandle<MockStream>(stream)->pBuffer = fromHandle<MockBuffer>(buffer);
+    return SCAL_SUCCESS;
+}
+
+int scal_stream_get_info(const scal_stream_handle_t stream, scal_stream_info_t* info)
+{
+    const MockStream* pStream = fromHandle<MockStream>(stream);
+
+    memset(info, 0, sizeof(*info));
+    info->name                 = pStream->name.c_str();
+    info->scheduler_handle     = toHandle<scal_core_handle_t>(&s_scheduler);
+    info->index                = pStream->index;
+    info->current_pi           = pStream->lastPi;
+    info->control_core_buffer  = toHandle<scal_buffer_handle_t>(pStream->pBuffer);
+    info->submission_alignment = MOCK_SUBMISSION_ALIGNMENT;
+    info->command_alignment    = MOCK_COMMAND_ALIGNMENT;
+    info->priority             = pStream->priority;
+    info->isDirectMode         = false;
+    return SCAL_SUCCESS;
+}
+
+int scal_stream_submit(const scal_stream_handle_t stream, const unsigned pi, const unsigned submission_alignment)
+{
+    MockStream* pStream = fromHandle<MockStream>(stream);
+
+    // The PI doesn't wrap, it counts the bytes written to the cyclic buffer
+    s_numOfSubmissions++;
+    s_numOfSubmittedBytes += pi - pStream->lastPi;
+    pStream->lastPi = pi;
+    return SCAL_SUCCESS;
+}
+
+int scal_get_so_pool_handle_by_name(const scal_handle_t scal, const char* pool_name, scal_so_pool_handle_t* so_pool)
+{
+    *so_pool = toHandle<scal_so_pool_handle_t>(&s_soPool);
+    return SCAL_SUCCESS;
+}
+
+int scal_so_pool_get_info(const scal_so_pool_handle_t so_pool, scal_so_pool_info* info)
+{
+    memset(info, 0, sizeof(*info));
+    info->scal    = mock_scal::getDeviceHandle();
+    info->name    = "mock_so_pool";
+    info->size    = 1;
+    info->baseIdx = MOCK_LONG_SO_WA_INDEX;
+    return SCAL_SUCCESS;
+}
+
+}  // extern "C"
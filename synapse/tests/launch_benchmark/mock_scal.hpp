@@ -0,0 +1,26 @@
+#pragma once
+
+#include "scal.h"
+
+#include <cstdint>
+
+/**
+ * Device-free libscal for the launch benchmark
+ *
+ * The benchmark executable exports the scal_* functions the runtime uses for its SCAL streams (see CMakeLists.txt),
+ * so the real streams, completion groups and memory pool of libSynapse run over them:
+ * - Memory pool buffers (e.g. the stream cyclic buffers) are host memory, their device address is the host address.
+ * - Streams, completion groups and the scheduler are looked up by name, any name is found.
+ * - Submissions are only counted, their commands stay in the cyclic buffer.
+ * - Work completes immediately: a completion group is done with every target set as its expected counter.
+ * The benchmark is single threaded, so is the mock.
+ */
+namespace mock_scal
+{
+scal_handle_t getDeviceHandle();
+
+// Of all the streams, since the last reset
+uint64_t getNumOfSubmissions();
+uint64_t getNumOfSubmittedBytes();
+void     resetCounters();
+}  // namespace mock_scal
@@ -171,6 +171,81 @@ TEST_F_SYN(SynCommonParallelLaunch, tpcGemmMulti)
     recipe.validateResults(recipeLaunchParam.getLaunchTensorMemory());
 }
 
+TEST_F_SYN(SynCommonParallelLaunch, tpc_gemm_batch)
+{
+    std::vector<TSize> sizes = {64, 64};
+    TestRecipeAddf32   recipe1(m_deviceType, sizes, false);
+    TestRecipeGemm     recipe2(m_deviceType, sizes, false);
+
+    recipe1.generateRecipe();
+    recipe2.generateRecipe();
+
+    TestDevice device(m_deviceType);
+
+    auto streamDown    = device.createStream();
+    auto streamCompute = device.createStream();
+    auto streamUp      = device.createStream();
+
+    TestLauncher launcher(device);
+
+    RecipeLaunchParams recipeLaunchParam1 =
+        std::move(launcher.createRecipeLaunchParams(recipe1, {TensorInitOp::RANDOM_POSITIVE, 0}));
+    RecipeLaunchParams recipeLaunchParam2 =
+        std::move(launcher.createRecipeLaunchParams(recipe2, {TensorInitOp::RANDOM_POSITIVE, 0}));
+    TestLauncher::download(streamDown, recipe1, recipeLaunchParam1);
+    TestLauncher::download(streamDown, recipe2, recipeLaunchParam2);
+    device.synchronize();
+
+    const synLaunchBatchInfo launchBatchInfo[] = {{recipeLaunchParam1.getSynLaunchTensorInfoVec().data(),
+                                                   recipe1.getTensorInfoVecSize(),
+                                                   recipeLaunchParam1.getWorkspace(),
+                                                   recipe1.getRecipe(),
+                                                   0 /* flags */},
+                                                  {recipeLaunchParam2.getSynLaunchTensorInfoVec().data(),
+                                                   recipe2.getTensorInfoVecSize(),
+                                                   recipeLaunchParam2.getWorkspace(),
+                                                   recipe2.getRecipe(),
+                                                   0 /* flags */}};
+
+    for (int i = 0; i < 10; i++)
+    {
+        uint32_t  numOfLaunched = 0;
+        synStatus status        = synLaunchBatch(streamCompute, launchBatchInfo, 2, &numOfLaunched);
+        ASSERT_EQ(status, synSuccess) << "Failed to launch the batch (iteration " << i << ")";
+        ASSERT_EQ(numOfLaunched, 2U);
+    }
+
+    // A batch whose second launch fails (its tensors are missing) enqueues only the first one
+    const synLaunchBatchInfo failingLaunchBatchInfo[] = {launchBatchInfo[0],
+                                                         {nullptr,
+                                                          0 /* numberOfTensors */,
+                                                          recipeLaunchParam2.getWorkspace(),
+                                                          recipe2.getRecipe(),
+                                                          0 /* flags */}};
+    const std::vector<synLaunchTensorInfoExt> tensorsBefore = recipeLaunchParam1.getSynLaunchTensorInfoVec();
+
+    uint32_t  numOfLaunched = 0;
+    synStatus status        = synLaunchBatch(streamCompute, failingLaunchBatchInfo, 2, &numOfLaunched);
+    ASSERT_NE(status, synSuccess) << "The batch with a failing launch succeeded";
+    ASSERT_EQ(numOfLaunched, 1U);
+
+    // The batch launches with a copy of the user's tensors
+    const std::vector<synLaunchTensorInfoExt>& tensorsAfter = recipeLaunchParam1.getSynLaunchTensorInfoVec();
+    ASSERT_EQ(tensorsBefore.size(), tensorsAfter.size());
+    for (size_t i = 0; i < tensorsBefore.size(); i++)
+    {
+        ASSERT_EQ(tensorsBefore[i].tensorId, tensorsAfter[i].tensorId);
+    }
+    device.synchronize();
+
+    TestLauncher::upload(streamUp, recipe1, recipeLaunchParam1);
+    TestLauncher::upload(streamUp, recipe2, recipeLaunchParam2);
+    device.synchronize();
+
+    recipe1.validateResults(recipeLaunchParam1.getLaunchTensorMemory());
+    recipe2.validateResults(recipeLaunchParam2.getLaunchTensorMemory());
+}
+
 TEST_F_SYN(SynCommonParallelLaunch, tpcGemm_tpc)
 {
     std::vector<TSize>   sizes = {64, 64};  // {1536, 1536};
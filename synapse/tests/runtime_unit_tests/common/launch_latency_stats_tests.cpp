@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "infra/latency_histogram.hpp"
+#include "runtime/common/launch_latency_stats.hpp"
+#include "scoped_configuration_change.h"
+
+TEST(UTLatencyHistogramTest, buckets_cover_their_values)
+{
+    for (uint64_t value : {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 31ULL, 32ULL, 1000ULL, 123456789ULL, ~0ULL})
+    {
+        const unsigned bucketIdx = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(bucketIdx, LatencyHistogram::NUM_BUCKETS);
+        ASSERT_GE(LatencyHistogram::bucketUpperBound(bucketIdx), value);
+        if (bucketIdx > 0)
+        {
+            ASSERT_LT(LatencyHistogram::bucketUpperBound(bucketIdx - 1), value);
+        }
+    }
+}
+
+TEST(UTLatencyHistogramTest, percentiles)
+{
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getCount(), 0);
+    ASSERT_EQ(histogram.getValueAtPercentile(50), 0);
+
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.getCount(), 1000);
+    ASSERT_EQ(histogram.getSum(), 1000 * 1001 / 2);
+    ASSERT_EQ(histogram.getMin(), 1);
+    ASSERT_EQ(histogram.getMax(), 1000);
+
+    // Within the bucket resolution (1/16)
+    for (double percentile : {50.0, 90.0, 99.0})
+    {
+        const double expected = percentile * 10;
+        const double actual   = histogram.getValueAtPercentile(percentile);
+        ASSERT_GE(actual, expected);
+        ASSERT_LE(actual, expected * (1 + 1.0 / LatencyHistogram::SUB_BUCKET_COUNT));
+    }
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 1000);
+
+    histogram.reset();
+    ASSERT_EQ(histogram.getCount(), 0);
+    ASSERT_EQ(histogram.getMin(), 0);
+}
+
+TEST(UTLaunchLatencyStatsTest, stages_are_recorded_into_the_current_stats)
+{
+    {
+        ScopedConfigurationChange disabled("ENABLE_LAUNCH_LATENCY_STATS", "false");
+        ASSERT_EQ(LaunchLatencyStats::create("disabled"), nullptr);
+    }
+
+    ScopedConfigurationChange enabled("ENABLE_LAUNCH_LATENCY_STATS", "true");
+    std::shared_ptr<LaunchLatencyStats> stats = LaunchLatencyStats::create("stream");
+    ASSERT_NE(stats, nullptr);
+
+    {
+        // Not current yet
+        LAUNCH_LATENCY_SCOPE(PATCHING);
+    }
+    ASSERT_EQ(stats->getHistogram(LaunchStage::PATCHING).getCount(), 0);
+
+    {
+        ScopedLaunchLatencyStats current(stats.get());
+        ASSERT_EQ(LaunchLatencyStats::current(), stats.get());
+        for (unsigned i = 0; i < 3; i++)
+        {
+            LAUNCH_LATENCY_SCOPE(PATCHING);
+        }
+    }
+    ASSERT_EQ(LaunchLatencyStats::current(), nullptr);
+    ASSERT_EQ(stats->getHistogram(LaunchStage::PATCHING).getCount(), 3);
+
+    nlohmann_hcl::json json = stats->toJson();
+    ASSERT_EQ(json["stream"], "stream");
+    ASSERT_EQ(json["stages"]["patching"]["count"], 3);
+    ASSERT_EQ(json["stages"]["patching"].count("p99_ns"), 1);
+    ASSERT_EQ(json["stages"].count("sif"), 0);
+
+    stats.reset();
+    LaunchLatencyStats::dumpAll();  // drops the destroyed stream
+    for (const auto& streamStats : LaunchLatencyStats::allToJson())
+    {
+        ASSERT_NE(streamStats["stream"], "stream");
+    }
+}
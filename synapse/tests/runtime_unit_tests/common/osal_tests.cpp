@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
 #include "runtime/common/osal/osal.hpp"
 #include "runtime/common/osal/physical_device_interface.hpp"
+#include "runtime/common/osal/host_numa_placement.hpp"
+#include "scoped_configuration_change.h"
+
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
 
 class PhysicalDeviceMock : public PhysicalDeviceInterface
 {
@@ -11,7 +22,13 @@ public:
 
     virtual int openByModuleId(synModuleId moduleid) override { return fdCompute; }
 
-    virtual int getPciBusIdFromFd(int fd, char* pci_bus_id, int len) override { return 0; }
+    // By default a bus ID no host has, so it has no NUMA node
+    virtual int getPciBusIdFromFd(int fd, char* pci_bus_id, int len) override
+    {
+        strncpy(pci_bus_id, pciBusId.c_str(), len - 1);
+        pci_bus_id[len - 1] = '\0';
+        return 0;
+    }
 
     virtual int getDeviceIndexFromPciBusId(const char* busid) override { return 0; }
 
@@ -56,12 +73,60 @@ public:
 
     int getControlFd() { return contolFd; }
 
-    const int fdCompute = 0;
-    int       contolFd  = 1;
+    const int   fdCompute = 0;
+    int         contolFd  = 1;
+    std::string pciBusId  = "ffff:ff:1f.7";
 };
 
 class UTOsalTest : public ::testing::Test
 {
+protected:
+    static const int MEMORY_POLICY_PREFERRED = 1;
+    static const int MEMORY_POLICY_F_ADDR    = 1 << 1;
+
+    static int readNumaNode(const std::string& path)
+    {
+        std::ifstream file(path);
+        int           node = HostNumaPlacement::INVALID_NODE;
+        return (file >> node) ? node : HostNumaPlacement::INVALID_NODE;
+    }
+
+    // A PCI device of this host with a known NUMA node, when the host has more than one node
+    static bool findNumaPciDevice(std::string& rPciBusId, int& rNode)
+    {
+        std::ifstream onlineNodes("/sys/devices/system/node/online");
+        std::string   nodes;
+        if (!std::getline(onlineNodes, nodes) || (nodes.find_first_of("-,") == std::string::npos))
+        {
+            return false;
+        }
+
+        DIR* pDir = opendir("/sys/bus/pci/devices");
+        if (pDir == nullptr)
+        {
+            return false;
+        }
+        bool found = false;
+        while (dirent* pEntry = readdir(pDir))
+        {
+            const std::string busId = pEntry->d_name;
+            const int         node  = readNumaNode("/sys/bus/pci/devices/" + busId + "/numa_node");
+            if ((busId[0] != '.') && (node >= 0))
+            {
+                rPciBusId = busId;
+                rNode     = node;
+                found     = true;
+                break;
+            }
+        }
+        closedir(pDir);
+        return found;
+    }
+
+    static bool isNodeSet(const HostNumaPlacement::NodeMask& nodeMask, int node)
+    {
+        return (nodeMask[node / 64] & (1ULL << (node % 64))) != 0;
+    }
 };
 
 TEST_F(UTOsalTest, acquire_release_device)
@@ -87,6 +152,99 @@ TEST_F(UTOsalTest, acquire_release_device)
     OSAL::testSetInterface(pInterfaceOrig);
 }
 
+TEST_F(UTOsalTest, numa_placement_of_unknown_device_node)
+{
+    PhysicalDeviceInterface* pInterfaceOrig = OSAL::testGetInterface();
+    PhysicalDeviceMock       mock;
+    OSAL::testSetInterface(&mock);
+    synStatus status = OSAL::getInstance().acquireDevice(nullptr, synDeviceGaudi, 0);
+    EXPECT_EQ(status, synSuccess);
+
+    // No placement, host memory is allocated as usual
+    EXPECT_EQ(HostNumaPlacement::getNode(), HostNumaPlacement::INVALID_NODE);
+    {
+        HostNumaPlacement::ScopedPreferredNode preferredNode;
+        std::vector<uint8_t>                   buffer(1024 * 1024, 1);
+        EXPECT_EQ(buffer.back(), 1);
+    }
+
+    status = OSAL::getInstance().releaseAcquiredDevice();
+    EXPECT_EQ(status, synSuccess);
+    EXPECT_EQ(HostNumaPlacement::getNode(), HostNumaPlacement::INVALID_NODE);
+
+    OSAL::testSetInterface(pInterfaceOrig);
+}
+
+TEST_F(UTOsalTest, numa_placement_of_known_device_node)
+{
+    std::string pciBusId;
+    int         deviceNode = HostNumaPlacement::INVALID_NODE;
+    if (!findNumaPciDevice(pciBusId, deviceNode))
+    {
+        GTEST_SKIP() << "Single NUMA node host, or no PCI device with a NUMA node";
+    }
+
+    ScopedConfigurationChange numaPlacement("ENABLE_NUMA_AWARE_HOST_PLACEMENT", "true");
+
+    PhysicalDeviceInterface* pInterfaceOrig = OSAL::testGetInterface();
+    PhysicalDeviceMock       mock;
+    mock.pciBusId = pciBusId;
+    OSAL::testSetInterface(&mock);
+    synStatus status = OSAL::getInstance().acquireDevice(nullptr, synDeviceGaudi, 0);
+    EXPECT_EQ(status, synSuccess);
+    EXPECT_EQ(HostNumaPlacement::getNode(), deviceNode);
+
+    // A bound buffer gets a preferred policy on the device node, and its pages are placed there once touched
+    const uint64_t pageSize = sysconf(_SC_PAGESIZE);
+    const uint64_t size     = 16 * pageSize;
+    void* hostAddress = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(hostAddress, MAP_FAILED);
+    HostNumaPlacement::bindMemory(hostAddress, size);
+
+    int                         mode = 0;
+    HostNumaPlacement::NodeMask nodeMask {};
+    ASSERT_EQ(syscall(SYS_get_mempolicy,
+                      &mode,
+                      nodeMask.data(),
+                      sizeof(nodeMask) * 8 + 1,
+                      hostAddress,
+                      MEMORY_POLICY_F_ADDR),
+              0);
+    EXPECT_EQ(mode, MEMORY_POLICY_PREFERRED);
+    EXPECT_TRUE(isNodeSet(nodeMask, deviceNode));
+
+    memset(hostAddress, 1, size);
+    std::vector<void*> pages;
+    for (uint64_t offset = 0; offset < size; offset += pageSize)
+    {
+        pages.push_back((uint8_t*)hostAddress + offset);
+    }
+    std::vector<int> pagesNodes(pages.size(), HostNumaPlacement::INVALID_NODE);
+    ASSERT_EQ(syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, pagesNodes.data(), 0), 0);
+    for (int pageNode : pagesNodes)
+    {
+        EXPECT_EQ(pageNode, deviceNode);
+    }
+    munmap(hostAddress, size);
+
+    // The thread policy is preferred on the device node for the scope only
+    {
+        HostNumaPlacement::ScopedPreferredNode preferredNode;
+        nodeMask = {};
+        ASSERT_EQ(syscall(SYS_get_mempolicy, &mode, nodeMask.data(), sizeof(nodeMask) * 8 + 1, nullptr, 0), 0);
+        EXPECT_EQ(mode, MEMORY_POLICY_PREFERRED);
+        EXPECT_TRUE(isNodeSet(nodeMask, deviceNode));
+    }
+    ASSERT_EQ(syscall(SYS_get_mempolicy, &mode, nullptr, 0, nullptr, 0), 0);
+    EXPECT_NE(mode, MEMORY_POLICY_PREFERRED);
+
+    status = OSAL::getInstance().releaseAcquiredDevice();
+    EXPECT_EQ(status, synSuccess);
+    EXPECT_EQ(HostNumaPlacement::getNode(), HostNumaPlacement::INVALID_NODE);
+
+    OSAL::testSetInterface(pInterfaceOrig);
+}
+
 TEST_F(UTOsalTest, acquire_multiple_devices_on_single_process)
 {
     PhysicalDeviceInterface* pInterfaceOrig = OSAL::testGetInterface();
@@ -1,7 +1,16 @@
 #include <gtest/gtest.h>
+#include "runtime/common/recipe/recipe_disk_cache.hpp"
 #include "runtime/common/recipe/recipe_handle_impl.hpp"
 #include "runtime/common/recipe/recipe_manager.hpp"
 #include "habana_graph_mock.hpp"
+#include "filesystem.h"
+#include "graph_editor.h"
+#include "node_factory.h"
+#include "recipe.h"
+#include "scoped_configuration_change.h"
+#include "tensor.h"
+
+#include <fstream>
 
 class UTRecipeManagerTest : public ::testing::Test
 {
@@ -36,3 +45,113 @@ TEST_F(UTRecipeManagerTest, checkCompileGetRemoveAll)
     status = rMng.removeAllRecipeHandle();
     ASSERT_EQ(true, status);
 }
+
+TEST_F(UTRecipeManagerTest, checkCompileFromDiskCache)
+{
+    const fs::path            cacheFolder = fs::temp_directory_path() / fmt::format("recipe_cache_{}", getpid());
+    ScopedConfigurationChange cachePath("RECIPE_DISK_CACHE_PATH", cacheFolder.string());
+
+    RecipeManager                rMng;
+    HabanaGraphMock              graph(synDeviceGaudi2, {0x100, 0x200, 0x400});
+    const std::string            fileName("myRecipe.txt");
+    InternalRecipeHandle*        pRecipeHndl = nullptr;
+    const RecipeDiskCache::Stats statsBefore = RecipeDiskCache::instance().getStats();
+
+    // First compilation populates the cache
+    synStatus status =
+        rMng.addRecipeHandleAndCompileGraph(&graph, false, nullptr, 0, fileName.c_str(), nullptr, pRecipeHndl);
+    ASSERT_EQ(synSuccess, status);
+    ASSERT_NE(nullptr, pRecipeHndl);
+
+    RecipeDiskCache::Stats stats = RecipeDiskCache::instance().getStats();
+    ASSERT_EQ(statsBefore.misses + 1, stats.misses);
+    ASSERT_EQ(statsBefore.stores + 1, stats.stores);
+
+    // Second compilation of the same graph is loaded from the cache
+    InternalRecipeHandle* pCachedRecipeHndl = nullptr;
+    status = rMng.addRecipeHandleAndCompileGraph(&graph, false, nullptr, 0, fileName.c_str(), nullptr, pCachedRecipeHndl);
+    ASSERT_EQ(synSuccess, status);
+    ASSERT_NE(nullptr, pCachedRecipeHndl);
+
+    stats = RecipeDiskCache::instance().getStats();
+    ASSERT_EQ(statsBefore.hits + 1, stats.hits);
+
+    const recipe_t* pRecipe       = pRecipeHndl->basicRecipeHandle.recipe;
+    const recipe_t* pCachedRecipe = pCachedRecipeHndl->basicRecipeHandle.recipe;
+    ASSERT_EQ(pRecipe->workspace_nr, pCachedRecipe->workspace_nr);
+    for (uint64_t i = 0; i < pRecipe->workspace_nr; i++)
+    {
+        ASSERT_EQ(pRecipe->workspace_sizes[i], pCachedRecipe->workspace_sizes[i]);
+    }
+
+    ASSERT_EQ(true, rMng.removeAllRecipeHandle());
+    fs::remove_all(cacheFolder);
+}
+
+TEST_F(UTRecipeManagerTest, checkDiskCacheKeyMismatchIsMiss)
+{
+    const fs::path            cacheFolder = fs::temp_directory_path() / fmt::format("recipe_cache_key_{}", getpid());
+    ScopedConfigurationChange cachePath("RECIPE_DISK_CACHE_PATH", cacheFolder.string());
+
+    RecipeManager                rMng;
+    HabanaGraphMock              graph(synDeviceGaudi2, {0x100, 0x200, 0x400});
+    const std::string            fileName("myRecipe.txt");
+    InternalRecipeHandle*        pRecipeHndl = nullptr;
+    const RecipeDiskCache::Stats statsBefore = RecipeDiskCache::instance().getStats();
+
+    synStatus status =
+        rMng.addRecipeHandleAndCompileGraph(&graph, false, nullptr, 0, fileName.c_str(), nullptr, pRecipeHndl);
+    ASSERT_EQ(synSuccess, status);
+    ASSERT_EQ(statsBefore.stores + 1, RecipeDiskCache::instance().getStats().stores);
+
+    // Another graph of the same hash, as after a collision, must not get this recipe
+    const RecipeDiskCache::GraphKey key = RecipeDiskCache::instance().calcGraphKey(graph);
+    {
+        std::ofstream keyFile(cacheFolder / fmt::format("{:016x}.key", key.hash), std::ios::binary | std::ios::trunc);
+        keyFile << "another graph";
+    }
+    status = rMng.addRecipeHandleAndCompileGraph(&graph, false, nullptr, 0, fileName.c_str(), nullptr, pRecipeHndl);
+    ASSERT_EQ(synSuccess, status);
+
+    RecipeDiskCache::Stats stats = RecipeDiskCache::instance().getStats();
+    ASSERT_EQ(statsBefore.hits, stats.hits);
+    ASSERT_EQ(statsBefore.misses + 2, stats.misses);
+    ASSERT_EQ(statsBefore.stores + 2, stats.stores);
+
+    // The entry is replaced by the recompiled one
+    status = rMng.addRecipeHandleAndCompileGraph(&graph, false, nullptr, 0, fileName.c_str(), nullptr, pRecipeHndl);
+    ASSERT_EQ(synSuccess, status);
+    ASSERT_EQ(statsBefore.hits + 1, RecipeDiskCache::instance().getStats().hits);
+
+    ASSERT_EQ(true, rMng.removeAllRecipeHandle());
+    fs::remove_all(cacheFolder);
+}
+
+TEST_F(UTRecipeManagerTest, checkDiskCacheKeyIncludesQuantization)
+{
+    HabanaGraphMock graph(synDeviceGaudi2, {0x100});
+    TSize           sizes[] = {16, 16};
+    TensorPtr       in      = std::make_shared<Tensor>(2, sizes, syn_type_int8);
+    TensorPtr       out     = std::make_shared<Tensor>(2, sizes, syn_type_int8);
+    GraphEditor::addNode(graph, NodeFactory::createNode({in}, {out}, nullptr, NodeFactory::memcpyNodeTypeName, "copy"));
+
+    const RecipeDiskCache::GraphKey key = RecipeDiskCache::instance().calcGraphKey(graph);
+
+    QuantizationData quantization(syn_type_int8);
+    quantization.setScale(0.5);
+    in->setQuantizationParams(quantization);
+    const RecipeDiskCache::GraphKey scaledKey = RecipeDiskCache::instance().calcGraphKey(graph);
+    ASSERT_NE(key.hash, scaledKey.hash);
+    ASSERT_NE(key.description, scaledKey.description);
+
+    DynamicRange dynamicRange;
+    dynamicRange.min   = -1;
+    dynamicRange.max   = 1;
+    dynamicRange.isSet = true;
+    out->setDynamicRange(dynamicRange);
+    ASSERT_NE(scaledKey.hash, RecipeDiskCache::instance().calcGraphKey(graph).hash);
+
+    // The key doesn't change without a change of the graph
+    ASSERT_EQ(RecipeDiskCache::instance().calcGraphKey(graph).description,
+              RecipeDiskCache::instance().calcGraphKey(graph).description);
+}
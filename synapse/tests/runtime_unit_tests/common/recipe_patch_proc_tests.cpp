@@ -6,6 +6,7 @@
 #include "define_synapse_common.hpp"
 #include "test_dummy_recipe.hpp"
 #include "runtime/common/recipe/recipe_patch_processor.hpp"
+#include "runtime/common/recipe/launch_capture.hpp"
 #include "../common/dev_memory_alloc_mock.hpp"
 #include "runtime/common/syn_logging.h"
 
@@ -211,7 +212,7 @@ void UTrecipePatchProcTest::runTest(bool             withValidate,
     patching::HostAddressPatchingInformation hostAddrPatchInfo;
     DevMemoryAllocMock                       devMemoryAlloc;
 
-    // analyze tensors
+    // analyze tensors, with and without resolving the tensors indices (only needed for DSD)
     for (int i = 0; i < 3; i++)
     {
         setupLaunchTensors(shuffle, tensorModifyFunc);
@@ -228,7 +229,7 @@ void UTrecipePatchProcTest::runTest(bool             withValidate,
                                                          devMemoryAlloc,
                                                          tensorIdx2userIdx,
                                                          true /* isInitAndCompletionRequired */,
-                                                         true /* shouldResolveTensorsIndices */,
+                                                         (i % 2) == 0 /* shouldResolveTensorsIndices */,
                                                          &validSectionAddresses);
         ASSERT_EQ(status, expectedProcess);
 
@@ -509,6 +510,31 @@ TEST_F(UTrecipePatchProcTest, duplicate_name)
     runAllCases(synSuccess, true, duplicateName);
 }
 
+TEST_F(UTrecipePatchProcTest, tensor_retrieve_id_by_name)
+{
+    setupTest();
+
+    const RecipeTensorsInfo& rRecipeTensorsInfo = m_deviceAgnosticRecipeInfo.m_recipeTensorInfo;
+    ASSERT_EQ(rRecipeTensorsInfo.m_tensorName2id.size(), (size_t)NUM_TENSORS);
+
+    uint64_t tensorId = 0;
+    for (int i = 0; i < NUM_TENSORS; i++)
+    {
+        ASSERT_EQ(rRecipeTensorsInfo.tensorRetrieveId(m_tensorName[i].c_str(), &tensorId), synSuccess);
+        ASSERT_EQ(tensorId, GET_TENSOR_INFO(i, DATA_TENSOR)) << "failed for tensor " << i;
+    }
+
+    // Looked up by value, not by the recipe pointer
+    const std::string nameCopy = m_tensorName[NUM_TENSORS / 2];
+    ASSERT_EQ(rRecipeTensorsInfo.tensorRetrieveId(nameCopy.c_str(), &tensorId), synSuccess);
+    ASSERT_EQ(tensorId, GET_TENSOR_INFO(NUM_TENSORS / 2, DATA_TENSOR));
+
+    ASSERT_EQ(rRecipeTensorsInfo.tensorRetrieveId("not_in_recipe", &tensorId), synSuccess);
+    ASSERT_EQ(tensorId, TENSOR_INVALID_ID);
+
+    ASSERT_EQ(rRecipeTensorsInfo.tensorRetrieveId(nullptr, &tensorId), synInvalidArgument);
+}
+
 TEST_F(UTrecipePatchProcTest, overlap_same_addr)
 {
     setupTest();
@@ -729,3 +755,92 @@ TEST_F(UTrecipePatchProcTest, VerifyConstSections_ZeroSizeMissingTensor)
     runTest(true, false, missingTensor, synSuccess, true);
     shouldAvoidCheckSectionAddr = false;
 }
+
+// Replay resolves the same sections addresses as process, and only the moved sections are marked as changed
+TEST_F(UTrecipePatchProcTest, launch_capture_replay)
+{
+    setupTest();
+    setupLaunchTensors(true, [](Tensors&) {});
+
+    const RecipeTensorsInfo& rRecipeTensorsInfo = m_deviceAgnosticRecipeInfo.m_recipeTensorInfo;
+
+    std::unique_ptr<LaunchCapture> capture =
+        LaunchCapture::create(m_recipeInfo, rRecipeTensorsInfo, m_launchTensors.data(), m_launchTensors.size());
+    ASSERT_NE(capture, nullptr);
+    ASSERT_EQ(capture->getNumTensors(), NUM_TENSORS);
+    ASSERT_EQ(capture->getNumSections(), NUM_SECTIONS);
+
+    patching::HostAddressPatchingInformation hostAddrPatchInfo;
+    bool                                     tensorsChanged = true;
+
+    synStatus status = RecipePatchProcessor::processReplay(m_recipeInfo,
+                                                           rRecipeTensorsInfo,
+                                                           *capture,
+                                                           m_launchTensors.data(),
+                                                           m_wsInfo,
+                                                           hostAddrPatchInfo,
+                                                           &validSectionAddresses,
+                                                           tensorsChanged);
+    ASSERT_EQ(status, synSuccess);
+    ASSERT_FALSE(tensorsChanged);
+    checkAddr(hostAddrPatchInfo);
+    hostAddrPatchInfo.clearSectionsChanged();
+
+    // Move all of the tensors of a single section
+    const uint32_t movedSection = toSectionIdx(5);
+    const uint64_t moveOffset   = 0x100000;
+    for (synLaunchTensorInfoExt& rTensor : m_launchTensors)
+    {
+        if (toSectionIdx(rTensor.tensorId) == movedSection)
+        {
+            rTensor.pTensorAddress += moveOffset;
+        }
+    }
+    ASSERT_TRUE(capture->matches(m_launchTensors.data(), m_launchTensors.size()));
+
+    status = RecipePatchProcessor::processReplay(m_recipeInfo,
+                                                 rRecipeTensorsInfo,
+                                                 *capture,
+                                                 m_launchTensors.data(),
+                                                 m_wsInfo,
+                                                 hostAddrPatchInfo,
+                                                 &validSectionAddresses,
+                                                 tensorsChanged);
+    ASSERT_EQ(status, synSuccess);
+    ASSERT_TRUE(tensorsChanged);
+
+    const uint64_t* sectionsAddr    = hostAddrPatchInfo.getSectionsToHostAddressDB();
+    const uint8_t*  sectionsChanged = hostAddrPatchInfo.getSectionsChangedDB();
+    for (uint32_t sectionId = MEMORY_ID_FOR_FIRST_PERSISTENT_TENSOR; sectionId < hostAddrPatchInfo.getSectionsDbSize();
+         sectionId++)
+    {
+        const bool isMoved = (sectionId == movedSection);
+        ASSERT_EQ(sectionsAddr[sectionId], sectionId * SECTION_TO_ADDR_FACTOR + (isMoved ? moveOffset : 0));
+        ASSERT_EQ(sectionsChanged[sectionId] != 0, isMoved) << "failed for section " << sectionId;
+    }
+
+    // Tensors given in another order are not the captured ones
+    Tensors reordered = m_launchTensors;
+    std::swap(reordered[0], reordered[1]);
+    ASSERT_FALSE(capture->matches(reordered.data(), reordered.size()));
+
+    // Moving a single tensor of a section makes its section address inconsistent
+    for (synLaunchTensorInfoExt& rTensor : m_launchTensors)
+    {
+        if (toSectionIdx(rTensor.tensorId) == movedSection)
+        {
+            rTensor.pTensorAddress += moveOffset;
+            break;
+        }
+    }
+
+    status = RecipePatchProcessor::processReplay(m_recipeInfo,
+                                                 rRecipeTensorsInfo,
+                                                 *capture,
+                                                 m_launchTensors.data(),
+                                                 m_wsInfo,
+                                                 hostAddrPatchInfo,
+                                                 &validSectionAddresses,
+                                                 tensorsChanged);
+    ASSERT_NE(status, synSuccess);
+}
@@ -7,6 +7,8 @@ QueueMock::QueueMock()
   m_queryCounter(0),
   m_syncCounter(0),
   m_copyCounter(0),
+  m_launchCounter(0),
+  m_numOfSuccessfulLaunches(0),
   m_lastDirection(MEMCOPY_MAX_ENUM),
   m_lastIsUserRequest(true),
   m_pPreviousStream(nullptr)
@@ -76,7 +76,8 @@ public:
                              EventWithMappedTensorDB&      events,
                              uint8_t                       apiId) override
     {
-        return synFail;
+        m_launchCounter++;
+        return (m_launchCounter <= m_numOfSuccessfulLaunches) ? synSuccess : synFail;
     }
 
     virtual void finalize() override {}
@@ -94,6 +95,9 @@ public:
     uint64_t                    m_queryCounter;
     uint64_t                    m_syncCounter;
     uint64_t                    m_copyCounter;
+    uint64_t                    m_launchCounter;
+    // The launches that succeed before the following ones fail
+    uint64_t                    m_numOfSuccessfulLaunches;
     internalMemcopyParams       m_lastMemcpyParams;
     internalDmaDir              m_lastDirection;
     bool                        m_lastIsUserRequest;
@@ -450,6 +450,35 @@ TEST_F(UTStreamTest, check_flush_waits)
     EXPECT_EQ(pStreamInterfaceWait, &streamNetwork);
 }
 
+TEST_F(UTStreamTest, check_launch_batch_failure)
+{
+    synEventHandle       eventHandle = nullptr;
+    ScalEvent            event(0, 0, nullptr);
+    QueueMock            stream;
+    QueueInterfacesArray internalStreamHandles {&stream, &stream, &stream, &stream, &stream};
+    Stream               Stream(eventHandle, event, 0, internalStreamHandles);
+
+    // Simulate user flow in which the stream container is responsible to ensure that affinity is locked
+    synStatus status = Stream.setAffinity(0, internalStreamHandles);
+    EXPECT_EQ(status, synSuccess);
+
+    // The second launch of the batch fails
+    stream.m_numOfSuccessfulLaunches = 1;
+
+    const uint32_t     numberOfLaunches = 3;
+    synLaunchBatchInfo launchBatchInfo[numberOfLaunches] {};
+    uint32_t           numOfLaunched = numberOfLaunches;
+
+    std::unique_ptr<StreamJob> job =
+        std::make_unique<ComputeBatchJob>(launchBatchInfo, numberOfLaunches, 0, 0, numOfLaunched);
+    status = Stream.addJob(job);
+    EXPECT_EQ(status, synFail);
+
+    // The batch stops on the failure, the launches before it stay enqueued
+    EXPECT_EQ(numOfLaunched, 1U);
+    EXPECT_EQ(stream.m_launchCounter, 2U);
+}
+
 class CounterStreamJobMock : public StreamJob
 {
     FRIEND_TEST(UTStreamTest, check_different_stream_jobs_sync);
@@ -1,6 +1,8 @@
 #include "common/dsd_recipe.hpp"
+#include "scoped_configuration_change.h"
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <vector>
 
 class UTGaudi2RtDynamicShapesTest : public DsdRecipe
@@ -68,6 +70,105 @@ TEST_F(UTGaudi2RtDynamicShapesTest, dynamicPatching_gaudi2)
 
 class UTGaudi3RtDynamicShapesTest : public DsdRecipe
 {
+protected:
+    // The data-chunks and the patch-points effective addresses after running SIF + SMF
+    struct DsdResult
+    {
+        std::vector<std::vector<uint8_t>> dataChunks;
+        std::vector<uint64_t>             effectiveAddresses;
+
+        bool operator==(const DsdResult& other) const
+        {
+            return dataChunks == other.dataChunks && effectiveAddresses == other.effectiveAddresses;
+        }
+    };
+
+    void initDynamicRecipeTest()
+    {
+        initDynamicPatchingTest();
+
+        blobs[NUM_BLOBS - 1].blob_type_all         = blob_t::DYNAMIC;
+        blobs[NUM_BLOBS - 1].blob_type.dynamic_exe = 1;
+
+        recipe.dynamic_blobs_buffer      = blobData[NUM_BLOBS - 1];
+        recipe.dynamic_blobs_buffer_size = BLOB_DATA_SIZE;
+
+        recipe.patching_blobs_buffer_size = (NUM_BLOBS - 1) * BLOB_DATA_SIZE;
+
+        addrPP[NUM_ADDR_PP - 1].blob_idx = NUM_BLOBS - 1;
+
+        ASSERT_EQ(DeviceAgnosticRecipeStaticProcessorScal::process(synDeviceGaudi3,
+                                                                   recipeInfo,
+                                                                   deviceAgnosticRecipeInfo.m_recipeStaticInfoScal),
+                  synSuccess);
+
+        m_launchTensorInfo.resize(ARRAY_SIZE(launchTensors));  // Persistent + shape tensors
+        for (uint64_t i = 0; i < m_launchTensorInfo.size(); i++)
+        {
+            m_launchTensorInfo[i].tensorName     = launchTensors[i].tensorName;
+            m_launchTensorInfo[i].pTensorAddress = launchTensors[i].pTensorAddress;
+            m_launchTensorInfo[i].tensorType     = launchTensors[i].tensorType;
+            m_launchTensorInfo[i].tensorId       = launchTensors[i].tensorId;
+            memcpy(m_launchTensorInfo[i].tensorSize,
+                   launchTensors[i].tensorSize,
+                   sizeof(m_launchTensorInfo[i].tensorSize));
+        }
+    }
+
+    std::unique_ptr<DynamicRecipe> createDynamicRecipe()
+    {
+        return std::make_unique<DynamicRecipe>(
+            recipeInfo,
+            deviceAgnosticRecipeInfo,
+            &deviceAgnosticRecipeInfo.m_recipeStaticInfoScal.recipeDsdPpInfo.getDsdDCPatchingInfo(),
+            &deviceAgnosticRecipeInfo.m_recipeStaticInfoScal.recipeAddrPatcher);
+    }
+
+    // Sets the launch shapes to the recipe ones, or to other valid ones:
+    // In0 -> node0 -> 14, node1 (In1 = 16) -> 15, node2 (In2 = 16) -> Out = 15
+    void setOtherShapes(bool other)
+    {
+        for (int j = 0; j < HABANA_DIM_MAX; j++)
+        {
+            m_launchTensorInfo[0].tensorSize[j] = other ? SET_TENSOR_SIZE - 2 : SET_TENSOR_SIZE;
+            m_launchTensorInfo[3].tensorSize[j] = other ? SET_TENSOR_SIZE - 1 : SET_TENSOR_SIZE;
+        }
+    }
+
+    // Runs SIF + SMF on freshly initialized data-chunks. The SMF runs on the node ranges starting at
+    // smfRangesStart (all the nodes at once by default)
+    DsdResult runDsd(DynamicRecipe& dynamicRecipe, const std::vector<uint32_t>& smfRangesStart = {0})
+    {
+        DsdResult result;
+        result.dataChunks.assign(2, std::vector<uint8_t>(TOTAL_DATA_SIZE, 0xCD));
+        std::vector<uint64_t> dataChunksHostAddresses;
+        for (auto& dataChunk : result.dataChunks)
+        {
+            dataChunksHostAddresses.push_back((uint64_t)dataChunk.data());
+        }
+
+        bool res = dynamicRecipe.runSifOnAllNodes(m_launchTensorInfo.data(),
+                                                  m_launchTensorInfo.size(),
+                                                  tensorIdx2userIdx,
+                                                  0 /* programDataHostAddress - NA*/);
+        EXPECT_EQ(true, res) << "Failed DSD SIF";
+
+        for (size_t range = 0; range < smfRangesStart.size(); range++)
+        {
+            const uint32_t lastNodeIndex = range + 1 < smfRangesStart.size() ? smfRangesStart[range + 1] : NUM_NODES;
+            res = dynamicRecipe.runSmfOnNodes(dataChunksHostAddresses, smfRangesStart[range], lastNodeIndex);
+            EXPECT_EQ(true, res) << "Failed DSD SMF of nodes " << smfRangesStart[range] << "-" << lastNodeIndex;
+        }
+
+        RecipeAddrPatcher& addrPatcher = dynamicRecipe.getRecipeAddrPatcher();
+        for (uint32_t pp = 0; pp < addrPatcher.getNumPatchPoints(); pp++)
+        {
+            result.effectiveAddresses.push_back(*addrPatcher.getPatchPointEffectiveAddr(pp));
+        }
+        return result;
+    }
+
+    std::vector<synLaunchTensorInfoExt> m_launchTensorInfo;
 };
 
 TEST_F(UTGaudi3RtDynamicShapesTest, dynamicPatching_gaudi3)
@@ -126,4 +227,94 @@ TEST_F(UTGaudi3RtDynamicShapesTest, dynamicPatching_gaudi3)
 
     res = dynamicRecipe.runSmfOnAllNodes(dataChunksHostAddresses);
     ASSERT_EQ(true, res) << "Failed DSD SMF";
-}
\ No newline at end of file
+}
+
+TEST_F(UTGaudi3RtDynamicShapesTest, sifCacheReplay_gaudi3)
+{
+    initDynamicRecipeTest();
+
+    // Results of uncached runs, of the recipe shapes and of other shapes
+    DsdResult expected;
+    DsdResult expectedOtherShapes;
+    {
+        ScopedConfigurationChange sifCacheSize("DSD_SIF_CACHE_SIZE", "0");
+        auto                      dynamicRecipe = createDynamicRecipe();
+        expected                                = runDsd(*dynamicRecipe);
+        setOtherShapes(true);
+        expectedOtherShapes = runDsd(*dynamicRecipe);
+        setOtherShapes(false);
+        ASSERT_EQ(dynamicRecipe->getSifCacheStats().hits + dynamicRecipe->getSifCacheStats().misses, 0U);
+    }
+    ASSERT_FALSE(expected.effectiveAddresses.empty());
+
+    ScopedConfigurationChange sifCacheSize("DSD_SIF_CACHE_SIZE", "4");
+    auto                      dynamicRecipe = createDynamicRecipe();
+    const auto&               stats         = dynamicRecipe->getSifCacheStats();
+
+    ASSERT_TRUE(runDsd(*dynamicRecipe) == expected) << "first (recorded) run differs";
+    ASSERT_EQ(stats.hits, 0U);
+    ASSERT_EQ(stats.misses, 1U);
+
+    ASSERT_TRUE(runDsd(*dynamicRecipe) == expected) << "replayed run differs";
+    ASSERT_EQ(stats.hits, 1U);
+    ASSERT_EQ(stats.misses, 1U);
+
+    // Other shapes must not replay the cached run
+    setOtherShapes(true);
+    ASSERT_TRUE(runDsd(*dynamicRecipe) == expectedOtherShapes) << "run of other shapes differs";
+    ASSERT_EQ(stats.hits, 1U);
+    ASSERT_EQ(stats.misses, 2U);
+    ASSERT_TRUE(runDsd(*dynamicRecipe) == expectedOtherShapes) << "replayed run of other shapes differs";
+    ASSERT_EQ(stats.hits, 2U);
+    ASSERT_EQ(stats.misses, 2U);
+    setOtherShapes(false);
+
+    // An aborted launch must not leave a partial replay behind
+    dynamicRecipe->patchAbort();
+    ASSERT_TRUE(runDsd(*dynamicRecipe) == expected) << "run after abort differs";
+    ASSERT_EQ(stats.hits, 3U);
+    ASSERT_EQ(stats.misses, 2U);
+}
+
+// The SMF of node ranges split between threads gives the same results as the sequential SMF, both when recording the
+// SIF cache entry (the per-thread recordings are appended by node order) and when replaying it
+TEST_F(UTGaudi3RtDynamicShapesTest, smfParallel_gaudi3)
+{
+    initDynamicRecipeTest();
+
+    DsdResult expected;
+    {
+        ScopedConfigurationChange sifCacheSize("DSD_SIF_CACHE_SIZE", "0");
+        auto                      dynamicRecipe = createDynamicRecipe();
+        ASSERT_EQ(dynamicRecipe->getSmfNumThreads(), 1U);
+        expected = runDsd(*dynamicRecipe);
+    }
+    ASSERT_FALSE(expected.effectiveAddresses.empty());
+
+    ScopedConfigurationChange minPatchPoints("PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS", "1");
+    ScopedConfigurationChange smfThreads("PARALLEL_LAUNCH_PREP_NUM_THREADS", "4");
+    {
+        ScopedConfigurationChange sifCacheSize("DSD_SIF_CACHE_SIZE", "0");
+        auto                      dynamicRecipe = createDynamicRecipe();
+        ASSERT_GT(dynamicRecipe->getSmfNumThreads(), 1U);
+        ASSERT_TRUE(runDsd(*dynamicRecipe) == expected) << "parallel SMF differs";
+        ASSERT_TRUE(runDsd(*dynamicRecipe, {0, 1}) == expected) << "parallel SMF of node ranges differs";
+    }
+
+    // All nodes at once, and the recipe split to a sequential range (node 0) and a parallel range (nodes 1-2)
+    for (const std::vector<uint32_t>& smfRangesStart : {std::vector<uint32_t> {0}, std::vector<uint32_t> {0, 1}})
+    {
+        ScopedConfigurationChange sifCacheSize("DSD_SIF_CACHE_SIZE", "4");
+        ScopedConfigurationChange minRangePatchPoints("PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS",
+                                                      smfRangesStart.size() > 1 ? "3" : "1");
+        auto                      dynamicRecipe = createDynamicRecipe();
+        const auto&               stats         = dynamicRecipe->getSifCacheStats();
+
+        ASSERT_TRUE(runDsd(*dynamicRecipe, smfRangesStart) == expected) << "recorded parallel SMF differs";
+        ASSERT_EQ(stats.misses, 1U);
+        ASSERT_TRUE(runDsd(*dynamicRecipe) == expected) << "replay of the parallel SMF recording differs";
+        ASSERT_TRUE(runDsd(*dynamicRecipe, {0, 1, 2}) == expected) << "replay by single nodes differs";
+        ASSERT_EQ(stats.hits, 2U);
+        ASSERT_EQ(stats.misses, 1U);
+    }
+}
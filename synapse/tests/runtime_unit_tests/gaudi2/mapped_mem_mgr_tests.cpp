@@ -13,6 +13,11 @@
 
 #include "gaudi2_arc_eng_packets.h"
 
+#include <atomic>
+#include <deque>
+#include <random>
+#include <thread>
+
 class UTGaudi2MappedMemMgrTest : public ::testing::TestWithParam<DummyRecipeType>
 {
 };
@@ -747,6 +752,129 @@ TEST(UTGaudi2MappedMemMgrTest, releaseEntryOrSegment)
     synDestroy();
 }
 
+// Several threads (as several streams sharing the mapped memory) launch the same and different recipes concurrently.
+// Each launch fills its patchable section with its running id, and checks that it and the non-patchable sections
+// are intact when it is released
+TEST(UTGaudi2MappedMemMgrTest, mappedMemMgr_concurrent_stress)
+{
+    synInitialize();  // for stats
+
+    // Small enough for launches to get busy and for recipes to be evicted
+    ScopedConfigurationChange dataChunksAmount("STREAM_COMPUTE_ARC_DATACHUNK_CACHE_AMOUNT_LOWER_CP", "12");
+
+    uint64_t      map2devOffset = 0x10000;
+    DummyDevAlloc dummyDevAlloc(map2devOffset);
+    MappedMemMgr  mmm("mappedMemMgr_concurrent_stress", dummyDevAlloc);
+
+    mmm.init();
+
+    const unsigned NUM_RECIPES     = 3;
+    const unsigned NUM_THREADS     = 4;
+    const unsigned NUM_RUNS        = 2000;
+    const unsigned MAX_OUTSTANDING = 2;
+
+    std::vector<std::unique_ptr<TestDummyRecipe>> dummyRecipes(NUM_RECIPES);
+    std::vector<RecipeStaticInfoScal>             recipeStaticInfoScalArr(NUM_RECIPES);
+    for (unsigned i = 0; i < NUM_RECIPES; i++)
+    {
+        dummyRecipes[i] = std::make_unique<TestDummyRecipe>(RECIPE_TYPE_NORMAL);
+        synStatus status = DeviceAgnosticRecipeStaticProcessorScal::process(synDeviceGaudi2,
+                                                                            *dummyRecipes[i]->getBasicRecipeInfo(),
+                                                                            recipeStaticInfoScalArr[i]);
+        ASSERT_EQ(status, synSuccess);
+    }
+
+    std::atomic<unsigned> failures {0};
+
+    auto launcher = [&](unsigned threadIdx) {
+        struct Launch
+        {
+            unsigned                            recipe;
+            EntryIds                            entryIds;
+            std::unique_ptr<MemorySectionsScal> pSections;
+        };
+        std::deque<Launch> outstanding;
+        std::mt19937       gen(threadIdx);
+
+        auto release = [&]() {
+            Launch& launch = outstanding.front();
+            bool    cmp    = MappedMemMgrTestUtils::testingCompareWithRecipeSimulatedPatch(
+                recipeStaticInfoScalArr[launch.recipe].recipeSections,
+                launch.entryIds.runningId,
+                *launch.pSections,
+                false,
+                false);
+            if (!cmp || !mmm.unuseId(launch.entryIds))
+            {
+                failures++;
+            }
+            outstanding.pop_front();
+        };
+
+        for (uint64_t i = 0; i < NUM_RUNS; i++)
+        {
+            unsigned recipe = gen() % NUM_RECIPES;
+            EntryIds entryIds {RecipeSeqId(dummyRecipes[recipe]->getRecipeSeqId()), ((uint64_t)threadIdx << 32) | i};
+
+            std::unique_ptr<MemorySectionsScal> pSections = std::make_unique<MemorySectionsScal>();
+            while (true)
+            {
+                mmm.getAddrForId(recipeStaticInfoScalArr[recipe], entryIds, *pSections);
+                if (!pSections->anyBusyInMapped())
+                {
+                    break;
+                }
+
+                // As waiting for a launch to complete: release our oldest one, or let the other threads release theirs
+                if (!outstanding.empty())
+                {
+                    release();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            const RecipeSingleSectionVec& recipeSections = recipeStaticInfoScalArr[recipe].recipeSections;
+            MappedMemorySectionsUtils::memcpyToMapped(*pSections, recipeSections, false, false);
+            if (pSections->m_inMappedNoPatch == OUT)
+            {
+                mmm.nonPatchableCopied(entryIds);
+            }
+            MappedMemMgrTestUtils::testingFillMappedPatchable(recipeSections, entryIds.runningId, *pSections);
+
+            outstanding.push_back({recipe, entryIds, std::move(pSections)});
+            if (outstanding.size() > MAX_OUTSTANDING)
+            {
+                release();
+            }
+        }
+
+        while (!outstanding.empty())
+        {
+            release();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned threadIdx = 0; threadIdx < NUM_THREADS; threadIdx++)
+    {
+        threads.emplace_back(launcher, threadIdx);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(failures, 0);
+
+    mmm.removeAllId();
+    ASSERT_EQ(mmm.getNumRecipes(), 0) << "mmm should be empty";
+
+    synDestroy();
+}
+
 INSTANTIATE_TEST_SUITE_P(UTGaudi2MemMgr,
                          UTGaudi2MappedMemMgrTest,
                          ::testing::Values(RECIPE_TYPE_NORMAL, RECIPE_TYPE_DSD, RECIPE_TYPE_DSD_AND_IH2D),
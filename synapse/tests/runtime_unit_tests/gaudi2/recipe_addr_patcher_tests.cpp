@@ -2,6 +2,7 @@
 #include "synapse_test.hpp"
 
 #include "runtime/scal/common/patching/recipe_addr_patcher.hpp"
+#include "scoped_configuration_change.h"
 
 class UTrecipePatchingInfo : public ::testing::Test
 {
@@ -9,7 +10,9 @@ public:
     ~UTrecipePatchingInfo();
 
     void basicTestFlow(uint32_t dcSize);
+    void deltaTestFlow(uint32_t dcSize);
     void patchingTime128K(uint8_t numDc);
+    void createRecipe128K();
 
     const int      TOTAL_BLOB     = 100;
     const int      BLOBS_WITH_PP  = TOTAL_BLOB / 2;
@@ -149,8 +152,83 @@ TEST_F(UTrecipePatchingInfo, basic_all_multi_dc_no_full)
     basicTestFlow((PATCHING_SIZE + 8 * TestDummyRecipe::BLOB_SIZE) / 4);
 }
 
+// Patch a subset of the sections after a full patching
+void UTrecipePatchingInfo::deltaTestFlow(uint32_t dcSize)
+{
+    createRecipe();
+    createDummySectionAddr(SECTION_OFFSET + BLOBS_WITH_PP);
+    copyToDummyDc(dcSize);
+
+    RecipeAddrPatcher rpi;
+    rpi.init(*m_basicRecipeInfo->recipe, dcSize);
+    ASSERT_EQ(rpi.getNumSections(), BLOBS_WITH_PP);
+    rpi.patchAll(m_sectionAddr.data(), m_dcAddr);
+
+    std::vector<uint8_t> sectionsChanged(m_sectionAddr.size(), 0);
+    for (uint32_t section = SECTION_OFFSET; section < m_sectionAddr.size(); section += 3)
+    {
+        m_sectionAddr[section] += 0x100000000 + 0x1000;
+        sectionsChanged[section] = 1;
+    }
+
+    uint32_t numPatched = rpi.patchChangedSections(m_sectionAddr.data(), sectionsChanged.data(), m_dcAddr);
+    ASSERT_EQ(numPatched, 2 * ((BLOBS_WITH_PP + 2) / 3)) << "Expected only the changed sections to be patched";
+
+    bool ok = rpi.verifySectionsAddrFromDc(m_dcAddr, dcSize, m_sectionAddr.data(), m_sectionAddr.size());
+    ASSERT_EQ(ok, true) << "Patchable buff is bad, check error log";
+
+    // A section that is not marked as changed is not patched
+    m_sectionAddr[SECTION_OFFSET + 1] += 0x100000000 + 0x1000;
+    rpi.patchChangedSections(m_sectionAddr.data(), sectionsChanged.data(), m_dcAddr);
+    ok = rpi.verifySectionsAddrFromDc(m_dcAddr, dcSize, m_sectionAddr.data(), m_sectionAddr.size());
+    ASSERT_EQ(ok, false) << "Unchanged section was patched";
+}
+
+TEST_F(UTrecipePatchingInfo, delta_single_dc)
+{
+    deltaTestFlow(PATCHING_SIZE);
+}
+
+TEST_F(UTrecipePatchingInfo, delta_multi_dc_no_full)
+{
+    deltaTestFlow((PATCHING_SIZE + 8 * TestDummyRecipe::BLOB_SIZE) / 4);
+}
+
+// The vectorized and the scalar patching give the same result
+TEST_F(UTrecipePatchingInfo, simd_same_as_scalar)
+{
+    const uint32_t dcSize = (PATCHING_SIZE + 8 * TestDummyRecipe::BLOB_SIZE) / 4;
+
+    createRecipe();
+    createDummySectionAddr(SECTION_OFFSET + BLOBS_WITH_PP);
+    copyToDummyDc(dcSize);
+
+    RecipeAddrPatcher rpiSimd;
+    rpiSimd.init(*m_basicRecipeInfo->recipe, dcSize);
+    rpiSimd.patchAll(m_sectionAddr.data(), m_dcAddr);
+
+    std::vector<std::vector<uint8_t>> simdDc;
+    for (auto& dc : m_dcAddr)
+    {
+        simdDc.emplace_back(dc.hostAddr, dc.hostAddr + dcSize);
+    }
+
+    copyToDummyDc(dcSize);
+    {
+        ScopedConfigurationChange simdPatching("ENABLE_SIMD_PATCHING", "false");
+        RecipeAddrPatcher         rpiScalar;
+        rpiScalar.init(*m_basicRecipeInfo->recipe, dcSize);
+        rpiScalar.patchAll(m_sectionAddr.data(), m_dcAddr);
+    }
+
+    for (uint32_t dc = 0; dc < m_dcAddr.size(); dc++)
+    {
+        ASSERT_EQ(memcmp(simdDc[dc].data(), m_dcAddr[dc].hostAddr, dcSize), 0) << "Different patching on dc " << dc;
+    }
+}
+
 /*********************************************************************************************/
-void UTrecipePatchingInfo::patchingTime128K(uint8_t numDc)
+void UTrecipePatchingInfo::createRecipe128K()
 {
     const uint32_t numPp       = 128 * 1024;
     const uint32_t numSections = 100;
@@ -186,8 +264,13 @@ void UTrecipePatchingInfo::patchingTime128K(uint8_t numDc)
     }
 
     createDummySectionAddr(numSections);
+}
 
-    uint64_t dcSize = patchingSize / numDc;
+void UTrecipePatchingInfo::patchingTime128K(uint8_t numDc)
+{
+    createRecipe128K();
+
+    uint64_t dcSize = m_recipe->patching_blobs_buffer_size / numDc;
 
     copyToDummyDc(dcSize);
 
@@ -222,3 +305,104 @@ TEST_F(UTrecipePatchingInfo, time_128K_4Dc)
 {
     patchingTime128K(4);
 }
+
+// Patching time of 128K patch points (4 DCs): all the sections vs. 10% of the sections, scalar vs. vectorized.
+// The dummy recipe patch points are of all types and spread evenly on the sections
+TEST_F(UTrecipePatchingInfo, time_128K_delta_vs_full)
+{
+    const uint8_t numDc = 4;
+    const int     loops = 10;
+
+    createRecipe128K();
+    uint64_t dcSize = m_recipe->patching_blobs_buffer_size / numDc;
+    copyToDummyDc(dcSize);
+
+    std::vector<uint8_t> sectionsChanged(m_sectionAddr.size(), 0);
+    for (uint32_t section = 0; section < m_sectionAddr.size(); section += 10)
+    {
+        sectionsChanged[section] = 1;
+    }
+
+    for (const char* simd : {"true", "false"})
+    {
+        ScopedConfigurationChange simdPatching("ENABLE_SIMD_PATCHING", simd);
+        RecipeAddrPatcher         rpi;
+        rpi.init(*m_basicRecipeInfo->recipe, dcSize);
+
+        std::chrono::nanoseconds fullTime(0);
+        std::chrono::nanoseconds deltaTime(0);
+        for (int loop = 0; loop < loops; loop++)
+        {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            rpi.patchAll(m_sectionAddr.data(), m_dcAddr);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            fullTime += end - begin;
+
+            for (uint32_t section = 0; section < m_sectionAddr.size(); section++)
+            {
+                if (sectionsChanged[section]) m_sectionAddr[section] += 0x1000;
+            }
+
+            begin = std::chrono::steady_clock::now();
+            rpi.patchChangedSections(m_sectionAddr.data(), sectionsChanged.data(), m_dcAddr);
+            end = std::chrono::steady_clock::now();
+            deltaTime += end - begin;
+        }
+
+        std::cout << "simd " << simd << ": full patching " << fullTime.count() / loops << "[ns], delta patching "
+                  << deltaTime.count() / loops << "[ns]" << std::endl;
+
+        bool ok = rpi.verifySectionsAddrFromDc(m_dcAddr, dcSize, m_sectionAddr.data(), m_sectionAddr.size());
+        ASSERT_EQ(ok, true) << "Patchable buff is bad, check error log";
+    }
+}
+
+// Patching time of 128K patch points (4 DCs) by the number of patching threads. The parallel patching gives the same
+// data-chunks as the sequential one
+TEST_F(UTrecipePatchingInfo, time_128K_parallel)
+{
+    const uint8_t numDc = 4;
+    const int     loops = 10;
+
+    createRecipe128K();
+    uint64_t dcSize = m_recipe->patching_blobs_buffer_size / numDc;
+
+    copyToDummyDc(dcSize);
+    {
+        RecipeAddrPatcher rpi;
+        rpi.init(*m_basicRecipeInfo->recipe, dcSize);
+        rpi.patchAll(m_sectionAddr.data(), m_dcAddr);
+    }
+    std::vector<std::vector<uint8_t>> expectedDc;
+    for (auto& dc : m_dcAddr)
+    {
+        expectedDc.emplace_back(dc.hostAddr, dc.hostAddr + dcSize);
+    }
+
+    ScopedConfigurationChange minPatchPoints("PARALLEL_LAUNCH_PREP_MIN_PATCH_POINTS", "1024");
+    for (const char* numThreads : {"1", "2", "4", "8"})
+    {
+        ScopedConfigurationChange patchingThreads("PARALLEL_LAUNCH_PREP_NUM_THREADS", numThreads);
+        RecipeAddrPatcher         rpi;
+        rpi.init(*m_basicRecipeInfo->recipe, dcSize);
+
+        copyToDummyDc(dcSize);
+        std::chrono::nanoseconds fullTime(0);
+        for (int loop = 0; loop < loops; loop++)
+        {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            rpi.patchAll(m_sectionAddr.data(), m_dcAddr);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            fullTime += end - begin;
+        }
+
+        std::cout << "patching threads " << rpi.getNumPatchingThreads() << " (max " << numThreads
+                  << "): full patching " << fullTime.count() / loops << "[ns]" << std::endl;
+
+        for (uint32_t dc = 0; dc < m_dcAddr.size(); dc++)
+        {
+            ASSERT_EQ(memcmp(expectedDc[dc].data(), m_dcAddr[dc].hostAddr, dcSize), 0)
+                << "Different patching on dc " << dc << " with " << numThreads << " threads";
+        }
+    }
+}
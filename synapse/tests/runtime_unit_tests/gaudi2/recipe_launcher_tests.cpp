@@ -132,6 +132,49 @@ public:
     {
         return synSuccess;
     };
+
+    synStatus submitPendingCommands() override
+    {
+        numOfPendingSubmits++;
+        return pendingSubmitStatus;
+    };
+
+    unsigned  numOfPendingSubmits = 0;
+    synStatus pendingSubmitStatus = synSuccess;
+};
+
+class UTRecipeLauncherTest : public ::testing::Test
+{
+protected:
+    UTRecipeLauncherTest()
+    : m_memMgrs("mock", m_devMemoryAlloc),
+      m_launcher(&m_computeScalStream,
+                 nullptr /* pComputeResources */,
+                 m_devMemoryAlloc,
+                 m_memMgrs,
+                 m_launchTracker,
+                 &m_internalRecipeHandle,
+                 nullptr /* pDynamicRecipeProcessor */,
+                 0 /* runningId */,
+                 0 /* apiId */)
+    {
+        m_internalRecipeHandle.basicRecipeHandle.recipe = &m_recipe;
+    }
+
+    void setBatchState(LaunchBatchState* pBatchState) { m_launcher.m_pBatchState = pBatchState; }
+
+    synStatus submitPendingComputeIfWaitedFor(uint64_t longSo)
+    {
+        return m_launcher.submitPendingComputeIfWaitedFor(longSo);
+    }
+
+    ScalStreamComputeMock m_computeScalStream;
+    DevMemoryAllocMock    m_devMemoryAlloc;
+    MemMgrs               m_memMgrs;
+    LaunchTrackerMock     m_launchTracker;
+    recipe_t              m_recipe {};
+    InternalRecipeHandle  m_internalRecipeHandle {};
+    RecipeLauncher        m_launcher;
 };
 
 TEST(UTRecipeLauncherTests, basic)
@@ -163,3 +206,39 @@ TEST(UTRecipeLauncherTests, basic)
     const InternalRecipeHandle& actualInternalRecipeHandle = launcher.getInternalRecipeHandle();
     ASSERT_EQ(&actualInternalRecipeHandle, &internalRecipeHandle);
 }
+
+// A launch of a batch that waits (on device, for its HBM buffers) for a launch of the batch whose compute commands
+// are still pending, submits them first
+TEST_F(UTRecipeLauncherTest, batch_pending_submit_on_download)
+{
+    // Not part of a batch
+    ASSERT_EQ(submitPendingComputeIfWaitedFor(100), synSuccess);
+    ASSERT_EQ(m_computeScalStream.numOfPendingSubmits, 0U);
+
+    LaunchBatchState batchState;
+    setBatchState(&batchState);
+
+    // Nothing is pending
+    ASSERT_EQ(submitPendingComputeIfWaitedFor(100), synSuccess);
+    ASSERT_EQ(m_computeScalStream.numOfPendingSubmits, 0U);
+
+    // Waits for a launch that precedes the pending ones
+    batchState.pendingLongSo = 10;
+    ASSERT_EQ(submitPendingComputeIfWaitedFor(9), synSuccess);
+    ASSERT_EQ(m_computeScalStream.numOfPendingSubmits, 0U);
+    ASSERT_EQ(batchState.pendingLongSo, 10U);
+
+    // Waits for the first pending launch
+    ASSERT_EQ(submitPendingComputeIfWaitedFor(10), synSuccess);
+    ASSERT_EQ(m_computeScalStream.numOfPendingSubmits, 1U);
+    ASSERT_EQ(batchState.pendingLongSo, 0U);
+
+    // Waits for a later pending launch, the submission fails and the commands stay pending
+    batchState.pendingLongSo                = 20;
+    m_computeScalStream.pendingSubmitStatus = synFail;
+    ASSERT_EQ(submitPendingComputeIfWaitedFor(25), synFail);
+    ASSERT_EQ(m_computeScalStream.numOfPendingSubmits, 2U);
+    ASSERT_EQ(batchState.pendingLongSo, 20U);
+
+    setBatchState(nullptr);
+}
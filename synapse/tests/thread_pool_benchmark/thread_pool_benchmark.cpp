@@ -0,0 +1,227 @@
+/*
+ * Fine-grained load microbenchmark of the graph compiler thread pools
+ *
+ * Runs a large number of tiny jobs through the previous ThreadPool implementation (a single mutex protected queue,
+ * kept here as a reference), through the work-stealing synapse::ThreadPool and through a TaskGroup fan-out on the
+ * WorkStealingPool, and reports the time per job of each.
+ *
+ * Usage: thread_pool_benchmark [--jobs N] [--threads N] [--json <file>]
+ */
+
+#include "infra/threads/thread_pool.h"
+#include "infra/threads/thread_work_item.h"
+#include "infra/threads/work_stealing_pool.h"
+#include "json_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// The previous ThreadPool implementation - a single mutex protected list
+class MutexQueueThreadPool
+{
+public:
+    explicit MutexQueueThreadPool(uint32_t numOfThreads)
+    {
+        for (uint32_t i = 0; i < numOfThreads; ++i)
+        {
+            m_threads.emplace_back([this]() { threadWorkFunction(); });
+        }
+    }
+
+    ~MutexQueueThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (std::thread& t : m_threads)
+        {
+            t.join();
+        }
+    }
+
+    void addJob(synapse::ThreadWorkItem* workItem)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workItems.push_back(workItem);
+        lock.unlock();
+        m_cv.notify_one();
+    }
+
+private:
+    void threadWorkFunction()
+    {
+        while (true)
+        {
+            synapse::ThreadWorkItem* wi = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (m_workItems.empty())
+                {
+                    if (m_stop) return;
+                    m_cv.wait(lock);
+                }
+                wi = m_workItems.front();
+                m_workItems.pop_front();
+            }
+            wi->call();
+        }
+    }
+
+    std::list<synapse::ThreadWorkItem*> m_workItems;
+    std::vector<std::thread>            m_threads;
+    std::mutex                          m_mutex;
+    std::condition_variable             m_cv;
+    bool                                m_stop = false;
+};
+
+class CountingWorkItem : public synapse::ThreadWorkItem
+{
+public:
+    CountingWorkItem(std::atomic<uint64_t>& count) : m_count(count) {}
+
+    void doWork() override { ++m_count; }
+
+private:
+    std::atomic<uint64_t>& m_count;
+};
+
+struct BenchmarkParams
+{
+    uint64_t    jobs    = 1000000;
+    uint32_t    threads = std::max(2U, std::thread::hardware_concurrency());
+    std::string jsonFile;
+};
+
+void runMutexQueuePool(const BenchmarkParams& params, std::atomic<uint64_t>& count)
+{
+    MutexQueueThreadPool tp(params.threads);
+    for (uint64_t i = 0; i < params.jobs; ++i)
+    {
+        tp.addJob(new CountingWorkItem(count));
+    }
+}
+
+void runWorkStealingPool(const BenchmarkParams& params, std::atomic<uint64_t>& count)
+{
+    synapse::ThreadPool tp(params.threads);
+    tp.start();
+    for (uint64_t i = 0; i < params.jobs; ++i)
+    {
+        tp.addJob(new CountingWorkItem(count));
+    }
+    tp.finish();
+}
+
+void runTaskGroupFanOut(const BenchmarkParams& params, std::atomic<uint64_t>& count)
+{
+    static const uint64_t     numOfChunks = 1000;
+    const uint64_t            chunkSize   = (params.jobs + numOfChunks - 1) / numOfChunks;
+    synapse::WorkStealingPool pool(params.threads);
+    synapse::TaskGroup        outer(pool);
+    for (uint64_t first = 0; first < params.jobs; first += chunkSize)
+    {
+        const uint64_t last = std::min(first + chunkSize, params.jobs);
+        outer.run([&, first, last]() {
+            synapse::TaskGroup inner(pool);
+            for (uint64_t j = first; j < last; ++j)
+            {
+                inner.run([&]() { ++count; });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+}
+
+bool parseArgs(int argc, char* argv[], BenchmarkParams& rParams)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const std::string value = argv[++i];
+        if (arg == "--jobs")
+        {
+            rParams.jobs = std::stoull(value);
+        }
+        else if (arg == "--threads")
+        {
+            rParams.threads = std::stoul(value);
+        }
+        else if (arg == "--json")
+        {
+            rParams.jsonFile = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return rParams.jobs > 0 && rParams.threads > 0;
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    BenchmarkParams params;
+    if (!parseArgs(argc, argv, params))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--jobs N] [--threads N] [--json <file>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    using BenchmarkFunc = void (*)(const BenchmarkParams&, std::atomic<uint64_t>&);
+    const std::vector<std::pair<std::string, BenchmarkFunc>> benchmarks = {
+        {"mutex queue pool, external submission", runMutexQueuePool},
+        {"work-stealing pool, external submission", runWorkStealingPool},
+        {"work-stealing pool, task group fan-out", runTaskGroupFanOut}};
+
+    int                result  = EXIT_SUCCESS;
+    nlohmann_hcl::json results = nlohmann_hcl::json::array();
+    for (const auto& [name, run] : benchmarks)
+    {
+        std::atomic<uint64_t> count(0);
+        const auto            start = std::chrono::steady_clock::now();
+        run(params, count);
+        const auto timeNs =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        const double nsPerJob = (double)timeNs / params.jobs;
+
+        std::cout << name << ": " << params.jobs << " jobs on " << params.threads << " threads, " << std::fixed
+                  << std::setprecision(3) << timeNs / 1e6 << " ms, " << std::setprecision(1) << nsPerJob
+                  << " ns/job" << std::endl;
+        if (count != params.jobs)
+        {
+            std::cerr << name << ": " << count << " jobs were run instead of " << params.jobs << std::endl;
+            result = EXIT_FAILURE;
+        }
+
+        nlohmann_hcl::json json;
+        json["pool"]       = name;
+        json["jobs"]       = params.jobs;
+        json["threads"]    = params.threads;
+        json["time_ns"]    = timeNs;
+        json["ns_per_job"] = nsPerJob;
+        results.push_back(std::move(json));
+    }
+
+    if (!params.jsonFile.empty())
+    {
+        json_utils::jsonToFile(results, params.jsonFile, 4);
+    }
+    return result;
+}